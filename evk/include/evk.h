@@ -22,7 +22,7 @@ evkResult evk_shutdown();
 /// @brief updates the renderer, starting the render commands and eventually calling back when it's time to render objects
 void evk_update(float timestep);
 
-/// @brief returns the id of an object underneath a given xy coordinates
+/// @brief returns the entity underneath a given xy coordinates, 0 when there's none or it was destroyed, resolve it with evk_entity_get
 uint32_t evk_pick_object(float2 xy);
 
 /// @brief returns the global context, used for external functions
@@ -31,6 +31,22 @@ evkContext* evk_get_context();
 /// @brief returns the main camera, object created to facilitate usage of the api
 evkCamera* evk_get_main_camera();
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Entities
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief creates an entity for an object, returning a handle with it's slot index and generation, 0 when out of ids or memory
+uint32_t evk_entity_create(void* object);
+
+/// @brief releases an entity, every copy of it's handle becomes stale and the slot is reused
+void evk_entity_destroy(uint32_t entity);
+
+/// @brief returns the object of an entity, NULL when the entity is 0 or was destroyed
+void* evk_entity_get(uint32_t entity);
+
+/// @brief returns true while the entity was not destroyed
+bool evk_entity_is_alive(uint32_t entity);
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Getters/Setters
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -78,18 +94,80 @@ void evk_set_renderui_callback(evkCalllback_RenderUI callback);
 /// @brief returns the function address responsible for issue the rendering of ui
 evkCalllback_RenderUI evk_get_renderui_callback();
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Memory
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief allocates memory charged to tag through the allocator given to evk_init, NULL when over budget or out of memory
+void* evk_allocator_alloc(evkAllocationTag tag, size_t size, size_t alignment, const char* file, int32_t line);
+
+/// @brief allocates zeroed memory charged to tag
+void* evk_allocator_calloc(evkAllocationTag tag, size_t num, size_t size, const char* file, int32_t line);
+
+/// @brief resizes memory from evk_allocator_alloc, NULL memory allocates and size 0 frees, the block keeps the tag it had
+void* evk_allocator_realloc(evkAllocationTag tag, void* memory, size_t size, size_t alignment, const char* file, int32_t line);
+
+/// @brief releases memory from evk_allocator_alloc, NULL is ignored
+void evk_allocator_free(void* memory, const char* file, int32_t line);
+
+/// @brief returns the usage of an allocation tag
+evkAllocationStats evk_get_allocation_stats(evkAllocationTag tag);
+
+/// @brief allocation macros used across evk, memory is aligned to 16 bytes
+#define EVK_MALLOC(tag, size) evk_allocator_alloc(tag, size, 16, __FILE__, __LINE__)
+#define EVK_CALLOC(tag, num, size) evk_allocator_calloc(tag, num, size, __FILE__, __LINE__)
+#define EVK_REALLOC(tag, ptr, size) evk_allocator_realloc(tag, ptr, size, 16, __FILE__, __LINE__)
+#define EVK_FREE(ptr) evk_allocator_free(ptr, __FILE__, __LINE__)
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Log and error
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// @brief general logging function
+/// @brief starts the thread queued messages are formatted and written on, called by evk_init, until then messages are written synchronously
+evkResult evk_log_init();
+
+/// @brief writes whatever is still queued and stops the log thread
+void evk_log_shutdown();
+
+/// @brief blocks until every message queued so far was written
+void evk_log_flush();
+
+/// @brief sets the threshold of every category
+void evk_log_set_severity(evkSeverity severity);
+
+/// @brief mutes the severities of a category below severity, fatal messages are always written
+void evk_log_set_threshold(evkLogCategory category, evkSeverity severity);
+
+/// @brief mutes or unmutes a single severity of a category, fatal can't be muted
+void evk_log_set_enabled(evkLogCategory category, evkSeverity severity, bool enabled);
+
+/// @brief returns if messages of a severity are written for a category
+bool evk_log_is_enabled(evkLogCategory category, evkSeverity severity);
+
+/// @brief returns how many messages were rate limited since evk_init, every call site included
+uint64_t evk_log_get_suppressed_count();
+
+/// @brief general logging function under the general category, the arguments are queued and formatted on the log thread, fatal messages are written before returning and abort
 void evk_log_message(evkSeverity severity, const char* file, int32_t line, const char* fmt, ...);
 
-/// @brief log macro 
+/// @brief logging function behind EVK_LOG, the category was already checked and the call site is rate limited
+void evk_log_site_message(evkLogSite* site, evkSeverity severity, const char* file, int32_t line, const char* fmt, ...);
+
+/// @brief muted severities per category, read by EVK_LOG so a muted message costs a single branch
+extern uint32_t g_EVKLogMuted[evk_Log_Category_Max];
+
+/// @brief category EVK_LOG writes under, implementation files set their own
+#ifndef EVK_LOG_CATEGORY
+	#define EVK_LOG_CATEGORY evk_Log_Category_General
+#endif
+
+/// @brief log macro, every expansion is a call site with it's own rate limit
 #ifdef EVK_ENABLE_VALIDATIONS
-	#define EVK_LOG(severity, ...) evk_log_message(severity, __FILE__, __LINE__, __VA_ARGS__);
+	#define EVK_LOG_AT(category, severity, ...) do { if ((g_EVKLogMuted[category] & (1u << (severity))) == 0) { static evkLogSite evkLogSite_ = { 0 }; evk_log_site_message(&evkLogSite_, severity, __FILE__, __LINE__, __VA_ARGS__); } } while (0)
+	#define EVK_LOG(severity, ...) EVK_LOG_AT(EVK_LOG_CATEGORY, severity, __VA_ARGS__)
 	#define EVK_ASSERT(condition, ...) if (!(condition)) { evk_log_message(evk_Fatal, __FILE__, __LINE__, __VA_ARGS__); }
 #else
+	#define EVK_LOG_AT(...)
 	#define EVK_LOG(...)
 	#define EVK_ASSERT(condition, msg) ((void)0)
 #endif
@@ -155,6 +233,25 @@ float3 evk_camera_get_position(evkCamera* camera);
 /// @brief returns the camera's current 3d front position
 float3 evk_camera_get_front(evkCamera* camera);
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Asset Pack
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief maps an asset pack (tools/asset_pack) into memory, the toc is validated once so lookups don't need to
+evkAssetPack* evk_asset_pack_open(const char* path);
+
+/// @brief unmaps the asset pack, blobs found inside it become invalid
+void evk_asset_pack_close(evkAssetPack* pack);
+
+/// @brief finds an asset by name in constant time, blob data points straight into the mapping
+bool evk_asset_pack_find(const evkAssetPack* pack, const char* name, evkAssetBlob* blob);
+
+/// @brief hints the os that a set of assets, like everything a level uses, is about to be read so it starts paging them in
+void evk_asset_pack_prefetch(const evkAssetPack* pack, const char* const* names, uint32_t count);
+
+/// @brief returns how many assets the pack holds
+uint32_t evk_asset_pack_get_count(const evkAssetPack* pack);
+
 #ifdef __cplusplus 
 }
 #endif
@@ -29,6 +29,9 @@
 #include "volk/volk.h"
 
 #define STB_IMAGE_IMPLEMENTATION
+#define STBI_MALLOC(size) EVK_MALLOC(evk_Allocation_Tag_Image, size)
+#define STBI_REALLOC(ptr, size) EVK_REALLOC(evk_Allocation_Tag_Image, ptr, size)
+#define STBI_FREE(ptr) EVK_FREE(ptr)
 #include "stb/stb_image.h"
 
 #define VECMATH_IMPLEMENTATION
@@ -44,9 +47,22 @@
 #define EVK_VULKAN_CORE_IMPLEMENTATION
 #include "evk_vulkan_core.h"
 
+#undef EVK_LOG_CATEGORY
+#define EVK_LOG_CATEGORY evk_Log_Category_General
+
 #include <stdio.h>
 #include <stdarg.h>
 #include <string.h>
+#include <time.h>
+
+#ifndef _WIN32
+    #include <pthread.h>
+    #include <sys/select.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -60,9 +76,14 @@ struct evkContext
     bool hint_resize;
 
     evkCamera* mainCamera;
-    idgen* idgen;
     evkMSAA msaa;
 
+    // entities, idgen hands out the slot indices and the generation of a slot is bumped when it's released
+    idgen* idgen;
+    void** entityObjects;
+    uint8_t* entityGenerations;
+    uint32_t entityCapacity;
+
     float2 viewportSize;
     float2 framebufferSize;
 
@@ -102,7 +123,214 @@ struct evkCamera
     bool movingRight;
 };
 
+struct evkAssetPack
+{
+    const uint8_t* base;
+    uint64_t size;
+    const evkAssetPackHeader* header;
+    const evkAssetPackEntry* toc;
+    const char* names;
+
+    #ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+    #else
+    int file;
+    #endif
+};
+
 static evkContext* g_EVKContext = NULL;
+static evkAllocator g_EVKAllocator = { 0 };
+static evkAllocationStats g_EVKAllocationStats[evk_Allocation_Tag_Max] = { 0 };
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Memory
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief precedes every block, offset is how far the block starts from what the allocator returned
+typedef struct ievkAllocationHeader
+{
+    uint64_t size;
+    uint32_t tag;
+    uint32_t offset;
+} ievkAllocationHeader;
+
+#define EVK_ALLOCATION_HEADER_SIZE 16
+
+#ifdef EVK_ENABLE_VALIDATIONS
+static const char* ievk_allocation_tag_to_str(evkAllocationTag tag)
+{
+    switch (tag)
+    {
+        case evk_Allocation_Tag_Context: return "Context";
+        case evk_Allocation_Tag_Core: return "Core";
+        case evk_Allocation_Tag_Renderphase: return "Renderphase";
+        case evk_Allocation_Tag_Drawable: return "Drawable";
+        case evk_Allocation_Tag_Image: return "Image";
+        case evk_Allocation_Tag_Container: return "Container";
+        case evk_Allocation_Tag_Vulkan: return "Vulkan";
+        default: break;
+    }
+    return "Unknown";
+}
+#endif
+
+/// @brief charges size bytes to a tag, false when it would go over the tag's budget
+static bool ievk_allocation_reserve(evkAllocationTag tag, uint64_t size)
+{
+    evkAllocationStats* stats = &g_EVKAllocationStats[tag];
+    uint64_t current = EVK_ATOMIC_FETCH_ADD(&stats->current, size) + size;
+
+    if (stats->budget != 0 && current > stats->budget) {
+        EVK_ATOMIC_FETCH_ADD(&stats->current, (uint64_t)0 - size);
+        EVK_ATOMIC_FETCH_ADD(&stats->failures, (uint64_t)1);
+        EVK_LOG(evk_Error, "%s allocation of %llu bytes refused, the budget is %llu bytes", ievk_allocation_tag_to_str(tag), (unsigned long long)size, (unsigned long long)stats->budget);
+        return false;
+    }
+
+    uint64_t peak = EVK_ATOMIC_LOAD(&stats->peak);
+    while (current > peak && !EVK_ATOMIC_CAS(&stats->peak, peak, current)) {
+        peak = EVK_ATOMIC_LOAD(&stats->peak);
+    }
+    return true;
+}
+
+static void ievk_allocation_release(evkAllocationTag tag, uint64_t size)
+{
+    EVK_ATOMIC_FETCH_ADD(&g_EVKAllocationStats[tag].current, (uint64_t)0 - size);
+}
+
+/// @brief called when the allocator itself fails, the bytes reserved for the block are given back
+static void ievk_allocation_failed(evkAllocationTag tag, uint64_t size)
+{
+    ievk_allocation_release(tag, size);
+    EVK_ATOMIC_FETCH_ADD(&g_EVKAllocationStats[tag].failures, (uint64_t)1);
+    EVK_LOG(evk_Error, "Out of memory for a %s allocation of %llu bytes", ievk_allocation_tag_to_str(tag), (unsigned long long)size);
+}
+
+void* evk_allocator_alloc(evkAllocationTag tag, size_t size, size_t alignment, const char* file, int32_t line)
+{
+    if (alignment < EVK_ALLOCATION_HEADER_SIZE) alignment = EVK_ALLOCATION_HEADER_SIZE;
+
+    if ((uint32_t)tag >= evk_Allocation_Tag_Max || (alignment & (alignment - 1)) != 0 || size > SIZE_MAX - alignment) {
+        EVK_LOG(evk_Error, "Invalid allocation of %llu bytes aligned to %llu", (unsigned long long)size, (unsigned long long)alignment);
+        return NULL;
+    }
+
+    if (!ievk_allocation_reserve(tag, size)) return NULL;
+
+    // memm only guarantees 16 bytes, so the block has room to move up to alignment whatever the allocator returns
+    uint8_t* raw = g_EVKAllocator.allocate != NULL
+        ? (uint8_t*)g_EVKAllocator.allocate(g_EVKAllocator.userData, size + alignment, alignment, tag)
+        : (uint8_t*)memm_malloc(size + alignment, file, line);
+
+    if (raw == NULL) {
+        ievk_allocation_failed(tag, size);
+        return NULL;
+    }
+
+    uint8_t* memory = (uint8_t*)(((uintptr_t)raw + EVK_ALLOCATION_HEADER_SIZE + alignment - 1) & ~(uintptr_t)(alignment - 1));
+    ievkAllocationHeader* header = (ievkAllocationHeader*)(memory - EVK_ALLOCATION_HEADER_SIZE);
+    header->size = size;
+    header->tag = (uint32_t)tag;
+    header->offset = (uint32_t)(memory - raw);
+
+    EVK_ATOMIC_FETCH_ADD(&g_EVKAllocationStats[tag].allocations, (uint64_t)1);
+    return memory;
+}
+
+void* evk_allocator_calloc(evkAllocationTag tag, size_t num, size_t size, const char* file, int32_t line)
+{
+    if (size != 0 && num > SIZE_MAX / size) {
+        EVK_LOG(evk_Error, "Invalid allocation of %llu elements of %llu bytes", (unsigned long long)num, (unsigned long long)size);
+        return NULL;
+    }
+
+    void* memory = evk_allocator_alloc(tag, num * size, EVK_ALLOCATION_HEADER_SIZE, file, line);
+    if (memory != NULL) memset(memory, 0, num * size);
+    return memory;
+}
+
+void* evk_allocator_realloc(evkAllocationTag tag, void* memory, size_t size, size_t alignment, const char* file, int32_t line)
+{
+    if (memory == NULL) return evk_allocator_alloc(tag, size, alignment, file, line);
+
+    if (size == 0) {
+        evk_allocator_free(memory, file, line);
+        return NULL;
+    }
+
+    ievkAllocationHeader* header = (ievkAllocationHeader*)((uint8_t*)memory - EVK_ALLOCATION_HEADER_SIZE);
+    evkAllocationTag owner = (evkAllocationTag)header->tag;
+    uint64_t oldSize = header->size;
+
+    // blocks right after their header are resized in place by the allocator, over-aligned ones would have their contents shifted so they're copied
+    bool inPlace = header->offset == EVK_ALLOCATION_HEADER_SIZE && alignment <= EVK_ALLOCATION_HEADER_SIZE && size <= SIZE_MAX - EVK_ALLOCATION_HEADER_SIZE;
+    if (g_EVKAllocator.allocate != NULL && g_EVKAllocator.reallocate == NULL) inPlace = false;
+
+    if (!inPlace) {
+        void* moved = evk_allocator_alloc(owner, size, alignment, file, line);
+        if (moved == NULL) return NULL;
+
+        memcpy(moved, memory, size < oldSize ? size : (size_t)oldSize);
+        evk_allocator_free(memory, file, line);
+        return moved;
+    }
+
+    if (size > oldSize && !ievk_allocation_reserve(owner, size - oldSize)) return NULL;
+
+    uint8_t* raw = (uint8_t*)header;
+    uint8_t* resized = g_EVKAllocator.allocate != NULL
+        ? (uint8_t*)g_EVKAllocator.reallocate(g_EVKAllocator.userData, raw, size + EVK_ALLOCATION_HEADER_SIZE, EVK_ALLOCATION_HEADER_SIZE, owner)
+        : (uint8_t*)memm_realloc(raw, size + EVK_ALLOCATION_HEADER_SIZE, file, line);
+
+    if (resized == NULL) {
+        if (size > oldSize) ievk_allocation_failed(owner, size - oldSize);
+        return NULL;
+    }
+
+    if (size < oldSize) ievk_allocation_release(owner, oldSize - size);
+
+    header = (ievkAllocationHeader*)resized;
+    header->size = size;
+
+    EVK_ATOMIC_FETCH_ADD(&g_EVKAllocationStats[owner].allocations, (uint64_t)1);
+    return resized + EVK_ALLOCATION_HEADER_SIZE;
+}
+
+void evk_allocator_free(void* memory, const char* file, int32_t line)
+{
+    if (memory == NULL) return;
+
+    ievkAllocationHeader* header = (ievkAllocationHeader*)((uint8_t*)memory - EVK_ALLOCATION_HEADER_SIZE);
+    evkAllocationTag tag = (evkAllocationTag)header->tag;
+    uint8_t* raw = (uint8_t*)memory - header->offset;
+
+    ievk_allocation_release(tag, header->size);
+    EVK_ATOMIC_FETCH_ADD(&g_EVKAllocationStats[tag].frees, (uint64_t)1);
+
+    if (g_EVKAllocator.allocate == NULL) {
+        memm_free(raw, file, line);
+    }
+
+    else if (g_EVKAllocator.free != NULL) {
+        g_EVKAllocator.free(g_EVKAllocator.userData, raw, tag);
+    }
+}
+
+evkAllocationStats evk_get_allocation_stats(evkAllocationTag tag)
+{
+    evkAllocationStats stats = { 0 };
+    if ((uint32_t)tag >= evk_Allocation_Tag_Max) return stats;
+
+    stats.current = EVK_ATOMIC_LOAD(&g_EVKAllocationStats[tag].current);
+    stats.peak = EVK_ATOMIC_LOAD(&g_EVKAllocationStats[tag].peak);
+    stats.budget = g_EVKAllocationStats[tag].budget;
+    stats.allocations = EVK_ATOMIC_LOAD(&g_EVKAllocationStats[tag].allocations);
+    stats.frees = EVK_ATOMIC_LOAD(&g_EVKAllocationStats[tag].frees);
+    stats.failures = EVK_ATOMIC_LOAD(&g_EVKAllocationStats[tag].failures);
+    return stats;
+}
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Context
@@ -110,11 +338,28 @@ static evkContext* g_EVKContext = NULL;
 
 evkResult evk_init(const evkCreateInfo* ci)
 {
-    // general initialization
+    // blocks from one hook would reach the other, so allocate and free are given together and reallocate only along with them
+    bool hooked = ci->allocator.allocate != NULL;
+    if (hooked != (ci->allocator.free != NULL) || (!hooked && ci->allocator.reallocate != NULL)) {
+        EVK_LOG(evk_Error, "The allocator must set allocate and free together, reallocate is optional and needs both");
+        return evk_Failure;
+    }
+
+    // general initialization, the allocator is set before anything is allocated
     memm_init();
 
+    g_EVKAllocator = ci->allocator;
+    for (uint32_t i = 0; i < evk_Allocation_Tag_Max; i++) {
+        memset(&g_EVKAllocationStats[i], 0, sizeof(evkAllocationStats));
+        g_EVKAllocationStats[i].budget = ci->allocator.budgets[i];
+    }
+
+    if (evk_log_init() != evk_Success) {
+        EVK_LOG(evk_Warn, "Failed to start the log thread, messages are written by the threads logging them");
+    }
+
     if (g_EVKContext == NULL) {
-        g_EVKContext = (evkContext*)m_malloc(sizeof(evkContext));
+        g_EVKContext = (evkContext*)EVK_MALLOC(evk_Allocation_Tag_Context, sizeof(evkContext));
         if (!g_EVKContext) {
             EVK_LOG(evk_Fatal, "Failed to allocate memory resources for evkContext");
             return evk_Failure;
@@ -126,11 +371,18 @@ evkResult evk_init(const evkCreateInfo* ci)
     g_EVKContext->hint_vsync = ci->vsync;
     g_EVKContext->hint_resize = false;
     g_EVKContext->msaa = ci->MSAA;
-    g_EVKContext->idgen = idgen_create(1);
+    g_EVKContext->idgen = idgen_create_memfuncs(1, evk_get_container_memfuncs());
+    g_EVKContext->entityObjects = NULL;
+    g_EVKContext->entityGenerations = NULL;
+    g_EVKContext->entityCapacity = 0;
     g_EVKContext->mainCamera = evk_camera_create((float)(ci->width / ci->height));
 
     // vulkan initialization
     evkResult res = evk_initialize_backend(ci);
+    if (res != evk_Success) {
+        EVK_LOG(evk_Error, "Failed to initialize the vulkan backend");
+        return res;
+    }
 
     return evk_Success;
 }
@@ -139,9 +391,20 @@ evkResult evk_shutdown()
 {
     evk_shutdown_backend();
     idgen_destroy(g_EVKContext->idgen);
+    if (g_EVKContext->entityObjects) EVK_FREE(g_EVKContext->entityObjects);
+    if (g_EVKContext->entityGenerations) EVK_FREE(g_EVKContext->entityGenerations);
     evk_camera_destroy(g_EVKContext->mainCamera);
 
-    m_free(g_EVKContext);
+    EVK_FREE(g_EVKContext);
+    g_EVKContext = NULL;
+    evk_log_shutdown();
+
+    for (uint32_t i = 0; i < evk_Allocation_Tag_Max; i++) {
+        if (g_EVKAllocationStats[i].current > 0) {
+            EVK_LOG(evk_Warn, "%s allocations still hold %llu bytes", ievk_allocation_tag_to_str((evkAllocationTag)i), (unsigned long long)g_EVKAllocationStats[i].current);
+        }
+    }
+
     memm_print_leaks();
     memm_shutdown();
 
@@ -156,7 +419,9 @@ void evk_update(float timestep)
 
 uint32_t evk_pick_object(float2 xy)
 {
-    return evk_pick_object_backend(xy);
+    // the picking image may still hold entities destroyed after it was rendered
+    uint32_t entity = evk_pick_object_backend(xy);
+    return evk_entity_is_alive(entity) ? entity : 0;
 }
 
 evkContext* evk_get_context()
@@ -170,6 +435,91 @@ evkCamera* evk_get_main_camera()
     return g_EVKContext != NULL ? g_EVKContext->mainCamera : NULL;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Entities
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define EVK_ENTITY_INDEX_MASK ((1u << EVK_ENTITY_INDEX_BITS) - 1u)
+
+/// @brief grows the slot arrays so index is addressable, new slots start at generation 0
+static bool ievk_entity_reserve(uint32_t index)
+{
+    uint32_t oldCapacity = g_EVKContext->entityCapacity;
+    if (index < oldCapacity) return true;
+
+    uint32_t capacity = oldCapacity ? oldCapacity : EVK_ENTITY_INITIAL_CAPACITY;
+    while (capacity <= index) capacity *= 2;
+
+    void** objects = (void**)EVK_REALLOC(evk_Allocation_Tag_Context, g_EVKContext->entityObjects, capacity * sizeof(void*));
+    if (!objects) return false;
+    memset(objects + oldCapacity, 0, (capacity - oldCapacity) * sizeof(void*));
+    g_EVKContext->entityObjects = objects;
+
+    uint8_t* generations = (uint8_t*)EVK_REALLOC(evk_Allocation_Tag_Context, g_EVKContext->entityGenerations, capacity * sizeof(uint8_t));
+    if (!generations) return false;
+    memset(generations + oldCapacity, 0, (capacity - oldCapacity) * sizeof(uint8_t));
+    g_EVKContext->entityGenerations = generations;
+
+    g_EVKContext->entityCapacity = capacity;
+    return true;
+}
+
+/// @brief returns the slot index of a live entity, 0 when it's stale or invalid
+static uint32_t ievk_entity_index(uint32_t entity)
+{
+    if (!g_EVKContext || entity == 0) return 0;
+
+    uint32_t index = entity & EVK_ENTITY_INDEX_MASK;
+    if (index >= g_EVKContext->entityCapacity) return 0;
+    if (g_EVKContext->entityGenerations[index] != (uint8_t)(entity >> EVK_ENTITY_INDEX_BITS)) return 0;
+    if (!idgen_is_registered(g_EVKContext->idgen, index)) return 0;
+
+    return index;
+}
+
+uint32_t evk_entity_create(void* object)
+{
+    if (!g_EVKContext) return 0;
+
+    // idgen starts at 1, so index 0 and therefore entity 0 are never handed out
+    uint32_t index = idgen_next(g_EVKContext->idgen);
+    if (index == 0 || index > EVK_ENTITY_INDEX_MASK) {
+        EVK_LOG(evk_Error, "Out of entity ids");
+        if (index != 0) idgen_unregister(g_EVKContext->idgen, index);
+        return 0;
+    }
+
+    if (!ievk_entity_reserve(index)) {
+        EVK_LOG(evk_Error, "Out of memory to grow the entity slots");
+        idgen_unregister(g_EVKContext->idgen, index);
+        return 0;
+    }
+
+    g_EVKContext->entityObjects[index] = object;
+    return index | ((uint32_t)g_EVKContext->entityGenerations[index] << EVK_ENTITY_INDEX_BITS);
+}
+
+void evk_entity_destroy(uint32_t entity)
+{
+    uint32_t index = ievk_entity_index(entity);
+    if (index == 0) return;
+
+    g_EVKContext->entityObjects[index] = NULL;
+    g_EVKContext->entityGenerations[index]++;
+    idgen_unregister(g_EVKContext->idgen, index);
+}
+
+void* evk_entity_get(uint32_t entity)
+{
+    uint32_t index = ievk_entity_index(entity);
+    return index != 0 ? g_EVKContext->entityObjects[index] : NULL;
+}
+
+bool evk_entity_is_alive(uint32_t entity)
+{
+    return ievk_entity_index(entity) != 0;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Getters/Setters
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -295,56 +645,624 @@ static const char* ievk_severity_to_str(evkSeverity severity)
     return "UNKNOWN";
 }
 
-static void ievk_log_format(char* outBuffer, size_t size, const struct tm* localTime, const char* file, int line, evkSeverity severity, const char* buffer)
+/// @brief a queued message, the arguments are packed as the format asks for them and only turned into text by the log thread
+typedef struct ievkLogRecord
 {
+    uint64_t sequence;      // equals the position it was written at plus one once published, the worker hands it back one lap later
+    int64_t time;
+    const char* file;
+    const char* fmt;
+    int32_t line;
+    uint32_t severity;
+    uint32_t preformatted;  // the payload already holds the message, used when the arguments can't be packed
+    uint32_t size;          // bytes of payload in use
+    uint8_t payload[EVK_LOG_PAYLOAD_SIZE];
+} ievkLogRecord;
+
+/// @brief bounded multi-producer queue drained by a single thread, producers never wait and drop the message when it's full
+typedef struct ievkLogger
+{
+    ievkLogRecord* records;
+    uint64_t head;          // next record the worker writes
+    uint64_t tail;          // next record handed to a producer
+    uint64_t dropped;       // messages lost because the queue was full
+    uint64_t reported;      // dropped messages already reported by the worker
+    uint64_t suppressed;    // messages rate limited since evk_init, across every call site
+    uint64_t sites;         // address of the last call site that had messages suppressed, they're chained through next
+    uint64_t running;       // 1 while the worker runs, 2 while it's being stopped and 0 once it's gone
+
+    #ifdef _WIN32
+    HANDLE thread;
+    #else
+    pthread_t thread;
+    #endif
+} ievkLogger;
+
+static ievkLogger g_EVKLogger = { 0 };
+
+/// @brief severities muted per category as bits, not static since EVK_LOG reads it wherever it's expanded
+uint32_t g_EVKLogMuted[evk_Log_Category_Max] = { 0 };
+
+/// @brief how a packed argument is read back, it keeps the type it was passed with
+typedef enum ievkLogArg
+{
+    ievk_Log_Arg_Invalid = 0,
+    ievk_Log_Arg_Int,
+    ievk_Log_Arg_Long,
+    ievk_Log_Arg_LongLong,
+    ievk_Log_Arg_Size,
+    ievk_Log_Arg_IntMax,
+    ievk_Log_Arg_PtrDiff,
+    ievk_Log_Arg_Double,
+    ievk_Log_Arg_LongDouble,
+    ievk_Log_Arg_Pointer,
+    ievk_Log_Arg_String
+} ievkLogArg;
+
+/// @brief a conversion of a format string, from it's '%' to one past the conversion character
+typedef struct ievkLogSpec
+{
+    const char* start;
+    const char* end;
+    uint32_t stars;         // width and precision given as int arguments before the value
+    int precision;          // -1 when not given, -2 when it's the last star argument
+    ievkLogArg arg;
+} ievkLogSpec;
+
+/// @brief finds the next conversion of fmt, false when there's none left, %% is left as text
+static bool ievk_log_next_spec(const char* fmt, ievkLogSpec* spec)
+{
+    const char* c = fmt;
+    while ((c = strchr(c, '%')) != NULL) {
+        if (c[1] == '%') {
+            c += 2;
+            continue;
+        }
+
+        spec->start = c++;
+        spec->stars = 0;
+        spec->precision = -1;
+
+        while (*c != '\0' && strchr("-+ #0", *c) != NULL) c++;
+        if (*c == '*') { spec->stars++; c++; }
+        while (*c >= '0' && *c <= '9') c++;
+        if (*c == '.') {
+            c++;
+            spec->precision = 0;
+            if (*c == '*') { spec->stars++; spec->precision = -2; c++; }
+            while (*c >= '0' && *c <= '9') {
+                if (spec->precision < 100000) spec->precision = spec->precision * 10 + (*c - '0'); // longer than any payload anyway
+                c++;
+            }
+        }
+
+        char length = 0;
+        if ((c[0] == 'h' || c[0] == 'l') && c[1] == c[0]) { length = (char)(c[0] == 'l' ? 'q' : 'H'); c += 2; }
+        else if (*c != '\0' && strchr("hlzjtL", *c) != NULL) length = *c++;
+
+        char conversion = *c;
+        if (conversion != '\0') c++;
+        spec->end = c;
+
+        switch (conversion)
+        {
+            case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+            {
+                if (conversion == 'c' && length != 0) spec->arg = ievk_Log_Arg_Invalid;
+                else if (length == 'l') spec->arg = ievk_Log_Arg_Long;
+                else if (length == 'q') spec->arg = ievk_Log_Arg_LongLong;
+                else if (length == 'z') spec->arg = ievk_Log_Arg_Size;
+                else if (length == 'j') spec->arg = ievk_Log_Arg_IntMax;
+                else if (length == 't') spec->arg = ievk_Log_Arg_PtrDiff;
+                else if (length == 'L') spec->arg = ievk_Log_Arg_Invalid;
+                else spec->arg = ievk_Log_Arg_Int;
+                break;
+            }
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            {
+                spec->arg = length == 'L' ? ievk_Log_Arg_LongDouble : (length == 0 || length == 'l') ? ievk_Log_Arg_Double : ievk_Log_Arg_Invalid;
+                break;
+            }
+            case 's': spec->arg = length == 0 ? ievk_Log_Arg_String : ievk_Log_Arg_Invalid; break;
+            case 'p': spec->arg = length == 0 ? ievk_Log_Arg_Pointer : ievk_Log_Arg_Invalid; break;
+            default: spec->arg = ievk_Log_Arg_Invalid; break; // %n, wide strings and unknown conversions
+        }
+        return true;
+    }
+    return false;
+}
+
+/// @brief appends size bytes to the payload keeping 8 byte alignment, false when they don't fit
+static bool ievk_log_push(ievkLogRecord* record, const void* data, size_t size)
+{
+    size_t aligned = (size + 7) & ~(size_t)7;
+    if (aligned > EVK_LOG_PAYLOAD_SIZE - record->size) return false;
+
+    memcpy(record->payload + record->size, data, size);
+    record->size += (uint32_t)aligned;
+    return true;
+}
+
+/// @brief packs the arguments fmt asks for, strings are copied and truncated to what's left, false when the message must be formatted instead
+static bool ievk_log_pack(ievkLogRecord* record, const char* fmt, va_list args)
+{
+    ievkLogSpec spec;
+    record->size = 0;
+
+    while (ievk_log_next_spec(fmt, &spec)) {
+        if (spec.arg == ievk_Log_Arg_Invalid) return false;
+
+        int star = -1;
+        for (uint32_t i = 0; i < spec.stars; i++) {
+            star = va_arg(args, int);
+            if (!ievk_log_push(record, &star, sizeof(int))) return false;
+        }
+        int precision = spec.precision == -2 ? (star < 0 ? -1 : star) : spec.precision;
+
+        bool pushed = false;
+        switch (spec.arg)
+        {
+            case ievk_Log_Arg_Int: { int value = va_arg(args, int); pushed = ievk_log_push(record, &value, sizeof(value)); break; }
+            case ievk_Log_Arg_Long: { long value = va_arg(args, long); pushed = ievk_log_push(record, &value, sizeof(value)); break; }
+            case ievk_Log_Arg_LongLong: { long long value = va_arg(args, long long); pushed = ievk_log_push(record, &value, sizeof(value)); break; }
+            case ievk_Log_Arg_Size: { size_t value = va_arg(args, size_t); pushed = ievk_log_push(record, &value, sizeof(value)); break; }
+            case ievk_Log_Arg_IntMax: { intmax_t value = va_arg(args, intmax_t); pushed = ievk_log_push(record, &value, sizeof(value)); break; }
+            case ievk_Log_Arg_PtrDiff: { ptrdiff_t value = va_arg(args, ptrdiff_t); pushed = ievk_log_push(record, &value, sizeof(value)); break; }
+            case ievk_Log_Arg_Double: { double value = va_arg(args, double); pushed = ievk_log_push(record, &value, sizeof(value)); break; }
+            case ievk_Log_Arg_LongDouble: { long double value = va_arg(args, long double); pushed = ievk_log_push(record, &value, sizeof(value)); break; }
+            case ievk_Log_Arg_Pointer: { void* value = va_arg(args, void*); pushed = ievk_log_push(record, &value, sizeof(value)); break; }
+            case ievk_Log_Arg_String:
+            {
+                const char* value = va_arg(args, const char*);
+                if (value == NULL) value = "(null)";
+
+                // the string is stored with it's length in front, what doesn't fit is cut
+                uint32_t room = EVK_LOG_PAYLOAD_SIZE - record->size;
+                if (room < sizeof(uint32_t) + 8) return false;
+
+                // a precision bounds the read, the string may not be terminated past it
+                size_t capacity = room - sizeof(uint32_t) - 1;
+                size_t length = 0;
+                if (precision >= 0) {
+                    const char* terminator = (const char*)memchr(value, '\0', (size_t)precision);
+                    length = terminator ? (size_t)(terminator - value) : (size_t)precision;
+                }
+                else {
+                    length = strlen(value);
+                }
+                uint32_t stored = (uint32_t)(length < capacity ? length : capacity);
+
+                uint8_t* out = record->payload + record->size;
+                memcpy(out, &stored, sizeof(uint32_t));
+                memcpy(out + sizeof(uint32_t), value, stored);
+                out[sizeof(uint32_t) + stored] = '\0';
+                record->size += (uint32_t)((sizeof(uint32_t) + stored + 1 + 7) & ~(size_t)7);
+                pushed = true;
+                break;
+            }
+            default: break;
+        }
+
+        if (!pushed) return false;
+        fmt = spec.end;
+    }
+    return true;
+}
+
+/// @brief turns a record back into text, runs on the log thread
+static void ievk_log_render(const ievkLogRecord* record, char* out, size_t size)
+{
+    if (record->preformatted) {
+        snprintf(out, size, "%s", (const char*)record->payload);
+        return;
+    }
+
+    const char* fmt = record->fmt;
+    const uint8_t* packed = record->payload;
+    size_t written = 0;
+    ievkLogSpec spec;
+
+    while (written + 1 < size) {
+        const char* text = fmt;
+        bool found = ievk_log_next_spec(fmt, &spec);
+        const char* textEnd = found ? spec.start : fmt + strlen(fmt);
+
+        // literal text, with %% collapsed
+        for (const char* c = text; c < textEnd && written + 1 < size; c++) {
+            out[written++] = *c;
+            if (c[0] == '%' && c[1] == '%') c++;
+        }
+        if (!found || written + 1 >= size) break;
+
+        // stars are written into the conversion, a negative precision means it was not given
+        char conversion[64];
+        size_t length = 0;
+        for (const char* c = spec.start; c < spec.end && length + 16 < sizeof(conversion); c++) {
+            if (*c != '*') {
+                conversion[length++] = *c;
+                continue;
+            }
+
+            int star;
+            memcpy(&star, packed, sizeof(int));
+            packed += 8;
+
+            if (c > spec.start && c[-1] == '.' && star < 0) length--;
+            else length += (size_t)snprintf(conversion + length, sizeof(conversion) - length, "%d", star);
+        }
+        conversion[length] = '\0';
+
+        char* dst = out + written;
+        size_t room = size - written;
+        int result = 0;
+        switch (spec.arg)
+        {
+            case ievk_Log_Arg_Int: { int value; memcpy(&value, packed, sizeof(value)); result = snprintf(dst, room, conversion, value); packed += 8; break; }
+            case ievk_Log_Arg_Long: { long value; memcpy(&value, packed, sizeof(value)); result = snprintf(dst, room, conversion, value); packed += 8; break; }
+            case ievk_Log_Arg_LongLong: { long long value; memcpy(&value, packed, sizeof(value)); result = snprintf(dst, room, conversion, value); packed += 8; break; }
+            case ievk_Log_Arg_Size: { size_t value; memcpy(&value, packed, sizeof(value)); result = snprintf(dst, room, conversion, value); packed += 8; break; }
+            case ievk_Log_Arg_IntMax: { intmax_t value; memcpy(&value, packed, sizeof(value)); result = snprintf(dst, room, conversion, value); packed += 8; break; }
+            case ievk_Log_Arg_PtrDiff: { ptrdiff_t value; memcpy(&value, packed, sizeof(value)); result = snprintf(dst, room, conversion, value); packed += 8; break; }
+            case ievk_Log_Arg_Double: { double value; memcpy(&value, packed, sizeof(value)); result = snprintf(dst, room, conversion, value); packed += 8; break; }
+            case ievk_Log_Arg_LongDouble: { long double value; memcpy(&value, packed, sizeof(value)); result = snprintf(dst, room, conversion, value); packed += (sizeof(value) + 7) & ~(size_t)7; break; }
+            case ievk_Log_Arg_Pointer: { void* value; memcpy(&value, packed, sizeof(value)); result = snprintf(dst, room, conversion, value); packed += 8; break; }
+            case ievk_Log_Arg_String:
+            {
+                uint32_t stored;
+                memcpy(&stored, packed, sizeof(uint32_t));
+                result = snprintf(dst, room, conversion, (const char*)(packed + sizeof(uint32_t)));
+                packed += (sizeof(uint32_t) + stored + 1 + 7) & ~(size_t)7;
+                break;
+            }
+            default: break;
+        }
+
+        if (result > 0) written += (size_t)result < room ? (size_t)result : room - 1;
+        fmt = spec.end;
+    }
+    out[written < size ? written : size - 1] = '\0';
+}
+
+/// @brief writes a formatted message to the output
+static void ievk_log_write(evkSeverity severity, int64_t timestamp, const char* file, int32_t line, const char* message)
+{
+    // localtime shares it's result, only one thread writes at a time: the log thread while it runs, the caller once it's stopped
+    time_t now = (time_t)timestamp;
+    struct tm localTime = *localtime(&now);
+
+    char logMessage[EVK_MAX_ERROR_LEN + 256];
     snprintf
     (
-        outBuffer,
-        size,
+        logMessage,
+        sizeof(logMessage),
         "[%02d/%02d/%04d - %02d:%02d:%02d][%s - %d][%s]: %s",
-        localTime->tm_mday,
-        localTime->tm_mon + 1,
-        localTime->tm_year + 1900,
-        localTime->tm_hour,
-        localTime->tm_min,
-        localTime->tm_sec,
+        localTime.tm_mday,
+        localTime.tm_mon + 1,
+        localTime.tm_year + 1900,
+        localTime.tm_hour,
+        localTime.tm_min,
+        localTime.tm_sec,
         file,
         line,
         ievk_severity_to_str(severity),
-        buffer
+        message
     );
+
+    #if defined(__ANDROID__)
+        __android_log_print(severity == evk_Fatal ? ANDROID_LOG_ERROR : ANDROID_LOG_DEBUG, "EVK", "%s", logMessage);
+    #else
+        printf("%s\n", logMessage);
+    #endif
+}
+
+/// @brief writes every published record, returns how many were written
+static uint32_t ievk_log_drain()
+{
+    char message[EVK_MAX_ERROR_LEN];
+    uint32_t written = 0;
+
+    for (;;) {
+        uint64_t head = g_EVKLogger.head;
+        ievkLogRecord* record = &g_EVKLogger.records[head & (EVK_LOG_QUEUE_CAPACITY - 1)];
+        if (EVK_ATOMIC_LOAD(&record->sequence) != head + 1) break;
+
+        ievk_log_render(record, message, sizeof(message));
+        ievk_log_write((evkSeverity)record->severity, record->time, record->file, record->line, message);
+
+        // the slot is handed back to producers for the next lap of the queue
+        EVK_ATOMIC_STORE(&record->sequence, head + EVK_LOG_QUEUE_CAPACITY);
+        EVK_ATOMIC_STORE(&g_EVKLogger.head, head + 1);
+        written++;
+    }
+
+    uint64_t dropped = EVK_ATOMIC_LOAD(&g_EVKLogger.dropped);
+    if (dropped != g_EVKLogger.reported) {
+        snprintf(message, sizeof(message), "%llu log messages were dropped, the queue was full", (unsigned long long)(dropped - g_EVKLogger.reported));
+        ievk_log_write(evk_Warn, (int64_t)time(NULL), __FILE__, __LINE__, message);
+        g_EVKLogger.reported = dropped;
+    }
+
+    if (written > 0) fflush(stdout);
+    return written;
+}
+
+static void ievk_log_sleep()
+{
+    #ifdef _WIN32
+    Sleep(1);
+    #else
+    struct timeval duration = { 0, 1000 }; // select is the sleep available without posix feature macros
+    select(0, NULL, NULL, NULL, &duration);
+    #endif
+}
+
+#ifdef _WIN32
+static DWORD WINAPI ievk_log_worker(LPVOID unused)
+#else
+static void* ievk_log_worker(void* unused)
+#endif
+{
+    (void)unused;
+
+    while (EVK_ATOMIC_LOAD(&g_EVKLogger.running) == 1) {
+        if (ievk_log_drain() == 0) ievk_log_sleep();
+    }
+
+    // whatever was queued before shutdown is still written
+    ievk_log_drain();
+    return 0;
+}
+
+/// @brief stops the log thread after it writes what was queued, the first caller joins it while any other waits until it's gone
+static void ievk_log_stop()
+{
+    if (!EVK_ATOMIC_CAS(&g_EVKLogger.running, (uint64_t)1, (uint64_t)2)) {
+        while (EVK_ATOMIC_LOAD(&g_EVKLogger.running) == 2) ievk_log_sleep();
+        return;
+    }
+
+    #ifdef _WIN32
+    WaitForSingleObject(g_EVKLogger.thread, INFINITE);
+    CloseHandle(g_EVKLogger.thread);
+    #else
+    pthread_join(g_EVKLogger.thread, NULL);
+    #endif
+
+    EVK_ATOMIC_STORE(&g_EVKLogger.running, (uint64_t)0);
+}
+
+/// @brief reserves the next record and it's position in the queue, NULL when the queue is full
+static ievkLogRecord* ievk_log_reserve(uint64_t* outPosition)
+{
+    uint64_t position = EVK_ATOMIC_LOAD(&g_EVKLogger.tail);
+
+    for (;;) {
+        ievkLogRecord* record = &g_EVKLogger.records[position & (EVK_LOG_QUEUE_CAPACITY - 1)];
+        int64_t difference = (int64_t)EVK_ATOMIC_LOAD(&record->sequence) - (int64_t)position;
+
+        if (difference == 0) {
+            if (EVK_ATOMIC_CAS(&g_EVKLogger.tail, position, position + 1)) {
+                *outPosition = position;
+                return record;
+            }
+        }
+
+        else if (difference < 0) {
+            return NULL;
+        }
+
+        position = EVK_ATOMIC_LOAD(&g_EVKLogger.tail);
+    }
+}
+
+void evk_log_set_severity(evkSeverity severity)
+{
+    for (uint32_t i = 0; i < evk_Log_Category_Max; i++) {
+        evk_log_set_threshold((evkLogCategory)i, severity);
+    }
+}
+
+void evk_log_set_threshold(evkLogCategory category, evkSeverity severity)
+{
+    if ((uint32_t)category >= evk_Log_Category_Max) return;
+
+    // a bit for every severity below the threshold, fatal is never muted
+    uint32_t muted = (1u << (uint32_t)severity) - 1u;
+    g_EVKLogMuted[category] = muted & ~(1u << evk_Fatal);
+}
+
+void evk_log_set_enabled(evkLogCategory category, evkSeverity severity, bool enabled)
+{
+    if ((uint32_t)category >= evk_Log_Category_Max || severity == evk_Fatal) return;
+
+    if (enabled) g_EVKLogMuted[category] &= ~(1u << (uint32_t)severity);
+    else g_EVKLogMuted[category] |= 1u << (uint32_t)severity;
+}
+
+bool evk_log_is_enabled(evkLogCategory category, evkSeverity severity)
+{
+    if ((uint32_t)category >= evk_Log_Category_Max) return false;
+    return (g_EVKLogMuted[category] & (1u << (uint32_t)severity)) == 0;
+}
+
+uint64_t evk_log_get_suppressed_count()
+{
+    return EVK_ATOMIC_LOAD(&g_EVKLogger.suppressed);
+}
+
+/// @brief queues a message, or writes it right away when the log thread isn't running or it's fatal
+static void ievk_log_vmessage(evkSeverity severity, const char* file, int32_t line, const char* fmt, va_list args)
+{
+    // fatal messages stop the log thread so they're written by the caller after everything queued before them, the process ends right after
+    if (severity == evk_Fatal || EVK_ATOMIC_LOAD(&g_EVKLogger.running) != 1) {
+        char buffer[EVK_MAX_ERROR_LEN];
+        vsnprintf(buffer, EVK_MAX_ERROR_LEN, fmt, args);
+
+        if (severity == evk_Fatal) ievk_log_stop();
+        ievk_log_write(severity, (int64_t)time(NULL), file, line, buffer);
+
+        if (severity == evk_Fatal) {
+            fflush(stdout);
+            abort();
+        }
+        return;
+    }
+
+    uint64_t position = 0;
+    ievkLogRecord* record = ievk_log_reserve(&position);
+    if (record == NULL) {
+        EVK_ATOMIC_FETCH_ADD(&g_EVKLogger.dropped, (uint64_t)1);
+        return;
+    }
+
+    record->time = (int64_t)time(NULL);
+    record->file = file;
+    record->fmt = fmt;
+    record->line = line;
+    record->severity = (uint32_t)severity;
+    record->preformatted = 0;
+
+    // packing consumes the arguments, a copy is kept in case the message has to be formatted here after all
+    va_list copy;
+    va_copy(copy, args);
+    if (!ievk_log_pack(record, fmt, copy)) {
+        vsnprintf((char*)record->payload, EVK_LOG_PAYLOAD_SIZE, fmt, args);
+        record->preformatted = 1;
+    }
+    va_end(copy);
+
+    EVK_ATOMIC_STORE(&record->sequence, position + 1);
+}
+
+/// @brief sends a message with the number of messages a call site suppressed during it's last window
+static void ievk_log_suppressed(evkSeverity severity, const char* file, int32_t line, ...)
+{
+    va_list args;
+    va_start(args, line);
+    ievk_log_vmessage(severity, file, line, "Suppressed %llu messages from this call site", args);
+    va_end(args);
 }
 
 void evk_log_message(evkSeverity severity, const char* file, int32_t line, const char* fmt, ...)
 {
-    char buffer[EVK_MAX_ERROR_LEN];
+    // filtered before anything is formatted, fatal messages are never muted
+    if (!evk_log_is_enabled(evk_Log_Category_General, severity)) return;
+
+    va_list args;
+    va_start(args, fmt);
+    ievk_log_vmessage(severity, file, line, fmt, args);
+    va_end(args);
+}
+
+void evk_log_site_message(evkLogSite* site, evkSeverity severity, const char* file, int32_t line, const char* fmt, ...)
+{
+    // fatal messages are never rate limited, the others get EVK_LOG_RATE_LIMIT messages per window of their call site
+    if (severity != evk_Fatal) {
+        uint64_t window = (uint64_t)time(NULL) / EVK_LOG_RATE_WINDOW;
+        uint64_t current = EVK_ATOMIC_LOAD(&site->window);
+
+        if (current != window && EVK_ATOMIC_CAS(&site->window, current, window)) {
+            EVK_ATOMIC_STORE(&site->count, (uint64_t)0);
+
+            // whoever opens the window reports what was suppressed in the previous one
+            uint64_t suppressed = EVK_ATOMIC_LOAD(&site->suppressed);
+            if (suppressed > 0) {
+                EVK_ATOMIC_FETCH_ADD(&site->suppressed, (uint64_t)0 - suppressed);
+                ievk_log_suppressed(severity, file, line, (unsigned long long)suppressed);
+            }
+        }
+
+        if (EVK_ATOMIC_FETCH_ADD(&site->count, (uint64_t)1) >= EVK_LOG_RATE_LIMIT) {
+            EVK_ATOMIC_FETCH_ADD(&site->suppressed, (uint64_t)1);
+            EVK_ATOMIC_FETCH_ADD(&g_EVKLogger.suppressed, (uint64_t)1);
+
+            // the site is listed the first time it suppresses something, so shutdown can report what it never got to
+            if (EVK_ATOMIC_CAS(&site->listed, (uint64_t)0, (uint64_t)1)) {
+                site->file = file;
+                site->line = line;
+                site->severity = (uint32_t)severity;
+
+                uint64_t head = EVK_ATOMIC_LOAD(&g_EVKLogger.sites);
+                site->next = head;
+                while (!EVK_ATOMIC_CAS(&g_EVKLogger.sites, head, (uint64_t)(uintptr_t)site)) {
+                    head = EVK_ATOMIC_LOAD(&g_EVKLogger.sites);
+                    site->next = head;
+                }
+            }
+            return;
+        }
+    }
+
     va_list args;
     va_start(args, fmt);
-    vsnprintf(buffer, EVK_MAX_ERROR_LEN, fmt, args);
+    ievk_log_vmessage(severity, file, line, fmt, args);
     va_end(args);
+}
 
-    char log_message[EVK_MAX_ERROR_LEN + 256];
-    time_t now = time(NULL);
-    struct tm* local_time = localtime(&now);
+evkResult evk_log_init()
+{
+    if (EVK_ATOMIC_LOAD(&g_EVKLogger.running) != 0) return evk_Success;
 
-    ievk_log_format(log_message, sizeof(log_message), local_time, file, line, severity, buffer);
+    ievkLogRecord* records = (ievkLogRecord*)EVK_MALLOC(evk_Allocation_Tag_Context, sizeof(ievkLogRecord) * EVK_LOG_QUEUE_CAPACITY);
+    if (records == NULL) return evk_Failure;
 
-    if (severity == evk_Fatal) {
-        #if defined(__ANDROID__)
-            __android_log_print(ANDROID_LOG_ERROR, "EVK", log_message);
-        #else
-            printf("%s\n", log_message);
-        #endif
-        abort();
+    for (uint64_t i = 0; i < EVK_LOG_QUEUE_CAPACITY; i++) {
+        records[i].sequence = i;
     }
 
-    else
-    {
-        #if defined(__ANDROID__)
-            __android_log_print(ANDROID_LOG_DEBUG, "EVK", log_message)
-        #else
-            printf("%s\n", log_message);
-        #endif
+    g_EVKLogger.records = records;
+    g_EVKLogger.head = 0;
+    g_EVKLogger.tail = 0;
+    g_EVKLogger.dropped = 0;
+    g_EVKLogger.reported = 0;
+    g_EVKLogger.suppressed = 0;
+    EVK_ATOMIC_STORE(&g_EVKLogger.running, (uint64_t)1);
+
+    #ifdef _WIN32
+    g_EVKLogger.thread = CreateThread(NULL, 0, ievk_log_worker, NULL, 0, NULL);
+    bool started = g_EVKLogger.thread != NULL;
+    #else
+    bool started = pthread_create(&g_EVKLogger.thread, NULL, ievk_log_worker, NULL) == 0;
+    #endif
+
+    // without the thread messages keep being written by whoever logs them
+    if (!started) {
+        EVK_ATOMIC_STORE(&g_EVKLogger.running, (uint64_t)0);
+        g_EVKLogger.records = NULL;
+        EVK_FREE(records);
+        return evk_Failure;
+    }
+    return evk_Success;
+}
+
+void evk_log_shutdown()
+{
+    // call sites that went quiet never started a new window to report what they suppressed
+    uint64_t address = EVK_ATOMIC_LOAD(&g_EVKLogger.sites);
+    while (address != 0) {
+        evkLogSite* site = (evkLogSite*)(uintptr_t)address;
+        uint64_t suppressed = EVK_ATOMIC_LOAD(&site->suppressed);
+
+        if (suppressed > 0) {
+            EVK_ATOMIC_FETCH_ADD(&site->suppressed, (uint64_t)0 - suppressed);
+            ievk_log_suppressed((evkSeverity)site->severity, site->file, site->line, (unsigned long long)suppressed);
+        }
+        address = site->next;
+    }
+
+    if (g_EVKLogger.records == NULL) return;
+
+    ievk_log_stop();
+    EVK_FREE(g_EVKLogger.records);
+    g_EVKLogger.records = NULL;
+}
+
+void evk_log_flush()
+{
+    uint64_t target = EVK_ATOMIC_LOAD(&g_EVKLogger.tail);
+
+    while (EVK_ATOMIC_LOAD(&g_EVKLogger.running) == 1 && EVK_ATOMIC_LOAD(&g_EVKLogger.head) < target) {
+        ievk_log_sleep();
     }
 }
 
@@ -365,7 +1283,7 @@ static void ievk_camera_update_view_matrix(evkCamera* camera)
 
 evkCamera* evk_camera_create(float aspectRatio)
 {
-    evkCamera* camera = (evkCamera*)m_malloc(sizeof(evkCamera));
+    evkCamera* camera = (evkCamera*)EVK_MALLOC(evk_Allocation_Tag_Context, sizeof(evkCamera));
     EVK_ASSERT(camera != NULL, "Failed to allocate memory for evkCamera");
 
     camera->fov = 45.0f;
@@ -398,7 +1316,7 @@ evkCamera* evk_camera_create(float aspectRatio)
 
 void evk_camera_destroy(evkCamera* camera)
 {
-    if (camera) m_free(camera);
+    if (camera) EVK_FREE(camera);
 }
 
 void evk_camera_update(evkCamera* camera, float timestep)
@@ -567,6 +1485,208 @@ float3 evk_camera_get_front(evkCamera* camera)
     return camera->frontPosition;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Asset Pack
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief fnv-1a 64 of a name, must match tools/asset_pack
+static uint64_t ievk_asset_pack_hash(const char* name, size_t length)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)name[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/// @brief releases the mapping and the file handles, safe to call on a partially opened pack
+static void ievk_asset_pack_unmap(evkAssetPack* pack)
+{
+    #ifdef _WIN32
+    if (pack->base) UnmapViewOfFile(pack->base);
+    if (pack->mapping) CloseHandle(pack->mapping);
+    if (pack->file && pack->file != INVALID_HANDLE_VALUE) CloseHandle(pack->file);
+    #else
+    if (pack->base) munmap((void*)pack->base, (size_t)pack->size);
+    if (pack->file >= 0) close(pack->file);
+    #endif
+}
+
+/// @brief checks the header and every toc slot against the file size, lookups trust the toc afterwards
+static bool ievk_asset_pack_validate(evkAssetPack* pack)
+{
+    if (pack->size < sizeof(evkAssetPackHeader)) return false;
+
+    const evkAssetPackHeader* header = (const evkAssetPackHeader*)pack->base;
+    if (header->magic != EVK_ASSET_PACK_MAGIC || header->version != EVK_ASSET_PACK_VERSION) return false;
+    if (header->slotCount == 0 || (header->slotCount & (header->slotCount - 1)) != 0 || header->entryCount >= header->slotCount) return false;
+    if (header->tocOffset % 8 != 0 || header->tocOffset > pack->size || (uint64_t)header->slotCount * sizeof(evkAssetPackEntry) > pack->size - header->tocOffset) return false;
+    if (header->namesOffset > pack->size || header->namesSize > pack->size - header->namesOffset) return false;
+
+    const evkAssetPackEntry* toc = (const evkAssetPackEntry*)(pack->base + header->tocOffset);
+    uint32_t used = 0;
+    for (uint32_t i = 0; i < header->slotCount; i++) {
+        const evkAssetPackEntry* entry = &toc[i];
+        if (entry->size == 0) continue;
+
+        if (entry->offset % EVK_ASSET_PACK_ALIGNMENT != 0 || entry->offset > pack->size || entry->size > pack->size - entry->offset) return false;
+        if ((uint64_t)entry->nameOffset + entry->nameLength > header->namesSize) return false;
+        used++;
+    }
+
+    if (used != header->entryCount) return false;
+
+    pack->header = header;
+    pack->toc = toc;
+    pack->names = (const char*)(pack->base + header->namesOffset);
+    return true;
+}
+
+evkAssetPack* evk_asset_pack_open(const char* path)
+{
+    if (!path) return NULL;
+
+    evkAssetPack* pack = (evkAssetPack*)EVK_MALLOC(evk_Allocation_Tag_Context, sizeof(evkAssetPack));
+    if (!pack) {
+        EVK_LOG(evk_Error, "Failed to allocate memory for evkAssetPack");
+        return NULL;
+    }
+    memset(pack, 0, sizeof(evkAssetPack));
+
+    bool success = false;
+
+    do
+    {
+        #ifdef _WIN32
+        pack->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (pack->file == INVALID_HANDLE_VALUE) {
+            EVK_LOG(evk_Error, "Failed to open asset pack %s", path);
+            break;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(pack->file, &fileSize) || fileSize.QuadPart <= 0) {
+            EVK_LOG(evk_Error, "Asset pack %s is empty", path);
+            break;
+        }
+        pack->size = (uint64_t)fileSize.QuadPart;
+
+        pack->mapping = CreateFileMappingA(pack->file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (!pack->mapping) {
+            EVK_LOG(evk_Error, "Failed to create a file mapping for asset pack %s", path);
+            break;
+        }
+
+        pack->base = (const uint8_t*)MapViewOfFile(pack->mapping, FILE_MAP_READ, 0, 0, 0);
+        #else
+        pack->file = open(path, O_RDONLY);
+        if (pack->file < 0) {
+            EVK_LOG(evk_Error, "Failed to open asset pack %s", path);
+            break;
+        }
+
+        struct stat fileStat;
+        if (fstat(pack->file, &fileStat) != 0 || fileStat.st_size <= 0) {
+            EVK_LOG(evk_Error, "Asset pack %s is empty", path);
+            break;
+        }
+        pack->size = (uint64_t)fileStat.st_size;
+
+        void* mapped = mmap(NULL, (size_t)pack->size, PROT_READ, MAP_PRIVATE, pack->file, 0);
+        pack->base = (mapped == MAP_FAILED) ? NULL : (const uint8_t*)mapped;
+        #endif
+
+        if (!pack->base) {
+            EVK_LOG(evk_Error, "Failed to map asset pack %s", path);
+            break;
+        }
+
+        if (!ievk_asset_pack_validate(pack)) {
+            EVK_LOG(evk_Error, "Asset pack %s is corrupted or from another version", path);
+            break;
+        }
+
+        success = true;
+    } while (0);
+
+    if (!success) {
+        ievk_asset_pack_unmap(pack);
+        EVK_FREE(pack);
+        return NULL;
+    }
+
+    return pack;
+}
+
+void evk_asset_pack_close(evkAssetPack* pack)
+{
+    if (!pack) return;
+
+    ievk_asset_pack_unmap(pack);
+    EVK_FREE(pack);
+}
+
+bool evk_asset_pack_find(const evkAssetPack* pack, const char* name, evkAssetBlob* blob)
+{
+    if (!pack || !name) return false;
+
+    size_t length = strlen(name);
+    uint64_t hash = ievk_asset_pack_hash(name, length);
+    uint32_t mask = pack->header->slotCount - 1;
+
+    // linear probing, the toc is at most half full so the first empty slot ends the search quickly
+    for (uint32_t i = (uint32_t)hash & mask, probes = 0; probes <= mask; i = (i + 1) & mask, probes++) {
+        const evkAssetPackEntry* entry = &pack->toc[i];
+        if (entry->size == 0) return false;
+
+        if (entry->hash == hash && entry->nameLength == length && memcmp(pack->names + entry->nameOffset, name, length) == 0) {
+            if (blob) {
+                blob->data = pack->base + entry->offset;
+                blob->size = entry->size;
+                blob->type = (evkAssetType)entry->type;
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void evk_asset_pack_prefetch(const evkAssetPack* pack, const char* const* names, uint32_t count)
+{
+    if (!pack || !names) return;
+
+    #if !defined(_WIN32) && defined(MADV_WILLNEED)
+    const uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+    #endif
+
+    for (uint32_t i = 0; i < count; i++) {
+        evkAssetBlob blob;
+        if (!evk_asset_pack_find(pack, names[i], &blob)) {
+            EVK_LOG(evk_Warn, "Asset %s is not inside the pack, nothing to prefetch", names[i]);
+            continue;
+        }
+
+        #ifdef _WIN32
+        #if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+        WIN32_MEMORY_RANGE_ENTRY range = { (PVOID)blob.data, (SIZE_T)blob.size };
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+        #endif
+        #elif defined(MADV_WILLNEED)
+        // madvise wants page aligned ranges, strict ansi builds hide it and skip the hint
+        uintptr_t start = (uintptr_t)blob.data & ~(pageSize - 1);
+        uintptr_t end = (uintptr_t)blob.data + (uintptr_t)blob.size;
+        madvise((void*)start, (size_t)(end - start), MADV_WILLNEED);
+        #endif
+    }
+}
+
+uint32_t evk_asset_pack_get_count(const evkAssetPack* pack)
+{
+    return pack ? pack->header->entryCount : 0;
+}
+
 #ifdef __cplusplus 
 }
 #endif
\ No newline at end of file
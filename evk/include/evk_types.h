@@ -2,6 +2,7 @@
 #define EVK_TYPES_INCLUDED
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include "vecmath/vecmath.h"
 
@@ -20,9 +21,38 @@
     #define align_as(X) _Alignas(X)  // C11 native
 #endif
 
+/// @brief atomic operations on uint64_t per compiler, used by structures written from any thread, every operation is a full barrier on msvc
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+    #define EVK_ATOMIC_LOAD(ptr) ((uint64_t)_InterlockedCompareExchange64((volatile long long*)(ptr), 0, 0))
+    #define EVK_ATOMIC_STORE(ptr, value) ((void)_InterlockedExchange64((volatile long long*)(ptr), (long long)(value)))
+    #define EVK_ATOMIC_FETCH_ADD(ptr, value) ((uint64_t)_InterlockedExchangeAdd64((volatile long long*)(ptr), (long long)(value)))
+    #define EVK_ATOMIC_CAS(ptr, expected, desired) (_InterlockedCompareExchange64((volatile long long*)(ptr), (long long)(desired), (long long)(expected)) == (long long)(expected))
+#else
+    #define EVK_ATOMIC_LOAD(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+    #define EVK_ATOMIC_STORE(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+    #define EVK_ATOMIC_FETCH_ADD(ptr, value) __atomic_fetch_add((ptr), (value), __ATOMIC_ACQ_REL)
+    #define EVK_ATOMIC_CAS(ptr, expected, desired) __sync_bool_compare_and_swap((ptr), (expected), (desired))
+#endif
+
 /// @brief max size of characters an error message may have
 #define EVK_MAX_ERROR_LEN 1024
 
+/// @brief how many messages the log queue holds before new ones are dropped, must be a power of 2
+#define EVK_LOG_QUEUE_CAPACITY 1024
+
+/// @brief bytes of packed arguments a queued message may carry, strings are cut to fit
+#define EVK_LOG_PAYLOAD_SIZE 960
+
+/// @brief how many messages a call site writes per window, the rest are counted and reported when the next window starts
+#define EVK_LOG_RATE_LIMIT 10
+
+/// @brief length in seconds of a rate limit window
+#define EVK_LOG_RATE_WINDOW 1
+
+/// @brief rate limits validation messages share, picked by message id so a noisy id doesn't silence the others, must be a power of 2
+#define EVK_LOG_VALIDATION_SITES 256
+
 /// @brief how many frames are simultaneously rendered
 #define EVK_CONCURRENTLY_RENDERED_FRAMES 2
 
@@ -35,6 +65,70 @@
 /// @brief how many shader stages a pipeline may have, since we only support Vertex and Fragment for now, 2
 #define EVK_PIPELINE_SHADER_STAGES_COUNT 2
 
+/// @brief how many levels the compute downsampler generates in a single dispatch, level 0 excluded
+#define EVK_COMPUTE_MIPMAP_MAX_LEVELS 12
+
+/// @brief how many threads at most decode a texture batch, the calling thread included
+#define EVK_TEXTURE_BATCH_MAX_THREADS 16
+
+/// @brief streamed textures always keep the levels whose largest side fits in this many texels
+#define EVK_TEXTURE_STREAM_TAIL_SIZE 128
+
+/// @brief frames without a request after which a streamed texture drops back to it's tail
+#define EVK_TEXTURE_STREAM_IDLE_FRAMES 120
+
+/// @brief size in texels of a thumbnail slot, images are scaled down to fit it keeping their aspect ratio
+#define EVK_THUMBNAIL_SIZE 128
+
+/// @brief size in texels of a thumbnail page, every page is a layer of the same image
+#define EVK_THUMBNAIL_PAGE_SIZE 2048
+
+/// @brief how many thumbnails are decoded and uploaded at most on a frame
+#define EVK_THUMBNAIL_UPLOADS_PER_FRAME 16
+
+/// @brief how many packets the draw queue holds when evkCreateInfo.drawQueueCapacity is 0, rounded up to a power of two
+#define EVK_DRAW_QUEUE_DEFAULT_CAPACITY 65536
+
+/// @brief how many descriptor sets and push constant bytes the command recorder remembers, push constants beyond it are always recorded
+#define EVK_COMMAND_RECORDER_MAX_SETS 4
+#define EVK_COMMAND_RECORDER_PUSH_CONSTANTS_SIZE 128
+
+/// @brief how many bits of a handle address it's slot, limiting a table to about a million objects with 4095 generations per slot
+#define EVK_HANDLE_INDEX_BITS 20
+
+/// @brief how many objects a pool chunk holds, chunks never move so pooled objects keep their address, a multiple of 64 so live words never straddle chunks
+#define EVK_POOL_CHUNK_OBJECTS 256
+
+/// @brief bytes of each frame arena when evkCreateInfo.frameArenaSize is 0
+#define EVK_FRAME_ARENA_DEFAULT_SIZE (1024 * 1024)
+
+/// @brief how many bits of an entity address it's slot, the remaining 8 hold the slot generation, matches the idgen range
+#define EVK_ENTITY_INDEX_BITS 24
+#define EVK_ENTITY_INITIAL_CAPACITY 1024
+
+/// @brief draw sort key layout, opaque keys are layer | material | depth so state is grouped and each group drawn front-to-back,
+/// transparent keys are layer | inverted depth | material so they are drawn back-to-front
+#define EVK_DRAW_KEY_LAYER_SHIFT 56
+#define EVK_DRAW_KEY_MATERIAL_BITS 24
+
+/// @brief identifies a cooked texture, "EVKT" read as a little-endian uint32
+#define EVK_COOKED_TEXTURE_MAGIC 0x544B5645
+
+/// @brief version of the cooked texture layout, bumped whenever tools/texture_cook changes the header
+#define EVK_COOKED_TEXTURE_VERSION 1
+
+/// @brief how many levels a cooked texture may carry
+#define EVK_COOKED_TEXTURE_MAX_LEVELS 16
+
+/// @brief identifies an asset pack, "EVKP" read as a little-endian uint32
+#define EVK_ASSET_PACK_MAGIC 0x504B5645
+
+/// @brief version of the asset pack layout, bumped whenever tools/asset_pack changes the header or the toc
+#define EVK_ASSET_PACK_VERSION 1
+
+/// @brief alignment of every blob inside an asset pack, enough for spirv words, cooked levels and cache lines
+#define EVK_ASSET_PACK_ALIGNMENT 64
+
 /// @brief macro for getting the size of a static array, DON'T USE ON PTR
 #define EVK_STATIC_ARRAY_SIZE(ARR) ((int32_t)(sizeof(ARR) / sizeof(*(ARR))))
 
@@ -63,6 +157,18 @@ typedef enum evkSeverity
 	evk_Fatal
 } evkSeverity;
 
+/// @brief parts of evk a log message comes from, each has it's own thresholds
+typedef enum evkLogCategory
+{
+	evk_Log_Category_General = 0,
+	evk_Log_Category_Core,
+	evk_Log_Category_Renderphase,
+	evk_Log_Category_Drawable,
+	evk_Log_Category_Validation,	// messages of the vulkan validation layers
+
+	evk_Log_Category_Max
+} evkLogCategory;
+
 /// @brief all diretions the camera can be moved towards
 typedef enum evkCameraDir
 {
@@ -108,6 +214,27 @@ typedef enum evkVertexComponent
 	evk_Vertex_Component_Max
 } evkVertexComponent;
 
+/// @brief subsystems every cpu allocation is charged to, budgets and stats are kept per tag
+typedef enum evkAllocationTag
+{
+	evk_Allocation_Tag_Context = 0,		// context, cameras, entities and asset packs
+	evk_Allocation_Tag_Core,			// backend, buffers and frame arenas
+	evk_Allocation_Tag_Renderphase,		// renderphases, pipelines and their framebuffers
+	evk_Allocation_Tag_Drawable,		// textures, sprites, meshes, caches and the draw queue
+	evk_Allocation_Tag_Image,			// pixels decoded by stb_image
+	evk_Allocation_Tag_Container,		// ctoolbox hash tables and id generators
+	evk_Allocation_Tag_Vulkan,			// host memory the driver asks for through VkAllocationCallbacks
+
+	evk_Allocation_Tag_Max
+} evkAllocationTag;
+
+/// @brief all supported index sizes
+typedef enum evkIndexType
+{
+	evk_Index_Type_U16 = 0,
+	evk_Index_Type_U32
+} evkIndexType;
+
 /// @brief all renderphases 
 typedef enum evkRenderphaseType
 {
@@ -117,6 +244,36 @@ typedef enum evkRenderphaseType
 	evk_Renderphase_Type_Viewport
 } evkRenderphaseType;
 
+/// @brief what a blob inside an asset pack holds
+typedef enum evkAssetType
+{
+	evk_Asset_Type_Raw = 0,
+	evk_Asset_Type_Texture,		// cooked texture, see evkCookedTextureHeader
+	evk_Asset_Type_Spirv,
+	evk_Asset_Type_Mesh
+} evkAssetType;
+
+/// @brief device type the device policy favors, any keeps the default scoring where discrete gpus win
+typedef enum evkDevicePreference
+{
+	evk_Device_Preference_Any = 0,
+	evk_Device_Preference_Discrete,
+	evk_Device_Preference_Integrated,
+	evk_Device_Preference_CPU			// software rasterizers like lavapipe or swiftshader
+} evkDevicePreference;
+
+/// @brief optional device features a device policy may require, required features are also enabled on the device
+typedef enum evkDeviceFeature
+{
+	evk_Device_Feature_Sampler_Anisotropy = 1 << 0,
+	evk_Device_Feature_Texture_Compression_BC = 1 << 1,
+	evk_Device_Feature_Texture_Compression_ASTC = 1 << 2,
+	evk_Device_Feature_Fill_Mode_Non_Solid = 1 << 3,
+	evk_Device_Feature_Wide_Lines = 1 << 4,
+	evk_Device_Feature_Geometry_Shader = 1 << 5,
+	evk_Device_Feature_Multi_Draw_Indirect = 1 << 6
+} evkDeviceFeature;
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Structs
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -157,17 +314,265 @@ typedef struct evkTexture2D evkTexture2D;
 /// @brief definition of the sprite structure
 typedef struct evkSprite evkSprite;
 
-/// @brief holds information about a particular vertex
+/// @brief definition of the sprite atlas structure
+typedef struct evkAtlas evkAtlas;
+
+/// @brief definition of the mesh structure
+typedef struct evkMesh evkMesh;
+
+/// @brief definition of the mesh arena structure
+typedef struct evkMeshArena evkMeshArena;
+
+/// @brief definition of the asset pack structure
+typedef struct evkAssetPack evkAssetPack;
+
+/// @brief generation-checked handles, resolving one is an array index and stale handles resolve to NULL, 0 is never valid
+typedef struct evkPipelineHandle { uint32_t value; } evkPipelineHandle;
+typedef struct evkBufferHandle { uint32_t value; } evkBufferHandle;
+typedef struct evkTextureHandle { uint32_t value; } evkTextureHandle;
+
+/// @brief a slot of a handle table, free slots are chained through nextFree
+typedef struct evkHandleSlot
+{
+	void* object;
+	uint32_t generation;
+	uint32_t nextFree;
+} evkHandleSlot;
+
+/// @brief maps handles to objects, a handle holds the slot index on it's low EVK_HANDLE_INDEX_BITS and the slot generation above them
+typedef struct evkHandleTable
+{
+	evkHandleSlot* slots;
+	uint32_t capacity;
+	uint32_t used;		// slots ever handed out, the ones past it were never touched
+	uint32_t count;		// slots currently holding an object
+	uint32_t freeHead;	// first released slot, UINT32_MAX when none
+} evkHandleTable;
+
+/// @brief rate limit of a log call site, EVK_LOG keeps one per expansion
+typedef struct evkLogSite
+{
+	uint64_t window;		// rate limit window the count belongs to
+	uint64_t count;			// messages sent during the window
+	uint64_t suppressed;	// messages dropped since the last report
+	uint64_t listed;		// set once the site is linked to the sites reported at shutdown
+	uint64_t next;			// next listed site, as an address
+	const char* file;
+	int32_t line;
+	uint32_t severity;
+} evkLogSite;
+
+/// @brief user allocation functions, memory must be aligned to alignment, which is a power of two and at least 16
+typedef void* (*evkAllocateFunction)(void* userData, size_t size, size_t alignment, evkAllocationTag tag);
+typedef void* (*evkReallocateFunction)(void* userData, void* memory, size_t size, size_t alignment, evkAllocationTag tag);
+typedef void (*evkFreeFunction)(void* userData, void* memory, evkAllocationTag tag);
+
+/// @brief allocator every cpu allocation is routed to, leaving allocate NULL keeps memm while still enforcing the budgets
+typedef struct evkAllocator
+{
+	void* userData;
+	evkAllocateFunction allocate;
+	evkReallocateFunction reallocate;		// optional, blocks are moved with allocate and free when NULL
+	evkFreeFunction free;
+	uint64_t budgets[evk_Allocation_Tag_Max];	// bytes a tag may hold at once, allocations past it fail, 0 means unlimited
+} evkAllocator;
+
+/// @brief usage of an allocation tag, sizes are the ones asked for, without alignment or headers
+typedef struct evkAllocationStats
+{
+	uint64_t current;		// bytes currently allocated
+	uint64_t peak;			// most bytes simultaneously allocated
+	uint64_t budget;		// 0 when unlimited
+	uint64_t allocations;	// blocks handed out since evk_init, reallocations included
+	uint64_t frees;			// blocks released since evk_init
+	uint64_t failures;		// allocations refused by the budget or the allocator
+} evkAllocationStats;
+
+/// @brief usage of a frame arena, overflow means a frame needed more than the arena and took the rest from the heap
+typedef struct evkFrameArenaStats
+{
+	uint64_t capacity;			// bytes of the arena
+	uint64_t used;				// bytes handed out since the last reset, overflow included
+	uint64_t highWater;			// most bytes a single frame ever took
+	uint64_t overflowBytes;		// bytes taken from the heap since creation
+	uint32_t overflowCount;		// allocations that went to the heap since creation
+	uint32_t growCount;			// times the arena grew to it's high-water mark after overflowing
+} evkFrameArenaStats;
+
+/// @brief linear allocator of a frame in flight, everything it hands out is released at once when the frame's fence signals again
+typedef struct evkFrameArena
+{
+	uint8_t* base;
+	uint64_t capacity;
+	uint64_t offset;			// bytes handed out from base since the last reset
+	uint64_t overflowUsed;		// bytes handed out from the heap since the last reset
+	void* overflow;				// heap blocks of the current frame, chained through their first pointer
+	evkFrameArenaStats stats;
+} evkFrameArena;
+
+/// @brief usage of an object pool
+typedef struct evkPoolStats
+{
+	uint32_t objectSize;	// bytes of an object, the slot adds a 16 byte header
+	uint32_t capacity;		// slots across every chunk
+	uint32_t live;			// objects currently allocated
+	uint32_t peak;			// most objects simultaneously allocated
+	uint32_t chunks;		// chunks of EVK_POOL_CHUNK_OBJECTS slots
+	uint64_t allocations;	// objects handed out since creation
+	uint64_t frees;			// objects released since creation
+} evkPoolStats;
+
+/// @brief fixed-size object allocator, objects are packed in chunks and released slots are reused through a free list
+typedef struct evkPool
+{
+	uint8_t** chunks;		// a slot is the object index followed by the object, free slots keep the next free index in the object
+	uint64_t* live;			// a bit per slot, set while it holds an object
+	uint8_t** sorted;		// chunks ordered by address, frees find their chunk before trusting the slot header
+	uint32_t stride;		// bytes of a slot, 0 while the pool is not initialized
+	uint32_t chunkCount;
+	uint32_t chunkCapacity;	// entries of chunks
+	uint32_t used;			// slots ever handed out, the ones past it were never touched
+	uint32_t freeHead;		// first released slot, UINT32_MAX when none
+	evkAllocationTag tag;	// chunks are charged to it
+	evkPoolStats stats;
+} evkPool;
+
+/// @brief holds information about a particular vertex, tightly packed to the formats the gpu fetches
 typedef struct evkVertex
 {
-	align_as(16) float3 position;
-	align_as(16) float3 normal;
-	align_as(8)  float2 uv_0;
-	align_as(16) float4 color_0;
-	align_as(16) float4 joints_0;
-	align_as(16) float4 weights_0;
+	float3 position;		// R32G32B32_SFLOAT
+	int16_t normal[2];		// R16G16_SNORM, octahedral encoded
+	uint16_t uv_0[2];		// R16G16_SFLOAT, half floats
+	uint8_t color_0[4];		// R8G8B8A8_UNORM
+	uint8_t joints_0[4];	// R8G8B8A8_UINT
+	uint16_t weights_0[4];	// R16G16B16A16_UNORM
 } evkVertex;
 
+/// @brief holds where an image was packed inside an atlas, uv values are normalized to the atlas page
+typedef struct evkAtlasRegion
+{
+	uint32_t layer;		// which page of the atlas array the image lives in
+	uint32_t x;			// left pixel of the image, padding excluded
+	uint32_t y;			// top pixel of the image, padding excluded
+	uint32_t width;
+	uint32_t height;
+	float2 uvOffset;	// top-left uv of the image on it's page
+	float2 uvScale;		// uv size of the image on it's page
+} evkAtlasRegion;
+
+/// @brief holds the texture cache counters, content hits are paths that resolved to an already resident image
+typedef struct evkTextureCacheStats
+{
+	uint64_t hits;			// requests served by path or content without touching the gpu
+	uint64_t contentHits;	// subset of hits where a new path shared the pixels of a resident texture
+	uint64_t misses;		// requests that had to create a new texture
+	uint64_t evictions;		// unreferenced textures released to stay under budget
+	uint64_t residentBytes;	// estimated device memory of every cached texture, mips included
+	uint64_t budgetBytes;	// 0 means unlimited
+	uint32_t textureCount;	// cached textures, referenced or not
+	float hitRate;			// hits / (hits + misses)
+} evkTextureCacheStats;
+
+/// @brief holds what a texture batch did, times are wall clock milliseconds
+typedef struct evkTextureBatchStats
+{
+	uint32_t requested;
+	uint32_t loaded;
+	uint32_t threadCount;	// decoding threads, the caller included
+	uint64_t stagingBytes;	// size of the single staging buffer
+	double decodeMs;		// parallel decode of every image
+	double uploadMs;		// staging, image creation and the single submission
+	double totalMs;
+} evkTextureBatchStats;
+
+/// @brief holds the texture streaming counters, levels are counted per texture
+typedef struct evkTextureStreamStats
+{
+	uint64_t residentBytes;		// bytes of every resident level, as cooked
+	uint64_t budgetBytes;		// 0 means unlimited, mip tails are kept even above it
+	uint64_t uploadedBytes;		// bytes read from the cooked data since initialization
+	uint64_t levelsUploaded;
+	uint64_t levelsEvicted;
+	uint64_t budgetMisses;		// updates where a texture got less detail than requested
+	uint32_t streamedTextures;
+} evkTextureStreamStats;
+
+/// @brief holds the thumbnail cache counters
+typedef struct evkThumbnailCacheStats
+{
+	uint64_t hits;			// requests answered with a resident thumbnail
+	uint64_t misses;		// requests that queued an upload
+	uint64_t uploads;
+	uint64_t evictions;		// thumbnails paged out to make room
+	uint64_t budgetBytes;	// device memory of every page
+	uint32_t pageCount;
+	uint32_t slotCount;
+	uint32_t residentCount;
+	uint32_t pendingCount;
+} evkThumbnailCacheStats;
+
+/// @brief where a level of a cooked texture lives, the offset is from the start of the file and 16-byte aligned
+typedef struct evkCookedTextureLevel
+{
+	uint64_t offset;
+	uint64_t size;
+} evkCookedTextureLevel;
+
+/// @brief header of a cooked texture as written by tools/texture_cook, level data follows ready to be copied into an image
+typedef struct evkCookedTextureHeader
+{
+	uint32_t magic;			// EVK_COOKED_TEXTURE_MAGIC
+	uint32_t version;		// EVK_COOKED_TEXTURE_VERSION
+	uint32_t format;		// VkFormat of the levels, RGBA8 or a BC/ASTC block format
+	uint32_t width;
+	uint32_t height;
+	uint32_t mipLevels;
+	uint32_t layerCount;	// always 1 for now
+	uint32_t reserved;
+	evkCookedTextureLevel levels[EVK_COOKED_TEXTURE_MAX_LEVELS];
+} evkCookedTextureHeader;
+
+/// @brief header of an asset pack as written by tools/asset_pack, offsets are from the start of the file
+typedef struct evkAssetPackHeader
+{
+	uint32_t magic;			// EVK_ASSET_PACK_MAGIC
+	uint32_t version;		// EVK_ASSET_PACK_VERSION
+	uint32_t entryCount;	// assets inside the pack
+	uint32_t slotCount;		// size of the toc, a power of two at least twice the entry count
+	uint64_t tocOffset;		// slotCount evkAssetPackEntry, open addressed by the name hash
+	uint64_t namesOffset;	// names of every asset, not null terminated
+	uint64_t namesSize;
+} evkAssetPackHeader;
+
+/// @brief a slot of the asset pack toc, slots with size 0 are empty
+typedef struct evkAssetPackEntry
+{
+	uint64_t hash;			// fnv-1a 64 of the name
+	uint64_t offset;		// EVK_ASSET_PACK_ALIGNMENT aligned
+	uint64_t size;
+	uint32_t nameOffset;	// relative to namesOffset
+	uint32_t nameLength;
+	uint32_t type;			// evkAssetType
+	uint32_t reserved;
+} evkAssetPackEntry;
+
+/// @brief an asset found inside a pack, data points straight into the mapped file and lives as long as the pack is open
+typedef struct evkAssetBlob
+{
+	const void* data;
+	uint64_t size;
+	evkAssetType type;
+} evkAssetBlob;
+
+/// @brief holds the interleaved layout of the enabled vertex components, the stride only accounts the components used
+typedef struct evkVertexLayout
+{
+	uint32_t stride;
+	uint32_t offsets[evk_Vertex_Component_Max];
+	evkVertexComponent components[evk_Vertex_Component_Max];
+	uint32_t componentsCount;
+} evkVertexLayout;
+
 /// @brief holds information about the push constant, sent to gpu once unique object
 typedef struct evkPushConstant
 {
@@ -175,6 +580,45 @@ typedef struct evkPushConstant
 	align_as(16) fmat4 model;
 } evkPushConstant;
 
+/// @brief a sprite draw submitted from any thread through the draw queue, evk builds it's sort key when the queue is drained
+typedef struct evkDrawPacket
+{
+	evkSprite* sprite;
+	fmat4 model;
+	uint32_t id;		// picking entity, 0 uses the sprite's own
+	uint8_t layer;		// coarse ordering, every packet of a lower layer draws first
+	bool transparent;	// blended packets draw after the opaque ones, back-to-front
+} evkDrawPacket;
+
+/// @brief holds the draw queue counters
+typedef struct evkDrawQueueStats
+{
+	uint64_t pushed;			// packets accepted since initialization
+	uint64_t dropped;			// packets refused because the queue was full
+	uint64_t drained;			// packets taken by the render thread
+	uint32_t lastDrained;		// packets rendered on the last frame
+	uint32_t lastTransparent;	// how many of those were transparent
+	uint32_t maxDrained;		// most packets rendered on a single frame
+	uint32_t capacity;
+} evkDrawQueueStats;
+
+/// @brief holds how many state commands were recorded and how many were skipped because the state was already bound
+typedef struct evkCommandStats
+{
+	uint32_t pipelineBinds;
+	uint32_t pipelineSkips;
+	uint32_t descriptorBinds;
+	uint32_t descriptorSkips;
+	uint32_t pushConstants;
+	uint32_t pushConstantSkips;
+	uint32_t viewports;
+	uint32_t viewportSkips;
+	uint32_t scissors;
+	uint32_t scissorSkips;
+	uint32_t bufferBinds;	// vertex and index buffers
+	uint32_t bufferSkips;
+} evkCommandStats;
+
 /// @brief holds information about a camera data, sent to to gpu per camera object
 typedef struct evkCameraUBO
 {
@@ -191,6 +635,31 @@ typedef struct evkSpriteUBO
 	align_as(8) float2 uv_scale;	// used to scale the uv textures
 } evkSpriteUBO;
 
+/// @brief holds the spirv binaries (as generated by tools/shader_dev) and vertex layout used to build the mesh pipelines
+typedef struct evkMeshShaders
+{
+	const uint32_t* defaultVertex;
+	size_t defaultVertexSize;
+	const uint32_t* defaultFragment;
+	size_t defaultFragmentSize;
+	const uint32_t* pickingVertex;
+	size_t pickingVertexSize;
+	const uint32_t* pickingFragment;
+	size_t pickingFragmentSize;
+	evkVertexComponent vertexComponents[evk_Vertex_Component_Max];
+	uint32_t vertexComponentsCount;
+} evkMeshShaders;
+
+/// @brief how the backend picks the physical device, a zeroed policy scores every suitable device and takes the best one
+typedef struct evkDevicePolicy
+{
+	evkDevicePreference preference;	// devices of this type always outscore the others
+	uint64_t minDeviceMemory;		// bytes of device local memory a device needs, 0 accepts any
+	uint32_t requiredFeatures;		// evkDeviceFeature bits a device must support, other bits fail the device choice
+	uint32_t deviceIndex;			// 1 + the index vkEnumeratePhysicalDevices lists the device at, 0 lets the policy choose
+	uint8_t deviceUUID[16];			// VkPhysicalDeviceIDProperties::deviceUUID of the device to use, all zeros lets the policy choose
+} evkDevicePolicy;
+
 /// @brief holds information about the window the API will be displaying to
 typedef struct evkWindow
 {
@@ -226,6 +695,13 @@ typedef struct evkCreateInfo
 	evkMSAA MSAA;
 	bool vsync;
 	bool viewport;
+	uint64_t textureCacheBudget; // bytes the texture cache tries to stay under by evicting unreferenced textures, 0 means unlimited
+	uint64_t textureStreamBudget; // bytes streamed textures may keep resident beyond their mip tails, 0 means unlimited
+	uint64_t thumbnailBudget; // bytes of thumbnail pages, rounded down to whole pages with at least one, 0 disables thumbnails
+	uint32_t drawQueueCapacity; // packets the draw queue holds between frames, 0 means EVK_DRAW_QUEUE_DEFAULT_CAPACITY
+	uint64_t frameArenaSize; // bytes of transient cpu memory per frame in flight, 0 means EVK_FRAME_ARENA_DEFAULT_SIZE
+	evkAllocator allocator; // routes evk, ctoolbox, stb_image and vulkan host allocations, zeroed keeps memm without budgets
+	evkDevicePolicy device; // which gpu to use, an explicit index or uuid overrides the scoring
 	evkWindow window;
 } evkCreateInfo;
 
@@ -30,6 +30,12 @@ uint32_t evk_pick_object_backend(float2 xy);
 /// @brief returns the vulkan instanced created by the backend
 VkInstance evk_get_instance();
 
+/// @brief returns the callbacks every vulkan object is created with, host memory the driver asks for is charged to evk_Allocation_Tag_Vulkan
+const VkAllocationCallbacks* evk_get_vulkan_allocator();
+
+/// @brief returns the memory functions ctoolbox containers are created with, charged to evk_Allocation_Tag_Container
+const ctoolbox_memfuncs* evk_get_container_memfuncs();
+
 /// @brief returns the vulkan physical device created by the backend
 VkPhysicalDevice evk_get_physical_device();
 
@@ -69,12 +75,93 @@ shashtable* evk_get_pipelines_library();
 /// @brief returns the buffers library
 shashtable* evk_get_buffers_library();
 
+/// @brief returns the table pipeline handles are resolved through
+evkHandleTable* evk_get_pipeline_handles();
+
+/// @brief returns the table texture handles are resolved through
+evkHandleTable* evk_get_texture_handles();
+
+/// @brief returns the handle of the main camera uniform buffer, registered as "MainCamera" on the buffers library
+evkBufferHandle evk_get_main_camera_buffer();
+
 /// @brief returns the number of the frame(double buffering) being handled at the time
 uint32_t evk_get_current_frame();
 
 /// @brief returns the current renderphase type at the time
 evkRenderphaseType evk_get_current_renderphase_type();
 
+/// @brief returns how many state commands the main, picking and viewport renderphases recorded and skipped on the last frame
+evkCommandStats evk_get_frame_command_stats();
+
+/// @brief returns the usage of the pool evkBuffers are allocated from
+evkPoolStats evk_get_buffer_pool_stats();
+
+/// @brief returns the arena of the frame being recorded, render callbacks may take transient memory from it
+evkFrameArena* evk_get_frame_arena();
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Handles
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief prepares an empty table, slots are allocated on the first insertion
+void evk_handle_table_init(evkHandleTable* table);
+
+/// @brief releases the table slots, objects are owned by the caller and left untouched
+void evk_handle_table_destroy(evkHandleTable* table);
+
+/// @brief stores an object and returns it's handle, 0 when the table is out of memory or indices
+uint32_t evk_handle_table_insert(evkHandleTable* table, void* object);
+
+/// @brief returns the object of a handle, NULL when the handle is 0 or it's object was removed
+void* evk_handle_table_get(const evkHandleTable* table, uint32_t handle);
+
+/// @brief removes the object of a handle, every copy of the handle becomes stale
+void evk_handle_table_remove(evkHandleTable* table, uint32_t handle);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Frame Arena
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief creates an arena with capacity bytes, 0 uses EVK_FRAME_ARENA_DEFAULT_SIZE
+evkResult evk_frame_arena_create(evkFrameArena* arena, uint64_t capacity);
+
+/// @brief releases the arena and any heap block it overflowed into
+void evk_frame_arena_destroy(evkFrameArena* arena);
+
+/// @brief releases everything handed out, a frame that overflowed grows the arena to it's high-water mark so the next one fits
+void evk_frame_arena_reset(evkFrameArena* arena);
+
+/// @brief returns size bytes aligned to alignment (a power of two, 0 means 16) valid until the arena is reset, falls back to the heap when full
+void* evk_frame_arena_alloc(evkFrameArena* arena, uint64_t size, uint64_t alignment);
+
+/// @brief returns the arena usage, high-water mark and overflow counters
+evkFrameArenaStats evk_frame_arena_get_stats(const evkFrameArena* arena);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Pools
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief prepares an empty pool of objectSize objects, chunks are allocated as objects are and charged to tag
+void evk_pool_init(evkPool* pool, uint32_t objectSize, evkAllocationTag tag);
+
+/// @brief releases every chunk, objects still alive are reported and released with them
+void evk_pool_destroy(evkPool* pool);
+
+/// @brief returns a zeroed object, NULL when out of memory
+void* evk_pool_alloc(evkPool* pool);
+
+/// @brief returns an object to the pool, it's slot is the next one handed out
+void evk_pool_free(evkPool* pool, void* object);
+
+/// @brief returns the first live object at or after cursor and moves cursor past it, NULL when there are no more, start with cursor at 0
+void* evk_pool_next(const evkPool* pool, uint32_t* cursor);
+
+/// @brief writes up to capacity live objects at or after cursor into objects and moves cursor past them, returns how many were written, 0 when there are no more
+uint32_t evk_pool_next_batch(const evkPool* pool, uint32_t* cursor, void** objects, uint32_t capacity);
+
+/// @brief returns the pool usage
+evkPoolStats evk_pool_get_stats(const evkPool* pool);
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Device
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -94,8 +181,17 @@ evkResult evk_device_create_image_sampler(VkDevice device, VkPhysicalDevice phys
 /// @brief creates an image descriptor set based on various params
 evkResult evk_device_create_image_descriptor_set(VkDevice device, VkDescriptorPool descriptorPool, VkDescriptorSetLayout descriptorSetLayout, VkSampler sampler, VkImageView view, VkDescriptorSet* outDescriptor);
 
-/// @brief generates mipmaps for the image
-void evk_device_create_image_mipmaps(VkDevice device, VkQueue queue, VkCommandBuffer cmdBuffer, int32_t width, int32_t height, int32_t mipLevels, VkImage image);
+/// @brief generates mipmaps for all layers of the image
+void evk_device_create_image_mipmaps(VkDevice device, VkQueue queue, VkCommandBuffer cmdBuffer, int32_t width, int32_t height, int32_t mipLevels, uint32_t layerCount, VkImage image);
+
+/// @brief creates the single dispatch compute downsampler from the spirv of tools/shader_dev/mipmap_downsample.comp, the backend calls it on initialization and without it mipmaps are always blitted
+evkResult evk_device_create_mipmap_compute(const uint32_t* spirv, size_t spirvSize);
+
+/// @brief returns true when the compute downsampler can generate the mipmaps of an image with this format and level count
+bool evk_device_can_compute_image_mipmaps(VkFormat format, int32_t mipLevels);
+
+/// @brief generates mipmaps for all layers of a RGBA8 image in one compute dispatch, same layouts as evk_device_create_image_mipmaps, on failure nothing is recorded and the blit path should be used
+evkResult evk_device_create_image_mipmaps_compute(VkDevice device, VkCommandBuffer cmdBuffer, int32_t width, int32_t height, int32_t mipLevels, uint32_t layerCount, VkFormat format, VkImage image);
 
 /// @brief synchronizes image layout transitions and memory access between pipeline stages
 void evk_device_create_image_memory_barrier(VkCommandBuffer cmdBuffer, VkImage image, VkAccessFlags srcAccessFlags, VkAccessFlags dstAccessFlags, VkImageLayout oldImageLayout, VkImageLayout newImageLayout, VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, VkImageSubresourceRange subresourceRange);
@@ -139,6 +235,13 @@ typedef struct evkBuffer
 	VkDeviceMemory* memories;
 	void** mappedPointers;
 	bool* isMapped;
+	evkBufferHandle handle; // set once the buffer is inserted into a library
+
+	// the per-frame arrays point here when frameCount fits, otherwise they share a single heap block
+	VkBuffer inlineBuffers[EVK_CONCURRENTLY_RENDERED_FRAMES];
+	VkDeviceMemory inlineMemories[EVK_CONCURRENTLY_RENDERED_FRAMES];
+	void* inlineMappedPointers[EVK_CONCURRENTLY_RENDERED_FRAMES];
+	bool inlineIsMapped[EVK_CONCURRENTLY_RENDERED_FRAMES];
 } evkBuffer;
 
 /// @brief creates an evkBuffer, returns NULL on failure with log messages about the error
@@ -147,6 +250,15 @@ evkBuffer* evk_buffer_create(VkDevice device, VkPhysicalDevice physicalDevice, V
 /// @brief releases all resources used by an evkBuffer
 void evk_buffer_destroy(VkDevice device, evkBuffer* buffer);
 
+/// @brief inserts the buffer into the library under name and returns it's handle, lookups by name are meant for registration only
+evkBufferHandle evk_buffer_library_insert(shashtable* buffers, const char* name, evkBuffer* buffer);
+
+/// @brief returns the handle of a buffer inserted under name, 0 when there's none
+evkBufferHandle evk_buffer_library_find(shashtable* buffers, const char* name);
+
+/// @brief returns the buffer of a handle, NULL when the buffer was destroyed
+evkBuffer* evk_buffer_library_get(evkBufferHandle handle);
+
 /// @brief maps the buffer memory to host-visible CPU-accessible memory for a specific frame index
 evkResult evk_buffer_map(VkDevice device, evkBuffer* buffer, uint32_t frameIndex);
 
@@ -162,6 +274,39 @@ evkResult evk_buffer_flush(VkDevice device, evkBuffer* buffer, uint32_t frameInd
 /// @brief records a GPU-side command to copy data from one buffer to another within a command buffer
 evkResult evk_buffer_command_copy(VkCommandBuffer commandBuffer, evkBuffer* srcBuffer, uint32_t srcFrameIndex, evkBuffer* dstBuffer, uint32_t dstFrameIndex, VkDeviceSize size, VkDeviceSize srcOffset, VkDeviceSize dstOffset);
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Sampler
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief the full state of a sampler, two equal states always resolve to the same shared sampler
+typedef struct evkSamplerState
+{
+	VkFilter minFilter;
+	VkFilter magFilter;
+	VkSamplerMipmapMode mipmapMode;
+	VkSamplerAddressMode addressModeU;
+	VkSamplerAddressMode addressModeV;
+	VkSamplerAddressMode addressModeW;
+	float mipLodBias;
+	VkBool32 anisotropyEnable;
+	float maxAnisotropy;		// 0 uses the device's maximum
+	VkBool32 compareEnable;
+	VkCompareOp compareOp;
+	float minLod;
+	float maxLod;				// VK_LOD_CLAMP_NONE lets the image view decide how many mips are sampled
+	VkBorderColor borderColor;
+	VkBool32 unnormalizedCoordinates;
+} evkSamplerState;
+
+/// @brief returns the state textures use, anisotropic trilinear filtering with the same address mode on all axes and no lod clamp
+evkSamplerState evk_sampler_state_default(VkFilter filter, VkSamplerAddressMode addressMode);
+
+/// @brief returns the shared sampler for the state, creating it on first use, it's owned by the backend and must not be destroyed
+VkSampler evk_sampler_cache_get(const evkSamplerState* state);
+
+/// @brief returns how many unique samplers the cache has created
+uint32_t evk_sampler_cache_get_count();
+
 #ifdef __cplusplus 
 }
 #endif
@@ -1,6 +1,7 @@
 #include "evk_vulkan_core.h"
 #include "evk.h"
 #include "vecmath/vecmath.h"
+#include "shader/mipmap_downsample_comp_spv.h"
 
 #define EVK_VULKAN_RENDERPHASE_IMPLEMENTATION
 #include "evk_vulkan_renderphase.h"
@@ -8,6 +9,9 @@
 #define EVK_VULKAN_DRAWABLE_IMPLEMENTATION
 #include "evk_vulkan_drawable.h"
 
+#undef EVK_LOG_CATEGORY
+#define EVK_LOG_CATEGORY evk_Log_Category_Core
+
 #ifdef __cplusplus 
 extern "C" {
 #endif
@@ -72,6 +76,29 @@ typedef struct evkSync
     uint32_t objectCount;
 } evkSync;
 
+/// @brief objects a compute mipmap dispatch needs until it's command buffer finishes executing
+typedef struct evkMipmapComputeTransient
+{
+    VkImage image;                                          // levels 1 to n, later copied into the real image
+    VkDeviceMemory mem;
+    VkImageView srcView;
+    VkImageView dstViews[EVK_COMPUTE_MIPMAP_MAX_LEVELS];
+    uint32_t dstViewCount;
+    VkBuffer counter;
+    VkDeviceMemory counterMem;
+    VkDescriptorPool descriptorPool;
+} evkMipmapComputeTransient;
+
+/// @brief holds the single dispatch compute downsampler
+typedef struct evkMipmapCompute
+{
+    VkShaderModule shader;
+    VkDescriptorSetLayout descriptorSetLayout;
+    VkPipelineLayout pipelineLayout;
+    VkPipeline pipeline;
+    darray* transients;     // evkMipmapComputeTransient, released once the single-time command buffers are done
+} evkMipmapCompute;
+
 /// @brief holds all vulkan backend structures needed on runtime
 struct evkVulkanBackend
 {
@@ -89,39 +116,111 @@ struct evkVulkanBackend
 
     shashtable* buffers;
     shashtable* pipelines;
+    shashtable* samplers;   // sampler state key -> index + 1 into samplersList
+    darray* samplersList;   // every VkSampler created by the cache, used for cleanup
+    float maxSamplerAnisotropy;         // device limits the sampler cache checks on every lookup, queried once after the device is created
+    uint32_t maxSamplerAllocationCount;
+    evkMipmapCompute mipmapCompute;
+    evkCommandStats commandStats;   // state commands recorded and skipped on the last frame
+
+    evkHandleTable pipelineHandles;
+    evkHandleTable bufferHandles;
+    evkHandleTable textureHandles;
+    evkBufferHandle mainCameraBuffer;
+
+    evkFrameArena frameArenas[EVK_CONCURRENTLY_RENDERED_FRAMES]; // reset once the fence of their frame signals
 };
 
 static evkVulkanBackend* g_EVKBackend = NULL;
+static evkPool g_EVKBufferPool = { 0 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Internal
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// @brief every validation message comes through the same callback, so they are rate limited by message id instead of by call site
+static evkLogSite g_EVKValidationSites[EVK_LOG_VALIDATION_SITES];
+
+/// @brief logs a validation message under the rate limit of it's id, ids hashing to the same site share it
+static void ievk_log_validation(int32_t messageId, evkSeverity severity, const char* message)
+{
+    if (g_EVKLogMuted[evk_Log_Category_Validation] & (1u << severity)) return;
+
+    uint32_t site = ((uint32_t)messageId * 2654435761u) & (EVK_LOG_VALIDATION_SITES - 1);
+    evk_log_site_message(&g_EVKValidationSites[site], severity, __FILE__, __LINE__, "%s\n", message);
+}
+
 /// @brief if validations are enabled, all vulkan messages will be call this function, wich will log the messages into the terminal
 static VKAPI_ATTR VkBool32 VKAPI_CALL ievk_log_callback(VkDebugUtilsMessageSeverityFlagBitsEXT severity, VkDebugUtilsMessageTypeFlagsEXT type, const VkDebugUtilsMessengerCallbackDataEXT* callback, void* userData)
 {
     if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT) {
-        EVK_LOG(evk_Error, "%s\n", callback->pMessage);
+        ievk_log_validation(callback->messageIdNumber, evk_Error, callback->pMessage);
         return VK_FALSE;
     }
 
     if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT) {
-        EVK_LOG(evk_Warn, "%s\n", callback->pMessage);
+        ievk_log_validation(callback->messageIdNumber, evk_Warn, callback->pMessage);
         return VK_FALSE;
     }
 
     if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT) {
-        EVK_LOG(evk_Info, "%s\n", callback->pMessage);
+        ievk_log_validation(callback->messageIdNumber, evk_Info, callback->pMessage);
         return VK_FALSE;
     }
 
     if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT) {
-        EVK_LOG(evk_Trace, "%s\n", callback->pMessage);
+        ievk_log_validation(callback->messageIdNumber, evk_Trace, callback->pMessage);
         return VK_FALSE;
     }
     return VK_TRUE;
 }
 
+/// @brief vulkan host allocations are routed through the evk allocator, reallocations of a different alignment are moved by it
+static void* VKAPI_PTR ievk_vulkan_allocate(void* userData, size_t size, size_t alignment, VkSystemAllocationScope scope)
+{
+    (void)userData;
+    (void)scope;
+    return evk_allocator_alloc(evk_Allocation_Tag_Vulkan, size, alignment, __FILE__, __LINE__);
+}
+
+static void* VKAPI_PTR ievk_vulkan_reallocate(void* userData, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope)
+{
+    (void)userData;
+    (void)scope;
+    return evk_allocator_realloc(evk_Allocation_Tag_Vulkan, original, size, alignment, __FILE__, __LINE__);
+}
+
+static void VKAPI_PTR ievk_vulkan_free(void* userData, void* memory)
+{
+    (void)userData;
+    evk_allocator_free(memory, __FILE__, __LINE__);
+}
+
+static const VkAllocationCallbacks g_EVKVulkanAllocator = { NULL, ievk_vulkan_allocate, ievk_vulkan_reallocate, ievk_vulkan_free, NULL, NULL };
+
+/// @brief ctoolbox memory functions have no user data, so every container is charged to the same tag
+static void* ievk_container_malloc(size_t size)
+{
+    return evk_allocator_alloc(evk_Allocation_Tag_Container, size, 16, __FILE__, __LINE__);
+}
+
+static void* ievk_container_calloc(size_t num, size_t size)
+{
+    return evk_allocator_calloc(evk_Allocation_Tag_Container, num, size, __FILE__, __LINE__);
+}
+
+static void ievk_container_free(void* ptr)
+{
+    evk_allocator_free(ptr, __FILE__, __LINE__);
+}
+
+static void* ievk_container_realloc(void* ptr, size_t newSize)
+{
+    return evk_allocator_realloc(evk_Allocation_Tag_Container, ptr, newSize, 16, __FILE__, __LINE__);
+}
+
+static const ctoolbox_memfuncs g_EVKContainerMemfuncs = { ievk_container_malloc, ievk_container_calloc, ievk_container_free, ievk_container_realloc };
+
 /// @brief the instance creation requires the names of all extensions it'll use, this changes depending on: platform, portability and validation requests, this function returns the list correctly
 static bool ievk_get_instance_extensions(uint32_t* count, const char** names)
 {
@@ -191,10 +290,10 @@ static evkInstance ievk_instance_create(const char* appName, uint32_t appVersion
         EVK_LOG(evk_Fatal, "Failed to retrieve initial count of required instance extensions");
     }
 
-    const char** extensions = m_malloc(count * sizeof(const char*));
+    const char** extensions = EVK_MALLOC(evk_Allocation_Tag_Core, count * sizeof(const char*));
     if (!ievk_get_instance_extensions(&count, extensions)) {
         EVK_LOG(evk_Fatal, "Failed to retrieve further list of required instance extensions");
-        m_free(extensions);
+        EVK_FREE(extensions);
     }
 
     VkInstanceCreateInfo instanceCI = { 0 };
@@ -224,14 +323,14 @@ static evkInstance ievk_instance_create(const char* appName, uint32_t appVersion
     instanceCI.pNext = &debugUtilsCI;
     #endif
 
-    EVK_ASSERT(vkCreateInstance(&instanceCI, NULL, &evkInstance.instance) == VK_SUCCESS, "Failed to create vulkan instance");
+    EVK_ASSERT(vkCreateInstance(&instanceCI, evk_get_vulkan_allocator(), &evkInstance.instance) == VK_SUCCESS, "Failed to create vulkan instance");
     volkLoadInstance(evkInstance.instance);
 
     #ifdef EVK_ENABLE_VALIDATIONS
-    EVK_ASSERT(vkCreateDebugUtilsMessengerEXT(evkInstance.instance, &debugUtilsCI, NULL, &evkInstance.debugger) == VK_SUCCESS, "Failed to create vulkan debugger");
+    EVK_ASSERT(vkCreateDebugUtilsMessengerEXT(evkInstance.instance, &debugUtilsCI, evk_get_vulkan_allocator(), &evkInstance.debugger) == VK_SUCCESS, "Failed to create vulkan debugger");
     #endif
 
-    m_free(extensions);
+    EVK_FREE(extensions);
     return evkInstance;
 }
 
@@ -240,17 +339,17 @@ static void ievk_instance_destroy(evkInstance* evkInstance)
 {
     EVK_ASSERT(evkInstance != NULL, "Vulkan backend is NULL");
 
-    vkDestroySurfaceKHR(evkInstance->instance, evkInstance->surface, NULL);
+    vkDestroySurfaceKHR(evkInstance->instance, evkInstance->surface, evk_get_vulkan_allocator());
     evkInstance->surface = VK_NULL_HANDLE;
 
     #ifdef EVK_ENABLE_VALIDATIONS
     if (vkDestroyDebugUtilsMessengerEXT) {
-        vkDestroyDebugUtilsMessengerEXT(evkInstance->instance, evkInstance->debugger, NULL);
+        vkDestroyDebugUtilsMessengerEXT(evkInstance->instance, evkInstance->debugger, evk_get_vulkan_allocator());
     }
     evkInstance->debugger = VK_NULL_HANDLE;
     #endif
 
-    vkDestroyInstance(evkInstance->instance, NULL);
+    vkDestroyInstance(evkInstance->instance, evk_get_vulkan_allocator());
     evkInstance->instance = VK_NULL_HANDLE;
 
     volkFinalize();
@@ -266,7 +365,7 @@ static void ievk_surface_create(VkInstance instance, VkSurfaceKHR* surface, void
     createInfo.hinstance = GetModuleHandle(NULL);
     createInfo.hwnd = (HWND)rawWindow;
     if (vkCreateWin32SurfaceKHR) {
-        EVK_ASSERT(vkCreateWin32SurfaceKHR(instance, &createInfo, NULL, surface) == VK_SUCCESS, "Failed to create the Win32 surface");
+        EVK_ASSERT(vkCreateWin32SurfaceKHR(instance, &createInfo, evk_get_vulkan_allocator(), surface) == VK_SUCCESS, "Failed to create the Win32 surface");
     }
 
     else {
@@ -279,7 +378,7 @@ static void ievk_surface_create(VkInstance instance, VkSurfaceKHR* surface, void
     createInfo.sType = VK_STRUCTURE_TYPE_METAL_SURFACE_CREATE_INFO_EXT;
     createInfo.pLayer = (CAMetalLayer*)rawWindow;
     if (vkCreateMetalSurfaceEXT) {
-        EVK_ASSERT(vkCreateMetalSurfaceEXT(instance, &createInfo, NULL, surface) == VK_SUCCESS, "Failed to create the Metal surface");
+        EVK_ASSERT(vkCreateMetalSurfaceEXT(instance, &createInfo, evk_get_vulkan_allocator(), surface) == VK_SUCCESS, "Failed to create the Metal surface");
     }
     else {
         EVK_ASSERT(true, "Cannot find vkCreateMetalSurfaceEXT");
@@ -291,7 +390,7 @@ static void ievk_surface_create(VkInstance instance, VkSurfaceKHR* surface, void
     createInfo.sType = VK_STRUCTURE_TYPE_ANDROID_SURFACE_CREATE_INFO_KHR;
     createInfo.window = (ANativeWindow*)rawWindow;
     if (vkCreateAndroidSurfaceKHR) {
-        EVK_ASSERT(vkCreateAndroidSurfaceKHR(instance, &createInfo, NULL, surface) == VK_SUCCESS, "Failed to create the Android surface");
+        EVK_ASSERT(vkCreateAndroidSurfaceKHR(instance, &createInfo, evk_get_vulkan_allocator(), surface) == VK_SUCCESS, "Failed to create the Android surface");
     }
     else {
         EVK_ASSERT(true, "Cannot find vkCreateAndroidSurfaceKHR");
@@ -305,7 +404,7 @@ static void ievk_surface_create(VkInstance instance, VkSurfaceKHR* surface, void
         createInfo.dpy = (Display*)rawDisplay;
         createInfo.window = (Window)rawWindow;
         if (vkCreateXlibSurfaceKHR) {
-            EVK_ASSERT(vkCreateXlibSurfaceKHR(instance, &createInfo, NULL, surface) == VK_SUCCESS, "Failed to create the Xlib surface");
+            EVK_ASSERT(vkCreateXlibSurfaceKHR(instance, &createInfo, evk_get_vulkan_allocator(), surface) == VK_SUCCESS, "Failed to create the Xlib surface");
         }
         else {
             EVK_ASSERT(true, "Cannot find vkCreateXlibSurfaceKHR");
@@ -318,7 +417,7 @@ static void ievk_surface_create(VkInstance instance, VkSurfaceKHR* surface, void
         createInfo.connection = (xcb_connection_t*)rawDisplay;
         createInfo.window = (xcb_window_t)rawWindow;
         if (vkCreateXcbSurfaceKHR) {
-            EVK_ASSERT(vkCreateXcbSurfaceKHR(instance, &createInfo, NULL, surface) == VK_SUCCESS, "Failed to create the XCB surface");
+            EVK_ASSERT(vkCreateXcbSurfaceKHR(instance, &createInfo, evk_get_vulkan_allocator(), surface) == VK_SUCCESS, "Failed to create the XCB surface");
         }
         else {
             EVK_ASSERT(true, "Cannot find vkCreateXcbSurfaceKHR");
@@ -331,7 +430,7 @@ static void ievk_surface_create(VkInstance instance, VkSurfaceKHR* surface, void
         createInfo.display = (struct wl_display*)rawDisplay;
         createInfo.surface = (struct wl_surface*)rawWindow;
         if (vkCreateWaylandSurfaceKHR) {
-            EVK_ASSERT(vkCreateWaylandSurfaceKHR(instance, &createInfo, NULL, surface) == VK_SUCCESS, "Failed to create the Wayland surface");
+            EVK_ASSERT(vkCreateWaylandSurfaceKHR(instance, &createInfo, evk_get_vulkan_allocator(), surface) == VK_SUCCESS, "Failed to create the Wayland surface");
         }
         else {
             EVK_ASSERT(true, "Cannot find vkCreateWaylandSurfaceKHR");
@@ -347,7 +446,7 @@ static bool ievk_check_device_extension_support(VkPhysicalDevice device, const c
     uint32_t available_extension_count;
     vkEnumerateDeviceExtensionProperties(device, NULL, &available_extension_count, NULL);
 
-    VkExtensionProperties* available_extensions = (VkExtensionProperties*)m_malloc(available_extension_count * sizeof(VkExtensionProperties));
+    VkExtensionProperties* available_extensions = (VkExtensionProperties*)EVK_MALLOC(evk_Allocation_Tag_Core, available_extension_count * sizeof(VkExtensionProperties));
     vkEnumerateDeviceExtensionProperties(device, NULL, &available_extension_count, available_extensions);
 
     for (uint32_t i = 0; i < extension_count; i++) {
@@ -359,28 +458,85 @@ static bool ievk_check_device_extension_support(VkPhysicalDevice device, const c
             }
         }
         if (!extension_found) {
-            m_free(available_extensions);
+            EVK_FREE(available_extensions);
             return 0;
         }
     }
 
-    m_free(available_extensions);
+    EVK_FREE(available_extensions);
     return 1;
 }
 
-/// @brief since one compute may have multiple physical gpus we must check them all to see which is more fit
-static VkPhysicalDevice ievk_device_choose(VkInstance instance, VkSurfaceKHR surface)
+/// @brief vulkan feature each evkDeviceFeature bit maps to, in bit order
+static const struct { size_t offset; const char* name; } g_EVKDeviceFeatures[] = {
+    { offsetof(VkPhysicalDeviceFeatures, samplerAnisotropy), "samplerAnisotropy" },
+    { offsetof(VkPhysicalDeviceFeatures, textureCompressionBC), "textureCompressionBC" },
+    { offsetof(VkPhysicalDeviceFeatures, textureCompressionASTC_LDR), "textureCompressionASTC_LDR" },
+    { offsetof(VkPhysicalDeviceFeatures, fillModeNonSolid), "fillModeNonSolid" },
+    { offsetof(VkPhysicalDeviceFeatures, wideLines), "wideLines" },
+    { offsetof(VkPhysicalDeviceFeatures, geometryShader), "geometryShader" },
+    { offsetof(VkPhysicalDeviceFeatures, multiDrawIndirect), "multiDrawIndirect" }
+};
+
+/// @brief returns the name of the first evkDeviceFeature bit the device doesn't support out of required, NULL when it supports them all
+static const char* ievk_device_missing_feature(const VkPhysicalDeviceFeatures* supported, uint32_t required)
+{
+    for (uint32_t i = 0; i < sizeof(g_EVKDeviceFeatures) / sizeof(g_EVKDeviceFeatures[0]); i++) {
+        if (!(required & (1u << i))) continue;
+        if (!*(const VkBool32*)((const char*)supported + g_EVKDeviceFeatures[i].offset)) return g_EVKDeviceFeatures[i].name;
+    }
+    return NULL;
+}
+
+/// @brief turns on the vulkan features of the evkDeviceFeature bits
+static void ievk_device_enable_features(VkPhysicalDeviceFeatures* enabled, uint32_t features)
+{
+    for (uint32_t i = 0; i < sizeof(g_EVKDeviceFeatures) / sizeof(g_EVKDeviceFeatures[0]); i++) {
+        if (features & (1u << i)) *(VkBool32*)((char*)enabled + g_EVKDeviceFeatures[i].offset) = VK_TRUE;
+    }
+}
+
+#ifdef EVK_ENABLE_VALIDATIONS
+/// @brief returns a readable name of the device type for the logs
+static const char* ievk_device_type_name(VkPhysicalDeviceType type)
+{
+    switch (type) {
+        case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU: return "discrete";
+        case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: return "integrated";
+        case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU: return "virtual";
+        case VK_PHYSICAL_DEVICE_TYPE_CPU: return "cpu";
+        default: return "other";
+    }
+}
+#endif
+
+/// @brief since one computer may have multiple physical gpus we score every usable one following the device policy, a device pinned by index or uuid is used as is or not at all
+static VkPhysicalDevice ievk_device_choose(VkInstance instance, VkSurfaceKHR surface, const evkDevicePolicy* policy)
 {
+    // a bit we don't map to a vulkan feature can't be honored, ignoring it would hand out a device without it
+    const uint32_t knownFeatures = (1u << (sizeof(g_EVKDeviceFeatures) / sizeof(g_EVKDeviceFeatures[0]))) - 1;
+    if (policy->requiredFeatures & ~knownFeatures) {
+        EVK_LOG(evk_Error, "The device policy requires unknown device features 0x%x", policy->requiredFeatures & ~knownFeatures);
+        return VK_NULL_HANDLE;
+    }
+
     uint32_t gpus = 0;
     vkEnumeratePhysicalDevices(instance, &gpus, NULL);
 
-    VkPhysicalDevice* devices = (VkPhysicalDevice*)m_malloc(gpus * sizeof(VkPhysicalDevice));
+    VkPhysicalDevice* devices = (VkPhysicalDevice*)EVK_MALLOC(evk_Allocation_Tag_Core, gpus * sizeof(VkPhysicalDevice));
     vkEnumeratePhysicalDevices(instance, &gpus, devices);
 
-    VkPhysicalDevice choosenOne = VK_NULL_HANDLE;
     const char* requiredExtensions[] = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
     const uint32_t requiredExtensionsCount = 1;
+    const uint32_t requiredFeatures = policy->requiredFeatures | evk_Device_Feature_Sampler_Anisotropy; // every sampler we create is anisotropic
     VkDeviceSize bestScore = 0;
+    uint32_t bestIndex = 0;
+
+    bool pinnedUUID = false;
+    for (uint32_t i = 0; i < VK_UUID_SIZE; i++) {
+        if (policy->deviceUUID[i] != 0) pinnedUUID = true;
+    }
+    bool pinned = pinnedUUID || policy->deviceIndex != 0;
 
     for (uint32_t i = 0; i < gpus; i++) {
 
@@ -390,31 +546,90 @@ static VkPhysicalDevice ievk_device_choose(VkInstance instance, VkSurfaceKHR sur
         vkGetPhysicalDeviceProperties(devices[i], &device_props);
         vkGetPhysicalDeviceFeatures(devices[i], &device_features);
         vkGetPhysicalDeviceMemoryProperties(devices[i], &mem_props);
+
+        if (policy->deviceIndex != 0 && policy->deviceIndex - 1 != i) continue;
+        if (pinnedUUID) {
+            // the id properties are core since vulkan 1.1, older devices can't be pinned by uuid
+            if (device_props.apiVersion < VK_API_VERSION_1_1) continue;
+
+            VkPhysicalDeviceIDProperties id_props = { 0 };
+            id_props.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+            VkPhysicalDeviceProperties2 props2 = { 0 };
+            props2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+            props2.pNext = &id_props;
+            vkGetPhysicalDeviceProperties2(devices[i], &props2);
+            if (memcmp(id_props.deviceUUID, policy->deviceUUID, VK_UUID_SIZE) != 0) continue;
+        }
+
+        // a single family with graphics and compute is enough, the compute family doesn't need to be a separate one
         evkQueueFamily indices = evk_device_find_queue_families(devices[i], surface);
-        if (!indices.graphicsFound || !indices.presentFound || !indices.computeFound) continue;
-        if (!ievk_check_device_extension_support(devices[i], requiredExtensions, requiredExtensionsCount)) continue;
+        if (!indices.graphicsFound || !indices.presentFound || !indices.computeFound) {
+            EVK_LOG(evk_Info, "Device %u %s skipped, it lacks a graphics, present or compute queue", i, device_props.deviceName);
+            continue;
+        }
+
+        if (!ievk_check_device_extension_support(devices[i], requiredExtensions, requiredExtensionsCount)) {
+            EVK_LOG(evk_Info, "Device %u %s skipped, it can't present to a swapchain", i, device_props.deviceName);
+            continue;
+        }
+
+        const char* missingFeature = ievk_device_missing_feature(&device_features, requiredFeatures);
+        if (missingFeature != NULL) {
+            EVK_LOG(evk_Info, "Device %u %s skipped, it lacks %s", i, device_props.deviceName, missingFeature);
+            continue;
+        }
+
+        VkDeviceSize deviceMemory = 0;
+        for (uint32_t j = 0; j < mem_props.memoryHeapCount; j++) {
+            if (mem_props.memoryHeaps[j].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) deviceMemory += mem_props.memoryHeaps[j].size;
+        }
+
+        if (deviceMemory < policy->minDeviceMemory) {
+            EVK_LOG(evk_Info, "Device %u %s skipped, it has %llu MB of device memory out of the %llu MB required", i, device_props.deviceName, (unsigned long long)(deviceMemory / (1024 * 1024)), (unsigned long long)(policy->minDeviceMemory / (1024 * 1024)));
+            continue;
+        }
+
+        VkDeviceSize currentScore = 1; // usable devices always score, so even a device with nothing going for it gets choosen
+        switch (policy->preference) {
+            case evk_Device_Preference_Discrete: if (device_props.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU) currentScore += 1ull << 32; break;
+            case evk_Device_Preference_Integrated: if (device_props.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU) currentScore += 1ull << 32; break;
+            case evk_Device_Preference_CPU: if (device_props.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU) currentScore += 1ull << 32; break;
+            default: break;
+        }
 
-        VkDeviceSize currentScore = 0;
         if (device_props.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU) currentScore += 1000;  // discrete gpu
         currentScore += device_props.limits.maxImageDimension2D;                                    // max texture size
-        for (uint32_t j = 0; j < mem_props.memoryHeapCount; j++) {                                  // prefer devices with dedicated VRAM
-            if (mem_props.memoryHeaps[j].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
-                currentScore += mem_props.memoryHeaps[j].size / (VkDeviceSize)(1024 * 1024);        // mb
-            }
-        }
+        currentScore += deviceMemory / (VkDeviceSize)(1024 * 1024);                                 // prefer devices with dedicated VRAM, in mb
+
+        EVK_LOG(evk_Info, "Device %u %s (%s, %llu MB) scored %llu", i, device_props.deviceName, ievk_device_type_name(device_props.deviceType), (unsigned long long)(deviceMemory / (1024 * 1024)), (unsigned long long)currentScore);
 
         if (currentScore > bestScore) {
             bestScore = currentScore;
-            choosenOne = devices[i];
+            bestIndex = i;
         }
     }
 
-    m_free(devices);
+    // usable devices score at least 1, so a zero score means none was
+    VkPhysicalDevice choosenOne = bestScore > 0 ? devices[bestIndex] : VK_NULL_HANDLE;
+
+    if (choosenOne != VK_NULL_HANDLE) {
+        VkPhysicalDeviceProperties device_props;
+        vkGetPhysicalDeviceProperties(choosenOne, &device_props);
+        EVK_LOG(evk_Info, "Using device %u %s (%s) with score %llu%s", bestIndex, device_props.deviceName, ievk_device_type_name(device_props.deviceType), (unsigned long long)bestScore, pinned ? ", pinned by the device policy" : "");
+    }
+    else if (pinned) {
+        EVK_LOG(evk_Error, "The device pinned by the device policy is not present or not usable, %u devices were checked", gpus);
+    }
+    else {
+        EVK_LOG(evk_Error, "None of the %u devices satisfies the device policy", gpus);
+    }
+
+    EVK_FREE(devices);
     return choosenOne;
 }
 
 /// @brief creates the logical device based on choosen physical device and surface, it'll be logical connection to a specific GPU, used for creatin all vulkan objects from now on
-static evkDevice ievk_device_create(VkInstance instance, VkSurfaceKHR surface, VkPhysicalDevice physicalDevice)
+static evkDevice ievk_device_create(VkInstance instance, VkSurfaceKHR surface, VkPhysicalDevice physicalDevice, uint32_t requiredFeatures)
 {
     evkDevice device = { 0 };
     device.physicalDevice = physicalDevice;
@@ -436,7 +651,7 @@ static evkDevice ievk_device_create(VkInstance instance, VkSurfaceKHR surface, V
     if (indices.present != -1 && indices.present != indices.graphics)  queueFamilyIndices[queueCount++] = indices.present;
     if (indices.compute != -1 && indices.compute != indices.graphics && indices.compute != indices.present) queueFamilyIndices[queueCount++] = indices.compute;
 
-    VkDeviceQueueCreateInfo* queueCreateInfos = (VkDeviceQueueCreateInfo*)m_malloc(sizeof(VkDeviceQueueCreateInfo) * queueCount);
+    VkDeviceQueueCreateInfo* queueCreateInfos = (VkDeviceQueueCreateInfo*)EVK_MALLOC(evk_Allocation_Tag_Core, sizeof(VkDeviceQueueCreateInfo) * queueCount);
     for (uint32_t i = 0; i < queueCount; i++) {
         queueCreateInfos[i].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
         queueCreateInfos[i].pNext = NULL;
@@ -454,8 +669,14 @@ static evkDevice ievk_device_create(VkInstance instance, VkSurfaceKHR surface, V
     uint32_t extensionCount = 1;
     #endif
 
+    VkPhysicalDeviceFeatures supportedFeatures = { 0 };
+    vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+
     VkPhysicalDeviceFeatures deviceFeatures = { 0 };
     deviceFeatures.samplerAnisotropy = VK_TRUE;
+    deviceFeatures.textureCompressionBC = supportedFeatures.textureCompressionBC;          // cooked textures
+    deviceFeatures.textureCompressionASTC_LDR = supportedFeatures.textureCompressionASTC_LDR;
+    ievk_device_enable_features(&deviceFeatures, requiredFeatures);                        // ievk_device_choose checked they are supported
 
     VkDeviceCreateInfo deviceCI = { 0 };
     deviceCI.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -468,7 +689,7 @@ static evkDevice ievk_device_create(VkInstance instance, VkSurfaceKHR surface, V
     deviceCI.pEnabledFeatures = &deviceFeatures;
     deviceCI.enabledLayerCount = validationLayerCount;
     deviceCI.ppEnabledLayerNames = validationLayers;
-    EVK_ASSERT(vkCreateDevice(physicalDevice, &deviceCI, NULL, &device.device) == VK_SUCCESS, "Failed to create vulkan logical device");
+    EVK_ASSERT(vkCreateDevice(physicalDevice, &deviceCI, evk_get_vulkan_allocator(), &device.device) == VK_SUCCESS, "Failed to create vulkan logical device");
     
     volkLoadDevice(device.device);
 
@@ -483,7 +704,7 @@ static evkDevice ievk_device_create(VkInstance instance, VkSurfaceKHR surface, V
     device.presentIndex = indices.present;
     device.computeIndex = indices.compute;
 
-    m_free(queueCreateInfos);
+    EVK_FREE(queueCreateInfos);
 
     return device;
 }
@@ -493,7 +714,7 @@ static void ievk_device_destroy(evkDevice* evkDevice)
 {
     EVK_ASSERT(evkDevice != NULL, "evkDevice is NULL");
 
-    vkDestroyDevice(g_EVKBackend->evkDevice.device, NULL);
+    vkDestroyDevice(g_EVKBackend->evkDevice.device, evk_get_vulkan_allocator());
     g_EVKBackend->evkDevice.device = VK_NULL_HANDLE;
 }
 
@@ -505,7 +726,7 @@ static evkSwapchainDetails ievk_swapchain_query_details(VkPhysicalDevice physica
     vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &details.surfaceFormatCount, NULL);
 
     if (details.surfaceFormatCount != 0) {
-        details.surfaceFormats = (VkSurfaceFormatKHR*)m_malloc(details.surfaceFormatCount * sizeof(VkSurfaceFormatKHR));
+        details.surfaceFormats = (VkSurfaceFormatKHR*)EVK_MALLOC(evk_Allocation_Tag_Core, details.surfaceFormatCount * sizeof(VkSurfaceFormatKHR));
 
         if (details.surfaceFormats) {
             vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &details.surfaceFormatCount, details.surfaceFormats);
@@ -515,7 +736,7 @@ static evkSwapchainDetails ievk_swapchain_query_details(VkPhysicalDevice physica
     vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &details.presentModeCount, NULL);
 
     if (details.presentModeCount != 0) {
-        details.presentModes = (VkPresentModeKHR*)m_malloc(details.presentModeCount * sizeof(VkPresentModeKHR));
+        details.presentModes = (VkPresentModeKHR*)EVK_MALLOC(evk_Allocation_Tag_Core, details.presentModeCount * sizeof(VkPresentModeKHR));
         if (details.presentModes) {
             vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &details.presentModeCount, details.presentModes);
         }
@@ -603,11 +824,11 @@ static evkSwapchain ievk_swapchain_create(VkSurfaceKHR surface, VkDevice device,
         swapchainCI.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
     }
 
-    EVK_ASSERT(vkCreateSwapchainKHR(device, &swapchainCI, NULL, &swapchain.swapchain) == VK_SUCCESS, "Failed to create swapchain");
+    EVK_ASSERT(vkCreateSwapchainKHR(device, &swapchainCI, evk_get_vulkan_allocator(), &swapchain.swapchain) == VK_SUCCESS, "Failed to create swapchain");
 
     vkGetSwapchainImagesKHR(device, swapchain.swapchain, &swapchain.imageCount, NULL);
-    swapchain.images = (VkImage*)m_malloc(swapchain.imageCount * sizeof(VkImage));
-    swapchain.imageViews = (VkImageView*)m_malloc(sizeof(VkImageView) * swapchain.imageCount);
+    swapchain.images = (VkImage*)EVK_MALLOC(evk_Allocation_Tag_Core, swapchain.imageCount * sizeof(VkImage));
+    swapchain.imageViews = (VkImageView*)EVK_MALLOC(evk_Allocation_Tag_Core, sizeof(VkImageView) * swapchain.imageCount);
     vkGetSwapchainImagesKHR(device, swapchain.swapchain, &swapchain.imageCount, swapchain.images);
 
     for (uint32_t i = 0; i < swapchain.imageCount; i++) {
@@ -615,8 +836,8 @@ static evkSwapchain ievk_swapchain_create(VkSurfaceKHR surface, VkDevice device,
     }
 
     // free details
-    m_free(details.presentModes);
-    m_free(details.surfaceFormats);
+    EVK_FREE(details.presentModes);
+    EVK_FREE(details.surfaceFormats);
 
     return swapchain;
 }
@@ -625,13 +846,13 @@ static evkSwapchain ievk_swapchain_create(VkSurfaceKHR surface, VkDevice device,
 static void ievk_swapchain_destroy(evkSwapchain* swapchain, VkDevice device)
 {
     for (uint32_t i = 0; i < swapchain->imageCount; i++) {
-        vkDestroyImageView(device, swapchain->imageViews[i], NULL);
+        vkDestroyImageView(device, swapchain->imageViews[i], evk_get_vulkan_allocator());
     }
 
-    m_free(swapchain->imageViews);
-    m_free(swapchain->images);
+    EVK_FREE(swapchain->imageViews);
+    EVK_FREE(swapchain->images);
 
-    vkDestroySwapchainKHR(device, swapchain->swapchain, NULL);
+    vkDestroySwapchainKHR(device, swapchain->swapchain, evk_get_vulkan_allocator());
     swapchain->swapchain = VK_NULL_HANDLE;
 }
 
@@ -651,14 +872,14 @@ static evkSync ievk_sync_create(VkDevice device, uint32_t objectCount)
     fenceCI.pNext = NULL;
     fenceCI.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
-    sync.imageAvailableSemaphores = (VkSemaphore*)m_malloc(sizeof(VkSemaphore) * objectCount);
-    sync.finishedRenderingSemaphores = (VkSemaphore*)m_malloc(sizeof(VkSemaphore) * objectCount);
-    sync.framesInFlightFences = (VkFence*)m_malloc(sizeof(VkFence) * objectCount);
+    sync.imageAvailableSemaphores = (VkSemaphore*)EVK_MALLOC(evk_Allocation_Tag_Core, sizeof(VkSemaphore) * objectCount);
+    sync.finishedRenderingSemaphores = (VkSemaphore*)EVK_MALLOC(evk_Allocation_Tag_Core, sizeof(VkSemaphore) * objectCount);
+    sync.framesInFlightFences = (VkFence*)EVK_MALLOC(evk_Allocation_Tag_Core, sizeof(VkFence) * objectCount);
 
     for (size_t i = 0; i < objectCount; i++) {
-        EVK_ASSERT(vkCreateSemaphore(device, &semaphoreCI, NULL, &sync.imageAvailableSemaphores[i]) == VK_SUCCESS, "Failed to create image available semaphore");
-        EVK_ASSERT(vkCreateSemaphore(device, &semaphoreCI, NULL, &sync.finishedRenderingSemaphores[i]) == VK_SUCCESS, "Failed to create rendering finished semaphore");
-        EVK_ASSERT(vkCreateFence(device, &fenceCI, NULL, &sync.framesInFlightFences[i]) == VK_SUCCESS, "Failed to create syncronizer fence");
+        EVK_ASSERT(vkCreateSemaphore(device, &semaphoreCI, evk_get_vulkan_allocator(), &sync.imageAvailableSemaphores[i]) == VK_SUCCESS, "Failed to create image available semaphore");
+        EVK_ASSERT(vkCreateSemaphore(device, &semaphoreCI, evk_get_vulkan_allocator(), &sync.finishedRenderingSemaphores[i]) == VK_SUCCESS, "Failed to create rendering finished semaphore");
+        EVK_ASSERT(vkCreateFence(device, &fenceCI, evk_get_vulkan_allocator(), &sync.framesInFlightFences[i]) == VK_SUCCESS, "Failed to create syncronizer fence");
     }
 
     return sync;
@@ -668,13 +889,13 @@ static evkSync ievk_sync_create(VkDevice device, uint32_t objectCount)
 static void ievk_sync_destroy(evkSync* sync, VkDevice device)
 {
     for (uint32_t i = 0; i < sync->objectCount; i++) {
-        if (sync->imageAvailableSemaphores[i]) vkDestroySemaphore(device, sync->imageAvailableSemaphores[i], NULL);
-        if (sync->finishedRenderingSemaphores[i]) vkDestroySemaphore(device, sync->finishedRenderingSemaphores[i], NULL);
-        if (sync->framesInFlightFences[i]) vkDestroyFence(device, sync->framesInFlightFences[i], NULL);
+        if (sync->imageAvailableSemaphores[i]) vkDestroySemaphore(device, sync->imageAvailableSemaphores[i], evk_get_vulkan_allocator());
+        if (sync->finishedRenderingSemaphores[i]) vkDestroySemaphore(device, sync->finishedRenderingSemaphores[i], evk_get_vulkan_allocator());
+        if (sync->framesInFlightFences[i]) vkDestroyFence(device, sync->framesInFlightFences[i], evk_get_vulkan_allocator());
     }
-    m_free(sync->imageAvailableSemaphores);
-    m_free(sync->finishedRenderingSemaphores);
-    m_free(sync->framesInFlightFences);
+    EVK_FREE(sync->imageAvailableSemaphores);
+    EVK_FREE(sync->finishedRenderingSemaphores);
+    EVK_FREE(sync->framesInFlightFences);
 }
 
 static void ievk_resize(VkExtent2D extent)
@@ -710,6 +931,41 @@ static void ievk_resize(VkExtent2D extent)
     evk_camera_set_aspect_ratio(evk_get_main_camera(), (float)(extent.width / extent.height));
 }
 
+/// @brief destroys the objects of compute mipmap dispatches, must only be called once their command buffers finished executing
+static void ievk_mipmap_compute_release_transients(VkDevice device, evkMipmapCompute* compute)
+{
+    if (!compute->transients) return;
+
+    for (size_t i = 0; i < darray_size(compute->transients); i++) {
+        evkMipmapComputeTransient transient = { 0 };
+        darray_get(compute->transients, i, &transient);
+
+        if (transient.descriptorPool != VK_NULL_HANDLE) vkDestroyDescriptorPool(device, transient.descriptorPool, evk_get_vulkan_allocator());
+        for (uint32_t j = 0; j < transient.dstViewCount; j++) vkDestroyImageView(device, transient.dstViews[j], evk_get_vulkan_allocator());
+        if (transient.srcView != VK_NULL_HANDLE) vkDestroyImageView(device, transient.srcView, evk_get_vulkan_allocator());
+        if (transient.image != VK_NULL_HANDLE) vkDestroyImage(device, transient.image, evk_get_vulkan_allocator());
+        if (transient.mem != VK_NULL_HANDLE) vkFreeMemory(device, transient.mem, evk_get_vulkan_allocator());
+        if (transient.counter != VK_NULL_HANDLE) vkDestroyBuffer(device, transient.counter, evk_get_vulkan_allocator());
+        if (transient.counterMem != VK_NULL_HANDLE) vkFreeMemory(device, transient.counterMem, evk_get_vulkan_allocator());
+    }
+
+    darray_resize(compute->transients, 0);
+}
+
+/// @brief releases the compute downsampler
+static void ievk_mipmap_compute_destroy(VkDevice device, evkMipmapCompute* compute)
+{
+    ievk_mipmap_compute_release_transients(device, compute);
+    if (compute->transients) darray_destroy(compute->transients);
+
+    if (compute->pipeline != VK_NULL_HANDLE) vkDestroyPipeline(device, compute->pipeline, evk_get_vulkan_allocator());
+    if (compute->pipelineLayout != VK_NULL_HANDLE) vkDestroyPipelineLayout(device, compute->pipelineLayout, evk_get_vulkan_allocator());
+    if (compute->descriptorSetLayout != VK_NULL_HANDLE) vkDestroyDescriptorSetLayout(device, compute->descriptorSetLayout, evk_get_vulkan_allocator());
+    if (compute->shader != VK_NULL_HANDLE) vkDestroyShaderModule(device, compute->shader, evk_get_vulkan_allocator());
+
+    memset(compute, 0, sizeof(evkMipmapCompute));
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // General core
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -718,16 +974,23 @@ evkResult evk_initialize_backend(const evkCreateInfo* ci)
 {
     // general initialization
     if (g_EVKBackend == NULL) {
-        g_EVKBackend = (evkVulkanBackend*)m_malloc(sizeof(evkVulkanBackend));
+        g_EVKBackend = (evkVulkanBackend*)EVK_MALLOC(evk_Allocation_Tag_Core, sizeof(evkVulkanBackend));
         memset(g_EVKBackend, 0, sizeof(g_EVKBackend));
         if (!g_EVKBackend) {
             EVK_LOG(evk_Fatal, "Failed to allocate memory resources for evkVulkanBackend");
             return evk_Failure;
         }
         
-        g_EVKBackend->buffers = shashtable_init();
-        g_EVKBackend->pipelines = shashtable_init();
+        g_EVKBackend->buffers = shashtable_init_memfuncs(&g_EVKContainerMemfuncs);
+        g_EVKBackend->pipelines = shashtable_init_memfuncs(&g_EVKContainerMemfuncs);
+        g_EVKBackend->samplers = shashtable_init_memfuncs(&g_EVKContainerMemfuncs);
+        g_EVKBackend->samplersList = darray_init_memfuncs(sizeof(VkSampler), 16, &g_EVKContainerMemfuncs);
         g_EVKBackend->msaa = ci->MSAA;
+
+        evk_handle_table_init(&g_EVKBackend->pipelineHandles);
+        evk_handle_table_init(&g_EVKBackend->bufferHandles);
+        evk_handle_table_init(&g_EVKBackend->textureHandles);
+        evk_pool_init(&g_EVKBufferPool, sizeof(evkBuffer), evk_Allocation_Tag_Core);
     }
     
     // instance
@@ -751,8 +1014,30 @@ evkResult evk_initialize_backend(const evkCreateInfo* ci)
     #endif
 
     // device
-    VkPhysicalDevice physicalDevice = ievk_device_choose(g_EVKBackend->evkInstance.instance, g_EVKBackend->evkInstance.surface);
-    g_EVKBackend->evkDevice = ievk_device_create(g_EVKBackend->evkInstance.instance, g_EVKBackend->evkInstance.surface, physicalDevice);
+    VkPhysicalDevice physicalDevice = ievk_device_choose(g_EVKBackend->evkInstance.instance, g_EVKBackend->evkInstance.surface, &ci->device);
+    if (physicalDevice == VK_NULL_HANDLE) {
+        // nothing past the instance exists yet, so only it and the containers are released
+        EVK_LOG(evk_Error, "Failed to find a device that satisfies the device policy");
+        ievk_instance_destroy(&g_EVKBackend->evkInstance);
+        darray_destroy(g_EVKBackend->samplersList);
+        shashtable_destroy(g_EVKBackend->samplers);
+        shashtable_destroy(g_EVKBackend->pipelines);
+        shashtable_destroy(g_EVKBackend->buffers);
+        evk_handle_table_destroy(&g_EVKBackend->pipelineHandles);
+        evk_handle_table_destroy(&g_EVKBackend->bufferHandles);
+        evk_handle_table_destroy(&g_EVKBackend->textureHandles);
+        evk_pool_destroy(&g_EVKBufferPool);
+        EVK_FREE(g_EVKBackend);
+        g_EVKBackend = NULL;
+        return evk_Failure;
+    }
+
+    g_EVKBackend->evkDevice = ievk_device_create(g_EVKBackend->evkInstance.instance, g_EVKBackend->evkInstance.surface, physicalDevice, ci->device.requiredFeatures);
+
+    VkPhysicalDeviceProperties deviceProps;
+    vkGetPhysicalDeviceProperties(g_EVKBackend->evkDevice.physicalDevice, &deviceProps);
+    g_EVKBackend->maxSamplerAnisotropy = deviceProps.limits.maxSamplerAnisotropy;
+    g_EVKBackend->maxSamplerAllocationCount = deviceProps.limits.maxSamplerAllocationCount;
 
     // swapchain
     g_EVKBackend->evkSwapchain = ievk_swapchain_create(g_EVKBackend->evkInstance.surface, g_EVKBackend->evkDevice.device, g_EVKBackend->evkDevice.physicalDevice, (VkExtent2D){ci->width, ci->height}, ci->vsync);
@@ -777,21 +1062,58 @@ evkResult evk_initialize_backend(const evkCreateInfo* ci)
 
     // buffers
     evkBuffer* cameraBuffer = evk_buffer_create(g_EVKBackend->evkDevice.device, g_EVKBackend->evkDevice.physicalDevice, sizeof(evkCameraUBO), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, EVK_CONCURRENTLY_RENDERED_FRAMES);
-    EVK_ASSERT(shashtable_insert(g_EVKBackend->buffers, "MainCamera", cameraBuffer) == CTOOLBOX_SUCCESS, "Failed to insert camera buffer into the buffer library");
+    g_EVKBackend->mainCameraBuffer = evk_buffer_library_insert(g_EVKBackend->buffers, "MainCamera", cameraBuffer);
+    EVK_ASSERT(g_EVKBackend->mainCameraBuffer.value != 0, "Failed to insert camera buffer into the buffer library");
 
     // pipelines
     evkRenderpass* renderpass = evk_using_viewport() ? &g_EVKBackend->evkViewportRenderphase.evkRenderpass : &g_EVKBackend->evkMainRenderphase.evkRenderpass;
     EVK_ASSERT(evk_pipeline_sprite_create(g_EVKBackend->pipelines, renderpass, &g_EVKBackend->evkPickingRenderphase.evkRenderpass, g_EVKBackend->evkDevice.device) == evk_Success, "Failed to create quad pipelines");
 
+    evkMeshShaders meshShaders = evk_pipeline_mesh_default_shaders();
+    evkResult meshResult = evk_pipeline_mesh_create(g_EVKBackend->pipelines, renderpass, &g_EVKBackend->evkPickingRenderphase.evkRenderpass, g_EVKBackend->evkDevice.device, &meshShaders);
+    EVK_ASSERT(meshResult == evk_Success, "Failed to create mesh pipelines");
+    (void)meshResult;
+
+    // compute mipmaps are optional, textures keep blitting their levels when the downsampler can't be created
+    if (evk_device_create_mipmap_compute(mipmap_downsample_comp_spv, mipmap_downsample_comp_spv_size) != evk_Success) {
+        EVK_LOG(evk_Warn, "Mipmap downsampler unavailable, mipmaps will be blitted");
+    }
+
+    // resources
+    evk_object_pools_init();
+
+    for (uint32_t i = 0; i < EVK_CONCURRENTLY_RENDERED_FRAMES; i++) {
+        EVK_ASSERT(evk_frame_arena_create(&g_EVKBackend->frameArenas[i], ci->frameArenaSize) == evk_Success, "Failed to create the frame arenas");
+    }
+
+    EVK_ASSERT(evk_texture_cache_init(ci->textureCacheBudget) == evk_Success, "Failed to create the texture cache");
+    EVK_ASSERT(evk_texture_stream_init(ci->textureStreamBudget) == evk_Success, "Failed to create the texture streamer");
+    EVK_ASSERT(evk_thumbnail_cache_init(ci->thumbnailBudget) == evk_Success, "Failed to create the thumbnail cache");
+    EVK_ASSERT(evk_draw_queue_init(ci->drawQueueCapacity) == evk_Success, "Failed to create the draw queue");
+
     return evk_Success;
 }
 
 void evk_shutdown_backend()
 {
-    evk_buffer_destroy(g_EVKBackend->evkDevice.device, (evkBuffer*)shashtable_lookup(g_EVKBackend->buffers, "MainCamera"));
+    if (g_EVKBackend == NULL) return; // initialization failed before the device existed and already released it's part
+
+    evk_texture_cache_shutdown();
+    evk_texture_stream_shutdown();
+    evk_thumbnail_cache_shutdown();
+    evk_draw_queue_shutdown();
+
+    for (uint32_t i = 0; i < EVK_CONCURRENTLY_RENDERED_FRAMES; i++) {
+        evk_frame_arena_destroy(&g_EVKBackend->frameArenas[i]);
+    }
+    evk_object_pools_shutdown();
+
+    evk_buffer_destroy(g_EVKBackend->evkDevice.device, evk_buffer_library_get(g_EVKBackend->mainCameraBuffer));
     shashtable_destroy(g_EVKBackend->buffers);
 
+    ievk_mipmap_compute_destroy(g_EVKBackend->evkDevice.device, &g_EVKBackend->mipmapCompute);
     evk_pipeline_sprite_destroy(g_EVKBackend->pipelines, g_EVKBackend->evkDevice.device);
+    evk_pipeline_mesh_destroy(g_EVKBackend->pipelines, g_EVKBackend->evkDevice.device);
     shashtable_destroy(g_EVKBackend->pipelines);
 
     if (evk_using_viewport()) {
@@ -802,12 +1124,34 @@ void evk_shutdown_backend()
     evk_renderphase_picking_destroy(&g_EVKBackend->evkPickingRenderphase, g_EVKBackend->evkDevice.device);
     evk_renderphase_main_destroy(&g_EVKBackend->evkMainRenderphase, g_EVKBackend->evkDevice.device);
 
+    for (size_t i = 0; i < darray_size(g_EVKBackend->samplersList); i++) {
+        VkSampler sampler = VK_NULL_HANDLE;
+        darray_get(g_EVKBackend->samplersList, i, &sampler);
+        vkDestroySampler(g_EVKBackend->evkDevice.device, sampler, evk_get_vulkan_allocator());
+    }
+    darray_destroy(g_EVKBackend->samplersList);
+    shashtable_destroy(g_EVKBackend->samplers);
+
     ievk_sync_destroy(&g_EVKBackend->evkSync, g_EVKBackend->evkDevice.device);
     ievk_swapchain_destroy(&g_EVKBackend->evkSwapchain, g_EVKBackend->evkDevice.device);
     ievk_device_destroy(&g_EVKBackend->evkDevice);
     ievk_instance_destroy(&g_EVKBackend->evkInstance);
 
-    m_free(g_EVKBackend);
+    evk_handle_table_destroy(&g_EVKBackend->pipelineHandles);
+    evk_handle_table_destroy(&g_EVKBackend->bufferHandles);
+    evk_handle_table_destroy(&g_EVKBackend->textureHandles);
+    evk_pool_destroy(&g_EVKBufferPool);
+
+    EVK_FREE(g_EVKBackend);
+}
+
+/// @brief records what the application renders on it's callback followed by the packets of the draw queue
+static void ievk_render_objects(evkContext* context, float timestep)
+{
+    evkCallback_Render callback = evk_get_render_callback();
+    if (callback != NULL) callback(context, timestep);
+
+    evk_draw_queue_render();
 }
 
 void evk_update_backend(float timestep, bool* mustResize)
@@ -820,11 +1164,13 @@ void evk_update_backend(float timestep, bool* mustResize)
     mainCameraData.view = evk_camera_get_view(mainCamera);
     mainCameraData.viewInverse = evk_camera_get_view_inverse(mainCamera);
     mainCameraData.proj = evk_camera_get_perspective(mainCamera);
-    evkBuffer* buffer = (evkBuffer*)shashtable_lookup(evk_get_buffers_library(), "MainCamera");
+    evkBuffer* buffer = evk_buffer_library_get(g_EVKBackend->mainCameraBuffer);
     evk_buffer_copy(buffer, evk_get_current_frame(), &mainCameraData, sizeof(evkCameraUBO), 0);
 
     // second phase
     vkWaitForFences(g_EVKBackend->evkDevice.device, 1, & g_EVKBackend->evkSync.framesInFlightFences[g_EVKBackend->evkSync.currentFrame], VK_TRUE, UINT64_MAX);
+    evk_frame_arena_reset(&g_EVKBackend->frameArenas[g_EVKBackend->evkSync.currentFrame]);
+
     VkResult res = vkAcquireNextImageKHR(g_EVKBackend->evkDevice.device, g_EVKBackend->evkSwapchain.swapchain, UINT64_MAX, g_EVKBackend->evkSync.imageAvailableSemaphores[g_EVKBackend->evkSync.currentFrame], VK_NULL_HANDLE, &g_EVKBackend->evkSwapchain.imageIndex);
 
     if (res == VK_ERROR_OUT_OF_DATE_KHR)
@@ -840,21 +1186,52 @@ void evk_update_backend(float timestep, bool* mustResize)
     EVK_ASSERT(res == VK_SUCCESS || res == VK_SUBOPTIMAL_KHR, "Renderer update was not able to aquire an image from the swapchain");
     vkResetFences(g_EVKBackend->evkDevice.device, 1, &g_EVKBackend->evkSync.framesInFlightFences[g_EVKBackend->evkSync.currentFrame]);
 
+    // streamed textures and thumbnails change residency before any command buffer of the frame binds them
+    evk_texture_stream_update();
+    evk_thumbnail_cache_update();
+
+    // packets submitted from other threads are taken once, every renderphase draws the same sorted set
+    evk_draw_queue_drain();
+
     // render phases
     g_EVKBackend->currentRenderphase = evk_Renderphase_Type_Main;
-    evk_renderphase_main_update(&g_EVKBackend->evkMainRenderphase, g_EVKBackend->evkDevice.device, timestep, g_EVKBackend->evkSync.currentFrame, g_EVKBackend->evkSwapchain.extent, g_EVKBackend->evkSwapchain.imageIndex, evk_using_viewport(), evk_get_render_callback());
+    evk_renderphase_main_update(&g_EVKBackend->evkMainRenderphase, g_EVKBackend->evkDevice.device, timestep, g_EVKBackend->evkSync.currentFrame, g_EVKBackend->evkSwapchain.extent, g_EVKBackend->evkSwapchain.imageIndex, evk_using_viewport(), ievk_render_objects);
     
     g_EVKBackend->currentRenderphase = evk_Renderphase_Type_Picking;
-    evk_renderphase_picking_update(&g_EVKBackend->evkPickingRenderphase, g_EVKBackend->evkDevice.device, timestep, g_EVKBackend->evkSync.currentFrame, g_EVKBackend->evkSwapchain.extent, g_EVKBackend->evkSwapchain.imageIndex, evk_using_viewport(), evk_get_render_callback());
+    evk_renderphase_picking_update(&g_EVKBackend->evkPickingRenderphase, g_EVKBackend->evkDevice.device, timestep, g_EVKBackend->evkSync.currentFrame, g_EVKBackend->evkSwapchain.extent, g_EVKBackend->evkSwapchain.imageIndex, evk_using_viewport(), ievk_render_objects);
     
     if (evk_using_viewport()) {
         g_EVKBackend->currentRenderphase = evk_Renderphase_Type_Picking;
-        evk_renderphase_viewport_update(&g_EVKBackend->evkViewportRenderphase, g_EVKBackend->evkDevice.device, timestep, g_EVKBackend->evkSync.currentFrame, g_EVKBackend->evkSwapchain.extent, g_EVKBackend->evkSwapchain.imageIndex, evk_using_viewport(), evk_get_render_callback());
+        evk_renderphase_viewport_update(&g_EVKBackend->evkViewportRenderphase, g_EVKBackend->evkDevice.device, timestep, g_EVKBackend->evkSync.currentFrame, g_EVKBackend->evkSwapchain.extent, g_EVKBackend->evkSwapchain.imageIndex, evk_using_viewport(), ievk_render_objects);
     }
 
     g_EVKBackend->currentRenderphase = evk_Renderphase_Type_UI;
     evk_renderphase_ui_update(&g_EVKBackend->evkUIRenderphase, g_EVKBackend->evkDevice.device, timestep, g_EVKBackend->evkSync.currentFrame, g_EVKBackend->evkSwapchain.extent, g_EVKBackend->evkSwapchain.imageIndex, evk_get_renderui_callback());
 
+    // the ui renderphase records through it's own backend, only the phases drawing objects are counted
+    evkCommandRecorder* recorders[] = {
+        &g_EVKBackend->evkMainRenderphase.evkRenderpass.recorders[g_EVKBackend->evkSync.currentFrame],
+        &g_EVKBackend->evkPickingRenderphase.evkRenderpass.recorders[g_EVKBackend->evkSync.currentFrame],
+        &g_EVKBackend->evkViewportRenderphase.evkRenderpass.recorders[g_EVKBackend->evkSync.currentFrame]
+    };
+
+    memset(&g_EVKBackend->commandStats, 0, sizeof(evkCommandStats));
+    for (uint32_t i = 0; i < (evk_using_viewport() ? 3U : 2U); i++) {
+        const evkCommandStats* stats = &recorders[i]->stats;
+        g_EVKBackend->commandStats.pipelineBinds += stats->pipelineBinds;
+        g_EVKBackend->commandStats.pipelineSkips += stats->pipelineSkips;
+        g_EVKBackend->commandStats.descriptorBinds += stats->descriptorBinds;
+        g_EVKBackend->commandStats.descriptorSkips += stats->descriptorSkips;
+        g_EVKBackend->commandStats.pushConstants += stats->pushConstants;
+        g_EVKBackend->commandStats.pushConstantSkips += stats->pushConstantSkips;
+        g_EVKBackend->commandStats.viewports += stats->viewports;
+        g_EVKBackend->commandStats.viewportSkips += stats->viewportSkips;
+        g_EVKBackend->commandStats.scissors += stats->scissors;
+        g_EVKBackend->commandStats.scissorSkips += stats->scissorSkips;
+        g_EVKBackend->commandStats.bufferBinds += stats->bufferBinds;
+        g_EVKBackend->commandStats.bufferSkips += stats->bufferSkips;
+    }
+
     // submit command buffers
     VkSwapchainKHR swapChains[] = { g_EVKBackend->evkSwapchain.swapchain };
     VkSemaphore waitSemaphores[] = { g_EVKBackend->evkSync.imageAvailableSemaphores[g_EVKBackend->evkSync.currentFrame] };
@@ -943,7 +1320,7 @@ uint32_t evk_pick_object_backend(float2 xy)
     bufferCI.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
     bufferCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
-    res = vkCreateBuffer(g_EVKBackend->evkDevice.device, &bufferCI, NULL, &stagingBuffer);
+    res = vkCreateBuffer(g_EVKBackend->evkDevice.device, &bufferCI, evk_get_vulkan_allocator(), &stagingBuffer);
     if (res != VK_SUCCESS) {
         EVK_LOG(evk_Error, "Failed to create staging buffer for picking");
         return 0;
@@ -956,7 +1333,7 @@ uint32_t evk_pick_object_backend(float2 xy)
 
     uint32_t memType = evk_device_find_suitable_memory_type(g_EVKBackend->evkDevice.physicalDevice, memReq.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
     if (memType == UINT32_MAX) {
-        vkDestroyBuffer(g_EVKBackend->evkDevice.device, stagingBuffer, NULL);
+        vkDestroyBuffer(g_EVKBackend->evkDevice.device, stagingBuffer, evk_get_vulkan_allocator());
         EVK_LOG(evk_Error, "No suitable memory type for picking");
         return 0;
     }
@@ -966,17 +1343,17 @@ uint32_t evk_pick_object_backend(float2 xy)
     allocInfo.allocationSize = alignedSize;
     allocInfo.memoryTypeIndex = memType;
 
-    res = vkAllocateMemory(g_EVKBackend->evkDevice.device, &allocInfo, NULL, &stagingMemory);
+    res = vkAllocateMemory(g_EVKBackend->evkDevice.device, &allocInfo, evk_get_vulkan_allocator(), &stagingMemory);
     if (res != VK_SUCCESS) {
-        vkDestroyBuffer(g_EVKBackend->evkDevice.device, stagingBuffer, NULL);
+        vkDestroyBuffer(g_EVKBackend->evkDevice.device, stagingBuffer, evk_get_vulkan_allocator());
         EVK_LOG(evk_Error, "Failed to allocate memory for picking");
         return 0;
     }
 
     res = vkBindBufferMemory(g_EVKBackend->evkDevice.device, stagingBuffer, stagingMemory, 0);
     if (res != VK_SUCCESS) {
-        vkFreeMemory(g_EVKBackend->evkDevice.device, stagingMemory, NULL);
-        vkDestroyBuffer(g_EVKBackend->evkDevice.device, stagingBuffer, NULL);
+        vkFreeMemory(g_EVKBackend->evkDevice.device, stagingMemory, evk_get_vulkan_allocator());
+        vkDestroyBuffer(g_EVKBackend->evkDevice.device, stagingBuffer, evk_get_vulkan_allocator());
         EVK_LOG(evk_Error, "Failed to bind buffer memory for picking");
         return 0;
     }
@@ -989,8 +1366,8 @@ uint32_t evk_pick_object_backend(float2 xy)
 
     res = vkAllocateCommandBuffers(g_EVKBackend->evkDevice.device, &cmdAlloc, &cmdBuffer);
     if (res != VK_SUCCESS) {
-        vkFreeMemory(g_EVKBackend->evkDevice.device, stagingMemory, NULL);
-        vkDestroyBuffer(g_EVKBackend->evkDevice.device, stagingBuffer, NULL);
+        vkFreeMemory(g_EVKBackend->evkDevice.device, stagingMemory, evk_get_vulkan_allocator());
+        vkDestroyBuffer(g_EVKBackend->evkDevice.device, stagingBuffer, evk_get_vulkan_allocator());
         EVK_LOG(evk_Error, "Failed to allocate command buffer for picking");
         return 0;
     }
@@ -1001,8 +1378,8 @@ uint32_t evk_pick_object_backend(float2 xy)
 
     res = vkBeginCommandBuffer(cmdBuffer, &beginInfo);
     if (res != VK_SUCCESS) {
-        vkFreeMemory(g_EVKBackend->evkDevice.device, stagingMemory, NULL);
-        vkDestroyBuffer(g_EVKBackend->evkDevice.device, stagingBuffer, NULL);
+        vkFreeMemory(g_EVKBackend->evkDevice.device, stagingMemory, evk_get_vulkan_allocator());
+        vkDestroyBuffer(g_EVKBackend->evkDevice.device, stagingBuffer, evk_get_vulkan_allocator());
         vkFreeCommandBuffers(g_EVKBackend->evkDevice.device, g_EVKBackend->evkPickingRenderphase.evkRenderpass.cmdPool, 1, &cmdBuffer);
         EVK_LOG(evk_Error, "Failed to begin command buffer for picking");
         return 0;
@@ -1054,8 +1431,8 @@ uint32_t evk_pick_object_backend(float2 xy)
 
     res = vkEndCommandBuffer(cmdBuffer);
     if (res != VK_SUCCESS) {
-        vkFreeMemory(g_EVKBackend->evkDevice.device, stagingMemory, NULL);
-        vkDestroyBuffer(g_EVKBackend->evkDevice.device, stagingBuffer, NULL);
+        vkFreeMemory(g_EVKBackend->evkDevice.device, stagingMemory, evk_get_vulkan_allocator());
+        vkDestroyBuffer(g_EVKBackend->evkDevice.device, stagingBuffer, evk_get_vulkan_allocator());
         vkFreeCommandBuffers(g_EVKBackend->evkDevice.device, g_EVKBackend->evkPickingRenderphase.evkRenderpass.cmdPool, 1, & cmdBuffer);
         EVK_LOG(evk_Error, "Failed to end command buffer for picking");
         return 0;
@@ -1063,10 +1440,10 @@ uint32_t evk_pick_object_backend(float2 xy)
 
     VkFenceCreateInfo fenceCI = { 0 };
     fenceCI.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-    res = vkCreateFence(g_EVKBackend->evkDevice.device, &fenceCI, NULL, &fence);
+    res = vkCreateFence(g_EVKBackend->evkDevice.device, &fenceCI, evk_get_vulkan_allocator(), &fence);
     if (res != VK_SUCCESS) {
-        vkFreeMemory(g_EVKBackend->evkDevice.device, stagingMemory, NULL);
-        vkDestroyBuffer(g_EVKBackend->evkDevice.device, stagingBuffer, NULL);
+        vkFreeMemory(g_EVKBackend->evkDevice.device, stagingMemory, evk_get_vulkan_allocator());
+        vkDestroyBuffer(g_EVKBackend->evkDevice.device, stagingBuffer, evk_get_vulkan_allocator());
         vkFreeCommandBuffers(g_EVKBackend->evkDevice.device, g_EVKBackend->evkPickingRenderphase.evkRenderpass.cmdPool, 1, &cmdBuffer);
         EVK_LOG(evk_Error, "Failed to create fence for picking");
         return 0;
@@ -1079,20 +1456,20 @@ uint32_t evk_pick_object_backend(float2 xy)
 
     res = vkQueueSubmit(g_EVKBackend->evkDevice.graphicsQueue, 1, &submit, fence);
     if (res != VK_SUCCESS) {
-        vkDestroyFence(g_EVKBackend->evkDevice.device, fence, NULL);
-        vkFreeMemory(g_EVKBackend->evkDevice.device, stagingMemory, NULL);
-        vkDestroyBuffer(g_EVKBackend->evkDevice.device, stagingBuffer, NULL);
+        vkDestroyFence(g_EVKBackend->evkDevice.device, fence, evk_get_vulkan_allocator());
+        vkFreeMemory(g_EVKBackend->evkDevice.device, stagingMemory, evk_get_vulkan_allocator());
+        vkDestroyBuffer(g_EVKBackend->evkDevice.device, stagingBuffer, evk_get_vulkan_allocator());
         vkFreeCommandBuffers(g_EVKBackend->evkDevice.device, g_EVKBackend->evkPickingRenderphase.evkRenderpass.cmdPool, 1, &cmdBuffer);
         EVK_LOG(evk_Error, "Failed to submit picking command buffer");
         return 0;
     }
 
     res = vkWaitForFences(g_EVKBackend->evkDevice.device, 1, &fence, VK_TRUE, UINT64_MAX);
-    vkDestroyFence(g_EVKBackend->evkDevice.device, fence, NULL);
+    vkDestroyFence(g_EVKBackend->evkDevice.device, fence, evk_get_vulkan_allocator());
 
     if (res != VK_SUCCESS) {
-        vkFreeMemory(g_EVKBackend->evkDevice.device, stagingMemory, NULL);
-        vkDestroyBuffer(g_EVKBackend->evkDevice.device, stagingBuffer, NULL);
+        vkFreeMemory(g_EVKBackend->evkDevice.device, stagingMemory, evk_get_vulkan_allocator());
+        vkDestroyBuffer(g_EVKBackend->evkDevice.device, stagingBuffer, evk_get_vulkan_allocator());
         vkFreeCommandBuffers(g_EVKBackend->evkDevice.device, g_EVKBackend->evkPickingRenderphase.evkRenderpass.cmdPool, 1, &cmdBuffer);
         EVK_LOG(evk_Error, "Failed to wait for picking fence");
         return 0;
@@ -1115,8 +1492,8 @@ uint32_t evk_pick_object_backend(float2 xy)
     }
 
     vkFreeCommandBuffers(g_EVKBackend->evkDevice.device, g_EVKBackend->evkPickingRenderphase.evkRenderpass.cmdPool, 1, &cmdBuffer);
-    vkFreeMemory(g_EVKBackend->evkDevice.device, stagingMemory, NULL);
-    vkDestroyBuffer(g_EVKBackend->evkDevice.device, stagingBuffer, NULL);
+    vkFreeMemory(g_EVKBackend->evkDevice.device, stagingMemory, evk_get_vulkan_allocator());
+    vkDestroyBuffer(g_EVKBackend->evkDevice.device, stagingBuffer, evk_get_vulkan_allocator());
 
     return pixelValue;
 }
@@ -1130,6 +1507,16 @@ VkInstance evk_get_instance()
     return g_EVKBackend->evkInstance.instance;
 }
 
+const VkAllocationCallbacks* evk_get_vulkan_allocator()
+{
+    return &g_EVKVulkanAllocator;
+}
+
+const ctoolbox_memfuncs* evk_get_container_memfuncs()
+{
+    return &g_EVKContainerMemfuncs;
+}
+
 VkPhysicalDevice evk_get_physical_device()
 {
     return g_EVKBackend->evkDevice.physicalDevice;
@@ -1228,6 +1615,21 @@ shashtable* evk_get_pipelines_library()
     return g_EVKBackend->pipelines;
 }
 
+evkHandleTable* evk_get_pipeline_handles()
+{
+    return &g_EVKBackend->pipelineHandles;
+}
+
+evkHandleTable* evk_get_texture_handles()
+{
+    return &g_EVKBackend->textureHandles;
+}
+
+evkBufferHandle evk_get_main_camera_buffer()
+{
+    return g_EVKBackend->mainCameraBuffer;
+}
+
 shashtable* evk_get_buffers_library()
 {
     return g_EVKBackend->buffers;
@@ -1243,6 +1645,395 @@ evkRenderphaseType evk_get_current_renderphase_type()
     return g_EVKBackend->currentRenderphase;
 }
 
+evkCommandStats evk_get_frame_command_stats()
+{
+    return g_EVKBackend->commandStats;
+}
+
+evkPoolStats evk_get_buffer_pool_stats()
+{
+    return evk_pool_get_stats(&g_EVKBufferPool);
+}
+
+evkFrameArena* evk_get_frame_arena()
+{
+    return &g_EVKBackend->frameArenas[g_EVKBackend->evkSync.currentFrame];
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Handles
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void evk_handle_table_init(evkHandleTable* table)
+{
+    memset(table, 0, sizeof(evkHandleTable));
+    table->freeHead = UINT32_MAX;
+}
+
+void evk_handle_table_destroy(evkHandleTable* table)
+{
+    if (table->slots != NULL) EVK_FREE(table->slots);
+    evk_handle_table_init(table);
+}
+
+uint32_t evk_handle_table_insert(evkHandleTable* table, void* object)
+{
+    uint32_t index = table->freeHead;
+
+    if (index != UINT32_MAX) {
+        table->freeHead = table->slots[index].nextFree;
+    }
+    else {
+        if (table->used == table->capacity) {
+            uint32_t capacity = table->capacity == 0 ? 64 : table->capacity * 2;
+            if (capacity > (1U << EVK_HANDLE_INDEX_BITS)) capacity = 1U << EVK_HANDLE_INDEX_BITS;
+
+            if (capacity == table->capacity) {
+                EVK_LOG(evk_Error, "Handle table is out of indices");
+                return 0;
+            }
+
+            evkHandleSlot* slots = (evkHandleSlot*)EVK_REALLOC(evk_Allocation_Tag_Core, table->slots, sizeof(evkHandleSlot) * capacity);
+            if (slots == NULL) {
+                EVK_LOG(evk_Error, "Failed to grow a handle table to %u slots", capacity);
+                return 0;
+            }
+
+            table->slots = slots;
+            table->capacity = capacity;
+        }
+
+        index = table->used++;
+        table->slots[index].generation = 1;
+    }
+
+    table->slots[index].object = object;
+    table->slots[index].nextFree = UINT32_MAX;
+    table->count++;
+
+    return (table->slots[index].generation << EVK_HANDLE_INDEX_BITS) | index;
+}
+
+void* evk_handle_table_get(const evkHandleTable* table, uint32_t handle)
+{
+    uint32_t index = handle & ((1U << EVK_HANDLE_INDEX_BITS) - 1);
+    if (handle == 0 || index >= table->used) return NULL;
+
+    const evkHandleSlot* slot = &table->slots[index];
+    return slot->generation == (handle >> EVK_HANDLE_INDEX_BITS) ? slot->object : NULL;
+}
+
+void evk_handle_table_remove(evkHandleTable* table, uint32_t handle)
+{
+    if (evk_handle_table_get(table, handle) == NULL) return;
+
+    // generations wrap within the bits left by the index, skipping 0 so no handle ever equals 0
+    uint32_t index = handle & ((1U << EVK_HANDLE_INDEX_BITS) - 1);
+    evkHandleSlot* slot = &table->slots[index];
+    slot->generation = (slot->generation + 1) & ((1U << (32 - EVK_HANDLE_INDEX_BITS)) - 1);
+    if (slot->generation == 0) slot->generation = 1;
+
+    slot->object = NULL;
+    slot->nextFree = table->freeHead;
+    table->freeHead = index;
+    table->count--;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Frame Arena
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+evkResult evk_frame_arena_create(evkFrameArena* arena, uint64_t capacity)
+{
+    memset(arena, 0, sizeof(evkFrameArena));
+    arena->capacity = capacity == 0 ? EVK_FRAME_ARENA_DEFAULT_SIZE : capacity;
+    arena->base = (uint8_t*)EVK_MALLOC(evk_Allocation_Tag_Core, (size_t)arena->capacity);
+
+    if (arena->base == NULL) {
+        EVK_LOG(evk_Error, "Failed to allocate a frame arena of %llu bytes", (unsigned long long)arena->capacity);
+        arena->capacity = 0;
+        return evk_Failure;
+    }
+
+    arena->stats.capacity = arena->capacity;
+    return evk_Success;
+}
+
+void evk_frame_arena_destroy(evkFrameArena* arena)
+{
+    evk_frame_arena_reset(arena);
+    if (arena->base != NULL) EVK_FREE(arena->base);
+    memset(arena, 0, sizeof(evkFrameArena));
+}
+
+void evk_frame_arena_reset(evkFrameArena* arena)
+{
+    while (arena->overflow != NULL) {
+        void* next = *(void**)arena->overflow;
+        EVK_FREE(arena->overflow);
+        arena->overflow = next;
+    }
+
+    // the contents are discarded anyway, so growing is a fresh allocation instead of a copy
+    uint64_t frameUsed = arena->offset + arena->overflowUsed;
+    if (arena->overflowUsed > 0) {
+        uint64_t capacity = arena->capacity == 0 ? EVK_FRAME_ARENA_DEFAULT_SIZE : arena->capacity;
+        while (capacity < frameUsed) capacity *= 2;
+
+        uint8_t* base = (uint8_t*)EVK_MALLOC(evk_Allocation_Tag_Core, (size_t)capacity);
+        if (base != NULL) {
+            if (arena->base != NULL) EVK_FREE(arena->base);
+            arena->base = base;
+            arena->capacity = capacity;
+            arena->stats.capacity = capacity;
+            arena->stats.growCount++;
+        }
+    }
+
+    arena->offset = 0;
+    arena->overflowUsed = 0;
+    arena->stats.used = 0;
+}
+
+void* evk_frame_arena_alloc(evkFrameArena* arena, uint64_t size, uint64_t alignment)
+{
+    if (arena == NULL || size == 0) return NULL;
+    if (alignment == 0) alignment = 16;
+
+    uintptr_t address = ((uintptr_t)arena->base + (uintptr_t)arena->offset + (uintptr_t)(alignment - 1)) & ~(uintptr_t)(alignment - 1);
+    uint64_t end = (uint64_t)(address - (uintptr_t)arena->base) + size;
+
+    if (arena->base != NULL && end <= arena->capacity) {
+        arena->offset = end;
+    }
+    else {
+        // the block keeps the previous overflow on it's first pointer, the user memory starts aligned after it
+        uint8_t* block = (uint8_t*)EVK_MALLOC(evk_Allocation_Tag_Core, (size_t)(sizeof(void*) + alignment + size));
+        if (block == NULL) {
+            EVK_LOG(evk_Error, "Frame arena failed to overflow %llu bytes into the heap", (unsigned long long)size);
+            return NULL;
+        }
+
+        *(void**)block = arena->overflow;
+        arena->overflow = block;
+        address = ((uintptr_t)block + sizeof(void*) + (uintptr_t)(alignment - 1)) & ~(uintptr_t)(alignment - 1);
+
+        arena->overflowUsed += size;
+        arena->stats.overflowBytes += size;
+        arena->stats.overflowCount++;
+    }
+
+    arena->stats.used = arena->offset + arena->overflowUsed;
+    if (arena->stats.used > arena->stats.highWater) arena->stats.highWater = arena->stats.used;
+
+    return (void*)address;
+}
+
+evkFrameArenaStats evk_frame_arena_get_stats(const evkFrameArena* arena)
+{
+    return arena->stats;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Pools
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief bytes before each pooled object, holding it's slot index while keeping the heap's 16 byte alignment
+#define EVK_POOL_SLOT_HEADER 16
+
+/// @brief returns the slot of an index, it's header comes first and the object after it
+static uint8_t* ievk_pool_slot(const evkPool* pool, uint32_t index)
+{
+    return pool->chunks[index / EVK_POOL_CHUNK_OBJECTS] + (size_t)(index % EVK_POOL_CHUNK_OBJECTS) * pool->stride;
+}
+
+/// @brief index of the lowest set bit, value must not be 0
+static uint32_t ievk_pool_ctz64(uint64_t value)
+{
+    #if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctzll(value);
+    #else
+    uint32_t index = 0;
+    while (!(value & 1ULL)) { value >>= 1; index++; }
+    return index;
+    #endif
+}
+
+/// @brief returns the position in sorted of the last chunk starting at or before address, UINT32_MAX when every chunk starts after it
+static uint32_t ievk_pool_find_chunk(const evkPool* pool, const uint8_t* address)
+{
+    if (pool->chunkCount == 0 || (uintptr_t)pool->sorted[0] > (uintptr_t)address) return UINT32_MAX;
+
+    // branchless halving, frees land on random chunks and a predicted branch would miss half the time
+    uint32_t first = 0;
+    uint32_t count = pool->chunkCount;
+    while (count > 1) {
+        uint32_t half = count / 2;
+        first = (uintptr_t)pool->sorted[first + half] <= (uintptr_t)address ? first + half : first;
+        count -= half;
+    }
+    return first;
+}
+
+/// @brief adds a chunk, growing the chunk list and live bits when they are full
+static bool ievk_pool_grow(evkPool* pool)
+{
+    if (pool->chunkCount == pool->chunkCapacity) {
+        uint32_t capacity = pool->chunkCapacity == 0 ? 8 : pool->chunkCapacity * 2;
+        uint32_t wordsPerChunk = EVK_POOL_CHUNK_OBJECTS / 64;
+
+        uint8_t** chunks = (uint8_t**)EVK_REALLOC(pool->tag, pool->chunks, sizeof(uint8_t*) * capacity);
+        if (chunks == NULL) return false;
+        pool->chunks = chunks;
+
+        uint8_t** sorted = (uint8_t**)EVK_REALLOC(pool->tag, pool->sorted, sizeof(uint8_t*) * capacity);
+        if (sorted == NULL) return false;
+        pool->sorted = sorted;
+
+        uint64_t* live = (uint64_t*)EVK_REALLOC(pool->tag, pool->live, sizeof(uint64_t) * wordsPerChunk * capacity);
+        if (live == NULL) return false;
+        memset(live + wordsPerChunk * pool->chunkCapacity, 0, sizeof(uint64_t) * wordsPerChunk * (capacity - pool->chunkCapacity));
+        pool->live = live;
+
+        pool->chunkCapacity = capacity;
+    }
+
+    uint8_t* chunk = (uint8_t*)EVK_MALLOC(pool->tag, (size_t)pool->stride * EVK_POOL_CHUNK_OBJECTS);
+    if (chunk == NULL) return false;
+
+    // growth is rare, keeping the address order here lets every free find it's chunk with a binary search
+    uint32_t position = ievk_pool_find_chunk(pool, chunk) + 1;
+    memmove(pool->sorted + position + 1, pool->sorted + position, sizeof(uint8_t*) * (pool->chunkCount - position));
+    pool->sorted[position] = chunk;
+
+    pool->chunks[pool->chunkCount++] = chunk;
+    pool->stats.chunks = pool->chunkCount;
+    pool->stats.capacity = pool->chunkCount * EVK_POOL_CHUNK_OBJECTS;
+    return true;
+}
+
+void evk_pool_init(evkPool* pool, uint32_t objectSize, evkAllocationTag tag)
+{
+    memset(pool, 0, sizeof(evkPool));
+
+    // a released slot stores the next free index where the object was, so it holds at least that
+    uint32_t size = objectSize < sizeof(uint32_t) ? (uint32_t)sizeof(uint32_t) : objectSize;
+    pool->stride = EVK_POOL_SLOT_HEADER + ((size + 15U) & ~15U);
+    pool->freeHead = UINT32_MAX;
+    pool->tag = tag;
+    pool->stats.objectSize = objectSize;
+}
+
+void evk_pool_destroy(evkPool* pool)
+{
+    if (pool->stats.live > 0) {
+        EVK_LOG(evk_Warn, "Pool of %u byte objects destroyed with %u objects alive", pool->stats.objectSize, pool->stats.live);
+    }
+
+    for (uint32_t i = 0; i < pool->chunkCount; i++) {
+        EVK_FREE(pool->chunks[i]);
+    }
+
+    if (pool->chunks != NULL) EVK_FREE(pool->chunks);
+    if (pool->sorted != NULL) EVK_FREE(pool->sorted);
+    if (pool->live != NULL) EVK_FREE(pool->live);
+    memset(pool, 0, sizeof(evkPool));
+}
+
+void* evk_pool_alloc(evkPool* pool)
+{
+    uint32_t index = pool->freeHead;
+
+    if (index != UINT32_MAX) {
+        memcpy(&pool->freeHead, ievk_pool_slot(pool, index) + EVK_POOL_SLOT_HEADER, sizeof(uint32_t));
+    }
+    else {
+        if (pool->used == pool->chunkCount * EVK_POOL_CHUNK_OBJECTS && !ievk_pool_grow(pool)) {
+            EVK_LOG(evk_Error, "Failed to grow a pool of %u byte objects past %u objects", pool->stats.objectSize, pool->used);
+            return NULL;
+        }
+
+        index = pool->used++;
+    }
+
+    uint8_t* slot = ievk_pool_slot(pool, index);
+    memcpy(slot, &index, sizeof(uint32_t));
+    memset(slot + EVK_POOL_SLOT_HEADER, 0, pool->stride - EVK_POOL_SLOT_HEADER);
+    pool->live[index / 64] |= 1ULL << (index % 64);
+
+    pool->stats.allocations++;
+    pool->stats.live++;
+    if (pool->stats.live > pool->stats.peak) pool->stats.peak = pool->stats.live;
+
+    return slot + EVK_POOL_SLOT_HEADER;
+}
+
+void evk_pool_free(evkPool* pool, void* object)
+{
+    if (object == NULL) return;
+
+    // the slot must lie on a slot boundary of one of our chunks before it's header is read
+    uint8_t* slot = (uint8_t*)object - EVK_POOL_SLOT_HEADER;
+    uint32_t position = ievk_pool_find_chunk(pool, slot);
+    uintptr_t distance = position == UINT32_MAX ? UINTPTR_MAX : (uintptr_t)slot - (uintptr_t)pool->sorted[position];
+    if (distance >= (uintptr_t)pool->stride * EVK_POOL_CHUNK_OBJECTS || distance % pool->stride != 0) {
+        EVK_LOG(evk_Error, "Object %p does not belong to the pool", object);
+        return;
+    }
+
+    // the header is only trusted once it points back to the same slot and that slot is alive
+    uint32_t index = UINT32_MAX;
+    memcpy(&index, slot, sizeof(uint32_t));
+    if (index >= pool->used || ievk_pool_slot(pool, index) != slot || !(pool->live[index / 64] & (1ULL << (index % 64)))) {
+        EVK_LOG(evk_Error, "Object %p does not belong to the pool or was already released", object);
+        return;
+    }
+
+    pool->live[index / 64] &= ~(1ULL << (index % 64));
+    memcpy(slot + EVK_POOL_SLOT_HEADER, &pool->freeHead, sizeof(uint32_t));
+    pool->freeHead = index;
+
+    pool->stats.frees++;
+    pool->stats.live--;
+}
+
+void* evk_pool_next(const evkPool* pool, uint32_t* cursor)
+{
+    void* object = NULL;
+    return evk_pool_next_batch(pool, cursor, &object, 1) == 1 ? object : NULL;
+}
+
+uint32_t evk_pool_next_batch(const evkPool* pool, uint32_t* cursor, void** objects, uint32_t capacity)
+{
+    const uint32_t wordsPerChunk = EVK_POOL_CHUNK_OBJECTS / 64;
+    const uint32_t wordCount = (pool->used + 63) / 64;
+    uint32_t count = 0;
+    uint32_t word = *cursor / 64;
+    uint64_t bits = word < wordCount ? pool->live[word] & (~0ULL << (*cursor % 64)) : 0;
+
+    // a live word never straddles chunks, so it's slots are reached from one base by the stride and released words are skipped whole
+    while (word < wordCount && count < capacity) {
+        const uint8_t* base = pool->chunks[word / wordsPerChunk] + (size_t)(word % wordsPerChunk) * 64 * pool->stride + EVK_POOL_SLOT_HEADER;
+        while (bits != 0 && count < capacity) {
+            uint32_t bit = ievk_pool_ctz64(bits);
+            objects[count++] = (void*)(base + (size_t)bit * pool->stride);
+            bits &= bits - 1;
+            *cursor = word * 64 + bit + 1;
+        }
+
+        if (bits != 0) break;
+        if (++word < wordCount) bits = pool->live[word];
+    }
+
+    if (count == 0) *cursor = pool->used;
+    return count;
+}
+
+evkPoolStats evk_pool_get_stats(const evkPool* pool)
+{
+    return pool->stats;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Device
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1257,7 +2048,7 @@ evkQueueFamily evk_device_find_queue_families(VkPhysicalDevice device, VkSurface
     uint32_t queue_family_count = 0;
     vkGetPhysicalDeviceQueueFamilyProperties(device, &queue_family_count, NULL);
 
-    VkQueueFamilyProperties* queue_families = (VkQueueFamilyProperties*)m_malloc(queue_family_count * sizeof(VkQueueFamilyProperties));
+    VkQueueFamilyProperties* queue_families = (VkQueueFamilyProperties*)EVK_MALLOC(evk_Allocation_Tag_Core, queue_family_count * sizeof(VkQueueFamilyProperties));
     vkGetPhysicalDeviceQueueFamilyProperties(device, &queue_family_count, queue_families);
 
     for (uint32_t i = 0; i < queue_family_count; i++) {
@@ -1281,7 +2072,7 @@ evkQueueFamily evk_device_find_queue_families(VkPhysicalDevice device, VkSurface
         if (indices.graphicsFound && indices.presentFound && indices.computeFound) break;
     }
 
-    m_free(queue_families);
+    EVK_FREE(queue_families);
     return indices;
 }
 
@@ -1303,7 +2094,7 @@ evkResult evk_device_create_image(VkExtent2D size, uint32_t mipLevels, uint32_t
     imageCI.samples = (VkSampleCountFlagBits)samples;
     imageCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
-    if (vkCreateImage(device, &imageCI, NULL, image) != VK_SUCCESS) {
+    if (vkCreateImage(device, &imageCI, evk_get_vulkan_allocator(), image) != VK_SUCCESS) {
         EVK_LOG(evk_Error, "Failed to create device image, check vulkan validations for a more detailed explanation");
         return evk_Failure;
     }
@@ -1316,7 +2107,7 @@ evkResult evk_device_create_image(VkExtent2D size, uint32_t mipLevels, uint32_t
     allocInfo.allocationSize = memRequirements.size;
     allocInfo.memoryTypeIndex = evk_device_find_suitable_memory_type(physicalDevice, memRequirements.memoryTypeBits, memoryProperties);
 
-    if (vkAllocateMemory(device, &allocInfo, NULL, memory) != VK_SUCCESS) {
+    if (vkAllocateMemory(device, &allocInfo, evk_get_vulkan_allocator(), memory) != VK_SUCCESS) {
         EVK_LOG(evk_Error, "Failed to allocate memory for the device image, check vulkan validations for a more detailed explanation");
         return evk_Failure;
     }
@@ -1356,7 +2147,7 @@ evkResult evk_device_create_image_view(VkDevice device, VkImage image, VkFormat
         imageViewCI.components = *swizzle;
     }
 
-    if (vkCreateImageView(device, &imageViewCI, NULL, outView) != VK_SUCCESS) {
+    if (vkCreateImageView(device, &imageViewCI, evk_get_vulkan_allocator(), outView) != VK_SUCCESS) {
         EVK_LOG(evk_Error, "Failed to create image view");
         return evk_Failure;
     }
@@ -1387,7 +2178,7 @@ evkResult evk_device_create_image_sampler(VkDevice device, VkPhysicalDevice phys
     samplerCI.compareOp = VK_COMPARE_OP_ALWAYS;
     samplerCI.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
 
-    if (vkCreateSampler(device, &samplerCI, NULL, outSampler) != VK_SUCCESS) {
+    if (vkCreateSampler(device, &samplerCI, evk_get_vulkan_allocator(), outSampler) != VK_SUCCESS) {
         EVK_LOG(evk_Error, "Failed to create image sampler");
         return evk_Failure;
     }
@@ -1424,7 +2215,7 @@ evkResult evk_device_create_image_descriptor_set(VkDevice device, VkDescriptorPo
     return evk_Success;
 }
 
-void evk_device_create_image_mipmaps(VkDevice device, VkQueue queue, VkCommandBuffer cmdBuffer, int32_t width, int32_t height, int32_t mipLevels, VkImage image)
+void evk_device_create_image_mipmaps(VkDevice device, VkQueue queue, VkCommandBuffer cmdBuffer, int32_t width, int32_t height, int32_t mipLevels, uint32_t layerCount, VkImage image)
 {
     if (mipLevels <= 1) return;
 
@@ -1435,7 +2226,7 @@ void evk_device_create_image_mipmaps(VkDevice device, VkQueue queue, VkCommandBu
     barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     barrier.subresourceRange.baseArrayLayer = 0;
-    barrier.subresourceRange.layerCount = 1;
+    barrier.subresourceRange.layerCount = layerCount;
     barrier.subresourceRange.levelCount = 1;
 
     int32_t mipWidth = width;
@@ -1456,14 +2247,14 @@ void evk_device_create_image_mipmaps(VkDevice device, VkQueue queue, VkCommandBu
         blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
         blit.srcSubresource.mipLevel = i - 1;
         blit.srcSubresource.baseArrayLayer = 0;
-        blit.srcSubresource.layerCount = 1;
+        blit.srcSubresource.layerCount = layerCount;
         blit.srcOffsets[1].x = mipWidth;
         blit.srcOffsets[1].y = mipHeight;
         blit.srcOffsets[1].z = 1;
         blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
         blit.dstSubresource.mipLevel = i;
         blit.dstSubresource.baseArrayLayer = 0;
-        blit.dstSubresource.layerCount = 1;
+        blit.dstSubresource.layerCount = layerCount;
         blit.dstOffsets[1].x = mipWidth > 1 ? mipWidth / 2 : 1;
         blit.dstOffsets[1].y = mipHeight > 1 ? mipHeight / 2 : 1;
         blit.dstOffsets[1].z = 1;
@@ -1489,6 +2280,330 @@ void evk_device_create_image_mipmaps(VkDevice device, VkQueue queue, VkCommandBu
     vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, NULL, 0, NULL, 1, &barrier);
 }
 
+evkResult evk_device_create_mipmap_compute(const uint32_t* spirv, size_t spirvSize)
+{
+    if (!g_EVKBackend || !spirv || spirvSize == 0) return evk_Failure;
+
+    VkDevice device = g_EVKBackend->evkDevice.device;
+    evkMipmapCompute* compute = &g_EVKBackend->mipmapCompute;
+    if (compute->pipeline != VK_NULL_HANDLE) return evk_Success;
+
+    // the dispatch is recorded on the graphics command buffers, so that family must also accept compute work
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(g_EVKBackend->evkDevice.physicalDevice, &familyCount, NULL);
+    VkQueueFamilyProperties* families = (VkQueueFamilyProperties*)EVK_MALLOC(evk_Allocation_Tag_Core, sizeof(VkQueueFamilyProperties) * familyCount);
+    if (!families) return evk_Failure;
+
+    vkGetPhysicalDeviceQueueFamilyProperties(g_EVKBackend->evkDevice.physicalDevice, &familyCount, families);
+    bool graphicsCompute = (families[g_EVKBackend->evkDevice.graphicsIndex].queueFlags & VK_QUEUE_COMPUTE_BIT) != 0;
+    EVK_FREE(families);
+
+    if (!graphicsCompute) {
+        EVK_LOG(evk_Warn, "Graphics queue doesn't support compute, mipmaps will be blitted");
+        return evk_Failure;
+    }
+
+    bool success = false;
+
+    do
+    {
+        VkShaderModuleCreateInfo moduleCI = { 0 };
+        moduleCI.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        moduleCI.codeSize = spirvSize * sizeof(uint32_t);
+        moduleCI.pCode = spirv;
+        if (vkCreateShaderModule(device, &moduleCI, evk_get_vulkan_allocator(), &compute->shader) != VK_SUCCESS) {
+            EVK_LOG(evk_Error, "Failed to create mipmap compute shader module");
+            break;
+        }
+
+        VkDescriptorSetLayoutBinding bindings[3] = { 0 };
+        // level 0
+        bindings[0].binding = 0;
+        bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        bindings[0].descriptorCount = 1;
+        bindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        // levels 1 to n
+        bindings[1].binding = 1;
+        bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        bindings[1].descriptorCount = EVK_COMPUTE_MIPMAP_MAX_LEVELS;
+        bindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        // workgroup counters
+        bindings[2].binding = 2;
+        bindings[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[2].descriptorCount = 1;
+        bindings[2].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+        VkDescriptorSetLayoutCreateInfo layoutCI = { 0 };
+        layoutCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutCI.bindingCount = 3;
+        layoutCI.pBindings = bindings;
+        if (vkCreateDescriptorSetLayout(device, &layoutCI, evk_get_vulkan_allocator(), &compute->descriptorSetLayout) != VK_SUCCESS) {
+            EVK_LOG(evk_Error, "Failed to create mipmap compute descriptor set layout");
+            break;
+        }
+
+        VkPushConstantRange pushConstant = { 0 };
+        pushConstant.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstant.offset = 0;
+        pushConstant.size = sizeof(uint32_t) * 3;
+
+        VkPipelineLayoutCreateInfo pipelineLayoutCI = { 0 };
+        pipelineLayoutCI.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutCI.setLayoutCount = 1;
+        pipelineLayoutCI.pSetLayouts = &compute->descriptorSetLayout;
+        pipelineLayoutCI.pushConstantRangeCount = 1;
+        pipelineLayoutCI.pPushConstantRanges = &pushConstant;
+        if (vkCreatePipelineLayout(device, &pipelineLayoutCI, evk_get_vulkan_allocator(), &compute->pipelineLayout) != VK_SUCCESS) {
+            EVK_LOG(evk_Error, "Failed to create mipmap compute pipeline layout");
+            break;
+        }
+
+        VkComputePipelineCreateInfo pipelineCI = { 0 };
+        pipelineCI.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineCI.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        pipelineCI.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        pipelineCI.stage.module = compute->shader;
+        pipelineCI.stage.pName = "main";
+        pipelineCI.layout = compute->pipelineLayout;
+        if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineCI, evk_get_vulkan_allocator(), &compute->pipeline) != VK_SUCCESS) {
+            EVK_LOG(evk_Error, "Failed to create mipmap compute pipeline");
+            break;
+        }
+
+        compute->transients = darray_init_memfuncs(sizeof(evkMipmapComputeTransient), 4, &g_EVKContainerMemfuncs);
+        if (!compute->transients) break;
+
+        success = true;
+    } while (0);
+
+    if (!success) {
+        ievk_mipmap_compute_destroy(device, compute);
+        return evk_Failure;
+    }
+
+    return evk_Success;
+}
+
+bool evk_device_can_compute_image_mipmaps(VkFormat format, int32_t mipLevels)
+{
+    if (!g_EVKBackend || g_EVKBackend->mipmapCompute.pipeline == VK_NULL_HANDLE) return false;
+    if (mipLevels <= 1 || mipLevels - 1 > EVK_COMPUTE_MIPMAP_MAX_LEVELS) return false;
+
+    // levels are written through a rgba8 unorm image, srgb is encoded by the shader
+    if (format != VK_FORMAT_R8G8B8A8_SRGB && format != VK_FORMAT_R8G8B8A8_UNORM) return false;
+
+    VkFormatProperties props;
+    vkGetPhysicalDeviceFormatProperties(g_EVKBackend->evkDevice.physicalDevice, VK_FORMAT_R8G8B8A8_UNORM, &props);
+    return (props.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT) != 0;
+}
+
+evkResult evk_device_create_image_mipmaps_compute(VkDevice device, VkCommandBuffer cmdBuffer, int32_t width, int32_t height, int32_t mipLevels, uint32_t layerCount, VkFormat format, VkImage image)
+{
+    if (!evk_device_can_compute_image_mipmaps(format, mipLevels)) return evk_Failure;
+
+    evkMipmapCompute* compute = &g_EVKBackend->mipmapCompute;
+    VkPhysicalDevice physicalDevice = g_EVKBackend->evkDevice.physicalDevice;
+    const uint32_t levels = (uint32_t)mipLevels - 1;
+    const VkExtent2D firstExtent = { width > 1 ? (uint32_t)width / 2 : 1, height > 1 ? (uint32_t)height / 2 : 1 };
+
+    evkMipmapComputeTransient transient = { 0 };
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+    bool success = false;
+
+    do
+    {
+        // levels 1 to n are written into an unorm image since srgb formats seldom allow storage
+        evkResult result = evk_device_create_image
+        (
+            firstExtent,
+            levels,
+            layerCount,
+            device,
+            physicalDevice,
+            &transient.image,
+            &transient.mem,
+            VK_FORMAT_R8G8B8A8_UNORM,
+            evk_Msaa_Off,
+            VK_IMAGE_TILING_OPTIMAL,
+            VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            0
+        );
+        if (result != evk_Success) break;
+
+        VkImageViewCreateInfo viewCI = { 0 };
+        viewCI.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewCI.viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+        viewCI.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewCI.subresourceRange.levelCount = 1;
+        viewCI.subresourceRange.baseArrayLayer = 0;
+        viewCI.subresourceRange.layerCount = layerCount;
+
+        viewCI.image = image;
+        viewCI.format = format;
+        viewCI.subresourceRange.baseMipLevel = 0;
+        if (vkCreateImageView(device, &viewCI, evk_get_vulkan_allocator(), &transient.srcView) != VK_SUCCESS) break;
+
+        viewCI.image = transient.image;
+        viewCI.format = VK_FORMAT_R8G8B8A8_UNORM;
+        for (uint32_t i = 0; i < levels; i++) {
+            viewCI.subresourceRange.baseMipLevel = i;
+            if (vkCreateImageView(device, &viewCI, evk_get_vulkan_allocator(), &transient.dstViews[i]) != VK_SUCCESS) break;
+            transient.dstViewCount++;
+        }
+        if (transient.dstViewCount != levels) break;
+
+        result = evk_device_create_buffer
+        (
+            device,
+            physicalDevice,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            sizeof(uint32_t) * layerCount,
+            &transient.counter,
+            &transient.counterMem,
+            NULL
+        );
+        if (result != evk_Success) {
+            transient.counter = VK_NULL_HANDLE;
+            transient.counterMem = VK_NULL_HANDLE;
+            break;
+        }
+
+        VkDescriptorPoolSize poolSizes[3] = { 0 };
+        poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        poolSizes[0].descriptorCount = 1;
+        poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        poolSizes[1].descriptorCount = EVK_COMPUTE_MIPMAP_MAX_LEVELS;
+        poolSizes[2].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        poolSizes[2].descriptorCount = 1;
+
+        VkDescriptorPoolCreateInfo poolCI = { 0 };
+        poolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolCI.maxSets = 1;
+        poolCI.poolSizeCount = 3;
+        poolCI.pPoolSizes = poolSizes;
+        if (vkCreateDescriptorPool(device, &poolCI, evk_get_vulkan_allocator(), &transient.descriptorPool) != VK_SUCCESS) break;
+
+        VkDescriptorSetAllocateInfo allocInfo = { 0 };
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = transient.descriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &compute->descriptorSetLayout;
+        if (vkAllocateDescriptorSets(device, &allocInfo, &descriptorSet) != VK_SUCCESS) break;
+
+        evkSamplerState samplerState = evk_sampler_state_default(VK_FILTER_NEAREST, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE);
+        VkDescriptorImageInfo srcInfo = { 0 };
+        srcInfo.sampler = evk_sampler_cache_get(&samplerState);
+        srcInfo.imageView = transient.srcView;
+        srcInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        if (srcInfo.sampler == VK_NULL_HANDLE) break;
+
+        // unused slots repeat the last level, the shader never writes past the level count
+        VkDescriptorImageInfo dstInfos[EVK_COMPUTE_MIPMAP_MAX_LEVELS] = { 0 };
+        for (uint32_t i = 0; i < EVK_COMPUTE_MIPMAP_MAX_LEVELS; i++) {
+            dstInfos[i].imageView = transient.dstViews[i < levels ? i : levels - 1];
+            dstInfos[i].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+        }
+
+        VkDescriptorBufferInfo counterInfo = { 0 };
+        counterInfo.buffer = transient.counter;
+        counterInfo.offset = 0;
+        counterInfo.range = VK_WHOLE_SIZE;
+
+        VkWriteDescriptorSet writes[3] = { 0 };
+        writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[0].dstSet = descriptorSet;
+        writes[0].dstBinding = 0;
+        writes[0].descriptorCount = 1;
+        writes[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[0].pImageInfo = &srcInfo;
+        writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[1].dstSet = descriptorSet;
+        writes[1].dstBinding = 1;
+        writes[1].descriptorCount = EVK_COMPUTE_MIPMAP_MAX_LEVELS;
+        writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[1].pImageInfo = dstInfos;
+        writes[2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[2].dstSet = descriptorSet;
+        writes[2].dstBinding = 2;
+        writes[2].descriptorCount = 1;
+        writes[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[2].pBufferInfo = &counterInfo;
+        vkUpdateDescriptorSets(device, 3, writes, 0, NULL);
+
+        success = darray_push_back(compute->transients, &transient) == CTOOLBOX_SUCCESS;
+    } while (0);
+
+    if (!success) {
+        EVK_LOG(evk_Warn, "Failed to prepare compute mipmaps, falling back to blits");
+
+        // nothing was recorded yet, so the partial objects can go right away
+        if (transient.descriptorPool != VK_NULL_HANDLE) vkDestroyDescriptorPool(device, transient.descriptorPool, evk_get_vulkan_allocator());
+        for (uint32_t i = 0; i < transient.dstViewCount; i++) vkDestroyImageView(device, transient.dstViews[i], evk_get_vulkan_allocator());
+        if (transient.srcView != VK_NULL_HANDLE) vkDestroyImageView(device, transient.srcView, evk_get_vulkan_allocator());
+        if (transient.image != VK_NULL_HANDLE) vkDestroyImage(device, transient.image, evk_get_vulkan_allocator());
+        if (transient.mem != VK_NULL_HANDLE) vkFreeMemory(device, transient.mem, evk_get_vulkan_allocator());
+        if (transient.counter != VK_NULL_HANDLE) vkDestroyBuffer(device, transient.counter, evk_get_vulkan_allocator());
+        if (transient.counterMem != VK_NULL_HANDLE) vkFreeMemory(device, transient.counterMem, evk_get_vulkan_allocator());
+        return evk_Failure;
+    }
+
+    VkImageSubresourceRange baseRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, layerCount };
+    VkImageSubresourceRange tailRange = { VK_IMAGE_ASPECT_COLOR_BIT, 1, levels, 0, layerCount };
+    VkImageSubresourceRange transientRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, levels, 0, layerCount };
+
+    // level 0 becomes readable, the transient levels writable and the counters zeroed
+    evk_device_create_image_memory_barrier(cmdBuffer, image, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, baseRange);
+    evk_device_create_image_memory_barrier(cmdBuffer, transient.image, 0, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, transientRange);
+    vkCmdFillBuffer(cmdBuffer, transient.counter, 0, VK_WHOLE_SIZE, 0);
+
+    VkBufferMemoryBarrier counterBarrier = { 0 };
+    counterBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    counterBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    counterBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    counterBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    counterBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    counterBarrier.buffer = transient.counter;
+    counterBarrier.offset = 0;
+    counterBarrier.size = VK_WHOLE_SIZE;
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, NULL, 1, &counterBarrier, 0, NULL);
+
+    // one workgroup per 64x64 tile of level 0, one slice per layer
+    uint32_t groupsX = ((uint32_t)width + 63) / 64;
+    uint32_t groupsY = ((uint32_t)height + 63) / 64;
+    uint32_t pushConstants[3] = { levels, groupsX * groupsY, format == VK_FORMAT_R8G8B8A8_SRGB ? 1U : 0U };
+
+    vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, compute->pipeline);
+    vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, compute->pipelineLayout, 0, 1, &descriptorSet, 0, NULL);
+    vkCmdPushConstants(cmdBuffer, compute->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants), pushConstants);
+    vkCmdDispatch(cmdBuffer, groupsX, groupsY, layerCount);
+
+    // copy the generated levels into the real image, unorm and srgb share the same bytes
+    evk_device_create_image_memory_barrier(cmdBuffer, transient.image, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, transientRange);
+
+    VkImageCopy regions[EVK_COMPUTE_MIPMAP_MAX_LEVELS] = { 0 };
+    for (uint32_t i = 0; i < levels; i++) {
+        uint32_t levelWidth = (uint32_t)width >> (i + 1);
+        uint32_t levelHeight = (uint32_t)height >> (i + 1);
+
+        regions[i].srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        regions[i].srcSubresource.mipLevel = i;
+        regions[i].srcSubresource.baseArrayLayer = 0;
+        regions[i].srcSubresource.layerCount = layerCount;
+        regions[i].dstSubresource = regions[i].srcSubresource;
+        regions[i].dstSubresource.mipLevel = i + 1;
+        regions[i].extent.width = levelWidth > 0 ? levelWidth : 1;
+        regions[i].extent.height = levelHeight > 0 ? levelHeight : 1;
+        regions[i].extent.depth = 1;
+    }
+    vkCmdCopyImage(cmdBuffer, transient.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, levels, regions);
+
+    evk_device_create_image_memory_barrier(cmdBuffer, image, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, tailRange);
+
+    return evk_Success;
+}
+
 void evk_device_create_image_memory_barrier(VkCommandBuffer cmdBuffer, VkImage image, VkAccessFlags srcAccessFlags, VkAccessFlags dstAccessFlags, VkImageLayout oldImageLayout, VkImageLayout newImageLayout, VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, VkImageSubresourceRange subresourceRange)
 {
     VkImageMemoryBarrier imageMemoryBarrier = { 0 };
@@ -1550,7 +2665,7 @@ evkResult evk_device_create_buffer(VkDevice device, VkPhysicalDevice physicalDev
     bufferCI.usage = usage;
     bufferCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
-    VkResult res = vkCreateBuffer(device, &bufferCI, NULL, buffer);
+    VkResult res = vkCreateBuffer(device, &bufferCI, evk_get_vulkan_allocator(), buffer);
     if (res != VK_SUCCESS) {
         EVK_LOG(evk_Error, "Failed to create buffer on GPU");
         return evk_Failure;
@@ -1565,18 +2680,18 @@ evkResult evk_device_create_buffer(VkDevice device, VkPhysicalDevice physicalDev
     allocInfo.allocationSize = memRequirements.size;
     allocInfo.memoryTypeIndex = evk_device_find_suitable_memory_type(physicalDevice, memRequirements.memoryTypeBits, properties);
 
-    res = vkAllocateMemory(device, &allocInfo, NULL, memory);
+    res = vkAllocateMemory(device, &allocInfo, evk_get_vulkan_allocator(), memory);
     if (res != VK_SUCCESS) {
         EVK_LOG(evk_Error, "Failed to allocate memory for GPU buffer");
-        vkDestroyBuffer(device, *buffer, NULL);
+        vkDestroyBuffer(device, *buffer, evk_get_vulkan_allocator());
         return evk_Failure;
     }
 
     res = vkBindBufferMemory(device, *buffer, *memory, 0);
     if (res != VK_SUCCESS) {
         EVK_LOG(evk_Error, "Failed to bind GPU memory with buffer");
-        vkDestroyBuffer(device, *buffer, NULL);
-        vkFreeMemory(device, *memory, NULL);
+        vkDestroyBuffer(device, *buffer, evk_get_vulkan_allocator());
+        vkFreeMemory(device, *memory, evk_get_vulkan_allocator());
         return evk_Failure;
     }
 
@@ -1642,13 +2757,17 @@ evkResult evk_device_end_commandbuffer_singletime(VkDevice device, VkCommandPool
         return evk_Failure;
     }
 
+    if (g_EVKBackend) {
+        ievk_mipmap_compute_release_transients(device, &g_EVKBackend->mipmapCompute);
+    }
+
     vkFreeCommandBuffers(device, cmdPool, 1, &cmdBuffer);
     return evk_Success;
 }
 
 int32_t evk_device_calculate_image_mipmap(uint32_t width, uint32_t height, bool uiImage)
 {
-    if (uiImage || evk_get_msaa() != evk_Msaa_Off) return 1; // UI textures or MSAA textures cannot have mipmaps
+    if (uiImage) return 1; // UI textures are shown at their size, MSAA doesn't matter since sampled textures are always single-sampled
     return i_floor(f_log2(f_max((float)width, (float)height))) + 1;
 }
 
@@ -1663,7 +2782,7 @@ evkBuffer* evk_buffer_create(VkDevice device, VkPhysicalDevice physicalDevice, V
         return NULL;
     }
 
-    evkBuffer* buffer = (evkBuffer*)m_malloc(sizeof(evkBuffer));
+    evkBuffer* buffer = (evkBuffer*)evk_pool_alloc(&g_EVKBufferPool);
     if (!buffer) {
         EVK_LOG(evk_Error, "Failed to allocate buffer structure");
         return NULL;
@@ -1673,21 +2792,31 @@ evkBuffer* evk_buffer_create(VkDevice device, VkPhysicalDevice physicalDevice, V
     buffer->usage = usage;
     buffer->memoryProperties = memoryProperties;
     buffer->frameCount = frameCount;
+    buffer->handle.value = 0;
 
-    // allocate arrays for per-frame resources
-    buffer->buffers = (VkBuffer*)m_malloc(sizeof(VkBuffer) * frameCount);
-    buffer->memories = (VkDeviceMemory*)m_malloc(sizeof(VkDeviceMemory) * frameCount);
-    buffer->mappedPointers = (void**)m_malloc(sizeof(void*) * frameCount);
-    buffer->isMapped = (bool*)m_malloc(sizeof(bool) * frameCount);
-
-    if (!buffer->buffers || !buffer->memories || !buffer->mappedPointers || !buffer->isMapped) {
-        EVK_LOG(evk_Error, "Failed to allocate buffer arrays");
-        evk_buffer_destroy(device, buffer);
-        return NULL;
+    // per-frame arrays, the pool hands out zeroed buffers so the inline ones start empty
+    if (frameCount <= EVK_CONCURRENTLY_RENDERED_FRAMES) {
+        buffer->buffers = buffer->inlineBuffers;
+        buffer->memories = buffer->inlineMemories;
+        buffer->mappedPointers = buffer->inlineMappedPointers;
+        buffer->isMapped = buffer->inlineIsMapped;
     }
+    else {
+        // ordered by alignment, vulkan handles are 64-bit on every platform
+        size_t blockSize = (sizeof(VkBuffer) + sizeof(VkDeviceMemory) + sizeof(void*) + sizeof(bool)) * frameCount;
+        uint8_t* block = (uint8_t*)EVK_MALLOC(evk_Allocation_Tag_Core, blockSize);
+        if (!block) {
+            EVK_LOG(evk_Error, "Failed to allocate buffer arrays");
+            evk_buffer_destroy(device, buffer);
+            return NULL;
+        }
 
-    memset(buffer->mappedPointers, 0, sizeof(void*) * frameCount);
-    memset(buffer->isMapped, 0, sizeof(bool) * frameCount);
+        memset(block, 0, blockSize);
+        buffer->buffers = (VkBuffer*)block;
+        buffer->memories = (VkDeviceMemory*)(buffer->buffers + frameCount);
+        buffer->mappedPointers = (void**)(buffer->memories + frameCount);
+        buffer->isMapped = (bool*)(buffer->mappedPointers + frameCount);
+    }
 
     // create each buffer
     for (uint32_t i = 0; i < frameCount; i++)
@@ -1697,7 +2826,7 @@ evkBuffer* evk_buffer_create(VkDevice device, VkPhysicalDevice physicalDevice, V
         bufferInfo.usage = usage;
         bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
-        VkResult result = vkCreateBuffer(device, &bufferInfo, NULL, &buffer->buffers[i]);
+        VkResult result = vkCreateBuffer(device, &bufferInfo, evk_get_vulkan_allocator(), &buffer->buffers[i]);
         if (result != VK_SUCCESS) {
             EVK_LOG(evk_Error, "Failed to create buffer %u: %d", i, result);
             evk_buffer_destroy(device, buffer);
@@ -1712,7 +2841,7 @@ evkBuffer* evk_buffer_create(VkDevice device, VkPhysicalDevice physicalDevice, V
         allocInfo.allocationSize = memRequirements.size;
         allocInfo.memoryTypeIndex = evk_device_find_suitable_memory_type(physicalDevice, memRequirements.memoryTypeBits, memoryProperties);
 
-        result = vkAllocateMemory(device, &allocInfo, NULL, &buffer->memories[i]);
+        result = vkAllocateMemory(device, &allocInfo, evk_get_vulkan_allocator(), &buffer->memories[i]);
         if (result != VK_SUCCESS) {
             EVK_LOG(evk_Error, "Failed to allocate buffer memory %u: %d", i, result);
             evk_buffer_destroy(device, buffer);
@@ -1742,6 +2871,8 @@ void evk_buffer_destroy(VkDevice device, evkBuffer* buffer)
 {
     if (!buffer) return;
 
+    if (buffer->handle.value != 0) evk_handle_table_remove(&g_EVKBackend->bufferHandles, buffer->handle.value);
+
     if (buffer->buffers) {
         for (uint32_t i = 0; i < buffer->frameCount; i++) {
             if (buffer->buffers[i] != VK_NULL_HANDLE) {
@@ -1750,27 +2881,50 @@ void evk_buffer_destroy(VkDevice device, evkBuffer* buffer)
                     evk_buffer_unmap(device, buffer, i);
                 }
 
-                vkDestroyBuffer(device, buffer->buffers[i], NULL);
+                vkDestroyBuffer(device, buffer->buffers[i], evk_get_vulkan_allocator());
                 buffer->buffers[i] = VK_NULL_HANDLE;
             }
         }
-        m_free(buffer->buffers);
     }
 
     if (buffer->memories) {
         for (uint32_t i = 0; i < buffer->frameCount; i++) {
             if (buffer->memories[i] != VK_NULL_HANDLE) {
-                vkFreeMemory(device, buffer->memories[i], NULL);
+                vkFreeMemory(device, buffer->memories[i], evk_get_vulkan_allocator());
                 buffer->memories[i] = VK_NULL_HANDLE;
             }
         }
-        m_free(buffer->memories);
     }
 
-    if (buffer->mappedPointers) m_free(buffer->mappedPointers);
-    if (buffer->isMapped) m_free(buffer->isMapped);
+    // the heap block starts with the buffers array
+    if (buffer->buffers && buffer->buffers != buffer->inlineBuffers) EVK_FREE(buffer->buffers);
+
+    evk_pool_free(&g_EVKBufferPool, buffer);
+}
+
+evkBufferHandle evk_buffer_library_insert(shashtable* buffers, const char* name, evkBuffer* buffer)
+{
+    evkBufferHandle handle = { 0 };
+    if (buffers == NULL || name == NULL || buffer == NULL) return handle;
+
+    if (shashtable_insert(buffers, name, buffer) != CTOOLBOX_SUCCESS) {
+        EVK_LOG(evk_Error, "Failed to insert buffer %s into the buffers library", name);
+        return handle;
+    }
+
+    if (buffer->handle.value == 0) buffer->handle.value = evk_handle_table_insert(&g_EVKBackend->bufferHandles, buffer);
+    return buffer->handle;
+}
 
-    m_free(buffer);
+evkBufferHandle evk_buffer_library_find(shashtable* buffers, const char* name)
+{
+    evkBuffer* buffer = (evkBuffer*)shashtable_lookup(buffers, name);
+    return buffer != NULL ? buffer->handle : (evkBufferHandle){ 0 };
+}
+
+evkBuffer* evk_buffer_library_get(evkBufferHandle handle)
+{
+    return (evkBuffer*)evk_handle_table_get(&g_EVKBackend->bufferHandles, handle.value);
 }
 
 evkResult evk_buffer_map(VkDevice device, evkBuffer* buffer, uint32_t frameIndex)
@@ -1869,6 +3023,106 @@ evkResult evk_buffer_command_copy(VkCommandBuffer commandBuffer, evkBuffer* srcB
     return evk_Success;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Sampler
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+evkSamplerState evk_sampler_state_default(VkFilter filter, VkSamplerAddressMode addressMode)
+{
+    evkSamplerState state = { 0 };
+    state.minFilter = filter;
+    state.magFilter = filter;
+    state.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+    state.addressModeU = addressMode;
+    state.addressModeV = addressMode;
+    state.addressModeW = addressMode;
+    state.mipLodBias = 0.0f;
+    state.anisotropyEnable = VK_TRUE;
+    state.maxAnisotropy = 0.0f;
+    state.compareEnable = VK_FALSE;
+    state.compareOp = VK_COMPARE_OP_ALWAYS;
+    state.minLod = 0.0f;
+    state.maxLod = VK_LOD_CLAMP_NONE;
+    state.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+    state.unnormalizedCoordinates = VK_FALSE;
+    return state;
+}
+
+VkSampler evk_sampler_cache_get(const evkSamplerState* state)
+{
+    if (!state || !g_EVKBackend) return VK_NULL_HANDLE;
+
+    // resolving the anisotropy first makes 0 and the explicit device maximum share the sampler
+    float maxAnisotropy = state->maxAnisotropy > 0.0f ? state->maxAnisotropy : g_EVKBackend->maxSamplerAnisotropy;
+    if (maxAnisotropy > g_EVKBackend->maxSamplerAnisotropy) maxAnisotropy = g_EVKBackend->maxSamplerAnisotropy;
+    if (!state->anisotropyEnable) maxAnisotropy = 1.0f;
+
+    char key[256];
+    snprintf
+    (
+        key, sizeof(key), "%d:%d:%d:%d:%d:%d:%g:%u:%g:%u:%d:%g:%g:%d:%u",
+        state->minFilter, state->magFilter, state->mipmapMode,
+        state->addressModeU, state->addressModeV, state->addressModeW,
+        state->mipLodBias, state->anisotropyEnable, maxAnisotropy,
+        state->compareEnable, state->compareOp, state->minLod, state->maxLod,
+        state->borderColor, state->unnormalizedCoordinates
+    );
+
+    // the table stores the list index since non-dispatchable handles may not fit a pointer
+    VkSampler sampler = VK_NULL_HANDLE;
+    uintptr_t slot = (uintptr_t)shashtable_lookup(g_EVKBackend->samplers, key);
+    if (slot != 0) {
+        darray_get(g_EVKBackend->samplersList, (size_t)(slot - 1), &sampler);
+        return sampler;
+    }
+
+    uint32_t count = (uint32_t)darray_size(g_EVKBackend->samplersList);
+    if (count >= g_EVKBackend->maxSamplerAllocationCount) {
+        EVK_LOG(evk_Error, "Sampler cache reached the device limit of %u samplers", g_EVKBackend->maxSamplerAllocationCount);
+        return VK_NULL_HANDLE;
+    }
+
+    VkSamplerCreateInfo samplerCI = { 0 };
+    samplerCI.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerCI.magFilter = state->magFilter;
+    samplerCI.minFilter = state->minFilter;
+    samplerCI.mipmapMode = state->mipmapMode;
+    samplerCI.addressModeU = state->addressModeU;
+    samplerCI.addressModeV = state->addressModeV;
+    samplerCI.addressModeW = state->addressModeW;
+    samplerCI.mipLodBias = state->mipLodBias;
+    samplerCI.anisotropyEnable = state->anisotropyEnable;
+    samplerCI.maxAnisotropy = maxAnisotropy;
+    samplerCI.compareEnable = state->compareEnable;
+    samplerCI.compareOp = state->compareOp;
+    samplerCI.minLod = state->minLod;
+    samplerCI.maxLod = state->maxLod;
+    samplerCI.borderColor = state->borderColor;
+    samplerCI.unnormalizedCoordinates = state->unnormalizedCoordinates;
+
+    if (vkCreateSampler(g_EVKBackend->evkDevice.device, &samplerCI, evk_get_vulkan_allocator(), &sampler) != VK_SUCCESS) {
+        EVK_LOG(evk_Error, "Failed to create cached sampler %s", key);
+        return VK_NULL_HANDLE;
+    }
+
+    if (darray_push_back(g_EVKBackend->samplersList, &sampler) != CTOOLBOX_SUCCESS) {
+        EVK_LOG(evk_Error, "Failed to register sampler %s into the sampler cache", key);
+        vkDestroySampler(g_EVKBackend->evkDevice.device, sampler, evk_get_vulkan_allocator());
+        return VK_NULL_HANDLE;
+    }
+
+    if (shashtable_insert(g_EVKBackend->samplers, key, (void*)(uintptr_t)(count + 1)) != CTOOLBOX_SUCCESS) {
+        EVK_LOG(evk_Warn, "Failed to index sampler %s, it'll stay alive but won't be shared", key);
+    }
+
+    return sampler;
+}
+
+uint32_t evk_sampler_cache_get_count()
+{
+    return g_EVKBackend ? (uint32_t)darray_size(g_EVKBackend->samplersList) : 0;
+}
+
 #ifdef __cplusplus 
 }
 #endif
@@ -18,9 +18,18 @@ evkTexture2D* evk_texture2d_create_from_path(const char* path, bool ui);
 /// @brief creates a 2D texture based on buffer data and parameters
 evkTexture2D* evk_texture2d_create_from_buffer(uint8_t* buffer, size_t bufferLen, uint32_t width, uint32_t height, bool ui);
 
+/// @brief creates a 2D texture from a cooked texture (tools/texture_cook) already in memory, levels are copied as-is so no decoding nor mip generation happens
+evkTexture2D* evk_texture2d_create_from_cooked(const void* data, size_t dataLen);
+
 /// @brief releases all resources used by a texture
 void evk_texture2d_destroy(evkTexture2D* texture);
 
+/// @brief returns the texture's handle, registering it on the first call, the handle goes stale once the texture is destroyed
+evkTextureHandle evk_texture2d_get_handle(evkTexture2D* texture);
+
+/// @brief returns the texture of a handle, NULL when it was destroyed
+evkTexture2D* evk_texture2d_from_handle(evkTextureHandle handle);
+
 /// @brief returns the texture's path
 const char* evk_texture2d_get_path(evkTexture2D* texture);
 
@@ -39,12 +48,134 @@ VkSampler evk_texture2d_get_sampler(evkTexture2D* texture);
 /// @brief returns the texture's vulkan descriptor set (normally used on showing the image into the ui, like texture browser)
 VkDescriptorSet evk_texture2d_get_descriptor_set(evkTexture2D* texture);
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Texture Batch
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief creates many 2D textures at once, images are decoded in parallel and uploaded through one staging buffer and one submission, textures that failed are left NULL
+evkResult evk_texture2d_create_batch(const char** paths, size_t count, bool ui, evkTexture2D** textures, evkTextureBatchStats* stats);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Texture Streaming
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief initializes the texture streamer, called by the backend with evkCreateInfo.textureStreamBudget
+evkResult evk_texture_stream_init(uint64_t budgetBytes);
+
+/// @brief stops streaming, called by the backend before the device is destroyed
+void evk_texture_stream_shutdown();
+
+/// @brief creates a texture from a cooked texture that only keeps it's mip tail resident, the data is read again whenever detail is streamed in so it must outlive the texture
+evkTexture2D* evk_texture2d_create_streamed(const void* data, size_t dataLen);
+
+/// @brief asks for a streamed texture to be resident up to the given level of detail, requests are applied on the next update
+void evk_texture2d_request_lod(evkTexture2D* texture, float lod);
+
+/// @brief asks for the level of detail of a streamed texture covering screenSize pixels
+void evk_texture2d_request_screen_size(evkTexture2D* texture, float2 screenSize);
+
+/// @brief applies the requests within the budget, evicting detail of the least recently requested textures, called by the backend once per frame
+void evk_texture_stream_update();
+
+/// @brief changes the budget, applied on the next update, 0 means unlimited
+void evk_texture_stream_set_budget(uint64_t budgetBytes);
+
+/// @brief returns the streaming counters
+evkTextureStreamStats evk_texture_stream_get_stats();
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Texture Cache
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief initializes the texture cache, called by the backend with evkCreateInfo.textureCacheBudget
+evkResult evk_texture_cache_init(uint64_t budgetBytes);
+
+/// @brief releases every cached texture, called by the backend before the device is destroyed
+void evk_texture_cache_shutdown();
+
+/// @brief returns a shared texture for the path, only loading it when neither the path nor it's pixels are resident, must be given back with evk_texture_cache_release
+evkTexture2D* evk_texture_cache_acquire(const char* path, bool ui);
+
+/// @brief drops a reference of an acquired texture, unreferenced textures stay resident until the budget needs their memory
+void evk_texture_cache_release(evkTexture2D* texture);
+
+/// @brief changes the budget and evicts unreferenced textures until the cache fits in it, 0 means unlimited
+void evk_texture_cache_set_budget(uint64_t budgetBytes);
+
+/// @brief evicts every unreferenced texture regardless of the budget
+void evk_texture_cache_trim();
+
+/// @brief returns the cache counters, including the hit rate and resident bytes
+evkTextureCacheStats evk_texture_cache_get_stats();
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Atlas
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief creates an empty atlas of square pages, padding is the border extruded around each image and also bounds how many mips are bleed-free
+evkAtlas* evk_atlas_create(uint32_t pageSize, uint32_t maxPages, uint32_t padding);
+
+/// @brief releases all resources used by the atlas, sprites created from it must be destroyed beforehand
+void evk_atlas_destroy(evkAtlas* atlas);
+
+/// @brief loads an image from disk and packs it into the atlas, the path is used as the region name
+evkResult evk_atlas_add_from_path(evkAtlas* atlas, const char* path);
+
+/// @brief packs a RGBA8 image into the atlas under the given name
+evkResult evk_atlas_add_from_buffer(evkAtlas* atlas, const char* name, const uint8_t* pixels, uint32_t width, uint32_t height);
+
+/// @brief uploads the packed pages into a 2D array texture with mips, no more images may be added afterwards
+evkResult evk_atlas_build(evkAtlas* atlas);
+
+/// @brief returns the region an image was packed into or NULL if the name is unknown
+const evkAtlasRegion* evk_atlas_find_region(evkAtlas* atlas, const char* name);
+
+/// @brief returns how many pages (array layers) the atlas is using
+uint32_t evk_atlas_get_page_count(evkAtlas* atlas);
+
+/// @brief returns how many mip levels the atlas has once built
+uint32_t evk_atlas_get_mip_levels(evkAtlas* atlas);
+
+/// @brief returns the view of the whole atlas array, for shaders sampling with sampler2DArray
+VkImageView evk_atlas_get_array_view(evkAtlas* atlas);
+
+/// @brief returns a 2D view of a single atlas page, for shaders sampling with sampler2D
+VkImageView evk_atlas_get_page_view(evkAtlas* atlas, uint32_t layer);
+
+/// @brief returns the atlas sampler
+VkSampler evk_atlas_get_sampler(evkAtlas* atlas);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Thumbnail Cache
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief initializes the thumbnail cache, called by the backend with evkCreateInfo.thumbnailBudget which fixes how many pages exist
+evkResult evk_thumbnail_cache_init(uint64_t budgetBytes);
+
+/// @brief releases the thumbnail pages, called by the backend before the device is destroyed
+void evk_thumbnail_cache_shutdown();
+
+/// @brief returns the page descriptor set and uv rect of an image's thumbnail, false while it's being loaded, thumbnails on the same page share the descriptor set
+bool evk_thumbnail_cache_get(const char* path, VkDescriptorSet* descriptor, float2* uvMin, float2* uvMax);
+
+/// @brief uploads a few requested thumbnails, paging out the least recently drawn ones when full, called by the backend once per frame
+void evk_thumbnail_cache_update();
+
+/// @brief returns the thumbnail cache counters
+evkThumbnailCacheStats evk_thumbnail_cache_get_stats();
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Sprite
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// @brief creates and returns a sprite
-evkSprite* evk_sprite_create_from_path(const char* path, uint32_t id);
+/// @brief creates and returns a sprite, it's picking entity is created with it and released on destroy
+evkSprite* evk_sprite_create_from_path(const char* path);
+
+/// @brief creates and returns a sprite that samples a region of a built atlas through the sprite's uv transform
+evkSprite* evk_sprite_create_from_atlas(evkAtlas* atlas, const char* name);
+
+/// @brief creates and returns a sprite that samples an existing texture, like a streamed one, the texture must outlive the sprite
+evkSprite* evk_sprite_create_from_texture(evkTexture2D* texture);
 
 /// @brief releases and destroys all resources used by the sprite
 void evk_sprite_destroy(evkSprite* sprite);
@@ -55,9 +186,109 @@ void evk_sprite_update(evkSprite* sprite, bool resend);
 /// @brief renders the sprite
 void evk_sprite_render(evkSprite* sprite, fmat4* modelMatrix);
 
-/// @brief returns the sprite's id
+/// @brief returns the sprite's entity, evk_entity_get maps it back to the sprite
 uint32_t evk_sprite_get_id(evkSprite* sprite);
 
+/// @brief walks the live sprites in memory order, returns the first one at or after cursor and moves it past it, NULL when done, start with cursor at 0
+evkSprite* evk_sprite_next(uint32_t* cursor);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Object Pools
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief prepares the pools textures and sprites are allocated from, called once by the backend before any is created
+void evk_object_pools_init();
+
+/// @brief releases the pools, textures and sprites still alive are reported
+void evk_object_pools_shutdown();
+
+/// @brief returns the usage of the texture pool
+evkPoolStats evk_texture2d_get_pool_stats();
+
+/// @brief returns the usage of the sprite pool
+evkPoolStats evk_sprite_get_pool_stats();
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Draw Queue
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief creates the queue sprites are submitted through from any thread, capacity is rounded up to a power of two and 0 uses the default
+evkResult evk_draw_queue_init(uint32_t capacity);
+
+/// @brief releases the queue, packets not yet rendered are discarded
+void evk_draw_queue_shutdown();
+
+/// @brief submits a packet, safe to call from any thread without locking, returns false when the queue is full and the packet was dropped
+bool evk_draw_queue_push(const evkDrawPacket* packet);
+
+/// @brief takes every published packet and radix sorts it's key, opaque front-to-back grouped by sprite then transparent back-to-front, called once per frame before the renderphases record
+uint32_t evk_draw_queue_drain();
+
+/// @brief renders the packets drained this frame with the pipeline of the current renderphase
+void evk_draw_queue_render();
+
+/// @brief returns the queue counters
+evkDrawQueueStats evk_draw_queue_get_stats();
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Vertex
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief converts a single precision float into a half precision float, rounding to nearest-even
+uint16_t evk_vertex_encode_half(float value);
+
+/// @brief encodes an unit-length normal into two snorm16 values using octahedral mapping
+void evk_vertex_encode_octahedral(float3 normal, int16_t outNormal[2]);
+
+/// @brief packs a full precision vertex into the compact evkVertex format, joints may be NULL
+evkVertex evk_vertex_pack(float3 position, float3 normal, float2 uv, float4 color, const uint8_t* joints, float4 weights);
+
+/// @brief interleaves the vertices into dst using only the components of the layout, dst must hold layout->stride * count bytes
+void evk_vertex_interleave(const evkVertexLayout* layout, const evkVertex* vertices, uint32_t count, void* dst);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Mesh
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief creates a mesh arena, a device-local vertex and index buffer pair that meshes share so they draw with a single bind, it's a bump allocator so recreate it when fragmented
+evkMeshArena* evk_mesh_arena_create(VkDeviceSize vertexCapacity, VkDeviceSize indexCapacity);
+
+/// @brief releases the arena buffers, all meshes created on it must be destroyed beforehand
+void evk_mesh_arena_destroy(evkMeshArena* arena);
+
+/// @brief returns how many bytes of the arena's vertex buffer are in use
+VkDeviceSize evk_mesh_arena_get_vertex_usage(evkMeshArena* arena);
+
+/// @brief returns how many bytes of the arena's index buffer are in use
+VkDeviceSize evk_mesh_arena_get_index_usage(evkMeshArena* arena);
+
+/// @brief recreates the mesh pipelines with the provided shaders, the backend already builds them with evk_pipeline_mesh_default_shaders
+evkResult evk_mesh_create_pipelines(const evkMeshShaders* shaders);
+
+/// @brief creates a mesh uploading it's vertices and indices to device-local memory through a staging buffer, when arena is NULL the mesh owns it's buffers
+evkMesh* evk_mesh_create(const evkVertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount, const evkVertexComponent* components, uint32_t componentsCount, evkMeshArena* arena);
+
+/// @brief releases all resources used by the mesh, it's arena space returns only if it was the last mesh placed or the arena became empty
+void evk_mesh_destroy(evkMesh* mesh);
+
+/// @brief binds the arena buffers and records an indexed draw into the command buffer, pipeline and descriptors must be already bound
+void evk_mesh_draw(evkMesh* mesh, VkCommandBuffer cmdBuffer);
+
+/// @brief renders the mesh with the pipeline of the current renderphase
+void evk_mesh_render(evkMesh* mesh, fmat4* modelMatrix);
+
+/// @brief returns the mesh's entity, evk_entity_get maps it back to the mesh
+uint32_t evk_mesh_get_id(evkMesh* mesh);
+
+/// @brief returns the mesh's vertex layout
+const evkVertexLayout* evk_mesh_get_layout(evkMesh* mesh);
+
+/// @brief returns how many vertices the mesh has
+uint32_t evk_mesh_get_vertex_count(evkMesh* mesh);
+
+/// @brief returns how many indices the mesh has
+uint32_t evk_mesh_get_index_count(evkMesh* mesh);
+
 #ifdef __cplusplus 
 }
 #endif
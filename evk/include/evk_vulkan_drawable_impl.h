@@ -1,4 +1,14 @@
 #include "evk_vulkan_drawable.h"
+#include <math.h>
+#include <time.h>
+
+#ifndef _WIN32
+    #include <pthread.h>
+    #include <unistd.h>
+#endif
+
+#undef EVK_LOG_CATEGORY
+#define EVK_LOG_CATEGORY evk_Log_Category_Drawable
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Texture
@@ -8,20 +18,31 @@ struct evkTexture2D
 {
     VkImage image;
     VkDeviceMemory mem;
-    VkSampler sampler;
+    VkSampler sampler; // shared, owned by the sampler cache
     VkImageView view;
     VkDescriptorSet descriptor; // used on ui to show the image
     int32_t width;
     int32_t height;
     int32_t mipLevel;
     const char* path;
+    struct evkTextureCacheEntry* cacheEntry; // set when owned by the texture cache
+    struct evkTextureStream* stream; // set when the mips are streamed
+    uint32_t generation; // bumped whenever the view is replaced, descriptors holding the old one must be rewritten
+    evkTextureHandle handle; // registered the first time it's asked for
 };
 
+/// @brief textures and sprites are packed into pools, set up by evk_object_pools_init
+static evkPool g_EVKTexturePool = { 0 };
+static evkPool g_EVKSpritePool = { 0 };
+
+/// @brief forgets the stream of a texture being destroyed, defined with the streamer
+static void ievk_texture_stream_release(evkTexture2D* texture);
+
 evkTexture2D* evk_texture2d_create_from_path(const char* path, bool ui)
 {
     if (path == NULL) return NULL;
 
-    evkTexture2D* texture = (evkTexture2D*)m_malloc(sizeof(evkTexture2D));
+    evkTexture2D* texture = (evkTexture2D*)evk_pool_alloc(&g_EVKTexturePool);
     if (!texture) return NULL;
 
     memset(texture, 0, sizeof(evkTexture2D));
@@ -92,7 +113,7 @@ evkTexture2D* evk_texture2d_create_from_path(const char* path, bool ui)
             &texture->image,
             &texture->mem,
             format,
-            (evkMSAA)texture->mipLevel,
+            evk_Msaa_Off,
             VK_IMAGE_TILING_OPTIMAL,
             usage,
             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
@@ -146,7 +167,9 @@ evkTexture2D* evk_texture2d_create_from_path(const char* path, bool ui)
 
         // generate mipmaps if needed
         if (texture->mipLevel > 1) {
-            evk_device_create_image_mipmaps(device, graphicsQueue, cmdBuffer, texture->width, texture->height, texture->mipLevel, texture->image);
+            if (evk_device_create_image_mipmaps_compute(device, cmdBuffer, texture->width, texture->height, texture->mipLevel, 1, format, texture->image) != evk_Success) {
+                evk_device_create_image_mipmaps(device, graphicsQueue, cmdBuffer, texture->width, texture->height, texture->mipLevel, 1, texture->image);
+            }
         }
         else {
             // transition to SHADER_READ_ONLY
@@ -170,8 +193,10 @@ evkTexture2D* evk_texture2d_create_from_path(const char* path, bool ui)
             break;
         }
 
-        result = evk_device_create_image_sampler(device, physicalDevice, VK_FILTER_LINEAR, VK_FILTER_LINEAR, VK_SAMPLER_ADDRESS_MODE_REPEAT, VK_SAMPLER_ADDRESS_MODE_REPEAT, VK_SAMPLER_ADDRESS_MODE_REPEAT, (float)texture->mipLevel, &texture->sampler);
-        if (result != evk_Success) {
+        evkSamplerState samplerState = evk_sampler_state_default(VK_FILTER_LINEAR, VK_SAMPLER_ADDRESS_MODE_REPEAT);
+        texture->sampler = evk_sampler_cache_get(&samplerState);
+        if (texture->sampler == VK_NULL_HANDLE) {
+            result = evk_Failure;
             EVK_LOG(evk_Error, "Failed to create sampler for: %s", path);
             break;
         }
@@ -188,16 +213,14 @@ evkTexture2D* evk_texture2d_create_from_path(const char* path, bool ui)
     // cleanup
     if (!success) {
         if (texture) {
-            if (texture->image != VK_NULL_HANDLE || texture->mem != VK_NULL_HANDLE) {
-                evk_texture2d_destroy(texture);
-            }
-            m_free(texture);
+            // destroy releases the texture itself, only the handles it holds are destroyed
+            evk_texture2d_destroy(texture);
             texture = NULL;
         }
     }
 
-    if (staging != VK_NULL_HANDLE) vkDestroyBuffer(device, staging, NULL);
-    if (stagingMem != VK_NULL_HANDLE) vkFreeMemory(device, stagingMem, NULL);
+    if (staging != VK_NULL_HANDLE) vkDestroyBuffer(device, staging, evk_get_vulkan_allocator());
+    if (stagingMem != VK_NULL_HANDLE) vkFreeMemory(device, stagingMem, evk_get_vulkan_allocator());
     if (pixels) stbi_image_free(pixels);
 
     return texture;
@@ -207,7 +230,7 @@ evkTexture2D* evk_texture2d_create_from_buffer(uint8_t* buffer, size_t bufferLen
 {
     if (!buffer || width == 0 || height == 0) return NULL;
 
-    evkTexture2D* texture = (evkTexture2D*)m_malloc(sizeof(evkTexture2D));
+    evkTexture2D* texture = (evkTexture2D*)evk_pool_alloc(&g_EVKTexturePool);
     if (!texture) return NULL;
 
     memset(texture, 0, sizeof(evkTexture2D));
@@ -263,7 +286,6 @@ evkTexture2D* evk_texture2d_create_from_buffer(uint8_t* buffer, size_t bufferLen
         const VkFormat format = VK_FORMAT_R8G8B8A8_SRGB;
         const VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
         evkRenderphaseType renderphaseType = evk_using_viewport() ? evk_Renderphase_Type_Viewport : evk_Renderphase_Type_Main;
-        evkMSAA msaa = ui ? evk_Msaa_Off : evk_get_msaa();
         VkCommandPool cmdPool = evk_get_command_pool(renderphaseType);
         VkQueue graphicsQueue = evk_get_graphics_queue();
 
@@ -277,7 +299,7 @@ evkTexture2D* evk_texture2d_create_from_buffer(uint8_t* buffer, size_t bufferLen
             & texture->image,
             & texture->mem,
             format,
-            msaa,
+            evk_Msaa_Off,
             VK_IMAGE_TILING_OPTIMAL,
             usage,
             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
@@ -331,7 +353,9 @@ evkTexture2D* evk_texture2d_create_from_buffer(uint8_t* buffer, size_t bufferLen
 
         // generate mipmaps
         if (texture->mipLevel > 1) {
-            evk_device_create_image_mipmaps(device, graphicsQueue, cmdBuffer, width, height, texture->mipLevel, texture->image);
+            if (evk_device_create_image_mipmaps_compute(device, cmdBuffer, width, height, texture->mipLevel, 1, format, texture->image) != evk_Success) {
+                evk_device_create_image_mipmaps(device, graphicsQueue, cmdBuffer, width, height, texture->mipLevel, 1, texture->image);
+            }
         }
         else {
             // transition to SHADER_READ_ONLY_OPTIMAL
@@ -355,8 +379,10 @@ evkTexture2D* evk_texture2d_create_from_buffer(uint8_t* buffer, size_t bufferLen
             break;
         }
 
-        result = evk_device_create_image_sampler(device, physicalDevice, VK_FILTER_LINEAR, VK_FILTER_LINEAR, VK_SAMPLER_ADDRESS_MODE_REPEAT, VK_SAMPLER_ADDRESS_MODE_REPEAT, VK_SAMPLER_ADDRESS_MODE_REPEAT, (float)texture->mipLevel, &texture->sampler);
-        if (result != evk_Success) {
+        evkSamplerState samplerState = evk_sampler_state_default(VK_FILTER_LINEAR, VK_SAMPLER_ADDRESS_MODE_REPEAT);
+        texture->sampler = evk_sampler_cache_get(&samplerState);
+        if (texture->sampler == VK_NULL_HANDLE) {
+            result = evk_Failure;
             EVK_LOG(evk_Error, "Failed to create sampler for texture from buffer");
             break;
         }
@@ -373,16 +399,264 @@ evkTexture2D* evk_texture2d_create_from_buffer(uint8_t* buffer, size_t bufferLen
     // cleanup
     if (!success) {
         if (texture) {
-            if (texture->image != VK_NULL_HANDLE || texture->mem != VK_NULL_HANDLE) {
-                evk_texture2d_destroy(texture);
-            }
-            m_free(texture);
+            // destroy releases the texture itself, only the handles it holds are destroyed
+            evk_texture2d_destroy(texture);
             texture = NULL;
         }
     }
 
-    if (staging != VK_NULL_HANDLE) vkDestroyBuffer(device, staging, NULL);
-    if (stagingMem != VK_NULL_HANDLE) vkFreeMemory(device, stagingMem, NULL);
+    if (staging != VK_NULL_HANDLE) vkDestroyBuffer(device, staging, evk_get_vulkan_allocator());
+    if (stagingMem != VK_NULL_HANDLE) vkFreeMemory(device, stagingMem, evk_get_vulkan_allocator());
+
+    return texture;
+}
+
+/// @brief texel block width and bytes per block of the formats the cooker emits, false for any other format
+static bool ievk_cooked_texture_format_block(VkFormat format, uint32_t* blockSize, uint32_t* blockBytes)
+{
+    switch (format) {
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB: *blockSize = 1; *blockBytes = 4; return true;
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK: *blockSize = 4; *blockBytes = 8; return true;
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+        case VK_FORMAT_BC7_SRGB_BLOCK:
+        case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+        case VK_FORMAT_ASTC_4x4_SRGB_BLOCK: *blockSize = 4; *blockBytes = 16; return true;
+        default: return false;
+    }
+}
+
+/// @brief copies and validates the header of a cooked texture, including the device's support for it's format
+static bool ievk_cooked_texture_read_header(const void* data, size_t dataLen, evkCookedTextureHeader* header)
+{
+    if (!data || dataLen < sizeof(evkCookedTextureHeader)) return false;
+
+    // the data may come straight from a mapped file, copy the header out instead of aliasing it
+    memcpy(header, data, sizeof(evkCookedTextureHeader));
+
+    if (header->magic != EVK_COOKED_TEXTURE_MAGIC || header->version != EVK_COOKED_TEXTURE_VERSION) {
+        EVK_LOG(evk_Error, "Cooked texture has an unknown magic or version (%u)", header->version);
+        return false;
+    }
+
+    if (header->width == 0 || header->height == 0 || header->layerCount != 1 || header->mipLevels == 0 || header->mipLevels > EVK_COOKED_TEXTURE_MAX_LEVELS) {
+        EVK_LOG(evk_Error, "Cooked texture has an invalid size, layer count or level count");
+        return false;
+    }
+
+    uint32_t blockSize = 0;
+    uint32_t blockBytes = 0;
+    if (!ievk_cooked_texture_format_block((VkFormat)header->format, &blockSize, &blockBytes)) {
+        EVK_LOG(evk_Error, "Cooked texture format %u is not one the cooker emits", header->format);
+        return false;
+    }
+
+    uint32_t fullChain = 1;
+    for (uint32_t extent = header->width > header->height ? header->width : header->height; extent > 1; extent >>= 1) fullChain++;
+    if (header->mipLevels > fullChain) {
+        EVK_LOG(evk_Error, "Cooked texture has %u levels but a %ux%u image has at most %u", header->mipLevels, header->width, header->height, fullChain);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < header->mipLevels; i++) {
+        const evkCookedTextureLevel* level = &header->levels[i];
+        if (level->size == 0 || level->offset > dataLen || level->size > dataLen - level->offset) {
+            EVK_LOG(evk_Error, "Cooked texture level %u lies outside of the data", i);
+            return false;
+        }
+
+        // the copy into the image reads whole blocks of the level's extent, a shorter level would read past the staging data
+        uint64_t width = header->width >> i ? header->width >> i : 1;
+        uint64_t height = header->height >> i ? header->height >> i : 1;
+        uint64_t expected = ((width + blockSize - 1) / blockSize) * ((height + blockSize - 1) / blockSize) * blockBytes;
+        if (level->size < expected) {
+            EVK_LOG(evk_Error, "Cooked texture level %u holds %llu bytes but it's extent needs %llu", i, (unsigned long long)level->size, (unsigned long long)expected);
+            return false;
+        }
+    }
+
+    // block compressed formats depend on device features, tell the caller to cook a fallback instead of failing inside the driver
+    VkFormatProperties formatProperties;
+    vkGetPhysicalDeviceFormatProperties(evk_get_physical_device(), (VkFormat)header->format, &formatProperties);
+    if (!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT)) {
+        EVK_LOG(evk_Error, "Cooked texture format %u is not supported by the device", header->format);
+        return false;
+    }
+
+    return true;
+}
+
+evkTexture2D* evk_texture2d_create_from_cooked(const void* data, size_t dataLen)
+{
+    evkCookedTextureHeader header;
+    if (!ievk_cooked_texture_read_header(data, dataLen, &header)) return NULL;
+
+    VkDeviceSize stagingSize = 0;
+    for (uint32_t i = 0; i < header.mipLevels; i++) {
+        stagingSize = ((stagingSize + 15) & ~(VkDeviceSize)15) + header.levels[i].size; // copies need offsets aligned to the texel block
+    }
+
+    VkDevice device = evk_get_device();
+    VkPhysicalDevice physicalDevice = evk_get_physical_device();
+    const VkFormat format = (VkFormat)header.format;
+
+    evkTexture2D* texture = (evkTexture2D*)evk_pool_alloc(&g_EVKTexturePool);
+    if (!texture) return NULL;
+
+    memset(texture, 0, sizeof(evkTexture2D));
+    texture->width = header.width;
+    texture->height = header.height;
+    texture->path = NULL;  // no path for cooked textures
+    texture->mipLevel = header.mipLevels;
+
+    VkBuffer staging = VK_NULL_HANDLE;
+    VkDeviceMemory stagingMem = VK_NULL_HANDLE;
+    VkCommandBuffer cmdBuffer = VK_NULL_HANDLE;
+    VkBufferImageCopy regions[EVK_COOKED_TEXTURE_MAX_LEVELS] = { 0 };
+    evkResult result = evk_Success;
+    bool success = false;
+
+    do
+    {
+        result = evk_device_create_buffer
+        (
+            device,
+            physicalDevice,
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            stagingSize,
+            &staging,
+            &stagingMem,
+            NULL
+        );
+        if (result != evk_Success) {
+            EVK_LOG(evk_Error, "Failed to create staging buffer for cooked texture");
+            break;
+        }
+
+        uint8_t* mapped;
+        if (vkMapMemory(device, stagingMem, 0, stagingSize, 0, (void**)&mapped) != VK_SUCCESS) {
+            EVK_LOG(evk_Error, "Failed to map staging memory for cooked texture");
+            result = evk_Failure;
+            break;
+        }
+
+        // levels are already in their final layout, they're copied as-is and one region is recorded per level
+        VkDeviceSize offset = 0;
+        for (uint32_t i = 0; i < header.mipLevels; i++) {
+            offset = (offset + 15) & ~(VkDeviceSize)15;
+            memcpy(mapped + offset, (const uint8_t*)data + header.levels[i].offset, (size_t)header.levels[i].size);
+
+            regions[i].bufferOffset = offset;
+            regions[i].imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            regions[i].imageSubresource.mipLevel = i;
+            regions[i].imageSubresource.baseArrayLayer = 0;
+            regions[i].imageSubresource.layerCount = 1;
+            regions[i].imageExtent.width = header.width >> i ? header.width >> i : 1;
+            regions[i].imageExtent.height = header.height >> i ? header.height >> i : 1;
+            regions[i].imageExtent.depth = 1;
+
+            offset += header.levels[i].size;
+        }
+        vkUnmapMemory(device, stagingMem);
+
+        evkRenderphaseType renderphaseType = evk_using_viewport() ? evk_Renderphase_Type_Viewport : evk_Renderphase_Type_Main;
+        VkCommandPool cmdPool = evk_get_command_pool(renderphaseType);
+        VkQueue graphicsQueue = evk_get_graphics_queue();
+
+        result = evk_device_create_image
+        (
+            (VkExtent2D) { header.width, header.height },
+            texture->mipLevel,
+            1,
+            device,
+            physicalDevice,
+            & texture->image,
+            & texture->mem,
+            format,
+            evk_Msaa_Off,
+            VK_IMAGE_TILING_OPTIMAL,
+            VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            0
+        );
+        if (result != evk_Success) {
+            EVK_LOG(evk_Error, "Failed to create Vulkan image for cooked texture");
+            break;
+        }
+
+        cmdBuffer = evk_device_begin_commandbuffer_singletime(device, cmdPool);
+        if (!cmdBuffer) {
+            EVK_LOG(evk_Error, "Failed to begin command buffer for cooked texture");
+            result = evk_Failure;
+            break;
+        }
+
+        // transition every level to TRANSFER_DST_OPTIMAL
+        VkImageMemoryBarrier barrier = { 0 };
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = texture->image;
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.baseMipLevel = 0;
+        barrier.subresourceRange.levelCount = texture->mipLevel;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount = 1;
+        vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, NULL, 0, NULL, 1, &barrier);
+
+        vkCmdCopyBufferToImage(cmdBuffer, staging, texture->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, header.mipLevels, regions);
+
+        // transition to SHADER_READ_ONLY_OPTIMAL, mips came with the file so there's nothing to generate
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, NULL, 0, NULL, 1, &barrier);
+
+        result = evk_device_end_commandbuffer_singletime(device, cmdPool, cmdBuffer, graphicsQueue);
+        if (result != evk_Success) {
+            EVK_LOG(evk_Error, "Failed to submit command buffer for cooked texture");
+            break;
+        }
+
+        // create image view, sampler and descriptor set
+        result = evk_device_create_image_view(device, texture->image, format, VK_IMAGE_ASPECT_COLOR_BIT, texture->mipLevel, 1, VK_IMAGE_VIEW_TYPE_2D, NULL, &texture->view);
+        if (result != evk_Success) {
+            EVK_LOG(evk_Error, "Failed to create image view for cooked texture");
+            break;
+        }
+
+        evkSamplerState samplerState = evk_sampler_state_default(VK_FILTER_LINEAR, VK_SAMPLER_ADDRESS_MODE_REPEAT);
+        texture->sampler = evk_sampler_cache_get(&samplerState);
+        if (texture->sampler == VK_NULL_HANDLE) {
+            result = evk_Failure;
+            EVK_LOG(evk_Error, "Failed to create sampler for cooked texture");
+            break;
+        }
+
+        result = evk_device_create_image_descriptor_set(device, evk_get_ui_descriptor_pool(), evk_get_ui_descriptor_set_layout(), texture->sampler, texture->view, &texture->descriptor);
+        if (result != evk_Success) {
+            EVK_LOG(evk_Error, "Failed to create descriptor set for cooked texture");
+            break;
+        }
+
+        success = true;
+    } while (0);
+
+    // cleanup, destroy releases the texture itself
+    if (!success) {
+        evk_texture2d_destroy(texture);
+        texture = NULL;
+    }
+
+    if (staging != VK_NULL_HANDLE) vkDestroyBuffer(device, staging, evk_get_vulkan_allocator());
+    if (stagingMem != VK_NULL_HANDLE) vkFreeMemory(device, stagingMem, evk_get_vulkan_allocator());
 
     return texture;
 }
@@ -392,12 +666,29 @@ void evk_texture2d_destroy(evkTexture2D* texture)
     EVK_ASSERT(texture != NULL, "Vulkan Texture is NULL");
     VkDevice device = evk_get_device();
 
-    if (texture->sampler != VK_NULL_HANDLE) vkDestroySampler(device, texture->sampler, NULL);
-    if (texture->view != VK_NULL_HANDLE) vkDestroyImageView(device, texture->view, NULL);
-    if (texture->image != VK_NULL_HANDLE) vkDestroyImage(device, texture->image, NULL);
-    if (texture->mem != VK_NULL_HANDLE) vkFreeMemory(device, texture->mem, NULL);
+    if (texture->stream) ievk_texture_stream_release(texture);
+    if (texture->handle.value != 0) evk_handle_table_remove(evk_get_texture_handles(), texture->handle.value);
+    if (texture->view != VK_NULL_HANDLE) vkDestroyImageView(device, texture->view, evk_get_vulkan_allocator());
+    if (texture->image != VK_NULL_HANDLE) vkDestroyImage(device, texture->image, evk_get_vulkan_allocator());
+    if (texture->mem != VK_NULL_HANDLE) vkFreeMemory(device, texture->mem, evk_get_vulkan_allocator());
+
+    evk_pool_free(&g_EVKTexturePool, texture);
+}
+
+evkTextureHandle evk_texture2d_get_handle(evkTexture2D* texture)
+{
+    if (texture == NULL) return (evkTextureHandle){ 0 };
+
+    if (texture->handle.value == 0) {
+        texture->handle.value = evk_handle_table_insert(evk_get_texture_handles(), texture);
+    }
+
+    return texture->handle;
+}
 
-    m_free(texture);
+evkTexture2D* evk_texture2d_from_handle(evkTextureHandle handle)
+{
+    return (evkTexture2D*)evk_handle_table_get(evk_get_texture_handles(), handle.value);
 }
 
 const char* evk_texture2d_get_path(evkTexture2D* texture)
@@ -438,194 +729,3551 @@ VkDescriptorSet evk_texture2d_get_descriptor_set(evkTexture2D* texture)
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// Sprite
+// Texture Batch
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct evkSprite
+/// @brief an image decoded by the batch workers, pixels come from stb and are released after staging
+typedef struct evkTextureBatchImage
 {
-    uint32_t id;
-    evkSpriteUBO ubo;
-    evkBuffer* buffer;
-    evkTexture2D* albedo;
-    VkDescriptorPool descriptorPool;
-    VkDescriptorSet descriptorSets[EVK_CONCURRENTLY_RENDERED_FRAMES];
-};
+    uint8_t* pixels;
+    int32_t width;
+    int32_t height;
+    VkDeviceSize stagingOffset;
+} evkTextureBatchImage;
 
-void ievk_sprite_refresh_data(evkSprite* sprite)
+/// @brief work shared by every decoding thread, images are claimed one at a time so fast threads keep pulling from slow ones
+typedef struct evkTextureBatchJob
 {
-    VkDevice device = evk_get_device();
-
-    for (uint32_t i = 0; i < EVK_CONCURRENTLY_RENDERED_FRAMES; i++)
-    {
-        evkBuffer* cameraBuffer = (evkBuffer*)shashtable_lookup(evk_get_buffers_library(), "MainCamera");
-        VkDescriptorBufferInfo camInfo = { 0 };
-        camInfo.buffer = cameraBuffer->buffers[i];
-        camInfo.offset = 0;
-        camInfo.range = sizeof(evkCameraUBO);
+    const char** paths;
+    evkTextureBatchImage* images;
+    uint32_t count;
+    volatile uint64_t next;
+} evkTextureBatchJob;
 
-        VkWriteDescriptorSet desc = { 0 };
-        desc.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        desc.dstSet = sprite->descriptorSets[i];
-        desc.dstBinding = 0;
-        desc.dstArrayElement = 0;
-        desc.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        desc.descriptorCount = 1;
-        desc.pBufferInfo = &camInfo;
-        vkUpdateDescriptorSets(device, 1, &desc, 0, NULL);
+/// @brief returns a monotonic timestamp in milliseconds
+static double ievk_texture_batch_now_ms()
+{
+    #ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart * 1000.0 / (double)frequency.QuadPart;
+    #elif defined(CLOCK_MONOTONIC)
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1000.0 + (double)now.tv_nsec / 1000000.0;
+    #else
+    return (double)time(NULL) * 1000.0;
+    #endif
+}
 
-        // 1: sprite data
-        VkDescriptorBufferInfo spriteInfo = { 0 };
-        spriteInfo.buffer = sprite->buffer->buffers[i];
-        spriteInfo.offset = 0;
-        spriteInfo.range = sizeof(evkSpriteUBO);
+/// @brief returns how many threads should decode a batch of count images, the calling thread included
+static uint32_t ievk_texture_batch_thread_count(uint32_t count)
+{
+    uint32_t cores = 1;
 
-        desc = (VkWriteDescriptorSet){ 0 };
-        desc.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        desc.dstSet = sprite->descriptorSets[i];
-        desc.dstBinding = 1;
-        desc.dstArrayElement = 0;
-        desc.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        desc.descriptorCount = 1;
-        desc.pBufferInfo = &spriteInfo;
-        vkUpdateDescriptorSets(device, 1, &desc, 0, NULL);
+    #ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    cores = (uint32_t)info.dwNumberOfProcessors;
+    #elif defined(_SC_NPROCESSORS_ONLN)
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    cores = online > 0 ? (uint32_t)online : 1;
+    #endif
 
-        // 2: albedo texture
-        VkDescriptorImageInfo albedoInfo = { 0 };
-        albedoInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        albedoInfo.imageView = sprite->albedo->view;
-        albedoInfo.sampler = sprite->albedo->sampler;
+    if (cores > EVK_TEXTURE_BATCH_MAX_THREADS) cores = EVK_TEXTURE_BATCH_MAX_THREADS;
+    return cores < count ? cores : count;
+}
 
-        desc = (VkWriteDescriptorSet){ 0 };
-        desc.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        desc.dstSet = sprite->descriptorSets[i];
-        desc.dstBinding = 2;
-        desc.dstArrayElement = 0;
-        desc.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        desc.descriptorCount = 1;
-        desc.pImageInfo = &albedoInfo;
-        vkUpdateDescriptorSets(device, 1, &desc, 0, NULL);
+/// @brief decodes images until none is left, stb allocates through the evk allocator so the workers rely on it and memm being thread safe
+static void ievk_texture_batch_decode(evkTextureBatchJob* job)
+{
+    for (uint64_t i = EVK_ATOMIC_FETCH_ADD(&job->next, 1); i < job->count; i = EVK_ATOMIC_FETCH_ADD(&job->next, 1)) {
+        int32_t channels = 0;
+        evkTextureBatchImage* image = &job->images[i];
+        image->pixels = job->paths[i] ? stbi_load(job->paths[i], &image->width, &image->height, &channels, 4) : NULL;
     }
-    evk_sprite_update(sprite, false);
 }
 
-evkSprite* evk_sprite_create_from_path(const char* path, uint32_t id)
+#ifdef _WIN32
+static DWORD WINAPI ievk_texture_batch_worker(LPVOID job)
 {
-    if (path == NULL) {
-        EVK_LOG(evk_Error, "Sprite path is NULL");
-        return NULL;
-    }
+    ievk_texture_batch_decode((evkTextureBatchJob*)job);
+    return 0;
+}
+#else
+static void* ievk_texture_batch_worker(void* job)
+{
+    ievk_texture_batch_decode((evkTextureBatchJob*)job);
+    return NULL;
+}
+#endif
 
-    evkSprite* sprite = (evkSprite*)m_malloc(sizeof(evkSprite));
-    if (sprite == NULL) {
-        EVK_LOG(evk_Error, "Out of memory to allocate sprite %s", path);
-        return NULL;
+/// @brief decodes every image of the job, spreading the work over threadCount threads with the caller being one of them
+static void ievk_texture_batch_decode_parallel(evkTextureBatchJob* job, uint32_t threadCount)
+{
+    uint32_t spawned = 0;
+
+    #ifdef _WIN32
+    HANDLE workers[EVK_TEXTURE_BATCH_MAX_THREADS];
+    for (uint32_t i = 0; i + 1 < threadCount; i++) {
+        workers[spawned] = CreateThread(NULL, 0, ievk_texture_batch_worker, job, 0, NULL);
+        if (workers[spawned] != NULL) spawned++;
     }
+    #else
+    pthread_t workers[EVK_TEXTURE_BATCH_MAX_THREADS];
+    for (uint32_t i = 0; i + 1 < threadCount; i++) {
+        if (pthread_create(&workers[spawned], NULL, ievk_texture_batch_worker, job) == 0) spawned++;
+    }
+    #endif
 
-    memset(sprite, 0, sizeof(evkSprite));
+    // a thread that failed to spawn only means less parallelism, the caller drains whatever is left
+    ievk_texture_batch_decode(job);
 
-    evkResult result = evk_Success;
-    evkBuffer* staging = NULL;
-    VkCommandBuffer cmdBuffer = VK_NULL_HANDLE;
-    VkDevice device = evk_get_device();
-    VkPhysicalDevice physicalDevice = evk_get_physical_device();
-    VkPhysicalDeviceProperties properties = evk_get_physical_device_properties();
-    bool success = false;
+    #ifdef _WIN32
+    if (spawned > 0) WaitForMultipleObjects(spawned, workers, TRUE, INFINITE);
+    for (uint32_t i = 0; i < spawned; i++) CloseHandle(workers[i]);
+    #else
+    for (uint32_t i = 0; i < spawned; i++) pthread_join(workers[i], NULL);
+    #endif
+}
 
-    do
-    {
-        EVK_LOG(evk_Todo, "Trace registered ids internally to inform when multiple identical ids were registered");
-        sprite->id = id;
-        sprite->albedo = evk_texture2d_create_from_path(path, false);
-        if (!sprite->albedo) {
-            EVK_LOG(evk_Error, "Failed to load albedo texture for sprite: %s because: %s", path, stbi_failure_reason());
-            break;
-        }
+evkResult evk_texture2d_create_batch(const char** paths, size_t count, bool ui, evkTexture2D** textures, evkTextureBatchStats* stats)
+{
+    if (!paths || !textures || count == 0 || count > UINT32_MAX) return evk_Failure;
 
+    const double startTime = ievk_texture_batch_now_ms();
+    evkTextureBatchStats batchStats = { 0 };
+    batchStats.requested = (uint32_t)count;
+
+    memset(textures, 0, sizeof(evkTexture2D*) * count);
+
+    evkTextureBatchImage* images = (evkTextureBatchImage*)EVK_MALLOC(evk_Allocation_Tag_Drawable, sizeof(evkTextureBatchImage) * count);
+    if (!images) {
+        EVK_LOG(evk_Error, "Failed to allocate memory for a batch of %zu textures", count);
+        return evk_Failure;
+    }
+    memset(images, 0, sizeof(evkTextureBatchImage) * count);
+
+    // decode everything first, the gpu work below needs every size to lay out the single staging buffer
+    evkTextureBatchJob job = { 0 };
+    job.paths = paths;
+    job.images = images;
+    job.count = (uint32_t)count;
+    job.next = 0;
+
+    batchStats.threadCount = ievk_texture_batch_thread_count((uint32_t)count);
+    ievk_texture_batch_decode_parallel(&job, batchStats.threadCount);
+
+    const double decodeTime = ievk_texture_batch_now_ms();
+    batchStats.decodeMs = decodeTime - startTime;
+
+    VkDeviceSize stagingSize = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!images[i].pixels) {
+            EVK_LOG(evk_Error, "Failed to load texture %s", paths[i] ? paths[i] : "(null)");
+            continue;
+        }
+        images[i].stagingOffset = stagingSize;
+        stagingSize += (VkDeviceSize)images[i].width * (VkDeviceSize)images[i].height * 4;
+    }
+    batchStats.stagingBytes = (uint64_t)stagingSize;
+
+    VkDevice device = evk_get_device();
+    VkPhysicalDevice physicalDevice = evk_get_physical_device();
+    VkBuffer staging = VK_NULL_HANDLE;
+    VkDeviceMemory stagingMem = VK_NULL_HANDLE;
+    VkCommandBuffer cmdBuffer = VK_NULL_HANDLE;
+    evkResult result = evk_Success;
+    bool success = false;
+
+    const VkFormat format = VK_FORMAT_R8G8B8A8_SRGB;
+    const VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    evkRenderphaseType renderphaseType = evk_using_viewport() ? evk_Renderphase_Type_Viewport : evk_Renderphase_Type_Main;
+    VkCommandPool cmdPool = evk_get_command_pool(renderphaseType);
+    VkQueue graphicsQueue = evk_get_graphics_queue();
+
+    do
+    {
+        if (stagingSize == 0) {
+            EVK_LOG(evk_Error, "None of the %zu textures of the batch could be loaded", count);
+            result = evk_Failure;
+            break;
+        }
+
+        result = evk_device_create_buffer
+        (
+            device,
+            physicalDevice,
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            stagingSize,
+            &staging,
+            &stagingMem,
+            NULL
+        );
+        if (result != evk_Success) {
+            EVK_LOG(evk_Error, "Failed to create staging buffer for a batch of %zu textures", count);
+            break;
+        }
+
+        uint8_t* mapped;
+        if (vkMapMemory(device, stagingMem, 0, stagingSize, 0, (void**)&mapped) != VK_SUCCESS) {
+            EVK_LOG(evk_Error, "Failed to map staging memory for a batch of %zu textures", count);
+            result = evk_Failure;
+            break;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            if (!images[i].pixels) continue;
+            memcpy(mapped + images[i].stagingOffset, images[i].pixels, (size_t)images[i].width * (size_t)images[i].height * 4);
+            stbi_image_free(images[i].pixels);
+            images[i].pixels = NULL;
+        }
+        vkUnmapMemory(device, stagingMem);
+
+        // create every image up front, an image that fails only drops its own texture from the batch
+        for (size_t i = 0; i < count; i++) {
+            if (images[i].width == 0) continue;
+
+            evkTexture2D* texture = (evkTexture2D*)evk_pool_alloc(&g_EVKTexturePool);
+            if (!texture) break;
+
+            memset(texture, 0, sizeof(evkTexture2D));
+            texture->path = paths[i];
+            texture->width = images[i].width;
+            texture->height = images[i].height;
+            texture->mipLevel = evk_device_calculate_image_mipmap(texture->width, texture->height, ui);
+
+            result = evk_device_create_image
+            (
+                (VkExtent2D) { texture->width, texture->height },
+                texture->mipLevel,
+                1,
+                device,
+                physicalDevice,
+                &texture->image,
+                &texture->mem,
+                format,
+                evk_Msaa_Off,
+                VK_IMAGE_TILING_OPTIMAL,
+                usage,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                0
+            );
+            if (result != evk_Success) {
+                EVK_LOG(evk_Error, "Failed to create vulkan image for %s", paths[i]);
+                evk_texture2d_destroy(texture);
+                continue;
+            }
+
+            textures[i] = texture;
+        }
+
+        cmdBuffer = evk_device_begin_commandbuffer_singletime(device, cmdPool);
+        if (!cmdBuffer) {
+            EVK_LOG(evk_Error, "Failed to begin command buffer for a batch of %zu textures", count);
+            result = evk_Failure;
+            break;
+        }
+
+        // every copy and every mip chain goes into the same command buffer, so the whole batch costs a single submission
+        for (size_t i = 0; i < count; i++) {
+            evkTexture2D* texture = textures[i];
+            if (!texture) continue;
+
+            VkImageMemoryBarrier barrier = { 0 };
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = texture->image;
+            barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            barrier.subresourceRange.baseMipLevel = 0;
+            barrier.subresourceRange.levelCount = texture->mipLevel;
+            barrier.subresourceRange.baseArrayLayer = 0;
+            barrier.subresourceRange.layerCount = 1;
+            vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, NULL, 0, NULL, 1, &barrier);
+
+            VkBufferImageCopy region = { 0 };
+            region.bufferOffset = images[i].stagingOffset;
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel = 0;
+            region.imageSubresource.baseArrayLayer = 0;
+            region.imageSubresource.layerCount = 1;
+            region.imageExtent.width = texture->width;
+            region.imageExtent.height = texture->height;
+            region.imageExtent.depth = 1;
+            vkCmdCopyBufferToImage(cmdBuffer, staging, texture->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+            if (texture->mipLevel > 1) {
+                if (evk_device_create_image_mipmaps_compute(device, cmdBuffer, texture->width, texture->height, texture->mipLevel, 1, format, texture->image) != evk_Success) {
+                    evk_device_create_image_mipmaps(device, graphicsQueue, cmdBuffer, texture->width, texture->height, texture->mipLevel, 1, texture->image);
+                }
+            }
+            else {
+                barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+                vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, NULL, 0, NULL, 1, &barrier);
+            }
+        }
+
+        result = evk_device_end_commandbuffer_singletime(device, cmdPool, cmdBuffer, graphicsQueue);
+        if (result != evk_Success) {
+            EVK_LOG(evk_Error, "Failed to submit command buffer for a batch of %zu textures", count);
+            break;
+        }
+
+        // create image views, samplers and descriptor sets
+        evkSamplerState samplerState = evk_sampler_state_default(VK_FILTER_LINEAR, VK_SAMPLER_ADDRESS_MODE_REPEAT);
+        VkSampler sampler = evk_sampler_cache_get(&samplerState);
+
+        for (size_t i = 0; i < count; i++) {
+            evkTexture2D* texture = textures[i];
+            if (!texture) continue;
+
+            texture->sampler = sampler;
+            if (sampler == VK_NULL_HANDLE
+                || evk_device_create_image_view(device, texture->image, format, VK_IMAGE_ASPECT_COLOR_BIT, texture->mipLevel, 1, VK_IMAGE_VIEW_TYPE_2D, NULL, &texture->view) != evk_Success
+                || evk_device_create_image_descriptor_set(device, evk_get_ui_descriptor_pool(), evk_get_ui_descriptor_set_layout(), texture->sampler, texture->view, &texture->descriptor) != evk_Success) {
+                EVK_LOG(evk_Error, "Failed to create view, sampler or descriptor set for %s", paths[i]);
+                evk_texture2d_destroy(texture);
+                textures[i] = NULL;
+                continue;
+            }
+
+            batchStats.loaded++;
+        }
+
+        success = true;
+    } while (0);
+
+    // cleanup, a failed submission leaves no texture usable
+    if (!success) {
+        for (size_t i = 0; i < count; i++) {
+            if (textures[i]) evk_texture2d_destroy(textures[i]);
+            textures[i] = NULL;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (images[i].pixels) stbi_image_free(images[i].pixels);
+    }
+    EVK_FREE(images);
+
+    if (staging != VK_NULL_HANDLE) vkDestroyBuffer(device, staging, evk_get_vulkan_allocator());
+    if (stagingMem != VK_NULL_HANDLE) vkFreeMemory(device, stagingMem, evk_get_vulkan_allocator());
+
+    const double endTime = ievk_texture_batch_now_ms();
+    batchStats.uploadMs = endTime - decodeTime;
+    batchStats.totalMs = endTime - startTime;
+    if (stats) *stats = batchStats;
+
+    return (success && batchStats.loaded == batchStats.requested) ? evk_Success : evk_Failure;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Texture Streaming
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct evkTextureStream
+{
+    evkTexture2D* texture;
+    const uint8_t* data;                // cooked texture, owned by the caller and read again every time detail comes back
+    evkCookedTextureHeader header;
+    uint64_t bytesFrom[EVK_COOKED_TEXTURE_MAX_LEVELS + 1]; // bytes of every level from the index to the last one
+    uint32_t residentBase;              // finest level currently in memory
+    uint32_t minBase;                   // finest level the device can hold, maxImageDimension2D may forbid level 0
+    uint32_t tailBase;                  // levels from here on are always resident
+    uint32_t requestedBase;             // finest level requested since the last update
+    uint32_t wantedBase;                // finest level requested on the last frame with requests
+    uint32_t targetBase;                // scratch used while planning an update
+    uint64_t lastRequestFrame;
+    struct evkTextureStream* prev;      // lru links, head is the most recently requested
+    struct evkTextureStream* next;
+};
+
+typedef struct evkTextureStreamer
+{
+    struct evkTextureStream* lruHead;
+    struct evkTextureStream* lruTail;
+    uint64_t frame;
+    evkTextureStreamStats stats;
+} evkTextureStreamer;
+
+/// @brief a residency change, the new image replaces the texture's one once the upload is done
+typedef struct evkTextureStreamChange
+{
+    struct evkTextureStream* stream;
+    uint32_t base;
+    VkImage image;
+    VkDeviceMemory mem;
+    VkImageView view;
+    VkDeviceSize stagingOffset;
+} evkTextureStreamChange;
+
+static evkTextureStreamer* g_EVKTextureStreamer = NULL;
+
+/// @brief returns the size of a level, never below one texel
+static VkExtent2D ievk_texture_stream_level_extent(const struct evkTextureStream* stream, uint32_t level)
+{
+    VkExtent2D extent;
+    extent.width = stream->header.width >> level ? stream->header.width >> level : 1;
+    extent.height = stream->header.height >> level ? stream->header.height >> level : 1;
+    return extent;
+}
+
+/// @brief removes the stream from the lru list
+static void ievk_texture_stream_unlink(evkTextureStreamer* streamer, struct evkTextureStream* stream)
+{
+    if (stream->prev) stream->prev->next = stream->next;
+    else streamer->lruHead = stream->next;
+
+    if (stream->next) stream->next->prev = stream->prev;
+    else streamer->lruTail = stream->prev;
+
+    stream->prev = NULL;
+    stream->next = NULL;
+}
+
+/// @brief moves the stream to the head of the lru list
+static void ievk_texture_stream_touch(evkTextureStreamer* streamer, struct evkTextureStream* stream)
+{
+    if (streamer->lruHead == stream) return;
+
+    // a new stream isn't in the list yet, unlinking it would clear the head and tail
+    if (stream->prev || stream->next) ievk_texture_stream_unlink(streamer, stream);
+    stream->next = streamer->lruHead;
+    if (streamer->lruHead) streamer->lruHead->prev = stream;
+    streamer->lruHead = stream;
+    if (!streamer->lruTail) streamer->lruTail = stream;
+}
+
+/// @brief rebuilds the images of every change with the new base level, resident levels are copied image to image and missing ones come from the cooked data, all in one submission
+static evkResult ievk_texture_stream_apply(evkTextureStreamer* streamer, evkTextureStreamChange* changes, uint32_t count)
+{
+    VkDevice device = evk_get_device();
+    VkPhysicalDevice physicalDevice = evk_get_physical_device();
+    VkBuffer staging = VK_NULL_HANDLE;
+    VkDeviceMemory stagingMem = VK_NULL_HANDLE;
+    VkCommandBuffer cmdBuffer = VK_NULL_HANDLE;
+    evkResult result = evk_Success;
+    bool success = false;
+
+    // only levels finer than what's resident need to be read, everything else is already on the device
+    VkDeviceSize stagingSize = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        struct evkTextureStream* stream = changes[i].stream;
+        uint32_t residentBase = stream->texture->image != VK_NULL_HANDLE ? stream->residentBase : stream->header.mipLevels;
+
+        changes[i].stagingOffset = stagingSize;
+        for (uint32_t level = changes[i].base; level < residentBase; level++) {
+            stagingSize = ((stagingSize + 15) & ~(VkDeviceSize)15) + stream->header.levels[level].size;
+        }
+    }
+
+    do
+    {
+        if (stagingSize > 0) {
+            result = evk_device_create_buffer
+            (
+                device,
+                physicalDevice,
+                VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                stagingSize,
+                &staging,
+                &stagingMem,
+                NULL
+            );
+            if (result != evk_Success) {
+                EVK_LOG(evk_Error, "Failed to create staging buffer for texture streaming");
+                break;
+            }
+
+            uint8_t* mapped;
+            if (vkMapMemory(device, stagingMem, 0, stagingSize, 0, (void**)&mapped) != VK_SUCCESS) {
+                EVK_LOG(evk_Error, "Failed to map staging memory for texture streaming");
+                result = evk_Failure;
+                break;
+            }
+
+            for (uint32_t i = 0; i < count; i++) {
+                struct evkTextureStream* stream = changes[i].stream;
+                uint32_t residentBase = stream->texture->image != VK_NULL_HANDLE ? stream->residentBase : stream->header.mipLevels;
+                VkDeviceSize offset = changes[i].stagingOffset;
+
+                for (uint32_t level = changes[i].base; level < residentBase; level++) {
+                    offset = (offset + 15) & ~(VkDeviceSize)15;
+                    memcpy(mapped + offset, stream->data + stream->header.levels[level].offset, (size_t)stream->header.levels[level].size);
+                    offset += stream->header.levels[level].size;
+                }
+            }
+            vkUnmapMemory(device, stagingMem);
+        }
+
+        // new images and views first, nothing on the old ones is touched until they all exist
+        for (uint32_t i = 0; i < count && result == evk_Success; i++) {
+            struct evkTextureStream* stream = changes[i].stream;
+            const VkFormat format = (VkFormat)stream->header.format;
+            uint32_t mipLevels = stream->header.mipLevels - changes[i].base;
+
+            result = evk_device_create_image
+            (
+                ievk_texture_stream_level_extent(stream, changes[i].base),
+                mipLevels,
+                1,
+                device,
+                physicalDevice,
+                &changes[i].image,
+                &changes[i].mem,
+                format,
+                evk_Msaa_Off,
+                VK_IMAGE_TILING_OPTIMAL,
+                VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                0
+            );
+            if (result != evk_Success) {
+                EVK_LOG(evk_Error, "Failed to create vulkan image for a streamed texture");
+                break;
+            }
+
+            result = evk_device_create_image_view(device, changes[i].image, format, VK_IMAGE_ASPECT_COLOR_BIT, mipLevels, 1, VK_IMAGE_VIEW_TYPE_2D, NULL, &changes[i].view);
+            if (result != evk_Success) {
+                EVK_LOG(evk_Error, "Failed to create image view for a streamed texture");
+                break;
+            }
+        }
+        if (result != evk_Success) break;
+
+        evkRenderphaseType renderphaseType = evk_using_viewport() ? evk_Renderphase_Type_Viewport : evk_Renderphase_Type_Main;
+        VkCommandPool cmdPool = evk_get_command_pool(renderphaseType);
+
+        cmdBuffer = evk_device_begin_commandbuffer_singletime(device, cmdPool);
+        if (!cmdBuffer) {
+            EVK_LOG(evk_Error, "Failed to begin command buffer for texture streaming");
+            result = evk_Failure;
+            break;
+        }
+
+        for (uint32_t i = 0; i < count; i++) {
+            struct evkTextureStream* stream = changes[i].stream;
+            evkTexture2D* texture = stream->texture;
+            uint32_t mipLevels = stream->header.mipLevels - changes[i].base;
+            uint32_t residentBase = texture->image != VK_NULL_HANDLE ? stream->residentBase : stream->header.mipLevels;
+
+            VkImageMemoryBarrier barriers[2] = { 0 };
+            barriers[0].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barriers[0].srcAccessMask = 0;
+            barriers[0].dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barriers[0].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barriers[0].newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barriers[0].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barriers[0].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barriers[0].image = changes[i].image;
+            barriers[0].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            barriers[0].subresourceRange.baseMipLevel = 0;
+            barriers[0].subresourceRange.levelCount = mipLevels;
+            barriers[0].subresourceRange.baseArrayLayer = 0;
+            barriers[0].subresourceRange.layerCount = 1;
+
+            // the old image is only read from, it's destroyed once the submission is done
+            barriers[1] = barriers[0];
+            barriers[1].srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            barriers[1].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+            barriers[1].oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            barriers[1].newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            barriers[1].image = texture->image;
+            barriers[1].subresourceRange.levelCount = (uint32_t)texture->mipLevel;
+
+            uint32_t barrierCount = texture->image != VK_NULL_HANDLE ? 2 : 1;
+            vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, NULL, 0, NULL, barrierCount, barriers);
+
+            VkDeviceSize offset = changes[i].stagingOffset;
+            for (uint32_t level = changes[i].base; level < stream->header.mipLevels; level++) {
+                VkExtent2D extent = ievk_texture_stream_level_extent(stream, level);
+
+                if (level >= residentBase) {
+                    VkImageCopy copy = { 0 };
+                    copy.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                    copy.srcSubresource.mipLevel = level - residentBase;
+                    copy.srcSubresource.baseArrayLayer = 0;
+                    copy.srcSubresource.layerCount = 1;
+                    copy.dstSubresource = copy.srcSubresource;
+                    copy.dstSubresource.mipLevel = level - changes[i].base;
+                    copy.extent.width = extent.width;
+                    copy.extent.height = extent.height;
+                    copy.extent.depth = 1;
+                    vkCmdCopyImage(cmdBuffer, texture->image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, changes[i].image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copy);
+                    continue;
+                }
+
+                offset = (offset + 15) & ~(VkDeviceSize)15;
+
+                VkBufferImageCopy region = { 0 };
+                region.bufferOffset = offset;
+                region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                region.imageSubresource.mipLevel = level - changes[i].base;
+                region.imageSubresource.baseArrayLayer = 0;
+                region.imageSubresource.layerCount = 1;
+                region.imageExtent.width = extent.width;
+                region.imageExtent.height = extent.height;
+                region.imageExtent.depth = 1;
+                vkCmdCopyBufferToImage(cmdBuffer, staging, changes[i].image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+                offset += stream->header.levels[level].size;
+            }
+
+            barriers[0].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barriers[0].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            barriers[0].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barriers[0].newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, NULL, 0, NULL, 1, barriers);
+        }
+
+        // waits for the queue to be idle, so neither the old images nor the descriptors below are in use anymore
+        result = evk_device_end_commandbuffer_singletime(device, cmdPool, cmdBuffer, evk_get_graphics_queue());
+        if (result != evk_Success) {
+            EVK_LOG(evk_Error, "Failed to submit command buffer for texture streaming");
+            break;
+        }
+
+        for (uint32_t i = 0; i < count; i++) {
+            struct evkTextureStream* stream = changes[i].stream;
+            evkTexture2D* texture = stream->texture;
+
+            if (texture->view != VK_NULL_HANDLE) vkDestroyImageView(device, texture->view, evk_get_vulkan_allocator());
+            if (texture->image != VK_NULL_HANDLE) vkDestroyImage(device, texture->image, evk_get_vulkan_allocator());
+            if (texture->mem != VK_NULL_HANDLE) vkFreeMemory(device, texture->mem, evk_get_vulkan_allocator());
+
+            if (changes[i].base < stream->residentBase) streamer->stats.levelsUploaded += stream->residentBase - changes[i].base;
+            else streamer->stats.levelsEvicted += changes[i].base - stream->residentBase;
+
+            streamer->stats.residentBytes -= stream->bytesFrom[stream->residentBase];
+            streamer->stats.residentBytes += stream->bytesFrom[changes[i].base];
+
+            texture->image = changes[i].image;
+            texture->mem = changes[i].mem;
+            texture->view = changes[i].view;
+            texture->mipLevel = (int32_t)(stream->header.mipLevels - changes[i].base);
+            texture->generation++;
+            stream->residentBase = changes[i].base;
+
+            changes[i].image = VK_NULL_HANDLE;
+            changes[i].mem = VK_NULL_HANDLE;
+            changes[i].view = VK_NULL_HANDLE;
+
+            // the ui descriptor belongs to the texture, sprites notice the generation and rewrite their own
+            if (texture->descriptor != VK_NULL_HANDLE) {
+                VkDescriptorImageInfo imageInfo = { 0 };
+                imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                imageInfo.imageView = texture->view;
+                imageInfo.sampler = texture->sampler;
+
+                VkWriteDescriptorSet desc = { 0 };
+                desc.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                desc.dstSet = texture->descriptor;
+                desc.dstBinding = 0;
+                desc.dstArrayElement = 0;
+                desc.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                desc.descriptorCount = 1;
+                desc.pImageInfo = &imageInfo;
+                vkUpdateDescriptorSets(device, 1, &desc, 0, NULL);
+            }
+        }
+
+        streamer->stats.uploadedBytes += stagingSize;
+        success = true;
+    } while (0);
+
+    // cleanup, failed changes keep their textures as they were
+    for (uint32_t i = 0; i < count; i++) {
+        if (changes[i].view != VK_NULL_HANDLE) vkDestroyImageView(device, changes[i].view, evk_get_vulkan_allocator());
+        if (changes[i].image != VK_NULL_HANDLE) vkDestroyImage(device, changes[i].image, evk_get_vulkan_allocator());
+        if (changes[i].mem != VK_NULL_HANDLE) vkFreeMemory(device, changes[i].mem, evk_get_vulkan_allocator());
+    }
+
+    if (staging != VK_NULL_HANDLE) vkDestroyBuffer(device, staging, evk_get_vulkan_allocator());
+    if (stagingMem != VK_NULL_HANDLE) vkFreeMemory(device, stagingMem, evk_get_vulkan_allocator());
+
+    return success ? evk_Success : evk_Failure;
+}
+
+static void ievk_texture_stream_release(evkTexture2D* texture)
+{
+    struct evkTextureStream* stream = texture->stream;
+    evkTextureStreamer* streamer = g_EVKTextureStreamer;
+    texture->stream = NULL;
+
+    if (streamer) {
+        ievk_texture_stream_unlink(streamer, stream);
+        streamer->stats.residentBytes -= stream->bytesFrom[stream->residentBase];
+        streamer->stats.streamedTextures--;
+    }
+
+    EVK_FREE(stream);
+}
+
+evkResult evk_texture_stream_init(uint64_t budgetBytes)
+{
+    if (g_EVKTextureStreamer != NULL) return evk_Success;
+
+    g_EVKTextureStreamer = (evkTextureStreamer*)EVK_MALLOC(evk_Allocation_Tag_Drawable, sizeof(evkTextureStreamer));
+    if (!g_EVKTextureStreamer) {
+        EVK_LOG(evk_Error, "Failed to allocate memory resources for the texture streamer");
+        return evk_Failure;
+    }
+
+    memset(g_EVKTextureStreamer, 0, sizeof(evkTextureStreamer));
+    g_EVKTextureStreamer->stats.budgetBytes = budgetBytes;
+
+    return evk_Success;
+}
+
+void evk_texture_stream_shutdown()
+{
+    evkTextureStreamer* streamer = g_EVKTextureStreamer;
+    if (!streamer) return;
+
+    if (streamer->stats.streamedTextures > 0) {
+        EVK_LOG(evk_Warn, "%u streamed textures were not destroyed before shutdown", streamer->stats.streamedTextures);
+    }
+
+    // textures outliving the streamer stop streaming but remain valid
+    while (streamer->lruHead) {
+        struct evkTextureStream* stream = streamer->lruHead;
+        ievk_texture_stream_unlink(streamer, stream);
+        stream->texture->stream = NULL;
+        EVK_FREE(stream);
+    }
+
+    EVK_FREE(streamer);
+    g_EVKTextureStreamer = NULL;
+}
+
+evkTexture2D* evk_texture2d_create_streamed(const void* data, size_t dataLen)
+{
+    evkTextureStreamer* streamer = g_EVKTextureStreamer;
+    if (!streamer) return NULL;
+
+    evkCookedTextureHeader header;
+    if (!ievk_cooked_texture_read_header(data, dataLen, &header)) return NULL;
+
+    evkTexture2D* texture = (evkTexture2D*)evk_pool_alloc(&g_EVKTexturePool);
+    struct evkTextureStream* stream = (struct evkTextureStream*)EVK_MALLOC(evk_Allocation_Tag_Drawable, sizeof(struct evkTextureStream));
+    if (!texture || !stream) {
+        EVK_LOG(evk_Error, "Failed to allocate memory for a streamed texture");
+        if (texture) evk_pool_free(&g_EVKTexturePool, texture);
+        if (stream) EVK_FREE(stream);
+        return NULL;
+    }
+
+    memset(texture, 0, sizeof(evkTexture2D));
+    memset(stream, 0, sizeof(struct evkTextureStream));
+    texture->width = (int32_t)header.width;
+    texture->height = (int32_t)header.height;
+    texture->path = NULL;  // no path for streamed textures
+    texture->stream = stream;
+
+    stream->texture = texture;
+    stream->data = (const uint8_t*)data;
+    stream->header = header;
+    stream->residentBase = header.mipLevels;
+
+    for (uint32_t i = header.mipLevels; i > 0; i--) {
+        stream->bytesFrom[i - 1] = stream->bytesFrom[i] + header.levels[i - 1].size;
+    }
+
+    // the tail is the first level small enough to always be kept, levels the device can't hold are never streamed in
+    uint32_t maxDimension = evk_get_physical_device_properties().limits.maxImageDimension2D;
+    stream->tailBase = header.mipLevels - 1;
+    stream->minBase = header.mipLevels - 1;
+
+    for (uint32_t i = header.mipLevels; i > 0; i--) {
+        VkExtent2D extent = ievk_texture_stream_level_extent(stream, i - 1);
+        uint32_t largest = extent.width > extent.height ? extent.width : extent.height;
+
+        if (largest <= EVK_TEXTURE_STREAM_TAIL_SIZE) stream->tailBase = i - 1;
+        if (largest <= maxDimension) stream->minBase = i - 1;
+    }
+
+    stream->requestedBase = stream->tailBase;
+    stream->wantedBase = stream->tailBase;
+
+    bool success = false;
+
+    do
+    {
+        evkTextureStreamChange change = { 0 };
+        change.stream = stream;
+        change.base = stream->tailBase;
+
+        if (ievk_texture_stream_apply(streamer, &change, 1) != evk_Success) {
+            EVK_LOG(evk_Error, "Failed to upload the mip tail of a streamed texture");
+            break;
+        }
+
+        evkSamplerState samplerState = evk_sampler_state_default(VK_FILTER_LINEAR, VK_SAMPLER_ADDRESS_MODE_REPEAT);
+        texture->sampler = evk_sampler_cache_get(&samplerState);
+        if (texture->sampler == VK_NULL_HANDLE) {
+            EVK_LOG(evk_Error, "Failed to create sampler for a streamed texture");
+            break;
+        }
+
+        if (evk_device_create_image_descriptor_set(evk_get_device(), evk_get_ui_descriptor_pool(), evk_get_ui_descriptor_set_layout(), texture->sampler, texture->view, &texture->descriptor) != evk_Success) {
+            EVK_LOG(evk_Error, "Failed to create descriptor set for a streamed texture");
+            break;
+        }
+
+        success = true;
+    } while (0);
+
+    if (!success) {
+        streamer->stats.residentBytes -= stream->bytesFrom[stream->residentBase];
+        texture->stream = NULL;
+        EVK_FREE(stream);
+        evk_texture2d_destroy(texture);
+        return NULL;
+    }
+
+    stream->lastRequestFrame = streamer->frame;
+    ievk_texture_stream_touch(streamer, stream);
+    streamer->stats.streamedTextures++;
+
+    return texture;
+}
+
+void evk_texture2d_request_lod(evkTexture2D* texture, float lod)
+{
+    evkTextureStreamer* streamer = g_EVKTextureStreamer;
+    if (!streamer || !texture || !texture->stream) return;
+
+    struct evkTextureStream* stream = texture->stream;
+    uint32_t base = lod > 0.0f ? (uint32_t)lod : 0;
+
+    if (base < stream->minBase) base = stream->minBase;
+    if (base > stream->tailBase) base = stream->tailBase;
+
+    // requests are consumed by the next update, several of them before it keep the finest level
+    uint64_t pending = streamer->frame + 1;
+    if (stream->lastRequestFrame != pending || base < stream->requestedBase) {
+        stream->requestedBase = base;
+    }
+
+    stream->lastRequestFrame = pending;
+    ievk_texture_stream_touch(streamer, stream);
+}
+
+void evk_texture2d_request_screen_size(evkTexture2D* texture, float2 screenSize)
+{
+    if (!texture || screenSize.xy.x <= 0.0f || screenSize.xy.y <= 0.0f) return;
+
+    // the level whose texels map one to one on screen, the larger axis decides
+    float ratioX = (float)texture->width / screenSize.xy.x;
+    float ratioY = (float)texture->height / screenSize.xy.y;
+    float ratio = ratioX > ratioY ? ratioX : ratioY;
+
+    evk_texture2d_request_lod(texture, ratio > 1.0f ? log2f(ratio) : 0.0f);
+}
+
+void evk_texture_stream_update()
+{
+    evkTextureStreamer* streamer = g_EVKTextureStreamer;
+    if (!streamer || !streamer->lruHead) {
+        if (streamer) streamer->frame++;
+        return;
+    }
+
+    streamer->frame++;
+    const uint64_t budget = streamer->stats.budgetBytes;
+    uint64_t resident = 0;
+
+    // what every texture wants, detail nobody asked for in a while goes back to the tail
+    for (struct evkTextureStream* stream = streamer->lruHead; stream; stream = stream->next) {
+        if (stream->lastRequestFrame == streamer->frame) {
+            stream->wantedBase = stream->requestedBase;
+        }
+        else if (streamer->frame - stream->lastRequestFrame > EVK_TEXTURE_STREAM_IDLE_FRAMES) {
+            stream->wantedBase = stream->tailBase;
+        }
+
+        stream->targetBase = stream->wantedBase > stream->residentBase ? stream->wantedBase : stream->residentBase;
+        resident += stream->bytesFrom[stream->targetBase];
+    }
+
+    // most recently requested textures grow first, taking detail away from the least recently requested ones when over budget
+    for (struct evkTextureStream* stream = streamer->lruHead; stream; stream = stream->next) {
+        if (stream->wantedBase >= stream->targetBase) continue;
+
+        for (uint32_t base = stream->wantedBase; base < stream->targetBase; base++) {
+            uint64_t need = stream->bytesFrom[base] - stream->bytesFrom[stream->targetBase];
+
+            for (struct evkTextureStream* victim = streamer->lruTail; budget > 0 && resident + need > budget && victim != stream; victim = victim->prev) {
+                if (victim->targetBase >= victim->tailBase) continue;
+
+                resident -= victim->bytesFrom[victim->targetBase] - victim->bytesFrom[victim->tailBase];
+                victim->targetBase = victim->tailBase;
+            }
+
+            if (budget == 0 || resident + need <= budget) {
+                resident += need;
+                stream->targetBase = base;
+                break;
+            }
+        }
+
+        if (stream->targetBase > stream->wantedBase) streamer->stats.budgetMisses++;
+    }
+
+    // a lowered budget is honored even when nothing grows, only the tails may stay above it
+    for (struct evkTextureStream* victim = streamer->lruTail; budget > 0 && resident > budget && victim; victim = victim->prev) {
+        if (victim->targetBase >= victim->tailBase) continue;
+
+        resident -= victim->bytesFrom[victim->targetBase] - victim->bytesFrom[victim->tailBase];
+        victim->targetBase = victim->tailBase;
+    }
+
+    uint32_t count = 0;
+    for (struct evkTextureStream* stream = streamer->lruHead; stream; stream = stream->next) {
+        if (stream->targetBase != stream->residentBase) count++;
+    }
+    if (count == 0) return;
+
+    evkTextureStreamChange* changes = (evkTextureStreamChange*)evk_frame_arena_alloc(evk_get_frame_arena(), sizeof(evkTextureStreamChange) * count, 0);
+    if (!changes) {
+        EVK_LOG(evk_Error, "Failed to allocate memory for %u texture residency changes", count);
+        return;
+    }
+    memset(changes, 0, sizeof(evkTextureStreamChange) * count);
+
+    uint32_t index = 0;
+    for (struct evkTextureStream* stream = streamer->lruHead; stream; stream = stream->next) {
+        if (stream->targetBase == stream->residentBase) continue;
+
+        changes[index].stream = stream;
+        changes[index].base = stream->targetBase;
+        index++;
+    }
+
+    if (ievk_texture_stream_apply(streamer, changes, count) != evk_Success) {
+        EVK_LOG(evk_Error, "Failed to change the residency of %u streamed textures", count);
+    }
+}
+
+void evk_texture_stream_set_budget(uint64_t budgetBytes)
+{
+    if (!g_EVKTextureStreamer) return;
+    g_EVKTextureStreamer->stats.budgetBytes = budgetBytes;
+}
+
+evkTextureStreamStats evk_texture_stream_get_stats()
+{
+    evkTextureStreamStats stats = { 0 };
+    if (!g_EVKTextureStreamer) return stats;
+
+    return g_EVKTextureStreamer->stats;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Texture Cache
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct evkTextureCacheEntry
+{
+    evkTexture2D* texture;
+    darray* paths;                      // char* of every path resolving to this entry, owned, the first one is the texture's path
+    char contentKey[17];                // hex of the pixels hash
+    uint64_t contentCheck;              // independent hash of the pixels, a key match only aliases the entry when it agrees too
+    bool contentIndexed;                // false when another entry already held the key, so only it's paths reach this one
+    uint32_t slot;                      // 1 when created for the ui, since it changes the mip chain
+    uint32_t refCount;
+    uint64_t bytes;
+    struct evkTextureCacheEntry* prev;  // lru links, only valid while unreferenced
+    struct evkTextureCacheEntry* next;
+};
+
+typedef struct evkTextureCache
+{
+    shashtable* paths[2];               // path -> entry, per slot
+    shashtable* contents[2];            // content key -> entry, per slot
+    struct evkTextureCacheEntry* lruHead; // least recently released, first to go
+    struct evkTextureCacheEntry* lruTail;
+    evkTextureCacheStats stats;
+} evkTextureCache;
+
+static evkTextureCache* g_EVKTextureCache = NULL;
+
+/// @brief hashes the pixels word by word with a multiply and fold, unrelated to fnv-1a so a collision of the key is not one of the check
+static uint64_t ievk_texture_cache_content_check(const uint8_t* pixels, size_t pixelsLen)
+{
+    uint64_t hash = 0x9E3779B97F4A7C15ULL ^ (uint64_t)pixelsLen;
+    size_t i = 0;
+
+    for (; i + 8 <= pixelsLen; i += 8) {
+        uint64_t word;
+        memcpy(&word, pixels + i, sizeof(word));
+        hash = (hash ^ word) * 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 32;
+    }
+
+    for (; i < pixelsLen; i++) {
+        hash = (hash ^ pixels[i]) * 0xc4ceb9fe1a85ec53ULL;
+        hash ^= hash >> 32;
+    }
+    return hash;
+}
+
+/// @brief hashes the pixels and dimensions with fnv-1a into a hex key, so different paths of the same image share the texture
+static void ievk_texture_cache_content_key(const uint8_t* pixels, size_t pixelsLen, int32_t width, int32_t height, char outKey[17])
+{
+    uint64_t hash = 14695981039346656037ULL;
+    const uint64_t prime = 1099511628211ULL;
+
+    for (size_t i = 0; i < pixelsLen; i++) {
+        hash ^= pixels[i];
+        hash *= prime;
+    }
+
+    hash ^= (uint64_t)(uint32_t)width;
+    hash *= prime;
+    hash ^= (uint64_t)(uint32_t)height;
+    hash *= prime;
+
+    snprintf(outKey, 17, "%016llx", (unsigned long long)hash);
+}
+
+/// @brief estimates how much device memory the texture occupies, mips included
+static uint64_t ievk_texture_cache_estimate_bytes(evkTexture2D* texture)
+{
+    uint64_t bytes = 0;
+    uint32_t width = (uint32_t)texture->width;
+    uint32_t height = (uint32_t)texture->height;
+
+    for (int32_t i = 0; i < texture->mipLevel; i++) {
+        bytes += (uint64_t)width * height * 4;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+
+    return bytes;
+}
+
+/// @brief removes the entry from the lru list
+static void ievk_texture_cache_unlink(evkTextureCache* cache, struct evkTextureCacheEntry* entry)
+{
+    if (entry->prev) entry->prev->next = entry->next;
+    else cache->lruHead = entry->next;
+
+    if (entry->next) entry->next->prev = entry->prev;
+    else cache->lruTail = entry->prev;
+
+    entry->prev = NULL;
+    entry->next = NULL;
+}
+
+/// @brief takes a reference, pulling the entry out of the lru list if it was unreferenced
+static void ievk_texture_cache_ref(evkTextureCache* cache, struct evkTextureCacheEntry* entry)
+{
+    if (entry->refCount == 0) {
+        ievk_texture_cache_unlink(cache, entry);
+    }
+
+    entry->refCount++;
+}
+
+/// @brief registers another path for the entry
+static evkResult ievk_texture_cache_add_path(evkTextureCache* cache, struct evkTextureCacheEntry* entry, const char* path)
+{
+    size_t len = strlen(path) + 1;
+    char* copy = (char*)EVK_MALLOC(evk_Allocation_Tag_Drawable, len);
+    if (!copy) return evk_Failure;
+
+    memcpy(copy, path, len);
+
+    if (darray_push_back(entry->paths, &copy) != CTOOLBOX_SUCCESS) {
+        EVK_FREE(copy);
+        return evk_Failure;
+    }
+
+    if (shashtable_insert(cache->paths[entry->slot], copy, entry) != CTOOLBOX_SUCCESS) {
+        darray_pop_back(entry->paths, NULL);
+        EVK_FREE(copy);
+        return evk_Failure;
+    }
+
+    return evk_Success;
+}
+
+/// @brief destroys the entry's texture and forgets every key pointing to it, the entry must be unreferenced
+static void ievk_texture_cache_evict(evkTextureCache* cache, struct evkTextureCacheEntry* entry)
+{
+    ievk_texture_cache_unlink(cache, entry);
+
+    for (size_t i = 0; i < darray_size(entry->paths); i++) {
+        char* path = NULL;
+        darray_get(entry->paths, i, &path);
+        shashtable_delete(cache->paths[entry->slot], path);
+        EVK_FREE(path);
+    }
+
+    darray_destroy(entry->paths);
+    if (entry->contentIndexed) shashtable_delete(cache->contents[entry->slot], entry->contentKey);
+
+    cache->stats.residentBytes -= entry->bytes;
+    cache->stats.textureCount--;
+
+    evk_texture2d_destroy(entry->texture);
+    EVK_FREE(entry);
+}
+
+/// @brief evicts unreferenced textures, least recently released first, while the cache is over budget
+static void ievk_texture_cache_enforce_budget(evkTextureCache* cache)
+{
+    if (cache->stats.budgetBytes == 0) return;
+    if (cache->stats.residentBytes <= cache->stats.budgetBytes || cache->lruHead == NULL) return;
+
+    // released textures may still be referenced by frames in flight
+    vkDeviceWaitIdle(evk_get_device());
+
+    while (cache->stats.residentBytes > cache->stats.budgetBytes && cache->lruHead != NULL) {
+        ievk_texture_cache_evict(cache, cache->lruHead);
+        cache->stats.evictions++;
+    }
+}
+
+evkResult evk_texture_cache_init(uint64_t budgetBytes)
+{
+    if (g_EVKTextureCache != NULL) return evk_Success;
+
+    g_EVKTextureCache = (evkTextureCache*)EVK_MALLOC(evk_Allocation_Tag_Drawable, sizeof(evkTextureCache));
+    if (!g_EVKTextureCache) {
+        EVK_LOG(evk_Error, "Failed to allocate memory resources for the texture cache");
+        return evk_Failure;
+    }
+
+    memset(g_EVKTextureCache, 0, sizeof(evkTextureCache));
+    g_EVKTextureCache->stats.budgetBytes = budgetBytes;
+
+    for (uint32_t i = 0; i < 2; i++) {
+        g_EVKTextureCache->paths[i] = shashtable_init_memfuncs(evk_get_container_memfuncs());
+        g_EVKTextureCache->contents[i] = shashtable_init_memfuncs(evk_get_container_memfuncs());
+    }
+
+    return evk_Success;
+}
+
+void evk_texture_cache_shutdown()
+{
+    evkTextureCache* cache = g_EVKTextureCache;
+    if (!cache) return;
+
+    evk_texture_cache_trim();
+
+    if (cache->stats.textureCount > 0) {
+        EVK_LOG(evk_Warn, "%u cached textures are still referenced at shutdown", cache->stats.textureCount);
+    }
+
+    for (uint32_t i = 0; i < 2; i++) {
+        shashtable_destroy(cache->paths[i]);
+        shashtable_destroy(cache->contents[i]);
+    }
+
+    EVK_FREE(cache);
+    g_EVKTextureCache = NULL;
+}
+
+evkTexture2D* evk_texture_cache_acquire(const char* path, bool ui)
+{
+    if (path == NULL) return NULL;
+
+    evkTextureCache* cache = g_EVKTextureCache;
+    if (!cache) {
+        EVK_LOG(evk_Error, "Texture cache is not initialized");
+        return NULL;
+    }
+
+    const uint32_t slot = ui ? 1 : 0;
+
+    // same path
+    struct evkTextureCacheEntry* entry = (struct evkTextureCacheEntry*)shashtable_lookup(cache->paths[slot], path);
+    if (entry) {
+        ievk_texture_cache_ref(cache, entry);
+        cache->stats.hits++;
+        return entry->texture;
+    }
+
+    int32_t width = 0;
+    int32_t height = 0;
+    int32_t channels = 0;
+    uint8_t* pixels = stbi_load(path, &width, &height, &channels, 4);
+    if (!pixels) {
+        EVK_LOG(evk_Error, "Failed to load texture %s because: %s", path, stbi_failure_reason());
+        return NULL;
+    }
+
+    size_t pixelsLen = (size_t)width * height * 4;
+    char contentKey[17];
+    ievk_texture_cache_content_key(pixels, pixelsLen, width, height, contentKey);
+    uint64_t contentCheck = ievk_texture_cache_content_check(pixels, pixelsLen);
+
+    // same pixels under another path, a key that matches with another size or check is a collision and the image gets it's own texture
+    entry = (struct evkTextureCacheEntry*)shashtable_lookup(cache->contents[slot], contentKey);
+    bool collided = entry && (entry->texture->width != width || entry->texture->height != height || entry->contentCheck != contentCheck);
+    if (collided) {
+        EVK_LOG(evk_Warn, "Texture %s collides with the content key of %s, it won't be shared", path, entry->texture->path);
+    }
+
+    if (entry && !collided) {
+        stbi_image_free(pixels);
+
+        if (ievk_texture_cache_add_path(cache, entry, path) != evk_Success) {
+            EVK_LOG(evk_Error, "Failed to register %s into the texture cache", path);
+            return NULL;
+        }
+
+        ievk_texture_cache_ref(cache, entry);
+        cache->stats.hits++;
+        cache->stats.contentHits++;
+        return entry->texture;
+    }
+
+    evkTexture2D* texture = evk_texture2d_create_from_buffer(pixels, pixelsLen, width, height, ui);
+    stbi_image_free(pixels);
+
+    if (!texture) {
+        EVK_LOG(evk_Error, "Failed to create texture for %s", path);
+        return NULL;
+    }
+
+    bool success = false;
+
+    do
+    {
+        entry = (struct evkTextureCacheEntry*)EVK_MALLOC(evk_Allocation_Tag_Drawable, sizeof(struct evkTextureCacheEntry));
+        if (!entry) {
+            EVK_LOG(evk_Error, "Out of memory to cache texture %s", path);
+            break;
+        }
+
+        memset(entry, 0, sizeof(struct evkTextureCacheEntry));
+        memcpy(entry->contentKey, contentKey, sizeof(contentKey));
+        entry->contentCheck = contentCheck;
+        entry->texture = texture;
+        entry->slot = slot;
+        entry->bytes = ievk_texture_cache_estimate_bytes(texture);
+        entry->paths = darray_init_memfuncs(sizeof(char*), 1, evk_get_container_memfuncs());
+
+        if (!entry->paths || ievk_texture_cache_add_path(cache, entry, path) != evk_Success) {
+            EVK_LOG(evk_Error, "Failed to register %s into the texture cache", path);
+            break;
+        }
+
+        if (!collided) {
+            if (shashtable_insert(cache->contents[slot], contentKey, entry) != CTOOLBOX_SUCCESS) {
+                EVK_LOG(evk_Error, "Failed to register %s content into the texture cache", path);
+                shashtable_delete(cache->paths[slot], path);
+                break;
+            }
+            entry->contentIndexed = true;
+        }
+
+        success = true;
+    } while (0);
+
+    if (!success) {
+        if (entry) {
+            if (entry->paths) {
+                for (size_t i = 0; i < darray_size(entry->paths); i++) {
+                    char* entryPath = NULL;
+                    darray_get(entry->paths, i, &entryPath);
+                    EVK_FREE(entryPath);
+                }
+                darray_destroy(entry->paths);
+            }
+            EVK_FREE(entry);
+        }
+        evk_texture2d_destroy(texture);
+        return NULL;
+    }
+
+    texture->path = *(char* const*)darray_const_peek(entry->paths, 0);
+    texture->cacheEntry = entry;
+    entry->refCount = 1;
+
+    cache->stats.misses++;
+    cache->stats.residentBytes += entry->bytes;
+    cache->stats.textureCount++;
+    ievk_texture_cache_enforce_budget(cache);
+
+    return texture;
+}
+
+void evk_texture_cache_release(evkTexture2D* texture)
+{
+    if (!texture) return;
+
+    evkTextureCache* cache = g_EVKTextureCache;
+    struct evkTextureCacheEntry* entry = texture->cacheEntry;
+
+    if (!cache || !entry) {
+        EVK_LOG(evk_Warn, "Texture was not acquired from the texture cache, use evk_texture2d_destroy instead");
+        return;
+    }
+
+    EVK_ASSERT(entry->refCount > 0, "Texture cache entry released more times than acquired");
+    entry->refCount--;
+
+    if (entry->refCount == 0) {
+        entry->prev = cache->lruTail;
+        entry->next = NULL;
+
+        if (cache->lruTail) cache->lruTail->next = entry;
+        else cache->lruHead = entry;
+
+        cache->lruTail = entry;
+        ievk_texture_cache_enforce_budget(cache);
+    }
+}
+
+void evk_texture_cache_set_budget(uint64_t budgetBytes)
+{
+    if (!g_EVKTextureCache) return;
+
+    g_EVKTextureCache->stats.budgetBytes = budgetBytes;
+    ievk_texture_cache_enforce_budget(g_EVKTextureCache);
+}
+
+void evk_texture_cache_trim()
+{
+    evkTextureCache* cache = g_EVKTextureCache;
+    if (!cache || cache->lruHead == NULL) return;
+
+    vkDeviceWaitIdle(evk_get_device());
+
+    while (cache->lruHead != NULL) {
+        ievk_texture_cache_evict(cache, cache->lruHead);
+        cache->stats.evictions++;
+    }
+}
+
+evkTextureCacheStats evk_texture_cache_get_stats()
+{
+    evkTextureCacheStats stats = { 0 };
+    if (!g_EVKTextureCache) return stats;
+
+    stats = g_EVKTextureCache->stats;
+    uint64_t requests = stats.hits + stats.misses;
+    stats.hitRate = requests > 0 ? (float)((double)stats.hits / (double)requests) : 0.0f;
+
+    return stats;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Atlas
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief a horizontal segment of the skyline, everything below y is already occupied
+typedef struct evkAtlasSkylineNode
+{
+    int32_t x;
+    int32_t y;
+    int32_t width;
+} evkAtlasSkylineNode;
+
+struct evkAtlas
+{
+    uint32_t pageSize;
+    uint32_t maxPages;
+    uint32_t padding;
+    uint32_t alignment;         // placement granularity, keeps padding intact on every generated mip
+    uint32_t mipLevels;
+    uint32_t pageCount;
+    uint8_t** pages;            // RGBA8 pixels of each page, released once built
+    darray** skylines;          // one skyline per page
+    darray* regions;            // evkAtlasRegion* owned by the atlas, used for cleanup
+    shashtable* lookup;         // name -> evkAtlasRegion*
+    bool built;
+
+    VkImage image;
+    VkDeviceMemory mem;
+    VkImageView arrayView;
+    VkImageView* pageViews;
+    VkSampler sampler;          // shared, owned by the sampler cache
+};
+
+/// @brief rounds value up to a multiple of alignment, alignment must be a power of two
+static uint32_t ievk_atlas_align(uint32_t value, uint32_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/// @brief checks if a rect fits when placed at the given skyline node, returning the resting y
+static bool ievk_atlas_skyline_fit(darray* skyline, size_t index, int32_t width, int32_t height, int32_t pageSize, int32_t* outY)
+{
+    const evkAtlasSkylineNode* node = (const evkAtlasSkylineNode*)darray_const_peek(skyline, index);
+    if (node->x + width > pageSize) return false;
+
+    int32_t y = node->y;
+    int32_t widthLeft = width;
+    size_t count = darray_size(skyline);
+
+    while (widthLeft > 0) {
+        if (index >= count) return false;
+
+        node = (const evkAtlasSkylineNode*)darray_const_peek(skyline, index);
+        if (node->y > y) y = node->y;
+        if (y + height > pageSize) return false;
+
+        widthLeft -= node->width;
+        index++;
+    }
+
+    *outY = y;
+    return true;
+}
+
+/// @brief finds the bottom-left position for a rect, returns false if the page has no room
+static bool ievk_atlas_skyline_find(darray* skyline, int32_t width, int32_t height, int32_t pageSize, size_t* outIndex, int32_t* outX, int32_t* outY)
+{
+    int32_t bestY = INT32_MAX;
+    int32_t bestWidth = INT32_MAX;
+    bool found = false;
+
+    for (size_t i = 0; i < darray_size(skyline); i++) {
+        int32_t y = 0;
+        if (!ievk_atlas_skyline_fit(skyline, i, width, height, pageSize, &y)) continue;
+
+        const evkAtlasSkylineNode* node = (const evkAtlasSkylineNode*)darray_const_peek(skyline, i);
+        if (y + height < bestY || (y + height == bestY && node->width < bestWidth)) {
+            bestY = y + height;
+            bestWidth = node->width;
+            *outIndex = i;
+            *outX = node->x;
+            *outY = y;
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+/// @brief raises the skyline where the rect was placed, trimming and merging the nodes it covers
+static void ievk_atlas_skyline_add(darray* skyline, size_t index, int32_t x, int32_t y, int32_t width, int32_t height)
+{
+    evkAtlasSkylineNode newNode = { x, y + height, width };
+    darray_insert_at(skyline, index, &newNode);
+
+    for (size_t i = index + 1; i < darray_size(skyline); i++) {
+        evkAtlasSkylineNode prev = { 0 };
+        evkAtlasSkylineNode node = { 0 };
+        darray_get(skyline, i - 1, &prev);
+        darray_get(skyline, i, &node);
+
+        if (node.x >= prev.x + prev.width) break;
+
+        int32_t shrink = prev.x + prev.width - node.x;
+        node.x += shrink;
+        node.width -= shrink;
+
+        if (node.width > 0) {
+            darray_set(skyline, i, &node);
+            break;
+        }
+
+        darray_remove_at(skyline, i, NULL);
+        i--;
+    }
+
+    for (size_t i = 0; i + 1 < darray_size(skyline); i++) {
+        evkAtlasSkylineNode node = { 0 };
+        evkAtlasSkylineNode next = { 0 };
+        darray_get(skyline, i, &node);
+        darray_get(skyline, i + 1, &next);
+
+        if (node.y == next.y) {
+            node.width += next.width;
+            darray_set(skyline, i, &node);
+            darray_remove_at(skyline, i + 1, NULL);
+            i--;
+        }
+    }
+}
+
+/// @brief opens a new blank page on the atlas
+static evkResult ievk_atlas_add_page(evkAtlas* atlas)
+{
+    if (atlas->pageCount >= atlas->maxPages) return evk_Failure;
+
+    size_t pageBytes = (size_t)atlas->pageSize * atlas->pageSize * 4;
+    uint8_t* page = (uint8_t*)EVK_MALLOC(evk_Allocation_Tag_Drawable, pageBytes);
+    darray* skyline = darray_init_memfuncs(sizeof(evkAtlasSkylineNode), 16, evk_get_container_memfuncs());
+
+    if (!page || !skyline) {
+        if (page) EVK_FREE(page);
+        if (skyline) darray_destroy(skyline);
+        EVK_LOG(evk_Error, "Out of memory to allocate atlas page");
+        return evk_Failure;
+    }
+
+    memset(page, 0, pageBytes);
+    evkAtlasSkylineNode root = { 0, 0, (int32_t)atlas->pageSize };
+    darray_push_back(skyline, &root);
+
+    atlas->pages[atlas->pageCount] = page;
+    atlas->skylines[atlas->pageCount] = skyline;
+    atlas->pageCount++;
+    return evk_Success;
+}
+
+/// @brief copies the image into the page and extrudes it's edges over the padding so filtering never reaches a neighbour
+static void ievk_atlas_write_pixels(evkAtlas* atlas, uint32_t layer, uint32_t x, uint32_t y, const uint8_t* pixels, uint32_t width, uint32_t height)
+{
+    uint8_t* page = atlas->pages[layer];
+    int32_t padding = (int32_t)atlas->padding;
+
+    for (int32_t dy = -padding; dy < (int32_t)height + padding; dy++) {
+        int32_t sy = dy < 0 ? 0 : (dy >= (int32_t)height ? (int32_t)height - 1 : dy);
+        uint8_t* dstRow = page + ((size_t)(y + dy) * atlas->pageSize) * 4;
+
+        for (int32_t dx = -padding; dx < (int32_t)width + padding; dx++) {
+            int32_t sx = dx < 0 ? 0 : (dx >= (int32_t)width ? (int32_t)width - 1 : dx);
+            memcpy(dstRow + (size_t)(x + dx) * 4, pixels + ((size_t)sy * width + sx) * 4, 4);
+        }
+    }
+}
+
+evkAtlas* evk_atlas_create(uint32_t pageSize, uint32_t maxPages, uint32_t padding)
+{
+    if (pageSize == 0 || (pageSize & (pageSize - 1)) != 0 || maxPages == 0) {
+        EVK_LOG(evk_Error, "Atlas page size must be a power of two and max pages greater than zero");
+        return NULL;
+    }
+
+    evkAtlas* atlas = (evkAtlas*)EVK_MALLOC(evk_Allocation_Tag_Drawable, sizeof(evkAtlas));
+    if (!atlas) {
+        EVK_LOG(evk_Error, "Out of memory to allocate atlas");
+        return NULL;
+    }
+
+    memset(atlas, 0, sizeof(evkAtlas));
+    atlas->pageSize = pageSize;
+    atlas->maxPages = maxPages;
+    atlas->padding = padding;
+
+    // a region stays bleed-free on mip N while it's aligned to 2^N and padded by at least 2^N texels
+    atlas->mipLevels = 1;
+    while ((1U << atlas->mipLevels) <= padding && (1U << atlas->mipLevels) < pageSize) atlas->mipLevels++;
+    atlas->alignment = 1U << (atlas->mipLevels - 1);
+
+    atlas->pages = (uint8_t**)EVK_MALLOC(evk_Allocation_Tag_Drawable, sizeof(uint8_t*) * maxPages);
+    atlas->skylines = (darray**)EVK_MALLOC(evk_Allocation_Tag_Drawable, sizeof(darray*) * maxPages);
+    atlas->pageViews = (VkImageView*)EVK_MALLOC(evk_Allocation_Tag_Drawable, sizeof(VkImageView) * maxPages);
+    atlas->regions = darray_init_memfuncs(sizeof(evkAtlasRegion*), 64, evk_get_container_memfuncs());
+    atlas->lookup = shashtable_init_memfuncs(evk_get_container_memfuncs());
+
+    if (!atlas->pages || !atlas->skylines || !atlas->pageViews || !atlas->regions || !atlas->lookup) {
+        EVK_LOG(evk_Error, "Out of memory to allocate atlas resources");
+        evk_atlas_destroy(atlas);
+        return NULL;
+    }
+
+    memset(atlas->pages, 0, sizeof(uint8_t*) * maxPages);
+    memset(atlas->skylines, 0, sizeof(darray*) * maxPages);
+    memset(atlas->pageViews, 0, sizeof(VkImageView) * maxPages);
+
+    return atlas;
+}
+
+void evk_atlas_destroy(evkAtlas* atlas)
+{
+    if (!atlas) return;
+
+    VkDevice device = evk_get_device();
+
+    if (atlas->built) {
+        vkDeviceWaitIdle(device);
+    }
+
+    if (atlas->arrayView != VK_NULL_HANDLE) vkDestroyImageView(device, atlas->arrayView, evk_get_vulkan_allocator());
+    if (atlas->image != VK_NULL_HANDLE) vkDestroyImage(device, atlas->image, evk_get_vulkan_allocator());
+    if (atlas->mem != VK_NULL_HANDLE) vkFreeMemory(device, atlas->mem, evk_get_vulkan_allocator());
+
+    if (atlas->pageViews) {
+        for (uint32_t i = 0; i < atlas->pageCount; i++) {
+            if (atlas->pageViews[i] != VK_NULL_HANDLE) vkDestroyImageView(device, atlas->pageViews[i], evk_get_vulkan_allocator());
+        }
+        EVK_FREE(atlas->pageViews);
+    }
+
+    for (uint32_t i = 0; i < atlas->pageCount; i++) {
+        if (atlas->pages && atlas->pages[i]) EVK_FREE(atlas->pages[i]);
+        if (atlas->skylines && atlas->skylines[i]) darray_destroy(atlas->skylines[i]);
+    }
+
+    if (atlas->pages) EVK_FREE(atlas->pages);
+    if (atlas->skylines) EVK_FREE(atlas->skylines);
+
+    if (atlas->regions) {
+        for (size_t i = 0; i < darray_size(atlas->regions); i++) {
+            evkAtlasRegion* region = NULL;
+            darray_get(atlas->regions, i, &region);
+            EVK_FREE(region);
+        }
+        darray_destroy(atlas->regions);
+    }
+
+    if (atlas->lookup) shashtable_destroy(atlas->lookup);
+
+    EVK_FREE(atlas);
+}
+
+evkResult evk_atlas_add_from_path(evkAtlas* atlas, const char* path)
+{
+    if (!atlas || !path) return evk_Failure;
+
+    int32_t width = 0;
+    int32_t height = 0;
+    int32_t channels = 0;
+    uint8_t* pixels = stbi_load(path, &width, &height, &channels, 4);
+
+    if (!pixels) {
+        EVK_LOG(evk_Error, "Failed to load atlas image %s because: %s", path, stbi_failure_reason());
+        return evk_Failure;
+    }
+
+    evkResult result = evk_atlas_add_from_buffer(atlas, path, pixels, (uint32_t)width, (uint32_t)height);
+    stbi_image_free(pixels);
+    return result;
+}
+
+evkResult evk_atlas_add_from_buffer(evkAtlas* atlas, const char* name, const uint8_t* pixels, uint32_t width, uint32_t height)
+{
+    if (!atlas || !name || !pixels || width == 0 || height == 0) return evk_Failure;
+
+    if (atlas->built) {
+        EVK_LOG(evk_Error, "Cannot add %s, the atlas was already built", name);
+        return evk_Failure;
+    }
+
+    if (shashtable_contains(atlas->lookup, name)) {
+        return evk_Success; // already packed
+    }
+
+    int32_t paddedWidth = (int32_t)ievk_atlas_align(width + atlas->padding * 2, atlas->alignment);
+    int32_t paddedHeight = (int32_t)ievk_atlas_align(height + atlas->padding * 2, atlas->alignment);
+
+    if (paddedWidth > (int32_t)atlas->pageSize || paddedHeight > (int32_t)atlas->pageSize) {
+        EVK_LOG(evk_Error, "Image %s (%ux%u) does not fit an atlas page of %u", name, width, height, atlas->pageSize);
+        return evk_Failure;
+    }
+
+    // try every open page before opening a new one
+    uint32_t layer = 0;
+    size_t index = 0;
+    int32_t x = 0;
+    int32_t y = 0;
+    bool placed = false;
+
+    for (layer = 0; layer < atlas->pageCount; layer++) {
+        if (ievk_atlas_skyline_find(atlas->skylines[layer], paddedWidth, paddedHeight, (int32_t)atlas->pageSize, &index, &x, &y)) {
+            placed = true;
+            break;
+        }
+    }
+
+    if (!placed) {
+        if (ievk_atlas_add_page(atlas) != evk_Success) {
+            EVK_LOG(evk_Error, "Atlas is out of pages while packing %s", name);
+            return evk_Failure;
+        }
+
+        layer = atlas->pageCount - 1;
+        placed = ievk_atlas_skyline_find(atlas->skylines[layer], paddedWidth, paddedHeight, (int32_t)atlas->pageSize, &index, &x, &y);
+        if (!placed) return evk_Failure;
+    }
+
+    ievk_atlas_skyline_add(atlas->skylines[layer], index, x, y, paddedWidth, paddedHeight);
+
+    evkAtlasRegion* region = (evkAtlasRegion*)EVK_MALLOC(evk_Allocation_Tag_Drawable, sizeof(evkAtlasRegion));
+    if (!region) {
+        EVK_LOG(evk_Error, "Out of memory to allocate atlas region");
+        return evk_Failure;
+    }
+
+    const float invPageSize = 1.0f / (float)atlas->pageSize;
+    region->layer = layer;
+    region->x = (uint32_t)x + atlas->padding;
+    region->y = (uint32_t)y + atlas->padding;
+    region->width = width;
+    region->height = height;
+    region->uvOffset = (float2){ { (float)region->x * invPageSize, (float)region->y * invPageSize } };
+    region->uvScale = (float2){ { (float)width * invPageSize, (float)height * invPageSize } };
+
+    ievk_atlas_write_pixels(atlas, layer, region->x, region->y, pixels, width, height);
+
+    if (darray_push_back(atlas->regions, &region) != CTOOLBOX_SUCCESS || shashtable_insert(atlas->lookup, name, region) != CTOOLBOX_SUCCESS) {
+        EVK_LOG(evk_Error, "Failed to register atlas region %s", name);
+        return evk_Failure;
+    }
+
+    return evk_Success;
+}
+
+evkResult evk_atlas_build(evkAtlas* atlas)
+{
+    if (!atlas || atlas->pageCount == 0) {
+        EVK_LOG(evk_Error, "Cannot build an empty atlas");
+        return evk_Failure;
+    }
+
+    if (atlas->built) return evk_Success;
+
+    VkDevice device = evk_get_device();
+    VkPhysicalDevice physicalDevice = evk_get_physical_device();
+    VkPhysicalDeviceProperties properties = evk_get_physical_device_properties();
+    evkBuffer* staging = NULL;
+    VkCommandBuffer cmdBuffer = VK_NULL_HANDLE;
+    const VkFormat format = VK_FORMAT_R8G8B8A8_SRGB;
+    const VkDeviceSize pageBytes = (VkDeviceSize)atlas->pageSize * atlas->pageSize * 4;
+    bool success = false;
+
+    do
+    {
+        if (atlas->pageSize > properties.limits.maxImageDimension2D || atlas->pageCount > properties.limits.maxImageArrayLayers) {
+            EVK_LOG(evk_Error, "Atlas of %u pages of %u exceeds the device limits", atlas->pageCount, atlas->pageSize);
+            break;
+        }
+
+        staging = evk_buffer_create(device, physicalDevice, pageBytes * atlas->pageCount, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 1);
+        if (!staging || !staging->isMapped[0]) {
+            EVK_LOG(evk_Error, "Failed to create atlas staging buffer");
+            break;
+        }
+
+        for (uint32_t i = 0; i < atlas->pageCount; i++) {
+            memcpy((uint8_t*)staging->mappedPointers[0] + pageBytes * i, atlas->pages[i], (size_t)pageBytes);
+        }
+
+        const VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        if (evk_device_create_image((VkExtent2D){ atlas->pageSize, atlas->pageSize }, atlas->mipLevels, atlas->pageCount, device, physicalDevice, &atlas->image, &atlas->mem, format, evk_Msaa_Off, VK_IMAGE_TILING_OPTIMAL, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0) != evk_Success) {
+            EVK_LOG(evk_Error, "Failed to create atlas image");
+            break;
+        }
+
+        evkRenderphaseType renderphaseType = evk_using_viewport() ? evk_Renderphase_Type_Viewport : evk_Renderphase_Type_Main;
+        VkCommandPool cmdPool = evk_get_command_pool(renderphaseType);
+        VkQueue graphicsQueue = evk_get_graphics_queue();
+
+        cmdBuffer = evk_device_begin_commandbuffer_singletime(device, cmdPool);
+
+        VkImageSubresourceRange range = { 0 };
+        range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        range.baseMipLevel = 0;
+        range.levelCount = atlas->mipLevels;
+        range.baseArrayLayer = 0;
+        range.layerCount = atlas->pageCount;
+        evk_device_create_image_memory_barrier(cmdBuffer, atlas->image, 0, VK_ACCESS_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, range);
+
+        // all pages are tightly laid out on the staging buffer, one copy covers every layer
+        VkBufferImageCopy region = { 0 };
+        region.bufferOffset = 0;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = 0;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount = atlas->pageCount;
+        region.imageExtent.width = atlas->pageSize;
+        region.imageExtent.height = atlas->pageSize;
+        region.imageExtent.depth = 1;
+        vkCmdCopyBufferToImage(cmdBuffer, staging->buffers[0], atlas->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+        if (atlas->mipLevels > 1) {
+            if (evk_device_create_image_mipmaps_compute(device, cmdBuffer, (int32_t)atlas->pageSize, (int32_t)atlas->pageSize, (int32_t)atlas->mipLevels, atlas->pageCount, format, atlas->image) != evk_Success) {
+                evk_device_create_image_mipmaps(device, graphicsQueue, cmdBuffer, (int32_t)atlas->pageSize, (int32_t)atlas->pageSize, (int32_t)atlas->mipLevels, atlas->pageCount, atlas->image);
+            }
+        }
+        else {
+            evk_device_create_image_memory_barrier(cmdBuffer, atlas->image, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, range);
+        }
+
+        if (evk_device_end_commandbuffer_singletime(device, cmdPool, cmdBuffer, graphicsQueue) != evk_Success) {
+            EVK_LOG(evk_Error, "Failed to submit atlas upload");
+            break;
+        }
+
+        if (evk_device_create_image_view(device, atlas->image, format, VK_IMAGE_ASPECT_COLOR_BIT, atlas->mipLevels, atlas->pageCount, VK_IMAGE_VIEW_TYPE_2D_ARRAY, NULL, &atlas->arrayView) != evk_Success) {
+            EVK_LOG(evk_Error, "Failed to create atlas array view");
+            break;
+        }
+
+        // single layer views let the current sprite shaders (sampler2D) read a page directly
+        bool viewsCreated = true;
+        for (uint32_t i = 0; i < atlas->pageCount; i++) {
+            VkImageViewCreateInfo viewCI = { 0 };
+            viewCI.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            viewCI.image = atlas->image;
+            viewCI.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            viewCI.format = format;
+            viewCI.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            viewCI.subresourceRange.baseMipLevel = 0;
+            viewCI.subresourceRange.levelCount = atlas->mipLevels;
+            viewCI.subresourceRange.baseArrayLayer = i;
+            viewCI.subresourceRange.layerCount = 1;
+
+            if (vkCreateImageView(device, &viewCI, evk_get_vulkan_allocator(), &atlas->pageViews[i]) != VK_SUCCESS) {
+                EVK_LOG(evk_Error, "Failed to create atlas page view %u", i);
+                viewsCreated = false;
+                break;
+            }
+        }
+        if (!viewsCreated) break;
+
+        // clamp keeps the extruded borders in use when sampling near the edges of a page
+        evkSamplerState samplerState = evk_sampler_state_default(VK_FILTER_LINEAR, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE);
+        atlas->sampler = evk_sampler_cache_get(&samplerState);
+        if (atlas->sampler == VK_NULL_HANDLE) {
+            EVK_LOG(evk_Error, "Failed to create atlas sampler");
+            break;
+        }
+
+        success = true;
+    } while (0);
+
+    if (staging) {
+        evk_buffer_destroy(device, staging);
+    }
+
+    if (!success) return evk_Failure;
+
+    // pixels are now on the gpu, the packing state is no longer needed
+    for (uint32_t i = 0; i < atlas->pageCount; i++) {
+        EVK_FREE(atlas->pages[i]);
+        atlas->pages[i] = NULL;
+        darray_destroy(atlas->skylines[i]);
+        atlas->skylines[i] = NULL;
+    }
+
+    atlas->built = true;
+    return evk_Success;
+}
+
+const evkAtlasRegion* evk_atlas_find_region(evkAtlas* atlas, const char* name)
+{
+    if (!atlas || !name) return NULL;
+    return (const evkAtlasRegion*)shashtable_lookup(atlas->lookup, name);
+}
+
+uint32_t evk_atlas_get_page_count(evkAtlas* atlas)
+{
+    return atlas ? atlas->pageCount : 0;
+}
+
+uint32_t evk_atlas_get_mip_levels(evkAtlas* atlas)
+{
+    return atlas ? atlas->mipLevels : 0;
+}
+
+VkImageView evk_atlas_get_array_view(evkAtlas* atlas)
+{
+    return atlas ? atlas->arrayView : VK_NULL_HANDLE;
+}
+
+VkImageView evk_atlas_get_page_view(evkAtlas* atlas, uint32_t layer)
+{
+    return (atlas && layer < atlas->pageCount) ? atlas->pageViews[layer] : VK_NULL_HANDLE;
+}
+
+VkSampler evk_atlas_get_sampler(evkAtlas* atlas)
+{
+    return atlas ? atlas->sampler : VK_NULL_HANDLE;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Thumbnail Cache
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct evkThumbnailEntry
+{
+    char* path;                         // owned, also the key on the entries table
+    uint32_t slot;                      // valid while resident
+    bool resident;
+    bool pending;                       // waiting on the upload queue
+    bool failed;                        // the image could not be decoded, it's never retried
+    float2 uvMin;
+    float2 uvMax;
+    uint64_t lastUsedFrame;
+    struct evkThumbnailEntry* prev;     // lru links, only valid while resident
+    struct evkThumbnailEntry* next;
+};
+
+typedef struct evkThumbnailCache
+{
+    VkImage image;                      // every page is a layer of the same image
+    VkDeviceMemory mem;
+    VkImageView* pageViews;             // single layer views, the ui samples a sampler2D
+    VkDescriptorSet* pageDescriptors;   // one set per page, shared by every thumbnail on it
+    VkSampler sampler;
+    evkBuffer* staging;                 // persistently mapped, fits EVK_THUMBNAIL_UPLOADS_PER_FRAME thumbnails
+    uint32_t pageCount;
+    uint32_t slotsPerRow;
+    uint32_t slotsPerPage;
+    uint32_t slotCount;
+    struct evkThumbnailEntry** slots;   // slot -> resident entry
+    darray* freeSlots;                  // uint32_t
+    darray* pending;                    // struct evkThumbnailEntry*, in request order
+    darray* entries;                    // struct evkThumbnailEntry*, every entry for shutdown
+    shashtable* lookup;                 // path -> entry
+    struct evkThumbnailEntry* lruHead;  // least recently used, first to be paged out
+    struct evkThumbnailEntry* lruTail;
+    uint64_t frame;
+    evkThumbnailCacheStats stats;
+} evkThumbnailCache;
+
+static evkThumbnailCache* g_EVKThumbnailCache = NULL;
+
+/// @brief removes the entry from the lru list
+static void ievk_thumbnail_cache_unlink(evkThumbnailCache* cache, struct evkThumbnailEntry* entry)
+{
+    if (entry->prev) entry->prev->next = entry->next;
+    else cache->lruHead = entry->next;
+
+    if (entry->next) entry->next->prev = entry->prev;
+    else cache->lruTail = entry->prev;
+
+    entry->prev = NULL;
+    entry->next = NULL;
+}
+
+/// @brief appends the entry as the most recently used
+static void ievk_thumbnail_cache_link_tail(evkThumbnailCache* cache, struct evkThumbnailEntry* entry)
+{
+    entry->prev = cache->lruTail;
+    entry->next = NULL;
+
+    if (cache->lruTail) cache->lruTail->next = entry;
+    else cache->lruHead = entry;
+
+    cache->lruTail = entry;
+}
+
+/// @brief returns a free slot, paging out the least recently used thumbnail not drawn on the last frame, UINT32_MAX when every slot is in use
+static uint32_t ievk_thumbnail_cache_take_slot(evkThumbnailCache* cache)
+{
+    uint32_t slot = UINT32_MAX;
+
+    if (darray_size(cache->freeSlots) > 0) {
+        darray_pop_back(cache->freeSlots, &slot);
+        return slot;
+    }
+
+    struct evkThumbnailEntry* victim = cache->lruHead;
+    if (!victim || victim->lastUsedFrame + 1 >= cache->frame) return UINT32_MAX;
+
+    ievk_thumbnail_cache_unlink(cache, victim);
+    victim->resident = false;
+    cache->slots[victim->slot] = NULL;
+    cache->stats.evictions++;
+    cache->stats.residentCount--;
+
+    return victim->slot;
+}
+
+/// @brief box filters an rgba image into dst, which is EVK_THUMBNAIL_SIZE wide, keeping the aspect ratio
+static void ievk_thumbnail_cache_downsample(const uint8_t* src, int32_t width, int32_t height, uint8_t* dst, uint32_t* outWidth, uint32_t* outHeight)
+{
+    const uint32_t size = EVK_THUMBNAIL_SIZE;
+    uint32_t dstWidth = size;
+    uint32_t dstHeight = size;
+
+    if (width >= height) dstHeight = (uint32_t)(((uint64_t)height * size + (uint64_t)width / 2) / (uint64_t)width);
+    else dstWidth = (uint32_t)(((uint64_t)width * size + (uint64_t)height / 2) / (uint64_t)height);
+
+    // small images are kept as they are
+    if ((uint32_t)width <= size && (uint32_t)height <= size) {
+        dstWidth = (uint32_t)width;
+        dstHeight = (uint32_t)height;
+    }
+
+    if (dstWidth == 0) dstWidth = 1;
+    if (dstHeight == 0) dstHeight = 1;
+
+    for (uint32_t y = 0; y < dstHeight; y++) {
+        uint32_t y0 = (uint32_t)((uint64_t)y * height / dstHeight);
+        uint32_t y1 = (uint32_t)((uint64_t)(y + 1) * height / dstHeight);
+        if (y1 <= y0) y1 = y0 + 1;
+
+        for (uint32_t x = 0; x < dstWidth; x++) {
+            uint32_t x0 = (uint32_t)((uint64_t)x * width / dstWidth);
+            uint32_t x1 = (uint32_t)((uint64_t)(x + 1) * width / dstWidth);
+            if (x1 <= x0) x1 = x0 + 1;
+
+            uint64_t sum[4] = { 0 };
+            for (uint32_t sy = y0; sy < y1; sy++) {
+                const uint8_t* row = src + ((size_t)sy * (size_t)width + x0) * 4;
+                for (uint32_t sx = x0; sx < x1; sx++, row += 4) {
+                    sum[0] += row[0];
+                    sum[1] += row[1];
+                    sum[2] += row[2];
+                    sum[3] += row[3];
+                }
+            }
+
+            uint64_t count = (uint64_t)(x1 - x0) * (y1 - y0);
+            uint8_t* texel = dst + ((size_t)y * size + x) * 4;
+            for (uint32_t c = 0; c < 4; c++) texel[c] = (uint8_t)((sum[c] + count / 2) / count);
+        }
+    }
+
+    *outWidth = dstWidth;
+    *outHeight = dstHeight;
+}
+
+evkResult evk_thumbnail_cache_init(uint64_t budgetBytes)
+{
+    // thumbnails are opt-in, their pages are device memory every application would pay for otherwise
+    if (g_EVKThumbnailCache != NULL || budgetBytes == 0) return evk_Success;
+
+    evkThumbnailCache* cache = (evkThumbnailCache*)EVK_MALLOC(evk_Allocation_Tag_Drawable, sizeof(evkThumbnailCache));
+    if (!cache) {
+        EVK_LOG(evk_Error, "Failed to allocate memory resources for the thumbnail cache");
+        return evk_Failure;
+    }
+    memset(cache, 0, sizeof(evkThumbnailCache));
+
+    VkDevice device = evk_get_device();
+    VkPhysicalDevice physicalDevice = evk_get_physical_device();
+    const VkFormat format = VK_FORMAT_R8G8B8A8_SRGB;
+    const uint64_t pageBytes = (uint64_t)EVK_THUMBNAIL_PAGE_SIZE * EVK_THUMBNAIL_PAGE_SIZE * 4;
+    uint32_t maxLayers = evk_get_physical_device_properties().limits.maxImageArrayLayers;
+    bool success = false;
+
+    // the budget is fixed for the cache's lifetime, it decides how many pages exist
+    cache->pageCount = budgetBytes >= pageBytes ? (uint32_t)(budgetBytes / pageBytes) : 1;
+    if (cache->pageCount > maxLayers) cache->pageCount = maxLayers;
+    cache->slotsPerRow = EVK_THUMBNAIL_PAGE_SIZE / EVK_THUMBNAIL_SIZE;
+    cache->slotsPerPage = cache->slotsPerRow * cache->slotsPerRow;
+    cache->slotCount = cache->pageCount * cache->slotsPerPage;
+
+    cache->stats.budgetBytes = pageBytes * cache->pageCount;
+    cache->stats.pageCount = cache->pageCount;
+    cache->stats.slotCount = cache->slotCount;
+
+    do
+    {
+        cache->pageViews = (VkImageView*)EVK_MALLOC(evk_Allocation_Tag_Drawable, sizeof(VkImageView) * cache->pageCount);
+        cache->pageDescriptors = (VkDescriptorSet*)EVK_MALLOC(evk_Allocation_Tag_Drawable, sizeof(VkDescriptorSet) * cache->pageCount);
+        cache->slots = (struct evkThumbnailEntry**)EVK_MALLOC(evk_Allocation_Tag_Drawable, sizeof(struct evkThumbnailEntry*) * cache->slotCount);
+        if (!cache->pageViews || !cache->pageDescriptors || !cache->slots) break;
+
+        memset(cache->pageViews, 0, sizeof(VkImageView) * cache->pageCount);
+        memset(cache->pageDescriptors, 0, sizeof(VkDescriptorSet) * cache->pageCount);
+        memset(cache->slots, 0, sizeof(struct evkThumbnailEntry*) * cache->slotCount);
+
+        cache->freeSlots = darray_init_memfuncs(sizeof(uint32_t), cache->slotCount, evk_get_container_memfuncs());
+        cache->pending = darray_init_memfuncs(sizeof(struct evkThumbnailEntry*), 64, evk_get_container_memfuncs());
+        cache->entries = darray_init_memfuncs(sizeof(struct evkThumbnailEntry*), 64, evk_get_container_memfuncs());
+        cache->lookup = shashtable_init_memfuncs(evk_get_container_memfuncs());
+        if (!cache->freeSlots || !cache->pending || !cache->entries || !cache->lookup) break;
+
+        // popped from the back, so the first slots are handed out first
+        for (uint32_t i = cache->slotCount; i > 0; i--) {
+            uint32_t slot = i - 1;
+            darray_push_back(cache->freeSlots, &slot);
+        }
+
+        VkDeviceSize stagingSize = (VkDeviceSize)EVK_THUMBNAIL_SIZE * EVK_THUMBNAIL_SIZE * 4 * EVK_THUMBNAIL_UPLOADS_PER_FRAME;
+        cache->staging = evk_buffer_create(device, physicalDevice, stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 1);
+        if (!cache->staging || evk_buffer_map(device, cache->staging, 0) != evk_Success) {
+            EVK_LOG(evk_Error, "Failed to create the thumbnail staging buffer");
+            break;
+        }
+
+        if (evk_device_create_image
+        (
+            (VkExtent2D) { EVK_THUMBNAIL_PAGE_SIZE, EVK_THUMBNAIL_PAGE_SIZE },
+            1,
+            cache->pageCount,
+            device,
+            physicalDevice,
+            &cache->image,
+            &cache->mem,
+            format,
+            evk_Msaa_Off,
+            VK_IMAGE_TILING_OPTIMAL,
+            VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            0
+        ) != evk_Success) {
+            EVK_LOG(evk_Error, "Failed to create the thumbnail pages");
+            break;
+        }
+
+        // pages start cleared and in the layout the ui samples them with
+        evkRenderphaseType renderphaseType = evk_using_viewport() ? evk_Renderphase_Type_Viewport : evk_Renderphase_Type_Main;
+        VkCommandPool cmdPool = evk_get_command_pool(renderphaseType);
+        VkCommandBuffer cmdBuffer = evk_device_begin_commandbuffer_singletime(device, cmdPool);
+        if (!cmdBuffer) break;
+
+        VkImageSubresourceRange range = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, cache->pageCount };
+        VkClearColorValue clearColor = { 0 };
+        evk_device_create_image_memory_barrier(cmdBuffer, cache->image, 0, VK_ACCESS_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, range);
+        vkCmdClearColorImage(cmdBuffer, cache->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clearColor, 1, &range);
+        evk_device_create_image_memory_barrier(cmdBuffer, cache->image, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, range);
+
+        if (evk_device_end_commandbuffer_singletime(device, cmdPool, cmdBuffer, evk_get_graphics_queue()) != evk_Success) {
+            EVK_LOG(evk_Error, "Failed to clear the thumbnail pages");
+            break;
+        }
+
+        evkSamplerState samplerState = evk_sampler_state_default(VK_FILTER_LINEAR, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE);
+        cache->sampler = evk_sampler_cache_get(&samplerState);
+        if (cache->sampler == VK_NULL_HANDLE) break;
+
+        bool pagesCreated = true;
+        for (uint32_t i = 0; i < cache->pageCount && pagesCreated; i++) {
+            VkImageViewCreateInfo viewCI = { 0 };
+            viewCI.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            viewCI.image = cache->image;
+            viewCI.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            viewCI.format = format;
+            viewCI.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            viewCI.subresourceRange.baseMipLevel = 0;
+            viewCI.subresourceRange.levelCount = 1;
+            viewCI.subresourceRange.baseArrayLayer = i;
+            viewCI.subresourceRange.layerCount = 1;
+
+            pagesCreated = vkCreateImageView(device, &viewCI, evk_get_vulkan_allocator(), &cache->pageViews[i]) == VK_SUCCESS
+                && evk_device_create_image_descriptor_set(device, evk_get_ui_descriptor_pool(), evk_get_ui_descriptor_set_layout(), cache->sampler, cache->pageViews[i], &cache->pageDescriptors[i]) == evk_Success;
+        }
+
+        if (!pagesCreated) {
+            EVK_LOG(evk_Error, "Failed to create the thumbnail page views and descriptor sets");
+            break;
+        }
+
+        success = true;
+    } while (0);
+
+    g_EVKThumbnailCache = cache;
+
+    if (!success) {
+        evk_thumbnail_cache_shutdown();
+        return evk_Failure;
+    }
+
+    return evk_Success;
+}
+
+void evk_thumbnail_cache_shutdown()
+{
+    evkThumbnailCache* cache = g_EVKThumbnailCache;
+    if (!cache) return;
+
+    VkDevice device = evk_get_device();
+    vkDeviceWaitIdle(device);
+
+    if (cache->entries) {
+        for (size_t i = 0; i < darray_size(cache->entries); i++) {
+            struct evkThumbnailEntry* entry = NULL;
+            darray_get(cache->entries, i, &entry);
+            EVK_FREE(entry->path);
+            EVK_FREE(entry);
+        }
+        darray_destroy(cache->entries);
+    }
+
+    if (cache->pageViews) {
+        for (uint32_t i = 0; i < cache->pageCount; i++) {
+            if (cache->pageViews[i] != VK_NULL_HANDLE) vkDestroyImageView(device, cache->pageViews[i], evk_get_vulkan_allocator());
+        }
+        EVK_FREE(cache->pageViews);
+    }
+
+    // descriptor sets go back with the ui descriptor pool
+    if (cache->pageDescriptors) EVK_FREE(cache->pageDescriptors);
+    if (cache->slots) EVK_FREE(cache->slots);
+    if (cache->freeSlots) darray_destroy(cache->freeSlots);
+    if (cache->pending) darray_destroy(cache->pending);
+    if (cache->lookup) shashtable_destroy(cache->lookup);
+    if (cache->staging) evk_buffer_destroy(device, cache->staging);
+    if (cache->image != VK_NULL_HANDLE) vkDestroyImage(device, cache->image, evk_get_vulkan_allocator());
+    if (cache->mem != VK_NULL_HANDLE) vkFreeMemory(device, cache->mem, evk_get_vulkan_allocator());
+
+    EVK_FREE(cache);
+    g_EVKThumbnailCache = NULL;
+}
+
+bool evk_thumbnail_cache_get(const char* path, VkDescriptorSet* descriptor, float2* uvMin, float2* uvMax)
+{
+    evkThumbnailCache* cache = g_EVKThumbnailCache;
+    if (!cache || !path) return false;
+
+    struct evkThumbnailEntry* entry = (struct evkThumbnailEntry*)shashtable_lookup(cache->lookup, path);
+
+    if (!entry) {
+        size_t len = strlen(path) + 1;
+        entry = (struct evkThumbnailEntry*)EVK_MALLOC(evk_Allocation_Tag_Drawable, sizeof(struct evkThumbnailEntry));
+        char* copy = (char*)EVK_MALLOC(evk_Allocation_Tag_Drawable, len);
+
+        if (!entry || !copy) {
+            if (entry) EVK_FREE(entry);
+            if (copy) EVK_FREE(copy);
+            return false;
+        }
+
+        memset(entry, 0, sizeof(struct evkThumbnailEntry));
+        memcpy(copy, path, len);
+        entry->path = copy;
+        entry->pending = true;
+
+        if (shashtable_insert(cache->lookup, copy, entry) != CTOOLBOX_SUCCESS || darray_push_back(cache->entries, &entry) != CTOOLBOX_SUCCESS) {
+            EVK_LOG(evk_Error, "Failed to register thumbnail %s", path);
+            shashtable_delete(cache->lookup, copy);
+            EVK_FREE(copy);
+            EVK_FREE(entry);
+            return false;
+        }
+
+        darray_push_back(cache->pending, &entry);
+        cache->stats.misses++;
+    }
+
+    entry->lastUsedFrame = cache->frame;
+
+    // paged out thumbnails are requested again and show up once the upload is done
+    if (!entry->resident) {
+        if (!entry->pending && !entry->failed) {
+            entry->pending = true;
+            darray_push_back(cache->pending, &entry);
+            cache->stats.misses++;
+        }
+        return false;
+    }
+
+    ievk_thumbnail_cache_unlink(cache, entry);
+    ievk_thumbnail_cache_link_tail(cache, entry);
+    cache->stats.hits++;
+
+    if (descriptor) *descriptor = cache->pageDescriptors[entry->slot / cache->slotsPerPage];
+    if (uvMin) *uvMin = entry->uvMin;
+    if (uvMax) *uvMax = entry->uvMax;
+
+    return true;
+}
+
+void evk_thumbnail_cache_update()
+{
+    evkThumbnailCache* cache = g_EVKThumbnailCache;
+    if (!cache) return;
+
+    cache->frame++;
+    if (darray_size(cache->pending) == 0) return;
+
+    VkDevice device = evk_get_device();
+    uint8_t* staging = (uint8_t*)cache->staging->mappedPointers[0];
+    const VkDeviceSize thumbnailBytes = (VkDeviceSize)EVK_THUMBNAIL_SIZE * EVK_THUMBNAIL_SIZE * 4;
+    const float pageSize = (float)EVK_THUMBNAIL_PAGE_SIZE;
+
+    VkBufferImageCopy regions[EVK_THUMBNAIL_UPLOADS_PER_FRAME];
+    struct evkThumbnailEntry* uploaded[EVK_THUMBNAIL_UPLOADS_PER_FRAME];
+    uint32_t uploadCount = 0;
+    size_t consumed = 0;
+
+    // decodes a few thumbnails per frame in request order, entries nobody drew since the request are dropped from the queue
+    while (consumed < darray_size(cache->pending) && uploadCount < EVK_THUMBNAIL_UPLOADS_PER_FRAME) {
+        struct evkThumbnailEntry* entry = NULL;
+        darray_get(cache->pending, consumed, &entry);
+
+        if (entry->lastUsedFrame + 1 < cache->frame) {
+            entry->pending = false;
+            consumed++;
+            continue;
+        }
+
+        uint32_t slot = ievk_thumbnail_cache_take_slot(cache);
+        if (slot == UINT32_MAX) break; // every slot was drawn last frame, wait for some to go out of view
+
+        int32_t width = 0, height = 0, channels = 0;
+        uint8_t* pixels = stbi_load(entry->path, &width, &height, &channels, 4);
+        consumed++;
+        entry->pending = false;
+
+        if (!pixels) {
+            EVK_LOG(evk_Error, "Failed to load thumbnail %s", entry->path);
+            entry->failed = true;
+            darray_push_back(cache->freeSlots, &slot);
+            continue;
+        }
+
+        uint32_t thumbWidth = 0, thumbHeight = 0;
+        VkDeviceSize offset = thumbnailBytes * uploadCount;
+        ievk_thumbnail_cache_downsample(pixels, width, height, staging + offset, &thumbWidth, &thumbHeight);
+        stbi_image_free(pixels);
+
+        uint32_t page = slot / cache->slotsPerPage;
+        uint32_t x = (slot % cache->slotsPerPage) % cache->slotsPerRow * EVK_THUMBNAIL_SIZE;
+        uint32_t y = (slot % cache->slotsPerPage) / cache->slotsPerRow * EVK_THUMBNAIL_SIZE;
+
+        VkBufferImageCopy* region = &regions[uploadCount];
+        memset(region, 0, sizeof(VkBufferImageCopy));
+        region->bufferOffset = offset;
+        region->bufferRowLength = EVK_THUMBNAIL_SIZE;
+        region->bufferImageHeight = EVK_THUMBNAIL_SIZE;
+        region->imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region->imageSubresource.mipLevel = 0;
+        region->imageSubresource.baseArrayLayer = page;
+        region->imageSubresource.layerCount = 1;
+        region->imageOffset.x = (int32_t)x;
+        region->imageOffset.y = (int32_t)y;
+        region->imageExtent.width = thumbWidth;
+        region->imageExtent.height = thumbHeight;
+        region->imageExtent.depth = 1;
+
+        entry->slot = slot;
+        entry->uvMin = (float2){ { (float)x / pageSize, (float)y / pageSize } };
+        entry->uvMax = (float2){ { (float)(x + thumbWidth) / pageSize, (float)(y + thumbHeight) / pageSize } };
+        uploaded[uploadCount++] = entry;
+    }
+
+    for (size_t i = 0; i < consumed; i++) darray_remove_at(cache->pending, 0, NULL);
+    cache->stats.pendingCount = (uint32_t)darray_size(cache->pending);
+    if (uploadCount == 0) return;
+
+    evkRenderphaseType renderphaseType = evk_using_viewport() ? evk_Renderphase_Type_Viewport : evk_Renderphase_Type_Main;
+    VkCommandPool cmdPool = evk_get_command_pool(renderphaseType);
+    VkCommandBuffer cmdBuffer = evk_device_begin_commandbuffer_singletime(device, cmdPool);
+    if (!cmdBuffer) return;
+
+    // the barrier waits on fragment reads of frames still in flight, the slots being overwritten were not drawn on the last frame
+    VkImageSubresourceRange range = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, cache->pageCount };
+    evk_device_create_image_memory_barrier(cmdBuffer, cache->image, VK_ACCESS_SHADER_READ_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, range);
+
+    // the previous occupant may have been larger, the whole slot is cleared before the copy
+    for (uint32_t i = 0; i < uploadCount; i++) {
+        if (regions[i].imageExtent.width == EVK_THUMBNAIL_SIZE && regions[i].imageExtent.height == EVK_THUMBNAIL_SIZE) continue;
+
+        VkDeviceSize offset = thumbnailBytes * i;
+        for (uint32_t row = 0; row < EVK_THUMBNAIL_SIZE; row++) {
+            uint8_t* line = staging + offset + (size_t)row * EVK_THUMBNAIL_SIZE * 4;
+            uint32_t from = row < regions[i].imageExtent.height ? regions[i].imageExtent.width : 0;
+            memset(line + (size_t)from * 4, 0, (size_t)(EVK_THUMBNAIL_SIZE - from) * 4);
+        }
+
+        regions[i].imageExtent.width = EVK_THUMBNAIL_SIZE;
+        regions[i].imageExtent.height = EVK_THUMBNAIL_SIZE;
+    }
+
+    vkCmdCopyBufferToImage(cmdBuffer, cache->staging->buffers[0], cache->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, uploadCount, regions);
+    evk_device_create_image_memory_barrier(cmdBuffer, cache->image, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, range);
+
+    if (evk_device_end_commandbuffer_singletime(device, cmdPool, cmdBuffer, evk_get_graphics_queue()) != evk_Success) {
+        EVK_LOG(evk_Error, "Failed to upload %u thumbnails", uploadCount);
+        for (uint32_t i = 0; i < uploadCount; i++) darray_push_back(cache->freeSlots, &uploaded[i]->slot);
+        return;
+    }
+
+    for (uint32_t i = 0; i < uploadCount; i++) {
+        uploaded[i]->resident = true;
+        cache->slots[uploaded[i]->slot] = uploaded[i];
+        ievk_thumbnail_cache_link_tail(cache, uploaded[i]);
+    }
+
+    cache->stats.uploads += uploadCount;
+    cache->stats.residentCount += uploadCount;
+}
+
+evkThumbnailCacheStats evk_thumbnail_cache_get_stats()
+{
+    evkThumbnailCacheStats stats = { 0 };
+    if (!g_EVKThumbnailCache) return stats;
+
+    return g_EVKThumbnailCache->stats;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Pipelines
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief handles of the builtin pipelines, resolved by name the first time they're used and again whenever the pipeline is recreated
+static evkPipelineHandle g_EVKSpriteDefaultPipeline = { 0 };
+static evkPipelineHandle g_EVKSpritePickingPipeline = { 0 };
+static evkPipelineHandle g_EVKMeshDefaultPipeline = { 0 };
+static evkPipelineHandle g_EVKMeshPickingPipeline = { 0 };
+
+/// @brief returns the pipeline behind a cached handle, only looking it up by name when the handle is unset or stale
+static evkPipeline* ievk_pipeline_resolve(evkPipelineHandle* handle, const char* name)
+{
+    evkPipeline* pipeline = evk_pipeline_library_get(*handle);
+    if (pipeline != NULL) return pipeline;
+
+    *handle = evk_pipeline_library_find(evk_get_pipelines_library(), name);
+    return evk_pipeline_library_get(*handle);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Sprite
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct evkSprite
+{
+    uint32_t id;
+    evkSpriteUBO ubo;
+    evkBuffer* buffer;
+    evkTexture2D* albedo;
+    bool albedoBorrowed; // albedo given by the caller instead of acquired from the texture cache
+    evkAtlas* atlas; // when set the sprite samples an atlas page instead of owning an albedo
+    uint32_t atlasLayer;
+    uint32_t albedoGenerations[EVK_CONCURRENTLY_RENDERED_FRAMES]; // albedo generation each descriptor set was written with
+    VkDescriptorPool descriptorPool;
+    VkDescriptorSet descriptorSets[EVK_CONCURRENTLY_RENDERED_FRAMES];
+};
+
+void ievk_sprite_refresh_data(evkSprite* sprite)
+{
+    VkDevice device = evk_get_device();
+
+    for (uint32_t i = 0; i < EVK_CONCURRENTLY_RENDERED_FRAMES; i++)
+    {
+        evkBuffer* cameraBuffer = evk_buffer_library_get(evk_get_main_camera_buffer());
+        VkDescriptorBufferInfo camInfo = { 0 };
+        camInfo.buffer = cameraBuffer->buffers[i];
+        camInfo.offset = 0;
+        camInfo.range = sizeof(evkCameraUBO);
+
+        VkWriteDescriptorSet desc = { 0 };
+        desc.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        desc.dstSet = sprite->descriptorSets[i];
+        desc.dstBinding = 0;
+        desc.dstArrayElement = 0;
+        desc.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        desc.descriptorCount = 1;
+        desc.pBufferInfo = &camInfo;
+        vkUpdateDescriptorSets(device, 1, &desc, 0, NULL);
+
+        // 1: sprite data
+        VkDescriptorBufferInfo spriteInfo = { 0 };
+        spriteInfo.buffer = sprite->buffer->buffers[i];
+        spriteInfo.offset = 0;
+        spriteInfo.range = sizeof(evkSpriteUBO);
+
+        desc = (VkWriteDescriptorSet){ 0 };
+        desc.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        desc.dstSet = sprite->descriptorSets[i];
+        desc.dstBinding = 1;
+        desc.dstArrayElement = 0;
+        desc.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        desc.descriptorCount = 1;
+        desc.pBufferInfo = &spriteInfo;
+        vkUpdateDescriptorSets(device, 1, &desc, 0, NULL);
+
+        // 2: albedo texture
+        VkDescriptorImageInfo albedoInfo = { 0 };
+        albedoInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        albedoInfo.imageView = sprite->atlas ? evk_atlas_get_page_view(sprite->atlas, sprite->atlasLayer) : sprite->albedo->view;
+        albedoInfo.sampler = sprite->atlas ? evk_atlas_get_sampler(sprite->atlas) : sprite->albedo->sampler; // atlas sprites clamp so the extruded borders hold
+
+        desc = (VkWriteDescriptorSet){ 0 };
+        desc.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        desc.dstSet = sprite->descriptorSets[i];
+        desc.dstBinding = 2;
+        desc.dstArrayElement = 0;
+        desc.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        desc.descriptorCount = 1;
+        desc.pImageInfo = &albedoInfo;
+        vkUpdateDescriptorSets(device, 1, &desc, 0, NULL);
+
+        if (sprite->albedo) sprite->albedoGenerations[i] = sprite->albedo->generation;
+    }
+    evk_sprite_update(sprite, false);
+}
+
+/// @brief points the frame's descriptor set to the albedo's current view, it's fence was already waited on and no phase bound it yet this frame
+static void ievk_sprite_refresh_albedo(evkSprite* sprite, uint32_t frame)
+{
+    VkDescriptorImageInfo albedoInfo = { 0 };
+    albedoInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    albedoInfo.imageView = sprite->albedo->view;
+    albedoInfo.sampler = sprite->albedo->sampler;
+
+    VkWriteDescriptorSet desc = { 0 };
+    desc.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    desc.dstSet = sprite->descriptorSets[frame];
+    desc.dstBinding = 2;
+    desc.dstArrayElement = 0;
+    desc.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    desc.descriptorCount = 1;
+    desc.pImageInfo = &albedoInfo;
+    vkUpdateDescriptorSets(evk_get_device(), 1, &desc, 0, NULL);
+
+    sprite->albedoGenerations[frame] = sprite->albedo->generation;
+}
+
+/// @brief creates the uniform buffer and descriptor sets of a sprite whose albedo (or atlas) is already set
+static bool ievk_sprite_create_resources(evkSprite* sprite, const char* name)
+{
+    evkBuffer* staging = NULL;
+    VkCommandBuffer cmdBuffer = VK_NULL_HANDLE;
+    VkDevice device = evk_get_device();
+    VkPhysicalDevice physicalDevice = evk_get_physical_device();
+    VkPhysicalDeviceProperties properties = evk_get_physical_device_properties();
+    bool success = false;
+
+    do
+    {
         VkDeviceSize atomSize = properties.limits.nonCoherentAtomSize;
         VkDeviceSize uniformAlign = properties.limits.minUniformBufferOffsetAlignment;
         VkDeviceSize requiredAlignment = (atomSize > uniformAlign) ? atomSize : uniformAlign;
         VkDeviceSize perFrameAlignedSize = (sizeof(evkSpriteUBO) + requiredAlignment - 1) & ~(requiredAlignment - 1);
         VkDeviceSize totalBufferSize = perFrameAlignedSize * EVK_CONCURRENTLY_RENDERED_FRAMES;
 
-        // create uniform buffer (non-coherent for cached performance)
-        sprite->buffer = evk_buffer_create(device, physicalDevice, totalBufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT, EVK_CONCURRENTLY_RENDERED_FRAMES);
-        sprite->buffer->originalDataSize = sizeof(evkSpriteUBO);
-        sprite->buffer->alignedPerFrameSize = perFrameAlignedSize;
+        // create uniform buffer (non-coherent for cached performance)
+        sprite->buffer = evk_buffer_create(device, physicalDevice, totalBufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT, EVK_CONCURRENTLY_RENDERED_FRAMES);
+        sprite->buffer->originalDataSize = sizeof(evkSpriteUBO);
+        sprite->buffer->alignedPerFrameSize = perFrameAlignedSize;
+
+        staging = evk_buffer_create(device, physicalDevice, sizeof(evkSpriteUBO), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 1);
+
+        // copy initial UBO data through staging
+        if (evk_buffer_map(device, staging, 0) != evk_Success) {
+            EVK_LOG(evk_Error, "Failed to map staging buffer");
+            break;
+        }
+
+        if (evk_buffer_copy(staging, 0, &sprite->ubo, sizeof(evkSpriteUBO), 0) != evk_Success) {
+            EVK_LOG(evk_Error, "Failed to copy to staging buffer");
+            evk_buffer_unmap(device, staging, 0);
+            break;
+        }
+
+        evk_buffer_unmap(device, staging, 0);
+
+        // copy from staging to each frame's uniform buffer
+        evkRenderphaseType renderPhaseType = evk_using_viewport() ? evk_Renderphase_Type_Viewport : evk_Renderphase_Type_Main;
+        VkCommandPool cmdPool = evk_get_command_pool(renderPhaseType);
+
+        cmdBuffer = evk_device_begin_commandbuffer_singletime(device, cmdPool);
+
+        for (uint32_t i = 0; i < EVK_CONCURRENTLY_RENDERED_FRAMES; i++) {
+            VkDeviceSize dstOffset = i * perFrameAlignedSize;
+            evk_buffer_command_copy(cmdBuffer, staging, 0, sprite->buffer, i, sizeof(evkSpriteUBO), 0, dstOffset);
+        }
+
+        evk_device_end_commandbuffer_singletime(device, cmdPool, cmdBuffer, evk_get_graphics_queue());
+
+        // get pipeline, create descriptor pool and allocate descriptor sets
+        evkPipeline* pipeline = ievk_pipeline_resolve(&g_EVKSpriteDefaultPipeline, EVK_PIPELINE_SPRITE_DEFAULT_NAME);
+
+        if (!pipeline) {
+            EVK_LOG(evk_Error, "Failed to find sprite pipeline");
+            break;
+        }
+       
+        VkDescriptorPoolSize poolSizes[3] = { 0 };
+        poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        poolSizes[0].descriptorCount = EVK_CONCURRENTLY_RENDERED_FRAMES;
+        poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        poolSizes[1].descriptorCount = EVK_CONCURRENTLY_RENDERED_FRAMES;
+        poolSizes[2].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        poolSizes[2].descriptorCount = EVK_CONCURRENTLY_RENDERED_FRAMES;
+
+        VkDescriptorPoolCreateInfo descriptorPoolCI = { 0 };
+        descriptorPoolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        descriptorPoolCI.poolSizeCount = (uint32_t)EVK_STATIC_ARRAY_SIZE(poolSizes);
+        descriptorPoolCI.pPoolSizes = poolSizes;
+        descriptorPoolCI.maxSets = EVK_CONCURRENTLY_RENDERED_FRAMES;
+
+        if (vkCreateDescriptorPool(device, &descriptorPoolCI, evk_get_vulkan_allocator(), &sprite->descriptorPool) != VK_SUCCESS) {
+            EVK_LOG(evk_Error, "Failed to create descriptor pool for quad: %s", name);
+            break;
+        }
+
+        VkDescriptorSetLayout layouts[EVK_CONCURRENTLY_RENDERED_FRAMES];
+
+        for (uint32_t i = 0; i < EVK_CONCURRENTLY_RENDERED_FRAMES; i++) {
+            layouts[i] = pipeline->descriptorSetLayout;
+        }
+
+        VkDescriptorSetAllocateInfo descSetAllocInfo = { 0 };
+        descSetAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        descSetAllocInfo.descriptorPool = sprite->descriptorPool;
+        descSetAllocInfo.descriptorSetCount = EVK_CONCURRENTLY_RENDERED_FRAMES;
+        descSetAllocInfo.pSetLayouts = layouts;
+
+        if (vkAllocateDescriptorSets(device, &descSetAllocInfo, sprite->descriptorSets) != VK_SUCCESS) {
+            EVK_LOG(evk_Error, "Failed to allocate descriptor sets for sprite");
+            break;
+        }
+
+        ievk_sprite_refresh_data(sprite);
+
+        success = true;
+    } while (0);
+
+    // cleanup
+    if (staging) {
+        evk_buffer_destroy(device, staging);
+    }
+
+    return success;
+}
+
+evkSprite* evk_sprite_create_from_path(const char* path)
+{
+    if (path == NULL) {
+        EVK_LOG(evk_Error, "Sprite path is NULL");
+        return NULL;
+    }
+
+    evkSprite* sprite = (evkSprite*)evk_pool_alloc(&g_EVKSpritePool);
+    if (sprite == NULL) {
+        EVK_LOG(evk_Error, "Out of memory to allocate sprite %s", path);
+        return NULL;
+    }
+
+    memset(sprite, 0, sizeof(evkSprite));
+    sprite->ubo.uv_scale = (float2){ { 1.0f, 1.0f } };
+
+    bool success = false;
+
+    do
+    {
+        sprite->id = evk_entity_create(sprite);
+        if (sprite->id == 0) break;
+
+        sprite->albedo = evk_texture_cache_acquire(path, false);
+        if (!sprite->albedo) {
+            EVK_LOG(evk_Error, "Failed to load albedo texture for sprite: %s", path);
+            break;
+        }
+
+        success = ievk_sprite_create_resources(sprite, path);
+    } while (0);
+
+    if (!success) {
+        evk_sprite_destroy(sprite);
+        return NULL;
+    }
+
+    return sprite;
+}
+
+evkSprite* evk_sprite_create_from_atlas(evkAtlas* atlas, const char* name)
+{
+    const evkAtlasRegion* region = evk_atlas_find_region(atlas, name);
+    if (region == NULL) {
+        EVK_LOG(evk_Error, "Atlas has no region named %s", name ? name : "NULL");
+        return NULL;
+    }
+
+    if (evk_atlas_get_array_view(atlas) == VK_NULL_HANDLE) {
+        EVK_LOG(evk_Error, "Atlas must be built before creating sprites from it");
+        return NULL;
+    }
+
+    evkSprite* sprite = (evkSprite*)evk_pool_alloc(&g_EVKSpritePool);
+    if (sprite == NULL) {
+        EVK_LOG(evk_Error, "Out of memory to allocate sprite %s", name);
+        return NULL;
+    }
+
+    memset(sprite, 0, sizeof(evkSprite));
+    sprite->atlas = atlas;
+    sprite->atlasLayer = region->layer;
+
+    // the shader applies (uv + offset) * scale, so the offset is expressed in region units
+    sprite->ubo.uv_scale = region->uvScale;
+    sprite->ubo.uv_offset = (float2){ { region->uvOffset.xy.x / region->uvScale.xy.x, region->uvOffset.xy.y / region->uvScale.xy.y } };
+
+    sprite->id = evk_entity_create(sprite);
+    if (sprite->id == 0 || !ievk_sprite_create_resources(sprite, name)) {
+        evk_sprite_destroy(sprite);
+        return NULL;
+    }
+
+    return sprite;
+}
+
+evkSprite* evk_sprite_create_from_texture(evkTexture2D* texture)
+{
+    if (texture == NULL) {
+        EVK_LOG(evk_Error, "Sprite texture is NULL");
+        return NULL;
+    }
+
+    evkSprite* sprite = (evkSprite*)evk_pool_alloc(&g_EVKSpritePool);
+    if (sprite == NULL) {
+        EVK_LOG(evk_Error, "Out of memory to allocate sprite from texture");
+        return NULL;
+    }
+
+    memset(sprite, 0, sizeof(evkSprite));
+    sprite->albedo = texture;
+    sprite->albedoBorrowed = true;
+    sprite->ubo.uv_scale = (float2){ { 1.0f, 1.0f } };
+
+    sprite->id = evk_entity_create(sprite);
+    if (sprite->id == 0 || !ievk_sprite_create_resources(sprite, "texture")) {
+        evk_sprite_destroy(sprite);
+        return NULL;
+    }
+
+    return sprite;
+}
+
+void evk_sprite_destroy(evkSprite* sprite)
+{
+    if (!sprite) return;
+
+    VkDevice device = evk_get_device();
+    vkDeviceWaitIdle(device);
+
+    if (sprite->descriptorPool != VK_NULL_HANDLE) {
+        vkDestroyDescriptorPool(device, sprite->descriptorPool, evk_get_vulkan_allocator());
+    }
+
+    if (sprite->buffer) {
+        evk_buffer_destroy(device, sprite->buffer);
+    }
+
+    if (sprite->albedo && !sprite->albedoBorrowed) {
+        evk_texture_cache_release(sprite->albedo);
+    }
+
+    evk_entity_destroy(sprite->id);
+    evk_pool_free(&g_EVKSpritePool, sprite);
+}
+
+void evk_sprite_update(evkSprite* sprite, bool resend)
+{
+    if (!sprite) return;
+
+    VkDevice device = evk_get_device();
+
+    if (sprite->buffer) {
+        if (resend) {
+            ievk_sprite_refresh_data(sprite);
+        }
+
+        VkPhysicalDeviceProperties properties = evk_get_physical_device_properties();
+
+        for (uint32_t i = 0; i < EVK_CONCURRENTLY_RENDERED_FRAMES; i++) {
+            evk_buffer_map(device, sprite->buffer, i);
+            evk_buffer_copy(sprite->buffer, i, &sprite->ubo, sizeof(evkSpriteUBO), 0);
+            evk_buffer_flush(device, sprite->buffer, i, sizeof(evkSpriteUBO), properties.limits.nonCoherentAtomSize, 0);
+            evk_buffer_unmap(device, sprite->buffer, i);
+        }
+    }
+}
+
+void evk_sprite_render(evkSprite* sprite, fmat4* modelMatrix)
+{
+    const VkDeviceSize offsets[] = { 0 };
+    evkPipeline* pipeline = NULL;
+    evkCommandRecorder* recorder = NULL;
+    VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+    uint32_t currentFrame = evk_get_current_frame();
+    evkRenderphaseType stage = evk_get_current_renderphase_type();
+
+    switch (stage)
+    {
+        case evk_Renderphase_Type_Main:
+        {
+            evkMainRenderphase* renderphase = (evkMainRenderphase*)evk_get_renderphase(stage);
+            pipeline = ievk_pipeline_resolve(&g_EVKSpriteDefaultPipeline, EVK_PIPELINE_SPRITE_DEFAULT_NAME);
+            recorder = &renderphase->evkRenderpass.recorders[currentFrame];
+            break;
+        }
+
+        case evk_Renderphase_Type_Viewport:
+        {
+            evkViewportRenderphase* renderphase = (evkViewportRenderphase*)evk_get_renderphase(stage);
+            pipeline = ievk_pipeline_resolve(&g_EVKSpriteDefaultPipeline, EVK_PIPELINE_SPRITE_DEFAULT_NAME); // viewport uses the same pipe as the default one
+            recorder = &renderphase->evkRenderpass.recorders[currentFrame];
+        }
+
+        case evk_Renderphase_Type_Picking:
+        {
+            evkPickingRenderphase* renderphase = (evkPickingRenderphase*)evk_get_renderphase(stage);
+            pipeline = ievk_pipeline_resolve(&g_EVKSpritePickingPipeline, EVK_PIPELINE_SPRITE_PICKING_NAME);
+            recorder = &renderphase->evkRenderpass.recorders[currentFrame];
+            break;
+        }
+
+        default:
+        {
+            return;
+        }
+    }
+
+    pipelineLayout = pipeline->layout;
+
+    evkPushConstant constants = { 0 };
+    constants.id = sprite->id;
+    constants.model = *modelMatrix;
+    evk_command_push_constants(recorder, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(evkPushConstant), &constants);
+
+    // streamed albedos replace their view when residency changes
+    if (sprite->albedo && sprite->albedoGenerations[currentFrame] != sprite->albedo->generation) {
+        ievk_sprite_refresh_albedo(sprite, currentFrame);
+    }
+
+    evk_command_bind_descriptor_set(recorder, pipelineLayout, 0, sprite->descriptorSets[currentFrame]);
+    evk_command_bind_pipeline(recorder, pipeline->pipeline);
+    vkCmdDraw(recorder->cmdBuffer, 6, 1, 0, 0);
+}
+
+uint32_t evk_sprite_get_id(evkSprite* sprite)
+{
+    return sprite != NULL ? sprite->id : 0;
+}
+
+evkSprite* evk_sprite_next(uint32_t* cursor)
+{
+    return (evkSprite*)evk_pool_next(&g_EVKSpritePool, cursor);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Object Pools
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void evk_object_pools_init()
+{
+    evk_pool_init(&g_EVKTexturePool, sizeof(evkTexture2D), evk_Allocation_Tag_Drawable);
+    evk_pool_init(&g_EVKSpritePool, sizeof(evkSprite), evk_Allocation_Tag_Drawable);
+}
+
+void evk_object_pools_shutdown()
+{
+    evk_pool_destroy(&g_EVKSpritePool);
+    evk_pool_destroy(&g_EVKTexturePool);
+}
+
+evkPoolStats evk_texture2d_get_pool_stats()
+{
+    return evk_pool_get_stats(&g_EVKTexturePool);
+}
+
+evkPoolStats evk_sprite_get_pool_stats()
+{
+    return evk_pool_get_stats(&g_EVKSpritePool);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Draw Queue
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief a slot of the ring, it's sequence tells whether producers may write it or the render thread may read it
+typedef struct evkDrawQueueCell
+{
+    volatile uint64_t sequence;
+    evkDrawPacket packet;
+} evkDrawQueueCell;
+
+/// @brief a packet's key and where it lives in the frame array, only these are moved around while sorting
+typedef struct evkDrawSortItem
+{
+    uint64_t key;
+    uint32_t index;
+} evkDrawSortItem;
+
+/// @brief bounded multi-producer single-consumer ring, producer and consumer positions live on different cache lines
+typedef struct evkDrawQueue
+{
+    evkDrawQueueCell* cells;
+    uint64_t mask;
+    evkDrawPacket* frame;                   // packets drained this frame, in the order they were published, from the frame arena
+    evkDrawSortItem* items;                 // opaque then transparent packets of the frame, each range sorted by key, from the frame arena
+    evkDrawSortItem* scratch;               // radix sort ping-pong buffer, from the frame arena
+    uint32_t frameCount;
+    evkDrawQueueStats stats;
+    align_as(64) volatile uint64_t tail;    // next cell a producer claims, also how many packets were accepted
+    align_as(64) volatile uint64_t dropped; // packets refused because the ring was full
+    align_as(64) uint64_t head;             // next cell the render thread reads, only it touches it
+} evkDrawQueue;
+
+static evkDrawQueue g_EVKDrawQueue = { 0 };
+
+/// @brief maps a float into an unsigned integer that sorts in the same order
+static uint32_t ievk_draw_key_depth(float depth)
+{
+    union { float f; uint32_t u; } bits = { depth };
+    return (bits.u & 0x80000000U) ? ~bits.u : (bits.u | 0x80000000U);
+}
+
+/// @brief builds the sort key of a packet, depth is it's distance along the camera's front
+static uint64_t ievk_draw_key_build(const evkDrawPacket* packet, float depth)
+{
+    // every sprite owns it's descriptor sets, packets of the same sprite are what shares state
+    uint64_t material = (uint64_t)((uint32_t)((uintptr_t)packet->sprite >> 4) * 2654435761U >> (32 - EVK_DRAW_KEY_MATERIAL_BITS));
+    uint64_t layer = (uint64_t)packet->layer << EVK_DRAW_KEY_LAYER_SHIFT;
+    uint64_t sortableDepth = ievk_draw_key_depth(depth);
+
+    if (packet->transparent) {
+        return layer | ((uint64_t)(~sortableDepth & 0xFFFFFFFFU) << EVK_DRAW_KEY_MATERIAL_BITS) | material;
+    }
+
+    return layer | (material << 32) | sortableDepth;
+}
+
+/// @brief least significant digit radix sort over the key bytes, a pass is skipped when every key shares it's byte
+static void ievk_draw_radix_sort(evkDrawSortItem* items, evkDrawSortItem* scratch, uint32_t count)
+{
+    evkDrawSortItem* src = items;
+    evkDrawSortItem* dst = scratch;
+
+    for (uint32_t shift = 0; shift < 64 && count > 1; shift += 8) {
+        uint32_t offsets[256] = { 0 };
+        for (uint32_t i = 0; i < count; i++) {
+            offsets[(src[i].key >> shift) & 0xFF]++;
+        }
+
+        if (offsets[(src[0].key >> shift) & 0xFF] == count) continue;
+
+        uint32_t sum = 0;
+        for (uint32_t digit = 0; digit < 256; digit++) {
+            uint32_t digitCount = offsets[digit];
+            offsets[digit] = sum;
+            sum += digitCount;
+        }
+
+        for (uint32_t i = 0; i < count; i++) {
+            dst[offsets[(src[i].key >> shift) & 0xFF]++] = src[i];
+        }
+
+        evkDrawSortItem* swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != items) memcpy(items, src, sizeof(evkDrawSortItem) * count);
+}
+
+evkResult evk_draw_queue_init(uint32_t capacity)
+{
+    uint32_t size = 1;
+    uint32_t requested = capacity == 0 ? EVK_DRAW_QUEUE_DEFAULT_CAPACITY : capacity;
+    while (size < requested && size < (1U << 31)) size <<= 1;
+
+    memset(&g_EVKDrawQueue, 0, sizeof(evkDrawQueue));
+    g_EVKDrawQueue.cells = (evkDrawQueueCell*)EVK_MALLOC(evk_Allocation_Tag_Drawable, sizeof(evkDrawQueueCell) * size);
+
+    if (g_EVKDrawQueue.cells == NULL) {
+        EVK_LOG(evk_Error, "Failed to allocate a draw queue of %u packets", size);
+        evk_draw_queue_shutdown();
+        return evk_Failure;
+    }
+
+    // a cell is free for the producer whose position matches it's sequence
+    for (uint32_t i = 0; i < size; i++) {
+        g_EVKDrawQueue.cells[i].sequence = i;
+    }
+
+    g_EVKDrawQueue.mask = size - 1;
+    g_EVKDrawQueue.stats.capacity = size;
+    return evk_Success;
+}
+
+void evk_draw_queue_shutdown()
+{
+    if (g_EVKDrawQueue.cells != NULL) EVK_FREE(g_EVKDrawQueue.cells);
+    memset(&g_EVKDrawQueue, 0, sizeof(evkDrawQueue));
+}
+
+bool evk_draw_queue_push(const evkDrawPacket* packet)
+{
+    if (g_EVKDrawQueue.cells == NULL || packet == NULL || packet->sprite == NULL) return false;
+
+    evkDrawQueueCell* cell = NULL;
+    uint64_t position = EVK_ATOMIC_LOAD(&g_EVKDrawQueue.tail);
+
+    for (;;) {
+        cell = &g_EVKDrawQueue.cells[position & g_EVKDrawQueue.mask];
+        int64_t distance = (int64_t)(EVK_ATOMIC_LOAD(&cell->sequence) - position);
+
+        // the cell still holds a packet from the previous lap, the render thread hasn't drained it yet
+        if (distance < 0) {
+            EVK_ATOMIC_FETCH_ADD(&g_EVKDrawQueue.dropped, 1);
+            return false;
+        }
+
+        if (distance == 0 && EVK_ATOMIC_CAS(&g_EVKDrawQueue.tail, position, position + 1)) break;
+        position = EVK_ATOMIC_LOAD(&g_EVKDrawQueue.tail);
+    }
+
+    cell->packet = *packet;
+    EVK_ATOMIC_STORE(&cell->sequence, position + 1);
+    return true;
+}
+
+uint32_t evk_draw_queue_drain()
+{
+    g_EVKDrawQueue.frameCount = 0;
+    if (g_EVKDrawQueue.cells == NULL) return 0;
+
+    // the frame's lists are sized by the packets claimed so far and live until the frame's fence signals again
+    uint64_t pending = EVK_ATOMIC_LOAD(&g_EVKDrawQueue.tail) - g_EVKDrawQueue.head;
+    if (pending > g_EVKDrawQueue.stats.capacity) pending = g_EVKDrawQueue.stats.capacity;
+
+    if (pending > 0) {
+        evkFrameArena* arena = evk_get_frame_arena();
+        g_EVKDrawQueue.frame = (evkDrawPacket*)evk_frame_arena_alloc(arena, sizeof(evkDrawPacket) * pending, 0);
+        g_EVKDrawQueue.items = (evkDrawSortItem*)evk_frame_arena_alloc(arena, sizeof(evkDrawSortItem) * pending, 0);
+        g_EVKDrawQueue.scratch = (evkDrawSortItem*)evk_frame_arena_alloc(arena, sizeof(evkDrawSortItem) * pending, 0);
+
+        if (g_EVKDrawQueue.frame == NULL || g_EVKDrawQueue.items == NULL || g_EVKDrawQueue.scratch == NULL) {
+            EVK_LOG(evk_Error, "Failed to allocate the lists of %llu drawn packets, they are kept for the next frame", (unsigned long long)pending);
+            return 0;
+        }
+    }
+
+    // stops at the first cell claimed but not yet written, the packets after it are taken next frame
+    uint64_t position = g_EVKDrawQueue.head;
+    while (g_EVKDrawQueue.frameCount < pending) {
+        evkDrawQueueCell* cell = &g_EVKDrawQueue.cells[position & g_EVKDrawQueue.mask];
+        if ((int64_t)(EVK_ATOMIC_LOAD(&cell->sequence) - (position + 1)) < 0) break;
+
+        g_EVKDrawQueue.frame[g_EVKDrawQueue.frameCount++] = cell->packet;
+        EVK_ATOMIC_STORE(&cell->sequence, position + g_EVKDrawQueue.mask + 1);
+        position++;
+    }
+    g_EVKDrawQueue.head = position;
+
+    // opaque packets take the front of the item list and transparent ones the rest, each range is sorted on it's own
+    evkCamera* camera = evk_get_main_camera();
+    float3 eye = camera != NULL ? evk_camera_get_position(camera) : (float3){ 0 };
+    float3 front = camera != NULL ? evk_camera_get_front(camera) : (float3){ 0 };
+    uint32_t opaqueCount = 0;
+    uint32_t itemCount = 0;
+
+    for (uint32_t pass = 0; pass < 2; pass++) {
+        for (uint32_t i = 0; i < g_EVKDrawQueue.frameCount; i++) {
+            const evkDrawPacket* packet = &g_EVKDrawQueue.frame[i];
+            if (packet->transparent != (pass == 1)) continue;
+
+            const float4* translation = &packet->model.column.c3;
+            float depth = (translation->xyzw.x - eye.xyz.x) * front.xyz.x + (translation->xyzw.y - eye.xyz.y) * front.xyz.y + (translation->xyzw.z - eye.xyz.z) * front.xyz.z;
+
+            g_EVKDrawQueue.items[itemCount].key = ievk_draw_key_build(packet, depth);
+            g_EVKDrawQueue.items[itemCount].index = i;
+            itemCount++;
+        }
+
+        if (pass == 0) opaqueCount = itemCount;
+    }
+
+    ievk_draw_radix_sort(g_EVKDrawQueue.items, g_EVKDrawQueue.scratch, opaqueCount);
+    ievk_draw_radix_sort(g_EVKDrawQueue.items + opaqueCount, g_EVKDrawQueue.scratch, itemCount - opaqueCount);
+
+    g_EVKDrawQueue.stats.drained += g_EVKDrawQueue.frameCount;
+    g_EVKDrawQueue.stats.lastDrained = g_EVKDrawQueue.frameCount;
+    g_EVKDrawQueue.stats.lastTransparent = itemCount - opaqueCount;
+    if (g_EVKDrawQueue.frameCount > g_EVKDrawQueue.stats.maxDrained) g_EVKDrawQueue.stats.maxDrained = g_EVKDrawQueue.frameCount;
+
+    return g_EVKDrawQueue.frameCount;
+}
+
+void evk_draw_queue_render()
+{
+    if (g_EVKDrawQueue.frameCount == 0) return;
+
+    evkPipeline* pipeline = NULL;
+    evkCommandRecorder* recorder = NULL;
+    uint32_t currentFrame = evk_get_current_frame();
+    evkRenderphaseType stage = evk_get_current_renderphase_type();
+
+    switch (stage)
+    {
+        case evk_Renderphase_Type_Main:
+        {
+            evkMainRenderphase* renderphase = (evkMainRenderphase*)evk_get_renderphase(stage);
+            pipeline = ievk_pipeline_resolve(&g_EVKSpriteDefaultPipeline, EVK_PIPELINE_SPRITE_DEFAULT_NAME);
+            recorder = &renderphase->evkRenderpass.recorders[currentFrame];
+            break;
+        }
+
+        case evk_Renderphase_Type_Viewport:
+        {
+            evkViewportRenderphase* renderphase = (evkViewportRenderphase*)evk_get_renderphase(stage);
+            pipeline = ievk_pipeline_resolve(&g_EVKSpriteDefaultPipeline, EVK_PIPELINE_SPRITE_DEFAULT_NAME);
+            recorder = &renderphase->evkRenderpass.recorders[currentFrame];
+            break;
+        }
+
+        case evk_Renderphase_Type_Picking:
+        {
+            evkPickingRenderphase* renderphase = (evkPickingRenderphase*)evk_get_renderphase(stage);
+            pipeline = ievk_pipeline_resolve(&g_EVKSpritePickingPipeline, EVK_PIPELINE_SPRITE_PICKING_NAME);
+            recorder = &renderphase->evkRenderpass.recorders[currentFrame];
+            break;
+        }
+
+        default:
+        {
+            return;
+        }
+    }
+
+    // every packet is a sprite quad, the recorder skips the binds that repeat between consecutive packets
+    evk_command_bind_pipeline(recorder, pipeline->pipeline);
+
+    for (uint32_t i = 0; i < g_EVKDrawQueue.frameCount; i++) {
+        const evkDrawPacket* packet = &g_EVKDrawQueue.frame[g_EVKDrawQueue.items[i].index];
+        evkSprite* sprite = packet->sprite;
+
+        if (sprite->albedo && sprite->albedoGenerations[currentFrame] != sprite->albedo->generation) {
+            ievk_sprite_refresh_albedo(sprite, currentFrame);
+        }
+
+        evk_command_bind_descriptor_set(recorder, pipeline->layout, 0, sprite->descriptorSets[currentFrame]);
+
+        evkPushConstant constants = { 0 };
+        constants.id = packet->id != 0 ? packet->id : sprite->id;
+        constants.model = packet->model;
+        evk_command_push_constants(recorder, pipeline->layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(evkPushConstant), &constants);
+        vkCmdDraw(recorder->cmdBuffer, 6, 1, 0, 0);
+    }
+}
+
+evkDrawQueueStats evk_draw_queue_get_stats()
+{
+    evkDrawQueueStats stats = g_EVKDrawQueue.stats;
+    stats.pushed = EVK_ATOMIC_LOAD(&g_EVKDrawQueue.tail);
+    stats.dropped = EVK_ATOMIC_LOAD(&g_EVKDrawQueue.dropped);
+    return stats;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Vertex
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief clamps and converts a [-1, 1] float into snorm16
+static int16_t ievk_vertex_encode_snorm16(float value)
+{
+    value = value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+    return (int16_t)(value >= 0.0f ? value * 32767.0f + 0.5f : value * 32767.0f - 0.5f);
+}
+
+/// @brief clamps and converts a [0, 1] float into unorm16
+static uint16_t ievk_vertex_encode_unorm16(float value)
+{
+    value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+    return (uint16_t)(value * 65535.0f + 0.5f);
+}
+
+/// @brief clamps and converts a [0, 1] float into unorm8
+static uint8_t ievk_vertex_encode_unorm8(float value)
+{
+    value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+    return (uint8_t)(value * 255.0f + 0.5f);
+}
+
+uint16_t evk_vertex_encode_half(float value)
+{
+    union { float f; uint32_t u; } bits = { value };
+    uint32_t sign = (bits.u >> 16) & 0x8000U;
+    uint32_t exponent = (bits.u >> 23) & 0xFFU;
+    uint32_t mantissa = bits.u & 0x7FFFFFU;
+
+    // nan and infinity
+    if (exponent == 0xFFU) {
+        return (uint16_t)(sign | 0x7C00U | (mantissa ? 0x200U : 0U));
+    }
 
-        staging = evk_buffer_create(device, physicalDevice, sizeof(evkSpriteUBO), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 1);
+    int32_t halfExponent = (int32_t)exponent - 127 + 15;
 
-        // copy initial UBO data through staging
-        if (evk_buffer_map(device, staging, 0) != evk_Success) {
-            EVK_LOG(evk_Error, "Failed to map staging buffer");
-            break;
-        }
+    // overflow, becomes infinity
+    if (halfExponent >= 0x1F) {
+        return (uint16_t)(sign | 0x7C00U);
+    }
 
-        if (evk_buffer_copy(staging, 0, &sprite->ubo, sizeof(evkSpriteUBO), 0) != evk_Success) {
-            EVK_LOG(evk_Error, "Failed to copy to staging buffer");
-            evk_buffer_unmap(device, staging, 0);
-            break;
-        }
+    // underflow, becomes a subnormal or zero
+    if (halfExponent <= 0) {
+        if (halfExponent < -10) return (uint16_t)sign;
 
-        evk_buffer_unmap(device, staging, 0);
+        mantissa |= 0x800000U;
+        uint32_t shift = (uint32_t)(14 - halfExponent);
+        uint32_t halfMantissa = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1U << shift) - 1U);
+        uint32_t halfway = 1U << (shift - 1U);
+        if (remainder > halfway || (remainder == halfway && (halfMantissa & 1U))) halfMantissa++;
+        return (uint16_t)(sign | halfMantissa);
+    }
 
-        // copy from staging to each frame's uniform buffer
-        evkRenderphaseType renderPhaseType = evk_using_viewport() ? evk_Renderphase_Type_Viewport : evk_Renderphase_Type_Main;
-        VkCommandPool cmdPool = evk_get_command_pool(renderPhaseType);
+    uint32_t half = sign | ((uint32_t)halfExponent << 10) | (mantissa >> 13);
+    uint32_t remainder = mantissa & 0x1FFFU;
+    if (remainder > 0x1000U || (remainder == 0x1000U && (half & 1U))) half++; // may carry into exponent, which is the correct rounding
+    return (uint16_t)half;
+}
 
-        cmdBuffer = evk_device_begin_commandbuffer_singletime(device, cmdPool);
+void evk_vertex_encode_octahedral(float3 normal, int16_t outNormal[2])
+{
+    float x = normal.xyz.x;
+    float y = normal.xyz.y;
+    float z = normal.xyz.z;
+    float sum = fabsf(x) + fabsf(y) + fabsf(z);
 
-        for (uint32_t i = 0; i < EVK_CONCURRENTLY_RENDERED_FRAMES; i++) {
-            VkDeviceSize dstOffset = i * perFrameAlignedSize;
-            evk_buffer_command_copy(cmdBuffer, staging, 0, sprite->buffer, i, sizeof(evkSpriteUBO), 0, dstOffset);
+    if (sum <= 0.0f) {
+        outNormal[0] = 0;
+        outNormal[1] = 0;
+        return;
+    }
+
+    x /= sum;
+    y /= sum;
+
+    // fold the lower hemisphere over the diagonals
+    if (z < 0.0f) {
+        float foldX = (1.0f - fabsf(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float foldY = (1.0f - fabsf(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = foldX;
+        y = foldY;
+    }
+
+    outNormal[0] = ievk_vertex_encode_snorm16(x);
+    outNormal[1] = ievk_vertex_encode_snorm16(y);
+}
+
+evkVertex evk_vertex_pack(float3 position, float3 normal, float2 uv, float4 color, const uint8_t* joints, float4 weights)
+{
+    evkVertex vertex = { 0 };
+    vertex.position = position;
+    evk_vertex_encode_octahedral(normal, vertex.normal);
+    vertex.uv_0[0] = evk_vertex_encode_half(uv.xy.x);
+    vertex.uv_0[1] = evk_vertex_encode_half(uv.xy.y);
+
+    for (uint32_t i = 0; i < 4; i++) {
+        vertex.color_0[i] = ievk_vertex_encode_unorm8(color.data[i]);
+        vertex.joints_0[i] = joints != NULL ? joints[i] : 0;
+        vertex.weights_0[i] = ievk_vertex_encode_unorm16(weights.data[i]);
+    }
+
+    return vertex;
+}
+
+void evk_vertex_interleave(const evkVertexLayout* layout, const evkVertex* vertices, uint32_t count, void* dst)
+{
+    if (!layout || !vertices || !dst) return;
+
+    uint8_t* out = (uint8_t*)dst;
+    for (uint32_t v = 0; v < count; v++) {
+        const evkVertex* vertex = &vertices[v];
+        uint8_t* base = out + (size_t)v * layout->stride;
+
+        for (uint32_t i = 0; i < layout->componentsCount; i++) {
+            evkVertexComponent component = layout->components[i];
+            const void* src = NULL;
+
+            switch (component)
+            {
+                case evk_Vertex_Component_Position: { src = &vertex->position; break; }
+                case evk_Vertex_Component_Normal: { src = vertex->normal; break; }
+                case evk_Vertex_Component_UV_0: { src = vertex->uv_0; break; }
+                case evk_Vertex_Component_Color_0: { src = vertex->color_0; break; }
+                case evk_Vertex_Component_Joints_0: { src = vertex->joints_0; break; }
+                case evk_Vertex_Component_Weights_0: { src = vertex->weights_0; break; }
+                default: { break; }
+            }
+
+            if (src != NULL) {
+                memcpy(base + layout->offsets[component], src, evk_vertex_component_size(component));
+            }
         }
+    }
+}
 
-        evk_device_end_commandbuffer_singletime(device, cmdPool, cmdBuffer, evk_get_graphics_queue());
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Mesh
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        // get pipeline, create descriptor pool and allocate descriptor sets
-        evkPipeline* pipeline = (evkPipeline*)shashtable_lookup(evk_get_pipelines_library(), EVK_PIPELINE_SPRITE_DEFAULT_NAME);
+struct evkMeshArena
+{
+    evkBuffer* vertexBuffer;
+    evkBuffer* indexBuffer;
+    VkDeviceSize vertexUsed;
+    VkDeviceSize indexUsed;
+    uint32_t meshCount;
+};
 
-        if (!pipeline) {
-            EVK_LOG(evk_Error, "Failed to find sprite pipeline");
+struct evkMesh
+{
+    uint32_t id;
+    evkVertexLayout layout;
+    evkIndexType indexType;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    VkDeviceSize vertexOffset;
+    VkDeviceSize indexOffset;
+    evkMeshArena* arena;
+    bool ownsArena;
+    VkDescriptorPool descriptorPool;
+    VkDescriptorSet descriptorSets[EVK_CONCURRENTLY_RENDERED_FRAMES];
+};
+
+/// @brief rounds the value up to the next multiple of four, used for buffer sizes and staging offsets
+static VkDeviceSize ievk_mesh_align(VkDeviceSize value)
+{
+    return (value + 3) & ~(VkDeviceSize)3;
+}
+
+/// @brief rounds the value up to the next multiple of size, arena offsets must be whole vertices and indices so draws can address them
+static VkDeviceSize ievk_mesh_align_to(VkDeviceSize value, VkDeviceSize size)
+{
+    return ((value + size - 1) / size) * size;
+}
+
+/// @brief returns the byte size of one index of the mesh
+static VkDeviceSize ievk_mesh_index_size(const evkMesh* mesh)
+{
+    return mesh->indexType == evk_Index_Type_U16 ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+
+/// @brief records the indexed draw of a mesh whose arena buffers are bound at offset 0
+static void ievk_mesh_draw_indexed(evkMesh* mesh, VkCommandBuffer cmdBuffer)
+{
+    uint32_t firstIndex = (uint32_t)(mesh->indexOffset / ievk_mesh_index_size(mesh));
+    int32_t vertexOffset = (int32_t)(mesh->vertexOffset / mesh->layout.stride);
+    vkCmdDrawIndexed(cmdBuffer, mesh->indexCount, 1, firstIndex, vertexOffset, 0);
+}
+
+/// @brief allocates and writes the camera descriptor sets used by the mesh pipelines
+static evkResult ievk_mesh_create_descriptors(evkMesh* mesh, VkDevice device)
+{
+    evkPipeline* pipeline = ievk_pipeline_resolve(&g_EVKMeshDefaultPipeline, EVK_PIPELINE_MESH_DEFAULT_NAME);
+    if (!pipeline) {
+        EVK_LOG(evk_Error, "Failed to find mesh pipeline");
+        return evk_Failure;
+    }
+
+    VkDescriptorPoolSize poolSize = { 0 };
+    poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    poolSize.descriptorCount = EVK_CONCURRENTLY_RENDERED_FRAMES;
+
+    VkDescriptorPoolCreateInfo descriptorPoolCI = { 0 };
+    descriptorPoolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    descriptorPoolCI.poolSizeCount = 1;
+    descriptorPoolCI.pPoolSizes = &poolSize;
+    descriptorPoolCI.maxSets = EVK_CONCURRENTLY_RENDERED_FRAMES;
+
+    if (vkCreateDescriptorPool(device, &descriptorPoolCI, evk_get_vulkan_allocator(), &mesh->descriptorPool) != VK_SUCCESS) {
+        EVK_LOG(evk_Error, "Failed to create descriptor pool for mesh");
+        return evk_Failure;
+    }
+
+    VkDescriptorSetLayout layouts[EVK_CONCURRENTLY_RENDERED_FRAMES];
+
+    for (uint32_t i = 0; i < EVK_CONCURRENTLY_RENDERED_FRAMES; i++) {
+        layouts[i] = pipeline->descriptorSetLayout;
+    }
+
+    VkDescriptorSetAllocateInfo descSetAllocInfo = { 0 };
+    descSetAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    descSetAllocInfo.descriptorPool = mesh->descriptorPool;
+    descSetAllocInfo.descriptorSetCount = EVK_CONCURRENTLY_RENDERED_FRAMES;
+    descSetAllocInfo.pSetLayouts = layouts;
+
+    if (vkAllocateDescriptorSets(device, &descSetAllocInfo, mesh->descriptorSets) != VK_SUCCESS) {
+        EVK_LOG(evk_Error, "Failed to allocate descriptor sets for mesh");
+        return evk_Failure;
+    }
+
+    evkBuffer* cameraBuffer = evk_buffer_library_get(evk_get_main_camera_buffer());
+
+    for (uint32_t i = 0; i < EVK_CONCURRENTLY_RENDERED_FRAMES; i++) {
+        VkDescriptorBufferInfo camInfo = { 0 };
+        camInfo.buffer = cameraBuffer->buffers[i];
+        camInfo.offset = 0;
+        camInfo.range = sizeof(evkCameraUBO);
+
+        VkWriteDescriptorSet desc = { 0 };
+        desc.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        desc.dstSet = mesh->descriptorSets[i];
+        desc.dstBinding = 0;
+        desc.dstArrayElement = 0;
+        desc.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        desc.descriptorCount = 1;
+        desc.pBufferInfo = &camInfo;
+        vkUpdateDescriptorSets(device, 1, &desc, 0, NULL);
+    }
+
+    return evk_Success;
+}
+
+evkMeshArena* evk_mesh_arena_create(VkDeviceSize vertexCapacity, VkDeviceSize indexCapacity)
+{
+    if (vertexCapacity == 0 || indexCapacity == 0) {
+        EVK_LOG(evk_Error, "Mesh arena requires non-zero capacities");
+        return NULL;
+    }
+
+    evkMeshArena* arena = (evkMeshArena*)EVK_MALLOC(evk_Allocation_Tag_Drawable, sizeof(evkMeshArena));
+    if (arena == NULL) {
+        EVK_LOG(evk_Error, "Out of memory to allocate mesh arena");
+        return NULL;
+    }
+
+    memset(arena, 0, sizeof(evkMeshArena));
+
+    VkDevice device = evk_get_device();
+    VkPhysicalDevice physicalDevice = evk_get_physical_device();
+
+    arena->vertexBuffer = evk_buffer_create(device, physicalDevice, ievk_mesh_align(vertexCapacity), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 1);
+    arena->indexBuffer = evk_buffer_create(device, physicalDevice, ievk_mesh_align(indexCapacity), VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 1);
+
+    if (!arena->vertexBuffer || !arena->indexBuffer) {
+        EVK_LOG(evk_Error, "Failed to create mesh arena buffers");
+        evk_mesh_arena_destroy(arena);
+        return NULL;
+    }
+
+    return arena;
+}
+
+void evk_mesh_arena_destroy(evkMeshArena* arena)
+{
+    if (!arena) return;
+
+    if (arena->meshCount > 0) {
+        EVK_LOG(evk_Warn, "Destroying mesh arena while %u meshes still reference it", arena->meshCount);
+    }
+
+    VkDevice device = evk_get_device();
+    vkDeviceWaitIdle(device);
+
+    if (arena->vertexBuffer) evk_buffer_destroy(device, arena->vertexBuffer);
+    if (arena->indexBuffer) evk_buffer_destroy(device, arena->indexBuffer);
+
+    EVK_FREE(arena);
+}
+
+VkDeviceSize evk_mesh_arena_get_vertex_usage(evkMeshArena* arena)
+{
+    return arena ? arena->vertexUsed : 0;
+}
+
+VkDeviceSize evk_mesh_arena_get_index_usage(evkMeshArena* arena)
+{
+    return arena ? arena->indexUsed : 0;
+}
+
+evkResult evk_mesh_create_pipelines(const evkMeshShaders* shaders)
+{
+    evkRenderpass* renderpass = NULL;
+
+    if (evk_using_viewport()) {
+        evkViewportRenderphase* renderphase = (evkViewportRenderphase*)evk_get_renderphase(evk_Renderphase_Type_Viewport);
+        renderpass = &renderphase->evkRenderpass;
+    }
+    else {
+        evkMainRenderphase* renderphase = (evkMainRenderphase*)evk_get_renderphase(evk_Renderphase_Type_Main);
+        renderpass = &renderphase->evkRenderpass;
+    }
+
+    evkPickingRenderphase* pickingRenderphase = (evkPickingRenderphase*)evk_get_renderphase(evk_Renderphase_Type_Picking);
+    return evk_pipeline_mesh_create(evk_get_pipelines_library(), renderpass, &pickingRenderphase->evkRenderpass, evk_get_device(), shaders);
+}
+
+evkMesh* evk_mesh_create(const evkVertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount, const evkVertexComponent* components, uint32_t componentsCount, evkMeshArena* arena)
+{
+    if (vertices == NULL || vertexCount == 0 || indices == NULL || indexCount == 0) {
+        EVK_LOG(evk_Error, "Mesh requires vertices and indices");
+        return NULL;
+    }
+
+    evkMesh* mesh = (evkMesh*)EVK_MALLOC(evk_Allocation_Tag_Drawable, sizeof(evkMesh));
+    if (mesh == NULL) {
+        EVK_LOG(evk_Error, "Out of memory to allocate mesh");
+        return NULL;
+    }
+
+    memset(mesh, 0, sizeof(evkMesh));
+    mesh->layout = evk_vertex_layout_create(components, componentsCount);
+    mesh->vertexCount = vertexCount;
+    mesh->indexCount = indexCount;
+    mesh->indexType = vertexCount <= UINT16_MAX ? evk_Index_Type_U16 : evk_Index_Type_U32;
+
+    VkDevice device = evk_get_device();
+    VkPhysicalDevice physicalDevice = evk_get_physical_device();
+    evkBuffer* staging = NULL;
+    VkCommandBuffer cmdBuffer = VK_NULL_HANDLE;
+    bool success = false;
+
+    do
+    {
+        if (mesh->layout.stride == 0) {
+            EVK_LOG(evk_Error, "Mesh vertex layout has no components");
             break;
         }
-       
-        VkDescriptorPoolSize poolSizes[3] = { 0 };
-        poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        poolSizes[0].descriptorCount = EVK_CONCURRENTLY_RENDERED_FRAMES;
-        poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        poolSizes[1].descriptorCount = EVK_CONCURRENTLY_RENDERED_FRAMES;
-        poolSizes[2].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        poolSizes[2].descriptorCount = EVK_CONCURRENTLY_RENDERED_FRAMES;
 
-        VkDescriptorPoolCreateInfo descriptorPoolCI = { 0 };
-        descriptorPoolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-        descriptorPoolCI.poolSizeCount = (uint32_t)EVK_STATIC_ARRAY_SIZE(poolSizes);
-        descriptorPoolCI.pPoolSizes = poolSizes;
-        descriptorPoolCI.maxSets = EVK_CONCURRENTLY_RENDERED_FRAMES;
+        mesh->id = evk_entity_create(mesh);
+        if (mesh->id == 0) break;
+
+        VkDeviceSize vertexSize = (VkDeviceSize)mesh->layout.stride * vertexCount;
+        VkDeviceSize indexSize = ievk_mesh_index_size(mesh) * indexCount;
+
+        // without an arena the mesh gets one sized exactly for it
+        if (arena == NULL) {
+            mesh->arena = evk_mesh_arena_create(vertexSize, indexSize);
+            mesh->ownsArena = true;
+            if (!mesh->arena) break;
+        }
+        else {
+            mesh->arena = arena;
+        }
 
-        if (vkCreateDescriptorPool(device, &descriptorPoolCI, NULL, &sprite->descriptorPool) != VK_SUCCESS) {
-            EVK_LOG(evk_Error, "Failed to create descriptor pool for quad: %s", path);
+        mesh->vertexOffset = ievk_mesh_align_to(mesh->arena->vertexUsed, mesh->layout.stride);
+        mesh->indexOffset = ievk_mesh_align_to(mesh->arena->indexUsed, ievk_mesh_index_size(mesh));
+
+        if (mesh->vertexOffset + vertexSize > mesh->arena->vertexBuffer->size || mesh->indexOffset + indexSize > mesh->arena->indexBuffer->size) {
+            EVK_LOG(evk_Error, "Mesh arena is out of space for a mesh of %u vertices and %u indices", vertexCount, indexCount);
+            if (!mesh->ownsArena) mesh->arena = NULL;
             break;
         }
 
-        VkDescriptorSetLayout layouts[EVK_CONCURRENTLY_RENDERED_FRAMES];
+        // vertices and indices are written into a single staging buffer, indices start right after the vertices
+        VkDeviceSize stagingIndexOffset = ievk_mesh_align(vertexSize);
+        staging = evk_buffer_create(device, physicalDevice, stagingIndexOffset + indexSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 1);
+        if (!staging || !staging->isMapped[0]) {
+            EVK_LOG(evk_Error, "Failed to create mesh staging buffer");
+            if (!mesh->ownsArena) mesh->arena = NULL;
+            break;
+        }
 
-        for (uint32_t i = 0; i < EVK_CONCURRENTLY_RENDERED_FRAMES; i++) {
-            layouts[i] = pipeline->descriptorSetLayout;
+        uint8_t* mapped = (uint8_t*)staging->mappedPointers[0];
+        evk_vertex_interleave(&mesh->layout, vertices, vertexCount, mapped);
+
+        if (mesh->indexType == evk_Index_Type_U16) {
+            uint16_t* dst = (uint16_t*)(mapped + stagingIndexOffset);
+            for (uint32_t i = 0; i < indexCount; i++) dst[i] = (uint16_t)indices[i];
+        }
+        else {
+            memcpy(mapped + stagingIndexOffset, indices, indexSize);
         }
 
-        VkDescriptorSetAllocateInfo descSetAllocInfo = { 0 };
-        descSetAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        descSetAllocInfo.descriptorPool = sprite->descriptorPool;
-        descSetAllocInfo.descriptorSetCount = EVK_CONCURRENTLY_RENDERED_FRAMES;
-        descSetAllocInfo.pSetLayouts = layouts;
+        evkRenderphaseType renderPhaseType = evk_using_viewport() ? evk_Renderphase_Type_Viewport : evk_Renderphase_Type_Main;
+        VkCommandPool cmdPool = evk_get_command_pool(renderPhaseType);
 
-        if (vkAllocateDescriptorSets(device, &descSetAllocInfo, sprite->descriptorSets) != VK_SUCCESS) {
-            EVK_LOG(evk_Error, "Failed to allocate descriptor sets for sprite");
+        cmdBuffer = evk_device_begin_commandbuffer_singletime(device, cmdPool);
+        evk_buffer_command_copy(cmdBuffer, staging, 0, mesh->arena->vertexBuffer, 0, vertexSize, 0, mesh->vertexOffset);
+        evk_buffer_command_copy(cmdBuffer, staging, 0, mesh->arena->indexBuffer, 0, indexSize, stagingIndexOffset, mesh->indexOffset);
+
+        if (evk_device_end_commandbuffer_singletime(device, cmdPool, cmdBuffer, evk_get_graphics_queue()) != evk_Success) {
+            EVK_LOG(evk_Error, "Failed to upload mesh data");
+            if (!mesh->ownsArena) mesh->arena = NULL;
             break;
         }
 
-        ievk_sprite_refresh_data(sprite);
+        mesh->arena->vertexUsed = mesh->vertexOffset + vertexSize;
+        mesh->arena->indexUsed = mesh->indexOffset + indexSize;
+        mesh->arena->meshCount++;
+
+        if (ievk_mesh_create_descriptors(mesh, device) != evk_Success) {
+            break;
+        }
 
         success = true;
     } while (0);
@@ -636,64 +4284,64 @@ evkSprite* evk_sprite_create_from_path(const char* path, uint32_t id)
     }
 
     if (!success) {
-        evk_sprite_destroy(sprite);
-        m_free(sprite);
+        evk_mesh_destroy(mesh);
         return NULL;
     }
 
-    return sprite;
+    return mesh;
 }
 
-void evk_sprite_destroy(evkSprite* sprite)
+void evk_mesh_destroy(evkMesh* mesh)
 {
-    if (!sprite) return;
+    if (!mesh) return;
 
     VkDevice device = evk_get_device();
     vkDeviceWaitIdle(device);
 
-    if (sprite->descriptorPool != VK_NULL_HANDLE) {
-        vkDestroyDescriptorPool(device, sprite->descriptorPool, NULL);
+    if (mesh->descriptorPool != VK_NULL_HANDLE) {
+        vkDestroyDescriptorPool(device, mesh->descriptorPool, evk_get_vulkan_allocator());
     }
 
-    if (sprite->buffer) {
-        evk_buffer_destroy(device, sprite->buffer);
-    }
+    if (mesh->arena) {
+        evkMeshArena* arena = mesh->arena;
+        if (arena->meshCount > 0) arena->meshCount--;
+
+        // the arena is a bump allocator, space returns when it empties or when the mesh was the last one placed
+        VkDeviceSize vertexEnd = mesh->vertexOffset + (VkDeviceSize)mesh->layout.stride * mesh->vertexCount;
+        VkDeviceSize indexEnd = mesh->indexOffset + ievk_mesh_index_size(mesh) * mesh->indexCount;
+        if (arena->meshCount == 0) {
+            arena->vertexUsed = 0;
+            arena->indexUsed = 0;
+        }
+        else {
+            if (arena->vertexUsed == vertexEnd) arena->vertexUsed = mesh->vertexOffset;
+            if (arena->indexUsed == indexEnd) arena->indexUsed = mesh->indexOffset;
+        }
 
-    if (sprite->albedo) {
-        evk_texture2d_destroy(sprite->albedo);
+        if (mesh->ownsArena) evk_mesh_arena_destroy(arena);
     }
 
-    m_free(sprite);
+    evk_entity_destroy(mesh->id);
+    EVK_FREE(mesh);
 }
 
-void evk_sprite_update(evkSprite* sprite, bool resend)
+void evk_mesh_draw(evkMesh* mesh, VkCommandBuffer cmdBuffer)
 {
-    if (!sprite) return;
-
-    VkDevice device = evk_get_device();
-
-    if (sprite->buffer) {
-        if (resend) {
-            ievk_sprite_refresh_data(sprite);
-        }
-
-        VkPhysicalDeviceProperties properties = evk_get_physical_device_properties();
+    if (!mesh || cmdBuffer == VK_NULL_HANDLE) return;
 
-        for (uint32_t i = 0; i < EVK_CONCURRENTLY_RENDERED_FRAMES; i++) {
-            evk_buffer_map(device, sprite->buffer, i);
-            evk_buffer_copy(sprite->buffer, i, &sprite->ubo, sizeof(evkSpriteUBO), 0);
-            evk_buffer_flush(device, sprite->buffer, i, sizeof(evkSpriteUBO), properties.limits.nonCoherentAtomSize, 0);
-            evk_buffer_unmap(device, sprite->buffer, i);
-        }
-    }
+    VkDeviceSize offset = 0;
+    VkIndexType indexType = mesh->indexType == evk_Index_Type_U16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+    vkCmdBindVertexBuffers(cmdBuffer, 0, 1, &mesh->arena->vertexBuffer->buffers[0], &offset);
+    vkCmdBindIndexBuffer(cmdBuffer, mesh->arena->indexBuffer->buffers[0], 0, indexType);
+    ievk_mesh_draw_indexed(mesh, cmdBuffer);
 }
 
-void evk_sprite_render(evkSprite* sprite, fmat4* modelMatrix)
+void evk_mesh_render(evkMesh* mesh, fmat4* modelMatrix)
 {
-    const VkDeviceSize offsets[] = { 0 };
+    if (!mesh) return;
+
     evkPipeline* pipeline = NULL;
-    VkCommandBuffer cmdBuffer = VK_NULL_HANDLE;
-    VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+    evkCommandRecorder* recorder = NULL;
     uint32_t currentFrame = evk_get_current_frame();
     evkRenderphaseType stage = evk_get_current_renderphase_type();
 
@@ -702,23 +4350,24 @@ void evk_sprite_render(evkSprite* sprite, fmat4* modelMatrix)
         case evk_Renderphase_Type_Main:
         {
             evkMainRenderphase* renderphase = (evkMainRenderphase*)evk_get_renderphase(stage);
-            pipeline = (evkPipeline*)shashtable_lookup(evk_get_pipelines_library(), EVK_PIPELINE_SPRITE_DEFAULT_NAME);
-            cmdBuffer = renderphase->evkRenderpass.cmdBuffers[currentFrame];
+            pipeline = ievk_pipeline_resolve(&g_EVKMeshDefaultPipeline, EVK_PIPELINE_MESH_DEFAULT_NAME);
+            recorder = &renderphase->evkRenderpass.recorders[currentFrame];
             break;
         }
 
         case evk_Renderphase_Type_Viewport:
         {
             evkViewportRenderphase* renderphase = (evkViewportRenderphase*)evk_get_renderphase(stage);
-            pipeline = (evkPipeline*)shashtable_lookup(evk_get_pipelines_library(), EVK_PIPELINE_SPRITE_DEFAULT_NAME); // viewport uses the same pipe as the default one
-            cmdBuffer = renderphase->evkRenderpass.cmdBuffers[currentFrame];
+            pipeline = ievk_pipeline_resolve(&g_EVKMeshDefaultPipeline, EVK_PIPELINE_MESH_DEFAULT_NAME); // viewport uses the same pipe as the default one
+            recorder = &renderphase->evkRenderpass.recorders[currentFrame];
+            break;
         }
 
         case evk_Renderphase_Type_Picking:
         {
             evkPickingRenderphase* renderphase = (evkPickingRenderphase*)evk_get_renderphase(stage);
-            pipeline = (evkPipeline*)shashtable_lookup(evk_get_pipelines_library(), EVK_PIPELINE_SPRITE_PICKING_NAME);
-            cmdBuffer = renderphase->evkRenderpass.cmdBuffers[currentFrame];
+            pipeline = ievk_pipeline_resolve(&g_EVKMeshPickingPipeline, EVK_PIPELINE_MESH_PICKING_NAME);
+            recorder = &renderphase->evkRenderpass.recorders[currentFrame];
             break;
         }
 
@@ -728,19 +4377,38 @@ void evk_sprite_render(evkSprite* sprite, fmat4* modelMatrix)
         }
     }
 
-    pipelineLayout = pipeline->layout;
+    if (!pipeline) return;
 
     evkPushConstant constants = { 0 };
-    constants.id = sprite->id;
+    constants.id = mesh->id;
     constants.model = *modelMatrix;
-    vkCmdPushConstants(cmdBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(evkPushConstant), &constants);
+    evk_command_push_constants(recorder, pipeline->layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(evkPushConstant), &constants);
 
-    vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &sprite->descriptorSets[currentFrame], 0, NULL);
-    vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->pipeline);
-    vkCmdDraw(cmdBuffer, 6, 1, 0, 0);
+    evk_command_bind_descriptor_set(recorder, pipeline->layout, 0, mesh->descriptorSets[currentFrame]);
+    evk_command_bind_pipeline(recorder, pipeline->pipeline);
+
+    // meshes sharing an arena keep the same buffers bound and only move the draw's first index and vertex offset
+    evk_command_bind_vertex_buffer(recorder, mesh->arena->vertexBuffer->buffers[0]);
+    evk_command_bind_index_buffer(recorder, mesh->arena->indexBuffer->buffers[0], mesh->indexType == evk_Index_Type_U16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32);
+    ievk_mesh_draw_indexed(mesh, recorder->cmdBuffer);
 }
 
-uint32_t evk_sprite_get_id(evkSprite* sprite)
+uint32_t evk_mesh_get_id(evkMesh* mesh)
 {
-    return sprite != NULL ? sprite->id : 0;
+    return mesh != NULL ? mesh->id : 0;
+}
+
+const evkVertexLayout* evk_mesh_get_layout(evkMesh* mesh)
+{
+    return mesh ? &mesh->layout : NULL;
+}
+
+uint32_t evk_mesh_get_vertex_count(evkMesh* mesh)
+{
+    return mesh ? mesh->vertexCount : 0;
+}
+
+uint32_t evk_mesh_get_index_count(evkMesh* mesh)
+{
+    return mesh ? mesh->indexCount : 0;
 }
@@ -8,6 +8,59 @@
 extern "C" {
 #endif
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Command Recorder
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief remembers the graphics state bound on a command buffer so redundant binds are not recorded
+typedef struct evkCommandRecorder
+{
+	VkCommandBuffer cmdBuffer;
+	VkPipeline pipeline;
+	VkPipelineLayout setsLayout;		// layout the cached descriptor sets were bound with
+	VkDescriptorSet sets[EVK_COMMAND_RECORDER_MAX_SETS];
+	VkPipelineLayout pushLayout;		// layout, stages and range of the cached push constants
+	VkShaderStageFlags pushStages;
+	uint32_t pushOffset;
+	uint32_t pushSize;
+	uint8_t pushData[EVK_COMMAND_RECORDER_PUSH_CONSTANTS_SIZE];
+	VkViewport viewport;
+	VkRect2D scissor;
+	VkBuffer vertexBuffer;				// bound at binding 0 with offset 0, meshes address their arena range on the draw
+	VkBuffer indexBuffer;
+	VkIndexType indexType;
+	bool viewportSet;
+	bool scissorSet;
+	evkCommandStats stats;
+} evkCommandRecorder;
+
+/// @brief starts tracking a command buffer that has just begun recording, forgetting the previous state and counters
+void evk_command_begin(evkCommandRecorder* recorder, VkCommandBuffer cmdBuffer);
+
+/// @brief forgets the tracked state while keeping the counters, needed after binding state on the command buffer without the recorder
+void evk_command_invalidate(evkCommandRecorder* recorder);
+
+/// @brief binds a graphics pipeline unless it's already bound
+void evk_command_bind_pipeline(evkCommandRecorder* recorder, VkPipeline pipeline);
+
+/// @brief binds a graphics descriptor set at index unless the same set is bound there with the same layout
+void evk_command_bind_descriptor_set(evkCommandRecorder* recorder, VkPipelineLayout layout, uint32_t index, VkDescriptorSet set);
+
+/// @brief updates push constants unless the exact same bytes were pushed on the same range
+void evk_command_push_constants(evkCommandRecorder* recorder, VkPipelineLayout layout, VkShaderStageFlags stages, uint32_t offset, uint32_t size, const void* data);
+
+/// @brief sets the dynamic viewport unless it didn't change
+void evk_command_set_viewport(evkCommandRecorder* recorder, const VkViewport* viewport);
+
+/// @brief sets the dynamic scissor unless it didn't change
+void evk_command_set_scissor(evkCommandRecorder* recorder, const VkRect2D* scissor);
+
+/// @brief binds a vertex buffer at binding 0 with offset 0 unless it's already bound
+void evk_command_bind_vertex_buffer(evkCommandRecorder* recorder, VkBuffer buffer);
+
+/// @brief binds an index buffer with offset 0 unless it's already bound with the same index type
+void evk_command_bind_index_buffer(evkCommandRecorder* recorder, VkBuffer buffer, VkIndexType indexType);
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Pipelines
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -20,6 +73,7 @@ typedef struct evkRenderpass
 	VkFormat format;
 	VkCommandPool cmdPool;
 	VkCommandBuffer cmdBuffers[EVK_CONCURRENTLY_RENDERED_FRAMES];
+	evkCommandRecorder recorders[EVK_CONCURRENTLY_RENDERED_FRAMES];
 	VkFramebuffer* framebuffers;
 	uint32_t framebufferCount;
 	VkRenderPass renderpass;
@@ -61,6 +115,8 @@ typedef struct evkPipeline
 	VkDescriptorSetLayout descriptorSetLayout;
 	VkPipelineLayout layout;
 	VkPipeline pipeline;
+	evkPipelineHandle handle;		// set once the pipeline is inserted into the library
+	evkVertexLayout vertexLayout;
 	VkVertexInputBindingDescription* bindingsDescription;
 	VkVertexInputAttributeDescription* attributesDescription;
 	uint32_t bindingsDescriptionCount;
@@ -78,9 +134,26 @@ typedef struct evkPipeline
 	VkPipelineColorBlendStateCreateInfo colorBlendState;
 } evkPipeline;
 
+/// @brief returns how many bytes a vertex component occupies on the interleaved vertex buffer
+uint32_t evk_vertex_component_size(evkVertexComponent component);
+
+/// @brief creates the interleaved vertex layout for the given components, in the order they were provided, invalid and repeated components are ignored
+evkVertexLayout evk_vertex_layout_create(const evkVertexComponent* components, uint32_t componentsCount);
+
+/// @brief inserts the pipeline into the library under name and returns it's handle, a pipeline replaced under the same name gets a new handle
+evkPipelineHandle evk_pipeline_library_insert(shashtable* pipelines, const char* name, evkPipeline* pipeline);
+
+/// @brief returns the handle of the pipeline inserted under name, 0 when there's none, meant to be resolved once and kept
+evkPipelineHandle evk_pipeline_library_find(shashtable* pipelines, const char* name);
+
+/// @brief returns the pipeline of a handle, NULL once the pipeline was destroyed or recreated
+evkPipeline* evk_pipeline_library_get(evkPipelineHandle handle);
+
 /// @brief name of pipelines for easy hashtable lookup
 #define EVK_PIPELINE_SPRITE_DEFAULT_NAME "SPRITE:DEFAULT"
 #define EVK_PIPELINE_SPRITE_PICKING_NAME "SPRITE:PICKING"
+#define EVK_PIPELINE_MESH_DEFAULT_NAME "MESH:DEFAULT"
+#define EVK_PIPELINE_MESH_PICKING_NAME "MESH:PICKING"
 
 /// @brief creates the sprite pipeline
 evkResult evk_pipeline_sprite_create(shashtable* pipelines, evkRenderpass* renderpass, evkRenderpass* pickingRenderpass, VkDevice device);
@@ -88,6 +161,15 @@ evkResult evk_pipeline_sprite_create(shashtable* pipelines, evkRenderpass* rende
 /// @brief releases all resources used in the sprite pipeline
 void evk_pipeline_sprite_destroy(shashtable* pipelines, VkDevice device);
 
+/// @brief returns the mesh shaders shipped with evk and the vertex layout they read
+evkMeshShaders evk_pipeline_mesh_default_shaders();
+
+/// @brief creates the mesh pipelines, both pipelines share the same vertex layout so a mesh may be drawn on either
+evkResult evk_pipeline_mesh_create(shashtable* pipelines, evkRenderpass* renderpass, evkRenderpass* pickingRenderpass, VkDevice device, const evkMeshShaders* shaders);
+
+/// @brief releases all resources used in the mesh pipelines
+void evk_pipeline_mesh_destroy(shashtable* pipelines, VkDevice device);
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Main render phase
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
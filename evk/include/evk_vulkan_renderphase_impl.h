@@ -4,95 +4,79 @@
 #include "shader/sprite_default_frag_spv.h"
 #include "shader/sprite_picking_vert_spv.h"
 #include "shader/sprite_picking_frag_spv.h"
+#include "shader/mesh_default_vert_spv.h"
+#include "shader/mesh_default_frag_spv.h"
+#include "shader/mesh_picking_vert_spv.h"
+#include "shader/mesh_picking_frag_spv.h"
+
+#undef EVK_LOG_CATEGORY
+#define EVK_LOG_CATEGORY evk_Log_Category_Renderphase
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Internal
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// @brief returns the vulkan format a vertex component is fetched with
+static VkFormat ievk_pipeline_get_vertex_component_format(evkVertexComponent component)
+{
+	switch (component)
+	{
+		case evk_Vertex_Component_Position: return VK_FORMAT_R32G32B32_SFLOAT;
+		case evk_Vertex_Component_Normal: return VK_FORMAT_R16G16_SNORM;
+		case evk_Vertex_Component_UV_0: return VK_FORMAT_R16G16_SFLOAT;
+		case evk_Vertex_Component_Color_0: return VK_FORMAT_R8G8B8A8_UNORM;
+		case evk_Vertex_Component_Joints_0: return VK_FORMAT_R8G8B8A8_UINT;
+		case evk_Vertex_Component_Weights_0: return VK_FORMAT_R16G16B16A16_UNORM;
+		default: break;
+	}
+	return VK_FORMAT_UNDEFINED;
+}
+
 /// @brief creates an array of VkVertexInputBindingDescription based on parameters
-static VkVertexInputBindingDescription* ievk_pipeline_get_binding_descriptions(bool passingVertexData, uint32_t* bindingCount)
+static VkVertexInputBindingDescription* ievk_pipeline_get_binding_descriptions(bool passingVertexData, const evkVertexLayout* layout, uint32_t* bindingCount)
 {
-    if (!passingVertexData) {
+    if (!passingVertexData || layout->componentsCount == 0) {
         *bindingCount = 0U;
         return NULL;
     }
 
-    VkVertexInputBindingDescription* bindings = (VkVertexInputBindingDescription*)m_malloc(sizeof(VkVertexInputBindingDescription));
+    VkVertexInputBindingDescription* bindings = (VkVertexInputBindingDescription*)EVK_MALLOC(evk_Allocation_Tag_Renderphase, sizeof(VkVertexInputBindingDescription));
     bindings[0].binding = 0;
-    bindings[0].stride = sizeof(evkVertex);
+    bindings[0].stride = layout->stride;
     bindings[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
     *bindingCount = 1U;
     return bindings;
 }
 
-/// @brief creates an array of VkVertexInputAttributeDescription
-static VkVertexInputAttributeDescription* ievk_pipeline_get_attribute_descriptions(evkVertexComponent* vertexComponents, uint32_t componentsCount, uint32_t* attributesCount)
+/// @brief creates an array of VkVertexInputAttributeDescription, only the components present on the layout are fetched
+static VkVertexInputAttributeDescription* ievk_pipeline_get_attribute_descriptions(bool passingVertexData, const evkVertexLayout* layout, uint32_t* attributesCount)
 {
-	VkVertexInputAttributeDescription* bindings = (VkVertexInputAttributeDescription*)m_malloc(sizeof(VkVertexInputAttributeDescription) * componentsCount);
+	if (!passingVertexData || layout->componentsCount == 0) {
+		*attributesCount = 0U;
+		return NULL;
+	}
 
-	for (uint32_t i = 0; i < componentsCount; i++) {
-		evkVertexComponent component = vertexComponents[i];
+	VkVertexInputAttributeDescription* attributes = (VkVertexInputAttributeDescription*)EVK_MALLOC(evk_Allocation_Tag_Renderphase, sizeof(VkVertexInputAttributeDescription) * layout->componentsCount);
+
+	for (uint32_t i = 0; i < layout->componentsCount; i++) {
+		evkVertexComponent component = layout->components[i];
 		VkVertexInputAttributeDescription desc = { 0 };
 		desc.binding = 0;
 		desc.location = (uint32_t)component;
-
-		switch (component)
-		{
-			case evk_Vertex_Component_Position:
-			{
-				desc.format = VK_FORMAT_R32G32B32_SFLOAT;
-				desc.offset = offsetof(evkVertex, position);
-				break;
-			}
-
-			case evk_Vertex_Component_Normal:
-			{
-				desc.format = VK_FORMAT_R32G32B32_SFLOAT;
-				desc.offset = offsetof(evkVertex, normal);
-				break;
-			}
-
-			case evk_Vertex_Component_UV_0:
-			{
-				desc.format = VK_FORMAT_R32G32_SFLOAT;
-				desc.offset = offsetof(evkVertex, uv_0);
-				break;
-			}
-
-			case evk_Vertex_Component_Color_0:
-			{
-				desc.format = VK_FORMAT_R32G32B32A32_SFLOAT;
-				desc.offset = offsetof(evkVertex, color_0);
-				break;
-			}
-
-			case evk_Vertex_Component_Weights_0:
-			{
-				desc.format = VK_FORMAT_R32G32B32A32_SFLOAT;
-				desc.offset = offsetof(evkVertex, weights_0);
-				break;
-			}
-
-			case evk_Vertex_Component_Joints_0:
-			{
-				desc.format = VK_FORMAT_R32G32B32A32_SFLOAT;
-				desc.offset = offsetof(evkVertex, joints_0);
-				break;
-			}
-
-			default: break;
-		}
-		bindings[i] = desc;
+		desc.format = ievk_pipeline_get_vertex_component_format(component);
+		desc.offset = layout->offsets[component];
+		attributes[i] = desc;
 	}
-	*attributesCount = componentsCount;
-	return bindings;
+	*attributesCount = layout->componentsCount;
+	return attributes;
 }
 
 static VkPipelineVertexInputStateCreateInfo ievk_pipeline_populate_visci(evkPipeline* pipeline, evkVertexComponent* vertexComponents, uint32_t componentsCount)
 {
-	pipeline->bindingsDescription = ievk_pipeline_get_binding_descriptions(pipeline->passingVertexData, &pipeline->bindingsDescriptionCount);
-	pipeline->attributesDescription = ievk_pipeline_get_attribute_descriptions(vertexComponents, componentsCount, &pipeline->attributesDescriptionCount);
+	pipeline->vertexLayout = evk_vertex_layout_create(vertexComponents, componentsCount);
+	pipeline->bindingsDescription = ievk_pipeline_get_binding_descriptions(pipeline->passingVertexData, &pipeline->vertexLayout, &pipeline->bindingsDescriptionCount);
+	pipeline->attributesDescription = ievk_pipeline_get_attribute_descriptions(pipeline->passingVertexData, &pipeline->vertexLayout, &pipeline->attributesDescriptionCount);
 
 	VkPipelineVertexInputStateCreateInfo visci = { 0 };
 	visci.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
@@ -114,6 +98,7 @@ static evkResult ievk_pipeline_create(VkDevice device, evkPipelineCreateInfo* ci
 
 	outPipe->passingVertexData = ci->passingVertexData;
 	outPipe->cache = ci->pipelineCache;
+	outPipe->handle.value = 0;
 	outPipe->shaderStages[0] = ci->vertexShader.info;
 	outPipe->shaderStages[1] = ci->fragmentShader.info;
 
@@ -124,7 +109,7 @@ static evkResult ievk_pipeline_create(VkDevice device, evkPipelineCreateInfo* ci
 	descSetLayoutCI.flags = 0;
 	descSetLayoutCI.bindingCount = ci->bindingsCount;
 	descSetLayoutCI.pBindings = ci->bindings;
-	EVK_ASSERT(vkCreateDescriptorSetLayout(device, &descSetLayoutCI, NULL, &outPipe->descriptorSetLayout) == VK_SUCCESS, "Failed to create descriptor set layout");
+	EVK_ASSERT(vkCreateDescriptorSetLayout(device, &descSetLayoutCI, evk_get_vulkan_allocator(), &outPipe->descriptorSetLayout) == VK_SUCCESS, "Failed to create descriptor set layout");
 
 	// pipeline layout
 	VkPipelineLayoutCreateInfo pipelineLayoutCI = { 0 };
@@ -135,7 +120,7 @@ static evkResult ievk_pipeline_create(VkDevice device, evkPipelineCreateInfo* ci
 	pipelineLayoutCI.pSetLayouts = &outPipe->descriptorSetLayout;
 	pipelineLayoutCI.pushConstantRangeCount = ci->pushConstantsCount;
 	pipelineLayoutCI.pPushConstantRanges = ci->pushConstants;
-	EVK_ASSERT(vkCreatePipelineLayout(device, &pipelineLayoutCI, NULL, &outPipe->layout) == VK_SUCCESS, "Failed to create pipeline layout");
+	EVK_ASSERT(vkCreatePipelineLayout(device, &pipelineLayoutCI, evk_get_vulkan_allocator(), &outPipe->layout) == VK_SUCCESS, "Failed to create pipeline layout");
 
 	// vertex input state
 	outPipe->vertexInputState = ievk_pipeline_populate_visci(outPipe, ci->vertexComponents, ci->vertexComponentsCount);
@@ -214,19 +199,20 @@ static void ievk_pipeline_destroy(VkDevice device, evkPipeline* pipeline)
 {
 	if (!pipeline || device == VK_NULL_HANDLE) return;
 
+	evk_handle_table_remove(evk_get_pipeline_handles(), pipeline->handle.value);
 	vkDeviceWaitIdle(device);
-	vkDestroyPipeline(device, pipeline->pipeline, NULL);
-	vkDestroyPipelineLayout(device, pipeline->layout, NULL);
-	vkDestroyDescriptorSetLayout(device, pipeline->descriptorSetLayout, NULL);
+	vkDestroyPipeline(device, pipeline->pipeline, evk_get_vulkan_allocator());
+	vkDestroyPipelineLayout(device, pipeline->layout, evk_get_vulkan_allocator());
+	vkDestroyDescriptorSetLayout(device, pipeline->descriptorSetLayout, evk_get_vulkan_allocator());
 
-	if (pipeline->bindingsDescription != NULL) m_free(pipeline->bindingsDescription);
-	if (pipeline->attributesDescription != NULL) m_free(pipeline->attributesDescription);
+	if (pipeline->bindingsDescription != NULL) EVK_FREE(pipeline->bindingsDescription);
+	if (pipeline->attributesDescription != NULL) EVK_FREE(pipeline->attributesDescription);
 
 	// not ideal since shader module was first introduced on shader struct, but it's the same module after-all
-	vkDestroyShaderModule(device, pipeline->shaderStages[0].module, NULL);
-	vkDestroyShaderModule(device, pipeline->shaderStages[1].module, NULL);
+	vkDestroyShaderModule(device, pipeline->shaderStages[0].module, evk_get_vulkan_allocator());
+	vkDestroyShaderModule(device, pipeline->shaderStages[1].module, evk_get_vulkan_allocator());
 
-	m_free(pipeline);
+	EVK_FREE(pipeline);
 }
 
 /// @brief builds a pipeline, must be previously configured as desired
@@ -259,7 +245,7 @@ static evkResult ievk_pipeline_build(VkDevice device, evkPipeline* pipeline)
 	ci.renderPass = pipeline->renderpass->renderpass;
 	ci.subpass = 0;
 
-	VkResult res = vkCreateGraphicsPipelines(device, pipeline->cache, 1, &ci, NULL, &pipeline->pipeline);
+	VkResult res = vkCreateGraphicsPipelines(device, pipeline->cache, 1, &ci, evk_get_vulkan_allocator(), &pipeline->pipeline);
 	if (res != VK_SUCCESS) {
 		EVK_LOG(evk_Error, "Failed to build the graphics pipeline {%d}", res);
 		return evk_Failure;
@@ -296,15 +282,184 @@ static evkShader ievk_pipeline_create_shader(VkDevice device, const char* name,
 	moduleCI.flags = 0;
 	moduleCI.codeSize = spirvSize * sizeof(uint32_t);
 	moduleCI.pCode = spirv;
-	EVK_ASSERT(vkCreateShaderModule(device, &moduleCI, NULL, &shader.info.module) == VK_SUCCESS, "Failed to create shader module");
+	EVK_ASSERT(vkCreateShaderModule(device, &moduleCI, evk_get_vulkan_allocator(), &shader.info.module) == VK_SUCCESS, "Failed to create shader module");
 
 	return shader;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Command Recorder
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void evk_command_begin(evkCommandRecorder* recorder, VkCommandBuffer cmdBuffer)
+{
+	memset(recorder, 0, sizeof(evkCommandRecorder));
+	recorder->cmdBuffer = cmdBuffer;
+}
+
+void evk_command_invalidate(evkCommandRecorder* recorder)
+{
+	VkCommandBuffer cmdBuffer = recorder->cmdBuffer;
+	evkCommandStats stats = recorder->stats;
+
+	evk_command_begin(recorder, cmdBuffer);
+	recorder->stats = stats;
+}
+
+void evk_command_bind_pipeline(evkCommandRecorder* recorder, VkPipeline pipeline)
+{
+	if (recorder->pipeline == pipeline) {
+		recorder->stats.pipelineSkips++;
+		return;
+	}
+
+	vkCmdBindPipeline(recorder->cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+	recorder->pipeline = pipeline;
+	recorder->stats.pipelineBinds++;
+}
+
+void evk_command_bind_descriptor_set(evkCommandRecorder* recorder, VkPipelineLayout layout, uint32_t index, VkDescriptorSet set)
+{
+	// sets bound with another layout may have been disturbed, only trust the cache while the layout is the same
+	if (recorder->setsLayout != layout) {
+		memset(recorder->sets, 0, sizeof(recorder->sets));
+		recorder->setsLayout = layout;
+	}
+
+	if (index < EVK_COMMAND_RECORDER_MAX_SETS && recorder->sets[index] == set) {
+		recorder->stats.descriptorSkips++;
+		return;
+	}
+
+	vkCmdBindDescriptorSets(recorder->cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, index, 1, &set, 0, NULL);
+	if (index < EVK_COMMAND_RECORDER_MAX_SETS) recorder->sets[index] = set;
+	recorder->stats.descriptorBinds++;
+}
+
+void evk_command_push_constants(evkCommandRecorder* recorder, VkPipelineLayout layout, VkShaderStageFlags stages, uint32_t offset, uint32_t size, const void* data)
+{
+	bool sameRange = recorder->pushLayout == layout && recorder->pushStages == stages && recorder->pushOffset == offset && recorder->pushSize == size;
+	if (sameRange && memcmp(recorder->pushData, data, size) == 0) {
+		recorder->stats.pushConstantSkips++;
+		return;
+	}
+
+	vkCmdPushConstants(recorder->cmdBuffer, layout, stages, offset, size, data);
+	recorder->stats.pushConstants++;
+
+	if (size <= EVK_COMMAND_RECORDER_PUSH_CONSTANTS_SIZE) {
+		memcpy(recorder->pushData, data, size);
+		recorder->pushLayout = layout;
+		recorder->pushStages = stages;
+		recorder->pushOffset = offset;
+		recorder->pushSize = size;
+	}
+	else {
+		recorder->pushLayout = VK_NULL_HANDLE;
+	}
+}
+
+void evk_command_set_viewport(evkCommandRecorder* recorder, const VkViewport* viewport)
+{
+	if (recorder->viewportSet && memcmp(&recorder->viewport, viewport, sizeof(VkViewport)) == 0) {
+		recorder->stats.viewportSkips++;
+		return;
+	}
+
+	vkCmdSetViewport(recorder->cmdBuffer, 0, 1, viewport);
+	recorder->viewport = *viewport;
+	recorder->viewportSet = true;
+	recorder->stats.viewports++;
+}
+
+void evk_command_set_scissor(evkCommandRecorder* recorder, const VkRect2D* scissor)
+{
+	if (recorder->scissorSet && memcmp(&recorder->scissor, scissor, sizeof(VkRect2D)) == 0) {
+		recorder->stats.scissorSkips++;
+		return;
+	}
+
+	vkCmdSetScissor(recorder->cmdBuffer, 0, 1, scissor);
+	recorder->scissor = *scissor;
+	recorder->scissorSet = true;
+	recorder->stats.scissors++;
+}
+
+void evk_command_bind_vertex_buffer(evkCommandRecorder* recorder, VkBuffer buffer)
+{
+	if (recorder->vertexBuffer == buffer) {
+		recorder->stats.bufferSkips++;
+		return;
+	}
+
+	VkDeviceSize offset = 0;
+	vkCmdBindVertexBuffers(recorder->cmdBuffer, 0, 1, &buffer, &offset);
+	recorder->vertexBuffer = buffer;
+	recorder->stats.bufferBinds++;
+}
+
+void evk_command_bind_index_buffer(evkCommandRecorder* recorder, VkBuffer buffer, VkIndexType indexType)
+{
+	if (recorder->indexBuffer == buffer && recorder->indexType == indexType) {
+		recorder->stats.bufferSkips++;
+		return;
+	}
+
+	vkCmdBindIndexBuffer(recorder->cmdBuffer, buffer, 0, indexType);
+	recorder->indexBuffer = buffer;
+	recorder->indexType = indexType;
+	recorder->stats.bufferBinds++;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Pipelines
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+uint32_t evk_vertex_component_size(evkVertexComponent component)
+{
+	switch (component)
+	{
+		case evk_Vertex_Component_Position: return (uint32_t)sizeof(float3);
+		case evk_Vertex_Component_Normal: return (uint32_t)sizeof(int16_t) * 2;
+		case evk_Vertex_Component_UV_0: return (uint32_t)sizeof(uint16_t) * 2;
+		case evk_Vertex_Component_Color_0: return (uint32_t)sizeof(uint8_t) * 4;
+		case evk_Vertex_Component_Joints_0: return (uint32_t)sizeof(uint8_t) * 4;
+		case evk_Vertex_Component_Weights_0: return (uint32_t)sizeof(uint16_t) * 4;
+		default: break;
+	}
+	return 0;
+}
+
+evkVertexLayout evk_vertex_layout_create(const evkVertexComponent* components, uint32_t componentsCount)
+{
+	evkVertexLayout layout = { 0 };
+	if (components == NULL) return layout;
+
+	bool used[evk_Vertex_Component_Max] = { 0 };
+	for (uint32_t i = 0; i < componentsCount; i++) {
+		evkVertexComponent component = components[i];
+		if (component >= evk_Vertex_Component_Max) {
+			EVK_LOG(evk_Warn, "Ignoring invalid vertex component %d", (int32_t)component);
+			continue;
+		}
+
+		// a repeated component would overwrite its offset and grow the stride with bytes nothing reads
+		if (used[component]) {
+			EVK_LOG(evk_Warn, "Ignoring duplicated vertex component %d", (int32_t)component);
+			continue;
+		}
+		used[component] = true;
+
+		layout.offsets[component] = layout.stride;
+		layout.components[layout.componentsCount++] = component;
+		layout.stride += evk_vertex_component_size(component);
+	}
+
+	// keeps the next vertex 4-byte aligned, all formats used are at least 4 bytes wide so this is a no-op for now
+	layout.stride = (layout.stride + 3U) & ~3U;
+	return layout;
+}
+
 evkResult evk_pipeline_sprite_create(shashtable* pipelines, evkRenderpass* renderpass, evkRenderpass* pickingRenderpass, VkDevice device)
 {
 	// default pipeline
@@ -343,16 +498,16 @@ evkResult evk_pipeline_sprite_create(shashtable* pipelines, evkRenderpass* rende
 	ci.bindings[2].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 	ci.bindings[2].descriptorCount = 1;
 	ci.bindings[2].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-	ci.bindings[2].pImmutableSamplers = NULL;
+	ci.bindings[2].pImmutableSamplers = NULL; // the descriptor brings the sampler, atlases clamp while textures repeat
 
-	defaultPipeline = (evkPipeline*)m_malloc(sizeof(evkPipeline));
+	defaultPipeline = (evkPipeline*)EVK_MALLOC(evk_Allocation_Tag_Renderphase, sizeof(evkPipeline));
 	EVK_ASSERT(defaultPipeline != NULL, "Failed to allocate memory for sprite default pipeline creation");
 
 	EVK_ASSERT(ievk_pipeline_create(device, &ci, defaultPipeline) == evk_Success, "Failed to create sprite default pipeline");
 	defaultPipeline->renderpass = renderpass;
 	defaultPipeline->rasterizationState.cullMode = VK_CULL_MODE_BACK_BIT;
 	EVK_ASSERT(ievk_pipeline_build(device, defaultPipeline) == evk_Success, "Failed to build sprite default pipeline");
-	EVK_ASSERT(shashtable_insert(pipelines, EVK_PIPELINE_SPRITE_DEFAULT_NAME, defaultPipeline) == CTOOLBOX_SUCCESS, "Failed to insert sprite default pipeline into pipeline's library");
+	EVK_ASSERT(evk_pipeline_library_insert(pipelines, EVK_PIPELINE_SPRITE_DEFAULT_NAME, defaultPipeline).value != 0, "Failed to insert sprite default pipeline into pipeline's library");
 	
 	// picking pipeline
 	evkPipeline* pickingPipeline = (evkPipeline*)shashtable_lookup(pipelines, EVK_PIPELINE_SPRITE_PICKING_NAME);
@@ -390,9 +545,9 @@ evkResult evk_pipeline_sprite_create(shashtable* pipelines, evkRenderpass* rende
 	ci.bindings[2].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 	ci.bindings[2].descriptorCount = 1;
 	ci.bindings[2].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-	ci.bindings[2].pImmutableSamplers = NULL;
+	ci.bindings[2].pImmutableSamplers = NULL; // the descriptor brings the sampler, atlases clamp while textures repeat
 	
-	pickingPipeline = (evkPipeline*)m_malloc(sizeof(evkPipeline));
+	pickingPipeline = (evkPipeline*)EVK_MALLOC(evk_Allocation_Tag_Renderphase, sizeof(evkPipeline));
 	EVK_ASSERT(pickingPipeline != NULL, "Failed to allocate memory for sprite picking pipeline creation");
 
 	EVK_ASSERT(ievk_pipeline_create(device, &ci, pickingPipeline) == evk_Success, "Failed to create sprite picking pipeline");
@@ -400,7 +555,7 @@ evkResult evk_pipeline_sprite_create(shashtable* pipelines, evkRenderpass* rende
 	pickingPipeline->rasterizationState.cullMode = VK_CULL_MODE_BACK_BIT;
 	pickingPipeline->colorBlendAttachmentState.colorWriteMask = VK_COLOR_COMPONENT_R_BIT; // id's are RED channel only
 	EVK_ASSERT(ievk_pipeline_build(device, pickingPipeline) == evk_Success, "Failed to build sprite picking pipeline");
-	EVK_ASSERT(shashtable_insert(pipelines, EVK_PIPELINE_SPRITE_PICKING_NAME, pickingPipeline) == CTOOLBOX_SUCCESS, "Failed to insert sprite picking pipeline into pipeline's library");
+	EVK_ASSERT(evk_pipeline_library_insert(pipelines, EVK_PIPELINE_SPRITE_PICKING_NAME, pickingPipeline).value != 0, "Failed to insert sprite picking pipeline into pipeline's library");
 
 	EVK_ASSERT(evk_Todo, "Create wireframe pipeline");
 	return evk_Success;
@@ -417,6 +572,127 @@ void evk_pipeline_sprite_destroy(shashtable* pipelines, VkDevice device)
 	pipe = NULL;
 }
 
+evkMeshShaders evk_pipeline_mesh_default_shaders()
+{
+	evkMeshShaders shaders = { 0 };
+	shaders.defaultVertex = mesh_default_vert_spv;
+	shaders.defaultVertexSize = mesh_default_vert_spv_size;
+	shaders.defaultFragment = mesh_default_frag_spv;
+	shaders.defaultFragmentSize = mesh_default_frag_spv_size;
+	shaders.pickingVertex = mesh_picking_vert_spv;
+	shaders.pickingVertexSize = mesh_picking_vert_spv_size;
+	shaders.pickingFragment = mesh_picking_frag_spv;
+	shaders.pickingFragmentSize = mesh_picking_frag_spv_size;
+
+	// the components mesh_default.vert reads, joints and weights are declared but unused until skinning lands
+	shaders.vertexComponents[shaders.vertexComponentsCount++] = evk_Vertex_Component_Position;
+	shaders.vertexComponents[shaders.vertexComponentsCount++] = evk_Vertex_Component_Normal;
+	shaders.vertexComponents[shaders.vertexComponentsCount++] = evk_Vertex_Component_UV_0;
+	shaders.vertexComponents[shaders.vertexComponentsCount++] = evk_Vertex_Component_Color_0;
+	return shaders;
+}
+
+evkResult evk_pipeline_mesh_create(shashtable* pipelines, evkRenderpass* renderpass, evkRenderpass* pickingRenderpass, VkDevice device, const evkMeshShaders* shaders)
+{
+	if (shaders == NULL || shaders->defaultVertex == NULL || shaders->defaultFragment == NULL || shaders->pickingVertex == NULL || shaders->pickingFragment == NULL) {
+		EVK_LOG(evk_Error, "Mesh pipelines require the default and picking shaders");
+		return evk_Failure;
+	}
+
+	// default pipeline
+	evkPipeline* defaultPipeline = (evkPipeline*)shashtable_lookup(pipelines, EVK_PIPELINE_MESH_DEFAULT_NAME);
+	if (defaultPipeline != NULL) ievk_pipeline_destroy(device, defaultPipeline);
+
+	evkPipelineCreateInfo ci = { 0 };
+	ci.renderpass = renderpass; // this will either be default or viewport renderpass
+	ci.vertexShader = ievk_pipeline_create_shader(device, "mesh.vert", shaders->defaultVertex, shaders->defaultVertexSize, evk_Shader_Type_Vertex);
+	ci.fragmentShader = ievk_pipeline_create_shader(device, "mesh.frag", shaders->defaultFragment, shaders->defaultFragmentSize, evk_Shader_Type_Fragment);
+	ci.passingVertexData = true;
+	ci.alphaBlending = false;
+	memcpy(ci.vertexComponents, shaders->vertexComponents, sizeof(ci.vertexComponents));
+	ci.vertexComponentsCount = shaders->vertexComponentsCount;
+
+	// push constant
+	ci.pushConstantsCount = 1;
+	ci.pushConstants[0].offset = 0;
+	ci.pushConstants[0].size = sizeof(evkPushConstant);
+	ci.pushConstants[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+	// bindings
+	ci.bindingsCount = 1;
+	// camera data
+	ci.bindings[0].binding = 0;
+	ci.bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	ci.bindings[0].descriptorCount = 1;
+	ci.bindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+	ci.bindings[0].pImmutableSamplers = NULL;
+
+	defaultPipeline = (evkPipeline*)EVK_MALLOC(evk_Allocation_Tag_Renderphase, sizeof(evkPipeline));
+	EVK_ASSERT(defaultPipeline != NULL, "Failed to allocate memory for mesh default pipeline creation");
+
+	EVK_ASSERT(ievk_pipeline_create(device, &ci, defaultPipeline) == evk_Success, "Failed to create mesh default pipeline");
+	defaultPipeline->renderpass = renderpass;
+	defaultPipeline->rasterizationState.cullMode = VK_CULL_MODE_BACK_BIT;
+	EVK_ASSERT(ievk_pipeline_build(device, defaultPipeline) == evk_Success, "Failed to build mesh default pipeline");
+	EVK_ASSERT(evk_pipeline_library_insert(pipelines, EVK_PIPELINE_MESH_DEFAULT_NAME, defaultPipeline).value != 0, "Failed to insert mesh default pipeline into pipeline's library");
+
+	// picking pipeline, keeps the same vertex layout even if it only reads the position so both share the mesh buffers
+	evkPipeline* pickingPipeline = (evkPipeline*)shashtable_lookup(pipelines, EVK_PIPELINE_MESH_PICKING_NAME);
+	if (pickingPipeline != NULL) ievk_pipeline_destroy(device, pickingPipeline);
+
+	ci.renderpass = pickingRenderpass;
+	ci.vertexShader = ievk_pipeline_create_shader(device, "mesh.vert", shaders->pickingVertex, shaders->pickingVertexSize, evk_Shader_Type_Vertex);
+	ci.fragmentShader = ievk_pipeline_create_shader(device, "mesh.frag", shaders->pickingFragment, shaders->pickingFragmentSize, evk_Shader_Type_Fragment);
+
+	pickingPipeline = (evkPipeline*)EVK_MALLOC(evk_Allocation_Tag_Renderphase, sizeof(evkPipeline));
+	EVK_ASSERT(pickingPipeline != NULL, "Failed to allocate memory for mesh picking pipeline creation");
+
+	EVK_ASSERT(ievk_pipeline_create(device, &ci, pickingPipeline) == evk_Success, "Failed to create mesh picking pipeline");
+	pickingPipeline->renderpass = pickingRenderpass;
+	pickingPipeline->rasterizationState.cullMode = VK_CULL_MODE_BACK_BIT;
+	pickingPipeline->colorBlendAttachmentState.colorWriteMask = VK_COLOR_COMPONENT_R_BIT; // id's are RED channel only
+	EVK_ASSERT(ievk_pipeline_build(device, pickingPipeline) == evk_Success, "Failed to build mesh picking pipeline");
+	EVK_ASSERT(evk_pipeline_library_insert(pipelines, EVK_PIPELINE_MESH_PICKING_NAME, pickingPipeline).value != 0, "Failed to insert mesh picking pipeline into pipeline's library");
+
+	return evk_Success;
+}
+
+void evk_pipeline_mesh_destroy(shashtable* pipelines, VkDevice device)
+{
+	evkPipeline* pipe = (evkPipeline*)shashtable_lookup(pipelines, EVK_PIPELINE_MESH_DEFAULT_NAME);
+	if (pipe != NULL) ievk_pipeline_destroy(device, pipe);
+	pipe = NULL;
+
+	pipe = (evkPipeline*)shashtable_lookup(pipelines, EVK_PIPELINE_MESH_PICKING_NAME);
+	if (pipe != NULL) ievk_pipeline_destroy(device, pipe);
+	pipe = NULL;
+}
+
+evkPipelineHandle evk_pipeline_library_insert(shashtable* pipelines, const char* name, evkPipeline* pipeline)
+{
+	evkPipelineHandle handle = { 0 };
+	if (pipelines == NULL || name == NULL || pipeline == NULL) return handle;
+
+	if (shashtable_insert(pipelines, name, pipeline) != CTOOLBOX_SUCCESS) {
+		EVK_LOG(evk_Error, "Failed to insert pipeline %s into the pipelines library", name);
+		return handle;
+	}
+
+	pipeline->handle.value = evk_handle_table_insert(evk_get_pipeline_handles(), pipeline);
+	return pipeline->handle;
+}
+
+evkPipelineHandle evk_pipeline_library_find(shashtable* pipelines, const char* name)
+{
+	evkPipeline* pipeline = (evkPipeline*)shashtable_lookup(pipelines, name);
+	return pipeline != NULL ? pipeline->handle : (evkPipelineHandle){ 0 };
+}
+
+evkPipeline* evk_pipeline_library_get(evkPipelineHandle handle)
+{
+	return (evkPipeline*)evk_handle_table_get(evk_get_pipeline_handles(), handle.value);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Main renderphase
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -496,7 +772,7 @@ evkMainRenderphase evk_renderphase_main_create(VkDevice device, VkPhysicalDevice
 	renderPassCI.pSubpasses = &subpass;
 	renderPassCI.dependencyCount = 2u;
 	renderPassCI.pDependencies = dependencies;
-	EVK_ASSERT(vkCreateRenderPass(device, &renderPassCI, NULL, &renderphase.evkRenderpass.renderpass) == VK_SUCCESS, "Failed to create main renderphase renderpass");
+	EVK_ASSERT(vkCreateRenderPass(device, &renderPassCI, evk_get_vulkan_allocator(), &renderphase.evkRenderpass.renderpass) == VK_SUCCESS, "Failed to create main renderphase renderpass");
 
 	// cmdpool and cmdbuffers
 	evkQueueFamily indices = evk_device_find_queue_families(physicalDevice, surface);
@@ -505,7 +781,7 @@ evkMainRenderphase evk_renderphase_main_create(VkDevice device, VkPhysicalDevice
 	cmdPoolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
 	cmdPoolInfo.queueFamilyIndex = indices.graphics;
 	cmdPoolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-	EVK_ASSERT(vkCreateCommandPool(device, &cmdPoolInfo, NULL, &renderphase.evkRenderpass.cmdPool) == VK_SUCCESS, "Failed to create main renderphase renderpass command pool");
+	EVK_ASSERT(vkCreateCommandPool(device, &cmdPoolInfo, evk_get_vulkan_allocator(), &renderphase.evkRenderpass.cmdPool) == VK_SUCCESS, "Failed to create main renderphase renderpass command pool");
 
 	VkCommandBufferAllocateInfo cmdBufferAllocInfo = { 0 };
 	cmdBufferAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -523,7 +799,7 @@ void evk_renderphase_main_destroy(evkMainRenderphase* renderphase, VkDevice devi
 
 	// renderpass
 	if (renderphase->evkRenderpass.renderpass != VK_NULL_HANDLE) {
-		vkDestroyRenderPass(device, renderphase->evkRenderpass.renderpass, NULL);
+		vkDestroyRenderPass(device, renderphase->evkRenderpass.renderpass, evk_get_vulkan_allocator());
 	}
 
 	if (renderphase->evkRenderpass.cmdBuffers) {
@@ -531,24 +807,24 @@ void evk_renderphase_main_destroy(evkMainRenderphase* renderphase, VkDevice devi
 	}
 
 	if (renderphase->evkRenderpass.cmdPool != VK_NULL_HANDLE) {
-		vkDestroyCommandPool(device, renderphase->evkRenderpass.cmdPool, NULL);
+		vkDestroyCommandPool(device, renderphase->evkRenderpass.cmdPool, evk_get_vulkan_allocator());
 	}
 
 	for (unsigned int i = 0; i < renderphase->evkRenderpass.framebufferCount; i++) {
-		vkDestroyFramebuffer(device, renderphase->evkRenderpass.framebuffers[i], NULL);
+		vkDestroyFramebuffer(device, renderphase->evkRenderpass.framebuffers[i], evk_get_vulkan_allocator());
 	}
 
-	m_free(renderphase->evkRenderpass.framebuffers);
+	EVK_FREE(renderphase->evkRenderpass.framebuffers);
 	memset(&renderphase->evkRenderpass, 0, sizeof(evkRenderpass));
 
 	// general
-	vkDestroyImage(device, renderphase->colorImage, NULL);
-	vkFreeMemory(device, renderphase->colorMem, NULL);
-	vkDestroyImageView(device, renderphase->colorView, NULL);
+	vkDestroyImage(device, renderphase->colorImage, evk_get_vulkan_allocator());
+	vkFreeMemory(device, renderphase->colorMem, evk_get_vulkan_allocator());
+	vkDestroyImageView(device, renderphase->colorView, evk_get_vulkan_allocator());
 	
-	vkDestroyImage(device, renderphase->depthImage, NULL);
-	vkFreeMemory(device, renderphase->depthMem, NULL);
-	vkDestroyImageView(device, renderphase->depthView, NULL);
+	vkDestroyImage(device, renderphase->depthImage, evk_get_vulkan_allocator());
+	vkFreeMemory(device, renderphase->depthMem, evk_get_vulkan_allocator());
+	vkDestroyImageView(device, renderphase->depthView, evk_get_vulkan_allocator());
 
 	memset(renderphase, 0, sizeof(evkMainRenderphase));
 }
@@ -556,18 +832,18 @@ void evk_renderphase_main_destroy(evkMainRenderphase* renderphase, VkDevice devi
 evkResult evk_renderphase_main_create_framebuffers(evkMainRenderphase* renderphase, VkDevice device, VkPhysicalDevice physicalDevice, VkImageView* views, uint32_t viewsCount, VkExtent2D extent, VkFormat colorFormat)
 {
 	// uppon a resize event, the framebuffers and it's images must be recreated, therefore we must check if they were created already
-	if (renderphase->depthView != VK_NULL_HANDLE) vkDestroyImageView(device, renderphase->depthView, NULL);
-	if (renderphase->depthImage != VK_NULL_HANDLE) vkDestroyImage(device, renderphase->depthImage, NULL);
-	if (renderphase->depthMem != VK_NULL_HANDLE) vkFreeMemory(device, renderphase->depthMem, NULL);
-	if (renderphase->colorView != VK_NULL_HANDLE) vkDestroyImageView(device, renderphase->colorView, NULL);
-	if (renderphase->colorImage != VK_NULL_HANDLE) vkDestroyImage(device, renderphase->colorImage, NULL);
-	if (renderphase->colorMem != VK_NULL_HANDLE) vkFreeMemory(device, renderphase->colorMem, NULL);
+	if (renderphase->depthView != VK_NULL_HANDLE) vkDestroyImageView(device, renderphase->depthView, evk_get_vulkan_allocator());
+	if (renderphase->depthImage != VK_NULL_HANDLE) vkDestroyImage(device, renderphase->depthImage, evk_get_vulkan_allocator());
+	if (renderphase->depthMem != VK_NULL_HANDLE) vkFreeMemory(device, renderphase->depthMem, evk_get_vulkan_allocator());
+	if (renderphase->colorView != VK_NULL_HANDLE) vkDestroyImageView(device, renderphase->colorView, evk_get_vulkan_allocator());
+	if (renderphase->colorImage != VK_NULL_HANDLE) vkDestroyImage(device, renderphase->colorImage, evk_get_vulkan_allocator());
+	if (renderphase->colorMem != VK_NULL_HANDLE) vkFreeMemory(device, renderphase->colorMem, evk_get_vulkan_allocator());
 
 	if (renderphase->evkRenderpass.framebuffers != NULL) {
 		for (uint32_t i = 0; i < renderphase->evkRenderpass.framebufferCount; i++) {
-			vkDestroyFramebuffer(device, renderphase->evkRenderpass.framebuffers[i], NULL);
+			vkDestroyFramebuffer(device, renderphase->evkRenderpass.framebuffers[i], evk_get_vulkan_allocator());
 		}
-		m_free(renderphase->evkRenderpass.framebuffers);
+		EVK_FREE(renderphase->evkRenderpass.framebuffers);
 	}
 
 	VkFormat depthFormat = evk_device_find_depth_format(physicalDevice);
@@ -653,7 +929,7 @@ evkResult evk_renderphase_main_create_framebuffers(evkMainRenderphase* renderpha
 	}
 
 	renderphase->evkRenderpass.framebufferCount = viewsCount;
-	renderphase->evkRenderpass.framebuffers = (VkFramebuffer*)m_malloc(sizeof(VkFramebuffer) * viewsCount);
+	renderphase->evkRenderpass.framebuffers = (VkFramebuffer*)EVK_MALLOC(evk_Allocation_Tag_Renderphase, sizeof(VkFramebuffer) * viewsCount);
 
 	if (!renderphase->evkRenderpass.framebuffers) {
 		EVK_LOG(evk_Error, "Failed to allocate memory for main renderphase framebuffers");
@@ -671,7 +947,7 @@ evkResult evk_renderphase_main_create_framebuffers(evkMainRenderphase* renderpha
 		fbci.height = extent.height;
 		fbci.layers = 1;
 
-		if (vkCreateFramebuffer(device, &fbci, NULL, &renderphase->evkRenderpass.framebuffers[i]) != VK_SUCCESS) {
+		if (vkCreateFramebuffer(device, &fbci, evk_get_vulkan_allocator(), &renderphase->evkRenderpass.framebuffers[i]) != VK_SUCCESS) {
 			EVK_LOG(evk_Error, "Failed to create default renderphase framebuffer");
 			return evk_Failure;
 		}
@@ -698,6 +974,7 @@ void evk_renderphase_main_update(evkMainRenderphase* renderphase, VkDevice devic
 	cmdBeginInfo.pNext = NULL;
 	cmdBeginInfo.flags = 0;
 	EVK_ASSERT(vkBeginCommandBuffer(cmdBuffer, &cmdBeginInfo) == VK_SUCCESS, "Failed to begin default renderphase command buffer");
+	evk_command_begin(&renderphase->evkRenderpass.recorders[currentFrame], cmdBuffer);
 	
 	VkRenderPassBeginInfo renderPassBeginInfo = { 0 };
 	renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -717,13 +994,13 @@ void evk_renderphase_main_update(evkMainRenderphase* renderphase, VkDevice devic
 	viewport.height = (float)extent.height;
 	viewport.minDepth = 0.0f;
 	viewport.maxDepth = 1.0f;
-	vkCmdSetViewport(cmdBuffer, 0, 1, &viewport);
+	evk_command_set_viewport(&renderphase->evkRenderpass.recorders[currentFrame], &viewport);
 	
 	// set frame commandbuffer scissor
 	VkRect2D scissor = { 0 };
 	scissor.offset = (VkOffset2D){ 0, 0 };
 	scissor.extent = extent;
-	vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
+	evk_command_set_scissor(&renderphase->evkRenderpass.recorders[currentFrame], &scissor);
 	
 	// not using viewport as the final target, therefore draw the objects
 	if (!usingViewport) {
@@ -817,14 +1094,14 @@ evkPickingRenderphase evk_renderphase_picking_create(VkDevice device, VkPhysical
 	renderPassCI.pSubpasses = &subpassDescription;
 	renderPassCI.dependencyCount = 2U;
 	renderPassCI.pDependencies = dependencies;
-	EVK_ASSERT(vkCreateRenderPass(device, &renderPassCI, NULL, &renderphase.evkRenderpass.renderpass) == VK_SUCCESS, "Failed to create picking renderphase renderpass");
+	EVK_ASSERT(vkCreateRenderPass(device, &renderPassCI, evk_get_vulkan_allocator(), &renderphase.evkRenderpass.renderpass) == VK_SUCCESS, "Failed to create picking renderphase renderpass");
 
 	evkQueueFamily indices = evk_device_find_queue_families(physicalDevice, surface);
 	VkCommandPoolCreateInfo cmdPoolInfo = { 0 };
 	cmdPoolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
 	cmdPoolInfo.queueFamilyIndex = indices.graphics;
 	cmdPoolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-	EVK_ASSERT(vkCreateCommandPool(device, &cmdPoolInfo, NULL, &renderphase.evkRenderpass.cmdPool) == VK_SUCCESS, "Failed to create picking renderphase command pool");
+	EVK_ASSERT(vkCreateCommandPool(device, &cmdPoolInfo, evk_get_vulkan_allocator(), &renderphase.evkRenderpass.cmdPool) == VK_SUCCESS, "Failed to create picking renderphase command pool");
 
 	VkCommandBufferAllocateInfo cmdBufferAllocInfo = { 0 };
 	cmdBufferAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -842,7 +1119,7 @@ void evk_renderphase_picking_destroy(evkPickingRenderphase* renderphase, VkDevic
 
 	// renderpass
 	if (renderphase->evkRenderpass.renderpass != VK_NULL_HANDLE) {
-		vkDestroyRenderPass(device, renderphase->evkRenderpass.renderpass, NULL);
+		vkDestroyRenderPass(device, renderphase->evkRenderpass.renderpass, evk_get_vulkan_allocator());
 	}
 
 	if (renderphase->evkRenderpass.cmdBuffers) {
@@ -850,24 +1127,24 @@ void evk_renderphase_picking_destroy(evkPickingRenderphase* renderphase, VkDevic
 	}
 
 	if (renderphase->evkRenderpass.cmdPool != VK_NULL_HANDLE) {
-		vkDestroyCommandPool(device, renderphase->evkRenderpass.cmdPool, NULL);
+		vkDestroyCommandPool(device, renderphase->evkRenderpass.cmdPool, evk_get_vulkan_allocator());
 	}
 
 	for (unsigned int i = 0; i < renderphase->evkRenderpass.framebufferCount; i++) {
-		vkDestroyFramebuffer(device, renderphase->evkRenderpass.framebuffers[i], NULL);
+		vkDestroyFramebuffer(device, renderphase->evkRenderpass.framebuffers[i], evk_get_vulkan_allocator());
 	}
 
-	m_free(renderphase->evkRenderpass.framebuffers);
+	EVK_FREE(renderphase->evkRenderpass.framebuffers);
 	memset(&renderphase->evkRenderpass, 0, sizeof(evkRenderpass));
 
 	// general
-	vkDestroyImage(device, renderphase->colorImage, NULL);
-	vkFreeMemory(device, renderphase->colorMem, NULL);
-	vkDestroyImageView(device, renderphase->colorView, NULL);
+	vkDestroyImage(device, renderphase->colorImage, evk_get_vulkan_allocator());
+	vkFreeMemory(device, renderphase->colorMem, evk_get_vulkan_allocator());
+	vkDestroyImageView(device, renderphase->colorView, evk_get_vulkan_allocator());
 
-	vkDestroyImage(device, renderphase->depthImage, NULL);
-	vkFreeMemory(device, renderphase->depthMem, NULL);
-	vkDestroyImageView(device, renderphase->depthView, NULL);
+	vkDestroyImage(device, renderphase->depthImage, evk_get_vulkan_allocator());
+	vkFreeMemory(device, renderphase->depthMem, evk_get_vulkan_allocator());
+	vkDestroyImageView(device, renderphase->depthView, evk_get_vulkan_allocator());
 
 	memset(renderphase, 0, sizeof(evkPickingRenderphase));
 }
@@ -875,18 +1152,18 @@ void evk_renderphase_picking_destroy(evkPickingRenderphase* renderphase, VkDevic
 evkResult evk_renderphase_picking_create_framebuffers(evkPickingRenderphase* renderphase, VkDevice device, VkPhysicalDevice physicalDevice, VkImageView* views, uint32_t viewsCount, VkExtent2D extent)
 {
 	// uppon a resize event, the framebuffers and it's images must be recreated, therefore we must check if they were created already
-	if (renderphase->depthView != VK_NULL_HANDLE) vkDestroyImageView(device, renderphase->depthView, NULL);
-	if (renderphase->depthImage != VK_NULL_HANDLE) vkDestroyImage(device, renderphase->depthImage, NULL);
-	if (renderphase->depthMem != VK_NULL_HANDLE) vkFreeMemory(device, renderphase->depthMem, NULL);
-	if (renderphase->colorView != VK_NULL_HANDLE) vkDestroyImageView(device, renderphase->colorView, NULL);
-	if (renderphase->colorImage != VK_NULL_HANDLE) vkDestroyImage(device, renderphase->colorImage, NULL);
-	if (renderphase->colorMem != VK_NULL_HANDLE) vkFreeMemory(device, renderphase->colorMem, NULL);
+	if (renderphase->depthView != VK_NULL_HANDLE) vkDestroyImageView(device, renderphase->depthView, evk_get_vulkan_allocator());
+	if (renderphase->depthImage != VK_NULL_HANDLE) vkDestroyImage(device, renderphase->depthImage, evk_get_vulkan_allocator());
+	if (renderphase->depthMem != VK_NULL_HANDLE) vkFreeMemory(device, renderphase->depthMem, evk_get_vulkan_allocator());
+	if (renderphase->colorView != VK_NULL_HANDLE) vkDestroyImageView(device, renderphase->colorView, evk_get_vulkan_allocator());
+	if (renderphase->colorImage != VK_NULL_HANDLE) vkDestroyImage(device, renderphase->colorImage, evk_get_vulkan_allocator());
+	if (renderphase->colorMem != VK_NULL_HANDLE) vkFreeMemory(device, renderphase->colorMem, evk_get_vulkan_allocator());
 
 	if (renderphase->evkRenderpass.framebuffers != NULL) {
 		for (uint32_t i = 0; i < renderphase->evkRenderpass.framebufferCount; i++) {
-			vkDestroyFramebuffer(device, renderphase->evkRenderpass.framebuffers[i], NULL);
+			vkDestroyFramebuffer(device, renderphase->evkRenderpass.framebuffers[i], evk_get_vulkan_allocator());
 		}
-		m_free(renderphase->evkRenderpass.framebuffers);
+		EVK_FREE(renderphase->evkRenderpass.framebuffers);
 	}
 
 	VkFormat depthFormat = evk_device_find_depth_format(physicalDevice);
@@ -972,7 +1249,7 @@ evkResult evk_renderphase_picking_create_framebuffers(evkPickingRenderphase* ren
 	}
 
 	renderphase->evkRenderpass.framebufferCount = viewsCount;
-	renderphase->evkRenderpass.framebuffers = (VkFramebuffer*)m_malloc(sizeof(VkFramebuffer) * viewsCount);
+	renderphase->evkRenderpass.framebuffers = (VkFramebuffer*)EVK_MALLOC(evk_Allocation_Tag_Renderphase, sizeof(VkFramebuffer) * viewsCount);
 
 	if (!renderphase->evkRenderpass.framebuffers) {
 		EVK_LOG(evk_Error, "Failed to allocate memory for main renderphase framebuffers");
@@ -990,7 +1267,7 @@ evkResult evk_renderphase_picking_create_framebuffers(evkPickingRenderphase* ren
 		fbci.height = extent.height;
 		fbci.layers = 1;
 
-		if (vkCreateFramebuffer(device, &fbci, NULL, &renderphase->evkRenderpass.framebuffers[i]) != VK_SUCCESS) {
+		if (vkCreateFramebuffer(device, &fbci, evk_get_vulkan_allocator(), &renderphase->evkRenderpass.framebuffers[i]) != VK_SUCCESS) {
 			EVK_LOG(evk_Error, "Failed to create default renderphase framebuffer");
 			return evk_Failure;
 		}
@@ -1017,6 +1294,7 @@ void evk_renderphase_picking_update(evkPickingRenderphase* renderphase, VkDevice
 	cmdBeginInfo.pNext = NULL;
 	cmdBeginInfo.flags = 0;
 	EVK_ASSERT(vkBeginCommandBuffer(cmdBuffer, &cmdBeginInfo) == VK_SUCCESS, "Failed to beging picking renderphase command buffer");
+	evk_command_begin(&renderphase->evkRenderpass.recorders[currentFrame], cmdBuffer);
 
 	VkRenderPassBeginInfo renderPassBeginInfo = { 0 };
 	renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -1036,12 +1314,12 @@ void evk_renderphase_picking_update(evkPickingRenderphase* renderphase, VkDevice
 	viewport.height = (float)extent.height;
 	viewport.minDepth = 0.0f;
 	viewport.maxDepth = 1.0f;
-	vkCmdSetViewport(cmdBuffer, 0, 1, &viewport);
+	evk_command_set_viewport(&renderphase->evkRenderpass.recorders[currentFrame], &viewport);
 
 	VkRect2D scissor = { 0 };
 	scissor.offset = (VkOffset2D){ 0, 0 };
 	scissor.extent = extent;
-	vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
+	evk_command_set_scissor(&renderphase->evkRenderpass.recorders[currentFrame], &scissor);
 
 	if (callback != NULL) {
 		callback(evk_get_context(), timestep);
@@ -1095,7 +1373,7 @@ evkUIRenderphase evk_renderphase_ui_create(VkDevice device, VkPhysicalDevice phy
 	info.pSubpasses = &subpass;
 	info.dependencyCount = 1;
 	info.pDependencies = &dependency;
-	EVK_ASSERT(vkCreateRenderPass(device, &info, NULL, &renderphase.evkRenderpass.renderpass) == VK_SUCCESS, "Failed to create ui render phase renderpass");
+	EVK_ASSERT(vkCreateRenderPass(device, &info, evk_get_vulkan_allocator(), &renderphase.evkRenderpass.renderpass) == VK_SUCCESS, "Failed to create ui render phase renderpass");
 
 	// command pool and buffers
 	evkQueueFamily indices = evk_device_find_queue_families(physicalDevice, surface);
@@ -1103,7 +1381,7 @@ evkUIRenderphase evk_renderphase_ui_create(VkDevice device, VkPhysicalDevice phy
 	cmdPoolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
 	cmdPoolInfo.queueFamilyIndex = indices.graphics;
 	cmdPoolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-	EVK_ASSERT(vkCreateCommandPool(device, &cmdPoolInfo, NULL, &renderphase.evkRenderpass.cmdPool) == VK_SUCCESS, "Failed to create ui render phase command pool");
+	EVK_ASSERT(vkCreateCommandPool(device, &cmdPoolInfo, evk_get_vulkan_allocator(), &renderphase.evkRenderpass.cmdPool) == VK_SUCCESS, "Failed to create ui render phase command pool");
 
 	VkCommandBufferAllocateInfo cmdBufferAllocInfo = { 0 };
 	cmdBufferAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -1122,7 +1400,7 @@ evkUIRenderphase evk_renderphase_ui_create(VkDevice device, VkPhysicalDevice phy
 	descInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
 	descInfo.bindingCount = 1;
 	descInfo.pBindings = binding;
-	EVK_ASSERT(vkCreateDescriptorSetLayout(device, &descInfo, NULL, &renderphase.descriptorSetLayout) == VK_SUCCESS, "Failed to create the ui render phase descriptor set layout");
+	EVK_ASSERT(vkCreateDescriptorSetLayout(device, &descInfo, evk_get_vulkan_allocator(), &renderphase.descriptorSetLayout) == VK_SUCCESS, "Failed to create the ui render phase descriptor set layout");
 
 	VkDescriptorPoolSize poolSizes[] =
 	{
@@ -1146,7 +1424,7 @@ evkUIRenderphase evk_renderphase_ui_create(VkDevice device, VkPhysicalDevice phy
 	poolCI.maxSets = 1000 * 11U;
 	poolCI.poolSizeCount = 11U;
 	poolCI.pPoolSizes = poolSizes;
-	EVK_ASSERT(vkCreateDescriptorPool(device, &poolCI, NULL, &renderphase.descriptorPool) == VK_SUCCESS, "Failed to create the ui render phase descriptor pool");
+	EVK_ASSERT(vkCreateDescriptorPool(device, &poolCI, evk_get_vulkan_allocator(), &renderphase.descriptorPool) == VK_SUCCESS, "Failed to create the ui render phase descriptor pool");
 
 	return renderphase;
 }
@@ -1157,7 +1435,7 @@ void evk_renderphase_ui_destroy(evkUIRenderphase* renderphase, VkDevice device)
 
 	// renderpass
 	if (renderphase->evkRenderpass.renderpass != VK_NULL_HANDLE) {
-		vkDestroyRenderPass(device, renderphase->evkRenderpass.renderpass, NULL);
+		vkDestroyRenderPass(device, renderphase->evkRenderpass.renderpass, evk_get_vulkan_allocator());
 	}
 
 	if (renderphase->evkRenderpass.cmdBuffers) {
@@ -1165,19 +1443,19 @@ void evk_renderphase_ui_destroy(evkUIRenderphase* renderphase, VkDevice device)
 	}
 
 	if (renderphase->evkRenderpass.cmdPool != VK_NULL_HANDLE) {
-		vkDestroyCommandPool(device, renderphase->evkRenderpass.cmdPool, NULL);
+		vkDestroyCommandPool(device, renderphase->evkRenderpass.cmdPool, evk_get_vulkan_allocator());
 	}
 
 	for (unsigned int i = 0; i < renderphase->evkRenderpass.framebufferCount; i++) {
-		vkDestroyFramebuffer(device, renderphase->evkRenderpass.framebuffers[i], NULL);
+		vkDestroyFramebuffer(device, renderphase->evkRenderpass.framebuffers[i], evk_get_vulkan_allocator());
 	}
 
-	m_free(renderphase->evkRenderpass.framebuffers);
+	EVK_FREE(renderphase->evkRenderpass.framebuffers);
 	memset(&renderphase->evkRenderpass, 0, sizeof(evkRenderpass));
 
 	// general
-	vkDestroyDescriptorSetLayout(device, renderphase->descriptorSetLayout, NULL);
-	vkDestroyDescriptorPool(device, renderphase->descriptorPool, NULL);
+	vkDestroyDescriptorSetLayout(device, renderphase->descriptorSetLayout, evk_get_vulkan_allocator());
+	vkDestroyDescriptorPool(device, renderphase->descriptorPool, evk_get_vulkan_allocator());
 
 	memset(renderphase, 0, sizeof(evkUIRenderphase));
 }
@@ -1186,13 +1464,13 @@ evkResult evk_renderphase_ui_create_framebuffers(evkUIRenderphase* renderphase,
 {
 	if (renderphase->evkRenderpass.framebuffers != NULL) {
 		for (uint32_t i = 0; i < renderphase->evkRenderpass.framebufferCount; i++) {
-			vkDestroyFramebuffer(device, renderphase->evkRenderpass.framebuffers[i], NULL);
+			vkDestroyFramebuffer(device, renderphase->evkRenderpass.framebuffers[i], evk_get_vulkan_allocator());
 		}
-		m_free(renderphase->evkRenderpass.framebuffers);
+		EVK_FREE(renderphase->evkRenderpass.framebuffers);
 	}
 
 	renderphase->evkRenderpass.framebufferCount = viewsCount;
-	renderphase->evkRenderpass.framebuffers = (VkFramebuffer*)m_malloc(sizeof(VkFramebuffer) * viewsCount);
+	renderphase->evkRenderpass.framebuffers = (VkFramebuffer*)EVK_MALLOC(evk_Allocation_Tag_Renderphase, sizeof(VkFramebuffer) * viewsCount);
 	if (renderphase->evkRenderpass.framebuffers == NULL) {
 		EVK_LOG(evk_Error, "Failed to allocate memory for the ui renderphase framebuffers");
 		return evk_Failure;
@@ -1210,7 +1488,7 @@ evkResult evk_renderphase_ui_create_framebuffers(evkUIRenderphase* renderphase,
 		framebufferCI.height = extent.height;
 		framebufferCI.layers = 1;
 
-		if (vkCreateFramebuffer(device, &framebufferCI, NULL, &renderphase->evkRenderpass.framebuffers[i]) != VK_SUCCESS) {
+		if (vkCreateFramebuffer(device, &framebufferCI, evk_get_vulkan_allocator(), &renderphase->evkRenderpass.framebuffers[i]) != VK_SUCCESS) {
 			EVK_LOG(evk_Error, "Failed to create ui render phase framebuffer");
 			return evk_Failure;
 		}
@@ -1324,7 +1602,7 @@ evkViewportRenderphase evk_renderphase_viewport_create(VkDevice device, VkPhysic
 	renderPassCI.pSubpasses = &subpassDescription;
 	renderPassCI.dependencyCount = dependenciesSize;
 	renderPassCI.pDependencies = dependencies;
-	EVK_ASSERT(vkCreateRenderPass(device, &renderPassCI, NULL, &renderphase.evkRenderpass.renderpass) == VK_SUCCESS, "Failed to create viewport render phase renderpass");
+	EVK_ASSERT(vkCreateRenderPass(device, &renderPassCI, evk_get_vulkan_allocator(), &renderphase.evkRenderpass.renderpass) == VK_SUCCESS, "Failed to create viewport render phase renderpass");
 	
 	// command pool and buffers
 	evkQueueFamily indices = evk_device_find_queue_families(physicalDevice, surface);
@@ -1332,7 +1610,7 @@ evkViewportRenderphase evk_renderphase_viewport_create(VkDevice device, VkPhysic
 	cmdPoolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
 	cmdPoolInfo.queueFamilyIndex = indices.graphics;
 	cmdPoolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-	EVK_ASSERT(vkCreateCommandPool(device, &cmdPoolInfo, NULL, &renderphase.evkRenderpass.cmdPool) == VK_SUCCESS, "Failed to create viewport renderphase command pool");
+	EVK_ASSERT(vkCreateCommandPool(device, &cmdPoolInfo, evk_get_vulkan_allocator(), &renderphase.evkRenderpass.cmdPool) == VK_SUCCESS, "Failed to create viewport renderphase command pool");
 
 	VkCommandBufferAllocateInfo cmdBufferAllocInfo = { 0 };
 	cmdBufferAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -1350,7 +1628,7 @@ void evk_renderphase_viewport_destroy(evkViewportRenderphase* renderphase, VkDev
 
 	// renderpass
 	if (renderphase->evkRenderpass.renderpass != VK_NULL_HANDLE) {
-		vkDestroyRenderPass(device, renderphase->evkRenderpass.renderpass, NULL);
+		vkDestroyRenderPass(device, renderphase->evkRenderpass.renderpass, evk_get_vulkan_allocator());
 	}
 
 	if (renderphase->evkRenderpass.cmdBuffers) {
@@ -1358,28 +1636,27 @@ void evk_renderphase_viewport_destroy(evkViewportRenderphase* renderphase, VkDev
 	}
 
 	if (renderphase->evkRenderpass.cmdPool != VK_NULL_HANDLE) {
-		vkDestroyCommandPool(device, renderphase->evkRenderpass.cmdPool, NULL);
+		vkDestroyCommandPool(device, renderphase->evkRenderpass.cmdPool, evk_get_vulkan_allocator());
 	}
 
 	for (unsigned int i = 0; i < renderphase->evkRenderpass.framebufferCount; i++) {
-		vkDestroyFramebuffer(device, renderphase->evkRenderpass.framebuffers[i], NULL);
+		vkDestroyFramebuffer(device, renderphase->evkRenderpass.framebuffers[i], evk_get_vulkan_allocator());
 	}
 
-	m_free(renderphase->evkRenderpass.framebuffers);
+	EVK_FREE(renderphase->evkRenderpass.framebuffers);
 	memset(&renderphase->evkRenderpass, 0, sizeof(evkRenderpass));
 
 	// general
-	vkDestroySampler(device, renderphase->sampler, NULL);
-	vkDestroyDescriptorPool(device, renderphase->descriptorPool, NULL);
-	vkDestroyDescriptorSetLayout(device, renderphase->descriptorSetLayout, NULL);
+	vkDestroyDescriptorPool(device, renderphase->descriptorPool, evk_get_vulkan_allocator());
+	vkDestroyDescriptorSetLayout(device, renderphase->descriptorSetLayout, evk_get_vulkan_allocator());
 
-	vkDestroyImageView(device, renderphase->depthView, NULL);
-	vkDestroyImage(device, renderphase->depthImage, NULL);
-	vkFreeMemory(device, renderphase->depthMem, NULL);
+	vkDestroyImageView(device, renderphase->depthView, evk_get_vulkan_allocator());
+	vkDestroyImage(device, renderphase->depthImage, evk_get_vulkan_allocator());
+	vkFreeMemory(device, renderphase->depthMem, evk_get_vulkan_allocator());
 
-	vkDestroyImageView(device, renderphase->colorView, NULL);
-	vkDestroyImage(device, renderphase->colorImage, NULL);
-	vkFreeMemory(device, renderphase->colorMem, NULL);
+	vkDestroyImageView(device, renderphase->colorView, evk_get_vulkan_allocator());
+	vkDestroyImage(device, renderphase->colorImage, evk_get_vulkan_allocator());
+	vkFreeMemory(device, renderphase->colorMem, evk_get_vulkan_allocator());
 
 	memset(renderphase, 0, sizeof(evkUIRenderphase));
 }
@@ -1388,17 +1665,17 @@ evkResult evk_renderphase_viewport_create_framebuffers(evkViewportRenderphase* r
 {
 	if (renderphase->evkRenderpass.framebuffers != NULL) {
 		for (uint32_t i = 0; i < renderphase->evkRenderpass.framebufferCount; i++) {
-			vkDestroyFramebuffer(device, renderphase->evkRenderpass.framebuffers[i], NULL);
+			vkDestroyFramebuffer(device, renderphase->evkRenderpass.framebuffers[i], evk_get_vulkan_allocator());
 		}
-		m_free(renderphase->evkRenderpass.framebuffers);
+		EVK_FREE(renderphase->evkRenderpass.framebuffers);
 	}
 
 	if (renderphase->descriptorPool != VK_NULL_HANDLE) {
-		vkDestroyDescriptorPool(device, renderphase->descriptorPool, NULL);
+		vkDestroyDescriptorPool(device, renderphase->descriptorPool, evk_get_vulkan_allocator());
 	}
 
 	if (renderphase->descriptorSet != VK_NULL_HANDLE) {
-		vkDestroyDescriptorSetLayout(device, renderphase->descriptorSetLayout, NULL);
+		vkDestroyDescriptorSetLayout(device, renderphase->descriptorSetLayout, evk_get_vulkan_allocator());
 	}
 	
 	// descriptor pool
@@ -1411,7 +1688,7 @@ evkResult evk_renderphase_viewport_create_framebuffers(evkViewportRenderphase* r
 	poolCI.poolSizeCount = (uint32_t)EVK_STATIC_ARRAY_SIZE(poolSizes);
 	poolCI.pPoolSizes = poolSizes;
 
-	if (vkCreateDescriptorPool(device, &poolCI, NULL, &renderphase->descriptorPool) != VK_SUCCESS) {
+	if (vkCreateDescriptorPool(device, &poolCI, evk_get_vulkan_allocator(), &renderphase->descriptorPool) != VK_SUCCESS) {
 		EVK_LOG(evk_Error, "Failed to create viewport render phase descriptor pool");
 		return evk_Failure;
 	}
@@ -1426,30 +1703,22 @@ evkResult evk_renderphase_viewport_create_framebuffers(evkViewportRenderphase* r
 	info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
 	info.bindingCount = 1;
 	info.pBindings = binding;
-	if (vkCreateDescriptorSetLayout(device, &info, NULL, &renderphase->descriptorSetLayout) != VK_SUCCESS) {
+	if (vkCreateDescriptorSetLayout(device, &info, evk_get_vulkan_allocator(), &renderphase->descriptorSetLayout) != VK_SUCCESS) {
 		EVK_LOG(evk_Error, "Failed to create viewport render phase descriptor set layout");
 		return evk_Failure;
 	}
 
-	// sampler
-	evkResult res = evk_device_create_image_sampler
-	(
-		device,
-		physicalDevice,
-		VK_FILTER_LINEAR,
-		VK_FILTER_LINEAR,
-		VK_SAMPLER_ADDRESS_MODE_REPEAT,
-		VK_SAMPLER_ADDRESS_MODE_REPEAT,
-		VK_SAMPLER_ADDRESS_MODE_REPEAT,
-		1.0f,
-		&renderphase->sampler
-	);
+	// sampler, shared through the sampler cache so resizes don't create new ones
+	evkSamplerState samplerState = evk_sampler_state_default(VK_FILTER_LINEAR, VK_SAMPLER_ADDRESS_MODE_REPEAT);
+	renderphase->sampler = evk_sampler_cache_get(&samplerState);
 
-	if (res != evk_Success) {
+	if (renderphase->sampler == VK_NULL_HANDLE) {
 		EVK_LOG(evk_Error, "Failed to create viewport render phase sampler");
-		return res;
+		return evk_Failure;
 	}
 
+	evkResult res = evk_Success;
+
 	// color image
 	res = evk_device_create_image
 	(
@@ -1579,7 +1848,7 @@ evkResult evk_renderphase_viewport_create_framebuffers(evkViewportRenderphase* r
 
 	// framebuffer
 	renderphase->evkRenderpass.framebufferCount = viewsCount;
-	renderphase->evkRenderpass.framebuffers = (VkFramebuffer*)m_malloc(sizeof(VkFramebuffer) * viewsCount);
+	renderphase->evkRenderpass.framebuffers = (VkFramebuffer*)EVK_MALLOC(evk_Allocation_Tag_Renderphase, sizeof(VkFramebuffer) * viewsCount);
 	EVK_ASSERT(renderphase->evkRenderpass.framebuffers != NULL, "Failed to allocate memory for the viewport renderphass framebuffers");
 
 	for (size_t i = 0; i < viewsCount; i++) {
@@ -1594,7 +1863,7 @@ evkResult evk_renderphase_viewport_create_framebuffers(evkViewportRenderphase* r
 		framebufferCI.height = extent.height;
 		framebufferCI.layers = 1;
 
-		if (vkCreateFramebuffer(device, &framebufferCI, NULL, &renderphase->evkRenderpass.framebuffers[i]) != VK_SUCCESS) {
+		if (vkCreateFramebuffer(device, &framebufferCI, evk_get_vulkan_allocator(), &renderphase->evkRenderpass.framebuffers[i]) != VK_SUCCESS) {
 			EVK_LOG(evk_Error, "Failed to create viewport renderphase framebuffer");
 			return res;
 		}
@@ -1620,6 +1889,7 @@ void evk_renderphase_viewport_update(evkViewportRenderphase* renderphase, VkDevi
 	cmdBeginInfo.pNext = NULL;
 	cmdBeginInfo.flags = 0;
 	EVK_ASSERT(vkBeginCommandBuffer(cmdBuffer, &cmdBeginInfo) == VK_SUCCESS, "Failed to begin viewport render phase command buffer");
+	evk_command_begin(&renderphase->evkRenderpass.recorders[currentFrame], cmdBuffer);
 
 	VkRenderPassBeginInfo renderPassBeginInfo = { 0 };
 	renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -1638,12 +1908,12 @@ void evk_renderphase_viewport_update(evkViewportRenderphase* renderphase, VkDevi
 	viewport.height = (float)extent.height;
 	viewport.minDepth = 0.0f;
 	viewport.maxDepth = 1.0f;
-	vkCmdSetViewport(cmdBuffer, 0, 1, &viewport);
+	evk_command_set_viewport(&renderphase->evkRenderpass.recorders[currentFrame], &viewport);
 
 	VkRect2D scissor = { 0 };
 	scissor.offset = (VkOffset2D){ 0, 0 };
 	scissor.extent = extent;
-	vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
+	evk_command_set_scissor(&renderphase->evkRenderpass.recorders[currentFrame], &scissor);
 
 	if (callback != NULL) {
 		callback(evk_get_context(), timestep);
@@ -0,0 +1,58 @@
+// Auto-generated from mesh_default_frag.spv
+#ifndef MESH_DEFAULT_FRAG_SPV_H
+#define MESH_DEFAULT_FRAG_SPV_H
+
+#include <stdint.h>
+
+const uint32_t mesh_default_frag_spv[] = {
+    0x07230203, 0x00010000, 0x000d000b, 0x0000002a, 0x00000000, 0x00020011, 0x00000001, 0x0006000b,
+    0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e, 0x00000000, 0x00000001,
+    0x0008000f, 0x00000004, 0x00000002, 0x6e69616d, 0x00000000, 0x00000003, 0x00000004, 0x00000005,
+    0x00030010, 0x00000002, 0x00000007, 0x00030003, 0x00000002, 0x000001cc, 0x000a0004, 0x475f4c47,
+    0x4c474f4f, 0x70635f45, 0x74735f70, 0x5f656c79, 0x656e696c, 0x7269645f, 0x69746365, 0x00006576,
+    0x00080004, 0x475f4c47, 0x4c474f4f, 0x6e695f45, 0x64756c63, 0x69645f65, 0x74636572, 0x00657669,
+    0x00040005, 0x00000002, 0x6e69616d, 0x00000000, 0x00050005, 0x00000003, 0x6e5f6e69, 0x616d726f,
+    0x0000006c, 0x00050005, 0x00000004, 0x5f74756f, 0x6f6c6f63, 0x00000072, 0x00050005, 0x00000005,
+    0x635f6e69, 0x726f6c6f, 0x00000000, 0x00050005, 0x00000006, 0x736e6f63, 0x746e6174, 0x00000073,
+    0x00040006, 0x00000006, 0x00000000, 0x00006469, 0x00050006, 0x00000006, 0x00000001, 0x65646f6d,
+    0x0000006c, 0x00050005, 0x00000007, 0x68737570, 0x6e6f635f, 0x00007473, 0x00050005, 0x00000008,
+    0x5f6f6275, 0x656d6163, 0x00006172, 0x00050006, 0x00000008, 0x00000000, 0x77656976, 0x00000000,
+    0x00060006, 0x00000008, 0x00000001, 0x77656976, 0x65766e49, 0x00657372, 0x00050006, 0x00000008,
+    0x00000002, 0x6a6f7270, 0x00000000, 0x00040005, 0x00000009, 0x656d6163, 0x00006172, 0x00040047,
+    0x00000003, 0x0000001e, 0x00000000, 0x00040047, 0x00000004, 0x0000001e, 0x00000000, 0x00040047,
+    0x00000005, 0x0000001e, 0x00000002, 0x00030047, 0x00000006, 0x00000002, 0x00050048, 0x00000006,
+    0x00000000, 0x00000023, 0x00000000, 0x00040048, 0x00000006, 0x00000001, 0x00000005, 0x00050048,
+    0x00000006, 0x00000001, 0x00000007, 0x00000010, 0x00050048, 0x00000006, 0x00000001, 0x00000023,
+    0x00000010, 0x00030047, 0x00000008, 0x00000002, 0x00040048, 0x00000008, 0x00000000, 0x00000005,
+    0x00050048, 0x00000008, 0x00000000, 0x00000007, 0x00000010, 0x00050048, 0x00000008, 0x00000000,
+    0x00000023, 0x00000000, 0x00040048, 0x00000008, 0x00000001, 0x00000005, 0x00050048, 0x00000008,
+    0x00000001, 0x00000007, 0x00000010, 0x00050048, 0x00000008, 0x00000001, 0x00000023, 0x00000040,
+    0x00040048, 0x00000008, 0x00000002, 0x00000005, 0x00050048, 0x00000008, 0x00000002, 0x00000007,
+    0x00000010, 0x00050048, 0x00000008, 0x00000002, 0x00000023, 0x00000080, 0x00040047, 0x00000009,
+    0x00000021, 0x00000000, 0x00040047, 0x00000009, 0x00000022, 0x00000000, 0x00020013, 0x0000000a,
+    0x00030021, 0x0000000b, 0x0000000a, 0x00030016, 0x0000000c, 0x00000020, 0x00040017, 0x0000000d,
+    0x0000000c, 0x00000003, 0x00040017, 0x0000000e, 0x0000000c, 0x00000004, 0x0004002b, 0x0000000c,
+    0x0000000f, 0x00000000, 0x0004002b, 0x0000000c, 0x00000010, 0x3e4ccccd, 0x0004002b, 0x0000000c,
+    0x00000011, 0x3e99999a, 0x0004002b, 0x0000000c, 0x00000012, 0x3f000000, 0x0004002b, 0x0000000c,
+    0x00000013, 0x3f4ccccd, 0x0004002b, 0x0000000c, 0x00000014, 0x3f800000, 0x0006002c, 0x0000000d,
+    0x00000015, 0x00000011, 0x00000014, 0x00000012, 0x00040020, 0x00000016, 0x00000001, 0x0000000d,
+    0x00040020, 0x00000017, 0x00000001, 0x0000000e, 0x0004003b, 0x00000016, 0x00000003, 0x00000001,
+    0x00040020, 0x00000018, 0x00000003, 0x0000000e, 0x0004003b, 0x00000018, 0x00000004, 0x00000003,
+    0x0004003b, 0x00000017, 0x00000005, 0x00000001, 0x00040015, 0x00000019, 0x00000020, 0x00000000,
+    0x00040018, 0x0000001a, 0x0000000e, 0x00000004, 0x0004001e, 0x00000006, 0x00000019, 0x0000001a,
+    0x00040020, 0x0000001b, 0x00000009, 0x00000006, 0x0004003b, 0x0000001b, 0x00000007, 0x00000009,
+    0x0005001e, 0x00000008, 0x0000001a, 0x0000001a, 0x0000001a, 0x00040020, 0x0000001c, 0x00000002,
+    0x00000008, 0x0004003b, 0x0000001c, 0x00000009, 0x00000002, 0x00050036, 0x0000000a, 0x00000002,
+    0x00000000, 0x0000000b, 0x000200f8, 0x0000001d, 0x0006000c, 0x0000000d, 0x0000001e, 0x00000001,
+    0x00000045, 0x00000015, 0x0004003d, 0x0000000d, 0x0000001f, 0x00000003, 0x0006000c, 0x0000000d,
+    0x00000020, 0x00000001, 0x00000045, 0x0000001f, 0x00050094, 0x0000000c, 0x00000021, 0x00000020,
+    0x0000001e, 0x0007000c, 0x0000000c, 0x00000022, 0x00000001, 0x00000028, 0x00000021, 0x0000000f,
+    0x00050085, 0x0000000c, 0x00000023, 0x00000022, 0x00000013, 0x00050081, 0x0000000c, 0x00000024,
+    0x00000023, 0x00000010, 0x0004003d, 0x0000000e, 0x00000025, 0x00000005, 0x0008004f, 0x0000000d,
+    0x00000026, 0x00000025, 0x00000025, 0x00000000, 0x00000001, 0x00000002, 0x0005008e, 0x0000000d,
+    0x00000027, 0x00000026, 0x00000024, 0x00050051, 0x0000000c, 0x00000028, 0x00000025, 0x00000003,
+    0x00050050, 0x0000000e, 0x00000029, 0x00000027, 0x00000028, 0x0003003e, 0x00000004, 0x00000029,
+    0x000100fd, 0x00010038,
+};
+const uint32_t mesh_default_frag_spv_size = 378;
+#endif // MESH_DEFAULT_FRAG_SPV_H
\ No newline at end of file
@@ -0,0 +1,32 @@
+// Auto-generated from mesh_picking_frag.spv
+#ifndef MESH_PICKING_FRAG_SPV_H
+#define MESH_PICKING_FRAG_SPV_H
+
+#include <stdint.h>
+
+const uint32_t mesh_picking_frag_spv[] = {
+    0x07230203, 0x00010000, 0x000d000b, 0x00000014, 0x00000000, 0x00020011, 0x00000001, 0x0006000b,
+    0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e, 0x00000000, 0x00000001,
+    0x0006000f, 0x00000004, 0x00000002, 0x6e69616d, 0x00000000, 0x00000003, 0x00030010, 0x00000002,
+    0x00000007, 0x00030003, 0x00000002, 0x000001cc, 0x000a0004, 0x475f4c47, 0x4c474f4f, 0x70635f45,
+    0x74735f70, 0x5f656c79, 0x656e696c, 0x7269645f, 0x69746365, 0x00006576, 0x00080004, 0x475f4c47,
+    0x4c474f4f, 0x6e695f45, 0x64756c63, 0x69645f65, 0x74636572, 0x00657669, 0x00040005, 0x00000002,
+    0x6e69616d, 0x00000000, 0x00050005, 0x00000003, 0x5f74756f, 0x6f6c6f63, 0x00000072, 0x00050005,
+    0x00000004, 0x736e6f63, 0x746e6174, 0x00000073, 0x00040006, 0x00000004, 0x00000000, 0x00006469,
+    0x00050006, 0x00000004, 0x00000001, 0x65646f6d, 0x0000006c, 0x00050005, 0x00000005, 0x68737570,
+    0x6e6f635f, 0x00007473, 0x00040047, 0x00000003, 0x0000001e, 0x00000000, 0x00030047, 0x00000004,
+    0x00000002, 0x00050048, 0x00000004, 0x00000000, 0x00000023, 0x00000000, 0x00040048, 0x00000004,
+    0x00000001, 0x00000005, 0x00050048, 0x00000004, 0x00000001, 0x00000007, 0x00000010, 0x00050048,
+    0x00000004, 0x00000001, 0x00000023, 0x00000010, 0x00020013, 0x00000006, 0x00030021, 0x00000007,
+    0x00000006, 0x00040015, 0x00000008, 0x00000020, 0x00000000, 0x00040020, 0x00000009, 0x00000003,
+    0x00000008, 0x0004003b, 0x00000009, 0x00000003, 0x00000003, 0x00030016, 0x0000000a, 0x00000020,
+    0x00040017, 0x0000000b, 0x0000000a, 0x00000004, 0x00040018, 0x0000000c, 0x0000000b, 0x00000004,
+    0x0004001e, 0x00000004, 0x00000008, 0x0000000c, 0x00040020, 0x0000000d, 0x00000009, 0x00000004,
+    0x0004003b, 0x0000000d, 0x00000005, 0x00000009, 0x00040015, 0x0000000e, 0x00000020, 0x00000001,
+    0x0004002b, 0x0000000e, 0x0000000f, 0x00000000, 0x00040020, 0x00000010, 0x00000009, 0x00000008,
+    0x00050036, 0x00000006, 0x00000002, 0x00000000, 0x00000007, 0x000200f8, 0x00000011, 0x00050041,
+    0x00000010, 0x00000012, 0x00000005, 0x0000000f, 0x0004003d, 0x00000008, 0x00000013, 0x00000012,
+    0x0003003e, 0x00000003, 0x00000013, 0x000100fd, 0x00010038,
+};
+const uint32_t mesh_picking_frag_spv_size = 173;
+#endif // MESH_PICKING_FRAG_SPV_H
\ No newline at end of file
@@ -0,0 +1,316 @@
+// Auto-generated from mipmap_downsample_comp.spv
+#ifndef MIPMAP_DOWNSAMPLE_COMP_SPV_H
+#define MIPMAP_DOWNSAMPLE_COMP_SPV_H
+
+#include <stdint.h>
+
+const uint32_t mipmap_downsample_comp_spv[] = {
+    0x07230203, 0x00010000, 0x000d000b, 0x000001a8, 0x00000000, 0x00020011, 0x00000001, 0x00020011,
+    0x00000032, 0x0006000b, 0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e,
+    0x00000000, 0x00000001, 0x0007000f, 0x00000005, 0x00000002, 0x6e69616d, 0x00000000, 0x00000003,
+    0x00000004, 0x00060010, 0x00000002, 0x00000011, 0x00000100, 0x00000001, 0x00000001, 0x00030003,
+    0x00000002, 0x000001cc, 0x000a0004, 0x475f4c47, 0x4c474f4f, 0x70635f45, 0x74735f70, 0x5f656c79,
+    0x656e696c, 0x7269645f, 0x69746365, 0x00006576, 0x00080004, 0x475f4c47, 0x4c474f4f, 0x6e695f45,
+    0x64756c63, 0x69645f65, 0x74636572, 0x00657669, 0x00040005, 0x00000002, 0x6e69616d, 0x00000000,
+    0x00070005, 0x00000005, 0x62677273, 0x5f6f745f, 0x656e696c, 0x76287261, 0x003b3366, 0x00070005,
+    0x00000006, 0x656e696c, 0x745f7261, 0x72735f6f, 0x76286267, 0x003b3366, 0x00060005, 0x00000007,
+    0x5f70696d, 0x657a6973, 0x3b316928, 0x00000000, 0x00090005, 0x00000008, 0x5f70696d, 0x726f7473,
+    0x31692865, 0x3269763b, 0x3b31693b, 0x3b346676, 0x00000000, 0x00080005, 0x00000009, 0x72756f73,
+    0x6c5f6563, 0x2864616f, 0x763b3162, 0x693b3269, 0x00003b31, 0x000a0005, 0x0000000a, 0x6e776f64,
+    0x706d6173, 0x745f656c, 0x28656c69, 0x3b326976, 0x693b3169, 0x31623b31, 0x0000003b, 0x00040005,
+    0x0000000b, 0x5f637273, 0x0070696d, 0x00050005, 0x0000000c, 0x5f747364, 0x7370696d, 0x00000000,
+    0x00050005, 0x0000000d, 0x6e756f63, 0x73726574, 0x00000000, 0x00050006, 0x0000000d, 0x00000000,
+    0x6e756f63, 0x00726574, 0x00050005, 0x0000000e, 0x736e6f63, 0x746e6174, 0x00000073, 0x00050006,
+    0x0000000e, 0x00000000, 0x7370696d, 0x00000000, 0x00060006, 0x0000000e, 0x00000001, 0x6b726f77,
+    0x6f72675f, 0x00737075, 0x00050006, 0x0000000e, 0x00000002, 0x62677273, 0x00000000, 0x00050005,
+    0x0000000f, 0x68737570, 0x6e6f635f, 0x00007473, 0x00040005, 0x00000010, 0x656c6974, 0x00000000,
+    0x00040005, 0x00000011, 0x6c5f7369, 0x00747361, 0x00080005, 0x00000003, 0x4c5f6c67, 0x6c61636f,
+    0x6f766e49, 0x69746163, 0x6e496e6f, 0x00786564, 0x00060005, 0x00000004, 0x575f6c67, 0x476b726f,
+    0x70756f72, 0x00004449, 0x00040005, 0x00000012, 0x64617571, 0x00000000, 0x00040005, 0x00000013,
+    0x75646572, 0x00646563, 0x00040005, 0x00000014, 0x74646977, 0x00000068, 0x00040005, 0x00000015,
+    0x6576656c, 0x0000006c, 0x00030005, 0x00000016, 0x00000069, 0x00040047, 0x0000000b, 0x00000021,
+    0x00000000, 0x00040047, 0x0000000b, 0x00000022, 0x00000000, 0x00040047, 0x0000000c, 0x00000021,
+    0x00000001, 0x00040047, 0x0000000c, 0x00000022, 0x00000000, 0x00030047, 0x0000000c, 0x00000017,
+    0x00040047, 0x00000017, 0x00000006, 0x00000004, 0x00040048, 0x0000000d, 0x00000000, 0x00000017,
+    0x00050048, 0x0000000d, 0x00000000, 0x00000023, 0x00000000, 0x00030047, 0x0000000d, 0x00000003,
+    0x00040047, 0x00000018, 0x00000021, 0x00000002, 0x00040047, 0x00000018, 0x00000022, 0x00000000,
+    0x00030047, 0x0000000e, 0x00000002, 0x00050048, 0x0000000e, 0x00000000, 0x00000023, 0x00000000,
+    0x00050048, 0x0000000e, 0x00000001, 0x00000023, 0x00000004, 0x00050048, 0x0000000e, 0x00000002,
+    0x00000023, 0x00000008, 0x00040047, 0x00000003, 0x0000000b, 0x0000001d, 0x00040047, 0x00000004,
+    0x0000000b, 0x0000001a, 0x00020013, 0x00000019, 0x00030021, 0x0000001a, 0x00000019, 0x00020014,
+    0x0000001b, 0x00040015, 0x0000001c, 0x00000020, 0x00000001, 0x00040015, 0x0000001d, 0x00000020,
+    0x00000000, 0x00030016, 0x0000001e, 0x00000020, 0x00040017, 0x0000001f, 0x0000001c, 0x00000002,
+    0x00040017, 0x00000020, 0x0000001c, 0x00000003, 0x00040017, 0x00000021, 0x0000001d, 0x00000002,
+    0x00040017, 0x00000022, 0x0000001d, 0x00000003, 0x00040017, 0x00000023, 0x0000001e, 0x00000003,
+    0x00040017, 0x00000024, 0x0000001e, 0x00000004, 0x00040017, 0x00000025, 0x0000001b, 0x00000002,
+    0x00040017, 0x00000026, 0x0000001b, 0x00000004, 0x00040021, 0x00000027, 0x00000023, 0x00000023,
+    0x00040021, 0x00000028, 0x0000001f, 0x0000001c, 0x00070021, 0x00000029, 0x00000019, 0x0000001c,
+    0x0000001f, 0x0000001c, 0x00000024, 0x00060021, 0x0000002a, 0x00000024, 0x0000001b, 0x0000001f,
+    0x0000001c, 0x00070021, 0x0000002b, 0x00000019, 0x0000001f, 0x0000001c, 0x0000001c, 0x0000001b,
+    0x00030029, 0x0000001b, 0x0000002c, 0x0003002a, 0x0000001b, 0x0000002d, 0x0004002b, 0x0000001c,
+    0x0000002e, 0x00000000, 0x0004002b, 0x0000001c, 0x0000002f, 0x00000001, 0x0004002b, 0x0000001c,
+    0x00000030, 0x00000002, 0x0004002b, 0x0000001c, 0x00000031, 0x00000003, 0x0004002b, 0x0000001c,
+    0x00000032, 0x00000004, 0x0004002b, 0x0000001c, 0x00000033, 0x00000005, 0x0004002b, 0x0000001c,
+    0x00000034, 0x00000006, 0x0004002b, 0x0000001c, 0x00000035, 0x00000007, 0x0004002b, 0x0000001c,
+    0x00000036, 0x00000008, 0x0004002b, 0x0000001c, 0x00000037, 0x00000009, 0x0004002b, 0x0000001c,
+    0x00000038, 0x0000000a, 0x0004002b, 0x0000001c, 0x00000039, 0x0000000b, 0x0004002b, 0x0000001c,
+    0x0000003a, 0x00000010, 0x0004002b, 0x0000001c, 0x0000003b, 0x00000020, 0x0004002b, 0x0000001d,
+    0x0000003c, 0x00000000, 0x0004002b, 0x0000001d, 0x0000003d, 0x00000001, 0x0004002b, 0x0000001d,
+    0x0000003e, 0x00000002, 0x0004002b, 0x0000001d, 0x0000003f, 0x00000004, 0x0004002b, 0x0000001d,
+    0x00000040, 0x00000006, 0x0004002b, 0x0000001d, 0x00000041, 0x0000000c, 0x0004002b, 0x0000001d,
+    0x00000042, 0x00000010, 0x0004002b, 0x0000001d, 0x00000043, 0x00000108, 0x0004002b, 0x0000001d,
+    0x00000044, 0x00000808, 0x0004002b, 0x0000001e, 0x00000045, 0x00000000, 0x0004002b, 0x0000001e,
+    0x00000046, 0x3f800000, 0x0004002b, 0x0000001e, 0x00000047, 0x3e800000, 0x0004002b, 0x0000001e,
+    0x00000048, 0x414eb852, 0x0004002b, 0x0000001e, 0x00000049, 0x3d6147ae, 0x0004002b, 0x0000001e,
+    0x0000004a, 0x3f870a3d, 0x0004002b, 0x0000001e, 0x0000004b, 0x4019999a, 0x0004002b, 0x0000001e,
+    0x0000004c, 0x3d25aee6, 0x0004002b, 0x0000001e, 0x0000004d, 0x3ed55555, 0x0004002b, 0x0000001e,
+    0x0000004e, 0x3b4d2e1c, 0x0006002c, 0x00000023, 0x0000004f, 0x00000048, 0x00000048, 0x00000048,
+    0x0006002c, 0x00000023, 0x00000050, 0x00000049, 0x00000049, 0x00000049, 0x0006002c, 0x00000023,
+    0x00000051, 0x0000004a, 0x0000004a, 0x0000004a, 0x0006002c, 0x00000023, 0x00000052, 0x0000004b,
+    0x0000004b, 0x0000004b, 0x0006002c, 0x00000023, 0x00000053, 0x0000004c, 0x0000004c, 0x0000004c,
+    0x0006002c, 0x00000023, 0x00000054, 0x0000004d, 0x0000004d, 0x0000004d, 0x0006002c, 0x00000023,
+    0x00000055, 0x0000004e, 0x0000004e, 0x0000004e, 0x0006002c, 0x00000023, 0x00000056, 0x00000045,
+    0x00000045, 0x00000045, 0x0006002c, 0x00000023, 0x00000057, 0x00000046, 0x00000046, 0x00000046,
+    0x0005002c, 0x0000001f, 0x00000058, 0x0000002e, 0x0000002e, 0x0005002c, 0x0000001f, 0x00000059,
+    0x0000002f, 0x0000002f, 0x0005002c, 0x0000001f, 0x0000005a, 0x00000030, 0x00000030, 0x0005002c,
+    0x0000001f, 0x0000005b, 0x0000003a, 0x0000003a, 0x0005002c, 0x0000001f, 0x0000005c, 0x0000003b,
+    0x0000003b, 0x0005002c, 0x0000001f, 0x0000005d, 0x0000002f, 0x0000002e, 0x0005002c, 0x0000001f,
+    0x0000005e, 0x0000002e, 0x0000002f, 0x00090019, 0x0000005f, 0x0000001e, 0x00000001, 0x00000000,
+    0x00000001, 0x00000000, 0x00000001, 0x00000000, 0x0003001b, 0x00000060, 0x0000005f, 0x00040020,
+    0x00000061, 0x00000000, 0x00000060, 0x0004003b, 0x00000061, 0x0000000b, 0x00000000, 0x00090019,
+    0x00000062, 0x0000001e, 0x00000001, 0x00000000, 0x00000001, 0x00000000, 0x00000002, 0x00000004,
+    0x0004001c, 0x00000063, 0x00000062, 0x00000041, 0x00040020, 0x00000064, 0x00000000, 0x00000063,
+    0x0004003b, 0x00000064, 0x0000000c, 0x00000000, 0x00040020, 0x00000065, 0x00000000, 0x00000062,
+    0x0003001d, 0x00000017, 0x0000001d, 0x0003001e, 0x0000000d, 0x00000017, 0x00040020, 0x00000066,
+    0x00000002, 0x0000000d, 0x0004003b, 0x00000066, 0x00000018, 0x00000002, 0x00040020, 0x00000067,
+    0x00000002, 0x0000001d, 0x0005001e, 0x0000000e, 0x0000001d, 0x0000001d, 0x0000001d, 0x00040020,
+    0x00000068, 0x00000009, 0x0000000e, 0x0004003b, 0x00000068, 0x0000000f, 0x00000009, 0x00040020,
+    0x00000069, 0x00000009, 0x0000001d, 0x0004001c, 0x0000006a, 0x00000024, 0x00000042, 0x0004001c,
+    0x0000006b, 0x0000006a, 0x00000042, 0x00040020, 0x0000006c, 0x00000004, 0x0000006b, 0x0004003b,
+    0x0000006c, 0x00000010, 0x00000004, 0x00040020, 0x0000006d, 0x00000004, 0x00000024, 0x00040020,
+    0x0000006e, 0x00000004, 0x0000001d, 0x0004003b, 0x0000006e, 0x00000011, 0x00000004, 0x00040020,
+    0x0000006f, 0x00000001, 0x0000001d, 0x0004003b, 0x0000006f, 0x00000003, 0x00000001, 0x00040020,
+    0x00000070, 0x00000001, 0x00000022, 0x0004003b, 0x00000070, 0x00000004, 0x00000001, 0x0004001c,
+    0x00000071, 0x00000024, 0x0000003f, 0x00040020, 0x00000072, 0x00000007, 0x00000071, 0x00040020,
+    0x00000073, 0x00000007, 0x00000024, 0x00040020, 0x00000074, 0x00000007, 0x0000001c, 0x00050036,
+    0x00000019, 0x00000002, 0x00000000, 0x0000001a, 0x000200f8, 0x00000075, 0x0004003d, 0x00000022,
+    0x00000076, 0x00000004, 0x00050051, 0x0000001d, 0x00000077, 0x00000076, 0x00000002, 0x0004007c,
+    0x0000001c, 0x00000078, 0x00000077, 0x0007004f, 0x00000021, 0x00000079, 0x00000076, 0x00000076,
+    0x00000000, 0x00000001, 0x0004007c, 0x0000001f, 0x0000007a, 0x00000079, 0x00080039, 0x00000019,
+    0x0000007b, 0x0000000a, 0x0000007a, 0x00000078, 0x0000002e, 0x0000002c, 0x00050041, 0x00000069,
+    0x0000007c, 0x0000000f, 0x0000002e, 0x0004003d, 0x0000001d, 0x0000007d, 0x0000007c, 0x000500b2,
+    0x0000001b, 0x0000007e, 0x0000007d, 0x00000040, 0x000300f7, 0x0000007f, 0x00000000, 0x000400fa,
+    0x0000007e, 0x00000080, 0x0000007f, 0x000200f8, 0x00000080, 0x000100fd, 0x000200f8, 0x0000007f,
+    0x0004003d, 0x0000001d, 0x00000081, 0x00000003, 0x000500aa, 0x0000001b, 0x00000082, 0x00000081,
+    0x0000003c, 0x000300f7, 0x00000083, 0x00000000, 0x000400fa, 0x00000082, 0x00000084, 0x00000083,
+    0x000200f8, 0x00000084, 0x000300e1, 0x0000003d, 0x00000044, 0x00060041, 0x00000067, 0x00000085,
+    0x00000018, 0x0000002e, 0x00000078, 0x000700ea, 0x0000001d, 0x00000086, 0x00000085, 0x0000003d,
+    0x0000003c, 0x0000003d, 0x00050041, 0x00000069, 0x00000087, 0x0000000f, 0x0000002f, 0x0004003d,
+    0x0000001d, 0x00000088, 0x00000087, 0x00050082, 0x0000001d, 0x00000089, 0x00000088, 0x0000003d,
+    0x000500aa, 0x0000001b, 0x0000008a, 0x00000086, 0x00000089, 0x000600a9, 0x0000001d, 0x0000008b,
+    0x0000008a, 0x0000003d, 0x0000003c, 0x0003003e, 0x00000011, 0x0000008b, 0x000200f9, 0x00000083,
+    0x000200f8, 0x00000083, 0x000400e0, 0x0000003e, 0x0000003e, 0x00000043, 0x0004003d, 0x0000001d,
+    0x0000008c, 0x00000011, 0x000500aa, 0x0000001b, 0x0000008d, 0x0000008c, 0x0000003c, 0x000300f7,
+    0x0000008e, 0x00000000, 0x000400fa, 0x0000008d, 0x0000008f, 0x0000008e, 0x000200f8, 0x0000008f,
+    0x000100fd, 0x000200f8, 0x0000008e, 0x000300e1, 0x0000003d, 0x00000044, 0x00080039, 0x00000019,
+    0x00000090, 0x0000000a, 0x00000058, 0x00000078, 0x00000034, 0x0000002d, 0x000100fd, 0x00010038,
+    0x00050036, 0x00000023, 0x00000005, 0x00000000, 0x00000027, 0x00030037, 0x00000023, 0x00000091,
+    0x000200f8, 0x00000092, 0x00050088, 0x00000023, 0x00000093, 0x00000091, 0x0000004f, 0x00050081,
+    0x00000023, 0x00000094, 0x00000091, 0x00000050, 0x00050088, 0x00000023, 0x00000095, 0x00000094,
+    0x00000051, 0x0007000c, 0x00000023, 0x00000096, 0x00000001, 0x0000001a, 0x00000095, 0x00000052,
+    0x0007000c, 0x00000023, 0x00000097, 0x00000001, 0x00000030, 0x00000053, 0x00000091, 0x0008000c,
+    0x00000023, 0x00000098, 0x00000001, 0x0000002e, 0x00000093, 0x00000096, 0x00000097, 0x000200fe,
+    0x00000098, 0x00010038, 0x00050036, 0x00000023, 0x00000006, 0x00000000, 0x00000027, 0x00030037,
+    0x00000023, 0x00000099, 0x000200f8, 0x0000009a, 0x0005008e, 0x00000023, 0x0000009b, 0x00000099,
+    0x00000048, 0x0007000c, 0x00000023, 0x0000009c, 0x00000001, 0x0000001a, 0x00000099, 0x00000054,
+    0x0005008e, 0x00000023, 0x0000009d, 0x0000009c, 0x0000004a, 0x00050083, 0x00000023, 0x0000009e,
+    0x0000009d, 0x00000050, 0x0007000c, 0x00000023, 0x0000009f, 0x00000001, 0x00000030, 0x00000055,
+    0x00000099, 0x0008000c, 0x00000023, 0x000000a0, 0x00000001, 0x0000002e, 0x0000009b, 0x0000009e,
+    0x0000009f, 0x000200fe, 0x000000a0, 0x00010038, 0x00050036, 0x0000001f, 0x00000007, 0x00000000,
+    0x00000028, 0x00030037, 0x0000001c, 0x000000a1, 0x000200f8, 0x000000a2, 0x000300f7, 0x000000a3,
+    0x00000000, 0x001b00fb, 0x000000a1, 0x000000a3, 0x00000000, 0x000000a4, 0x00000001, 0x000000a5,
+    0x00000002, 0x000000a6, 0x00000003, 0x000000a7, 0x00000004, 0x000000a8, 0x00000005, 0x000000a9,
+    0x00000006, 0x000000aa, 0x00000007, 0x000000ab, 0x00000008, 0x000000ac, 0x00000009, 0x000000ad,
+    0x0000000a, 0x000000ae, 0x0000000b, 0x000000af, 0x000200f8, 0x000000a4, 0x00050041, 0x00000065,
+    0x000000b0, 0x0000000c, 0x0000002e, 0x0004003d, 0x00000062, 0x000000b1, 0x000000b0, 0x00040068,
+    0x00000020, 0x000000b2, 0x000000b1, 0x0007004f, 0x0000001f, 0x000000b3, 0x000000b2, 0x000000b2,
+    0x00000000, 0x00000001, 0x000200fe, 0x000000b3, 0x000200f8, 0x000000a5, 0x00050041, 0x00000065,
+    0x000000b4, 0x0000000c, 0x0000002f, 0x0004003d, 0x00000062, 0x000000b5, 0x000000b4, 0x00040068,
+    0x00000020, 0x000000b6, 0x000000b5, 0x0007004f, 0x0000001f, 0x000000b7, 0x000000b6, 0x000000b6,
+    0x00000000, 0x00000001, 0x000200fe, 0x000000b7, 0x000200f8, 0x000000a6, 0x00050041, 0x00000065,
+    0x000000b8, 0x0000000c, 0x00000030, 0x0004003d, 0x00000062, 0x000000b9, 0x000000b8, 0x00040068,
+    0x00000020, 0x000000ba, 0x000000b9, 0x0007004f, 0x0000001f, 0x000000bb, 0x000000ba, 0x000000ba,
+    0x00000000, 0x00000001, 0x000200fe, 0x000000bb, 0x000200f8, 0x000000a7, 0x00050041, 0x00000065,
+    0x000000bc, 0x0000000c, 0x00000031, 0x0004003d, 0x00000062, 0x000000bd, 0x000000bc, 0x00040068,
+    0x00000020, 0x000000be, 0x000000bd, 0x0007004f, 0x0000001f, 0x000000bf, 0x000000be, 0x000000be,
+    0x00000000, 0x00000001, 0x000200fe, 0x000000bf, 0x000200f8, 0x000000a8, 0x00050041, 0x00000065,
+    0x000000c0, 0x0000000c, 0x00000032, 0x0004003d, 0x00000062, 0x000000c1, 0x000000c0, 0x00040068,
+    0x00000020, 0x000000c2, 0x000000c1, 0x0007004f, 0x0000001f, 0x000000c3, 0x000000c2, 0x000000c2,
+    0x00000000, 0x00000001, 0x000200fe, 0x000000c3, 0x000200f8, 0x000000a9, 0x00050041, 0x00000065,
+    0x000000c4, 0x0000000c, 0x00000033, 0x0004003d, 0x00000062, 0x000000c5, 0x000000c4, 0x00040068,
+    0x00000020, 0x000000c6, 0x000000c5, 0x0007004f, 0x0000001f, 0x000000c7, 0x000000c6, 0x000000c6,
+    0x00000000, 0x00000001, 0x000200fe, 0x000000c7, 0x000200f8, 0x000000aa, 0x00050041, 0x00000065,
+    0x000000c8, 0x0000000c, 0x00000034, 0x0004003d, 0x00000062, 0x000000c9, 0x000000c8, 0x00040068,
+    0x00000020, 0x000000ca, 0x000000c9, 0x0007004f, 0x0000001f, 0x000000cb, 0x000000ca, 0x000000ca,
+    0x00000000, 0x00000001, 0x000200fe, 0x000000cb, 0x000200f8, 0x000000ab, 0x00050041, 0x00000065,
+    0x000000cc, 0x0000000c, 0x00000035, 0x0004003d, 0x00000062, 0x000000cd, 0x000000cc, 0x00040068,
+    0x00000020, 0x000000ce, 0x000000cd, 0x0007004f, 0x0000001f, 0x000000cf, 0x000000ce, 0x000000ce,
+    0x00000000, 0x00000001, 0x000200fe, 0x000000cf, 0x000200f8, 0x000000ac, 0x00050041, 0x00000065,
+    0x000000d0, 0x0000000c, 0x00000036, 0x0004003d, 0x00000062, 0x000000d1, 0x000000d0, 0x00040068,
+    0x00000020, 0x000000d2, 0x000000d1, 0x0007004f, 0x0000001f, 0x000000d3, 0x000000d2, 0x000000d2,
+    0x00000000, 0x00000001, 0x000200fe, 0x000000d3, 0x000200f8, 0x000000ad, 0x00050041, 0x00000065,
+    0x000000d4, 0x0000000c, 0x00000037, 0x0004003d, 0x00000062, 0x000000d5, 0x000000d4, 0x00040068,
+    0x00000020, 0x000000d6, 0x000000d5, 0x0007004f, 0x0000001f, 0x000000d7, 0x000000d6, 0x000000d6,
+    0x00000000, 0x00000001, 0x000200fe, 0x000000d7, 0x000200f8, 0x000000ae, 0x00050041, 0x00000065,
+    0x000000d8, 0x0000000c, 0x00000038, 0x0004003d, 0x00000062, 0x000000d9, 0x000000d8, 0x00040068,
+    0x00000020, 0x000000da, 0x000000d9, 0x0007004f, 0x0000001f, 0x000000db, 0x000000da, 0x000000da,
+    0x00000000, 0x00000001, 0x000200fe, 0x000000db, 0x000200f8, 0x000000af, 0x00050041, 0x00000065,
+    0x000000dc, 0x0000000c, 0x00000039, 0x0004003d, 0x00000062, 0x000000dd, 0x000000dc, 0x00040068,
+    0x00000020, 0x000000de, 0x000000dd, 0x0007004f, 0x0000001f, 0x000000df, 0x000000de, 0x000000de,
+    0x00000000, 0x00000001, 0x000200fe, 0x000000df, 0x000200f8, 0x000000a3, 0x000200fe, 0x00000058,
+    0x00010038, 0x00050036, 0x00000019, 0x00000008, 0x00000000, 0x00000029, 0x00030037, 0x0000001c,
+    0x000000e0, 0x00030037, 0x0000001f, 0x000000e1, 0x00030037, 0x0000001c, 0x000000e2, 0x00030037,
+    0x00000024, 0x000000e3, 0x000200f8, 0x000000e4, 0x00050041, 0x00000069, 0x000000e5, 0x0000000f,
+    0x0000002e, 0x0004003d, 0x0000001d, 0x000000e6, 0x000000e5, 0x0004007c, 0x0000001c, 0x000000e7,
+    0x000000e6, 0x000500af, 0x0000001b, 0x000000e8, 0x000000e0, 0x000000e7, 0x00050039, 0x0000001f,
+    0x000000e9, 0x00000007, 0x000000e0, 0x000500af, 0x00000025, 0x000000ea, 0x000000e1, 0x000000e9,
+    0x0004009a, 0x0000001b, 0x000000eb, 0x000000ea, 0x000500a6, 0x0000001b, 0x000000ec, 0x000000e8,
+    0x000000eb, 0x000300f7, 0x000000ed, 0x00000000, 0x000400fa, 0x000000ec, 0x000000ee, 0x000000ed,
+    0x000200f8, 0x000000ee, 0x000100fd, 0x000200f8, 0x000000ed, 0x00050041, 0x00000069, 0x000000ef,
+    0x0000000f, 0x00000030, 0x0004003d, 0x0000001d, 0x000000f0, 0x000000ef, 0x000500ab, 0x0000001b,
+    0x000000f1, 0x000000f0, 0x0000003c, 0x0008004f, 0x00000023, 0x000000f2, 0x000000e3, 0x000000e3,
+    0x00000000, 0x00000001, 0x00000002, 0x0008000c, 0x00000023, 0x000000f3, 0x00000001, 0x0000002b,
+    0x000000f2, 0x00000056, 0x00000057, 0x00050039, 0x00000023, 0x000000f4, 0x00000006, 0x000000f3,
+    0x00050051, 0x0000001e, 0x000000f5, 0x000000e3, 0x00000003, 0x00050050, 0x00000024, 0x000000f6,
+    0x000000f4, 0x000000f5, 0x00070050, 0x00000026, 0x000000f7, 0x000000f1, 0x000000f1, 0x000000f1,
+    0x000000f1, 0x000600a9, 0x00000024, 0x000000f8, 0x000000f7, 0x000000f6, 0x000000e3, 0x00050050,
+    0x00000020, 0x000000f9, 0x000000e1, 0x000000e2, 0x000300f7, 0x000000fa, 0x00000000, 0x001b00fb,
+    0x000000e0, 0x000000fa, 0x00000000, 0x000000fb, 0x00000001, 0x000000fc, 0x00000002, 0x000000fd,
+    0x00000003, 0x000000fe, 0x00000004, 0x000000ff, 0x00000005, 0x00000100, 0x00000006, 0x00000101,
+    0x00000007, 0x00000102, 0x00000008, 0x00000103, 0x00000009, 0x00000104, 0x0000000a, 0x00000105,
+    0x0000000b, 0x00000106, 0x000200f8, 0x000000fb, 0x00050041, 0x00000065, 0x00000107, 0x0000000c,
+    0x0000002e, 0x0004003d, 0x00000062, 0x00000108, 0x00000107, 0x00040063, 0x00000108, 0x000000f9,
+    0x000000f8, 0x000200f9, 0x000000fa, 0x000200f8, 0x000000fc, 0x00050041, 0x00000065, 0x00000109,
+    0x0000000c, 0x0000002f, 0x0004003d, 0x00000062, 0x0000010a, 0x00000109, 0x00040063, 0x0000010a,
+    0x000000f9, 0x000000f8, 0x000200f9, 0x000000fa, 0x000200f8, 0x000000fd, 0x00050041, 0x00000065,
+    0x0000010b, 0x0000000c, 0x00000030, 0x0004003d, 0x00000062, 0x0000010c, 0x0000010b, 0x00040063,
+    0x0000010c, 0x000000f9, 0x000000f8, 0x000200f9, 0x000000fa, 0x000200f8, 0x000000fe, 0x00050041,
+    0x00000065, 0x0000010d, 0x0000000c, 0x00000031, 0x0004003d, 0x00000062, 0x0000010e, 0x0000010d,
+    0x00040063, 0x0000010e, 0x000000f9, 0x000000f8, 0x000200f9, 0x000000fa, 0x000200f8, 0x000000ff,
+    0x00050041, 0x00000065, 0x0000010f, 0x0000000c, 0x00000032, 0x0004003d, 0x00000062, 0x00000110,
+    0x0000010f, 0x00040063, 0x00000110, 0x000000f9, 0x000000f8, 0x000200f9, 0x000000fa, 0x000200f8,
+    0x00000100, 0x00050041, 0x00000065, 0x00000111, 0x0000000c, 0x00000033, 0x0004003d, 0x00000062,
+    0x00000112, 0x00000111, 0x00040063, 0x00000112, 0x000000f9, 0x000000f8, 0x000200f9, 0x000000fa,
+    0x000200f8, 0x00000101, 0x00050041, 0x00000065, 0x00000113, 0x0000000c, 0x00000034, 0x0004003d,
+    0x00000062, 0x00000114, 0x00000113, 0x00040063, 0x00000114, 0x000000f9, 0x000000f8, 0x000200f9,
+    0x000000fa, 0x000200f8, 0x00000102, 0x00050041, 0x00000065, 0x00000115, 0x0000000c, 0x00000035,
+    0x0004003d, 0x00000062, 0x00000116, 0x00000115, 0x00040063, 0x00000116, 0x000000f9, 0x000000f8,
+    0x000200f9, 0x000000fa, 0x000200f8, 0x00000103, 0x00050041, 0x00000065, 0x00000117, 0x0000000c,
+    0x00000036, 0x0004003d, 0x00000062, 0x00000118, 0x00000117, 0x00040063, 0x00000118, 0x000000f9,
+    0x000000f8, 0x000200f9, 0x000000fa, 0x000200f8, 0x00000104, 0x00050041, 0x00000065, 0x00000119,
+    0x0000000c, 0x00000037, 0x0004003d, 0x00000062, 0x0000011a, 0x00000119, 0x00040063, 0x0000011a,
+    0x000000f9, 0x000000f8, 0x000200f9, 0x000000fa, 0x000200f8, 0x00000105, 0x00050041, 0x00000065,
+    0x0000011b, 0x0000000c, 0x00000038, 0x0004003d, 0x00000062, 0x0000011c, 0x0000011b, 0x00040063,
+    0x0000011c, 0x000000f9, 0x000000f8, 0x000200f9, 0x000000fa, 0x000200f8, 0x00000106, 0x00050041,
+    0x00000065, 0x0000011d, 0x0000000c, 0x00000039, 0x0004003d, 0x00000062, 0x0000011e, 0x0000011d,
+    0x00040063, 0x0000011e, 0x000000f9, 0x000000f8, 0x000200f9, 0x000000fa, 0x000200f8, 0x000000fa,
+    0x000100fd, 0x00010038, 0x00050036, 0x00000024, 0x00000009, 0x00000000, 0x0000002a, 0x00030037,
+    0x0000001b, 0x0000011f, 0x00030037, 0x0000001f, 0x00000120, 0x00030037, 0x0000001c, 0x00000121,
+    0x000200f8, 0x00000122, 0x000300f7, 0x00000123, 0x00000000, 0x000400fa, 0x0000011f, 0x00000124,
+    0x00000123, 0x000200f8, 0x00000124, 0x0004003d, 0x00000060, 0x00000125, 0x0000000b, 0x00040064,
+    0x0000005f, 0x00000126, 0x00000125, 0x00050067, 0x00000020, 0x00000127, 0x00000126, 0x0000002e,
+    0x0007004f, 0x0000001f, 0x00000128, 0x00000127, 0x00000127, 0x00000000, 0x00000001, 0x00050082,
+    0x0000001f, 0x00000129, 0x00000128, 0x00000059, 0x0008000c, 0x0000001f, 0x0000012a, 0x00000001,
+    0x0000002d, 0x00000120, 0x00000058, 0x00000129, 0x00050050, 0x00000020, 0x0000012b, 0x0000012a,
+    0x00000121, 0x0007005f, 0x00000024, 0x0000012c, 0x00000126, 0x0000012b, 0x00000002, 0x0000002e,
+    0x000200fe, 0x0000012c, 0x000200f8, 0x00000123, 0x00050041, 0x00000065, 0x0000012d, 0x0000000c,
+    0x00000033, 0x0004003d, 0x00000062, 0x0000012e, 0x0000012d, 0x00040068, 0x00000020, 0x0000012f,
+    0x0000012e, 0x0007004f, 0x0000001f, 0x00000130, 0x0000012f, 0x0000012f, 0x00000000, 0x00000001,
+    0x00050082, 0x0000001f, 0x00000131, 0x00000130, 0x00000059, 0x0008000c, 0x0000001f, 0x00000132,
+    0x00000001, 0x0000002d, 0x00000120, 0x00000058, 0x00000131, 0x00050050, 0x00000020, 0x00000133,
+    0x00000132, 0x00000121, 0x00050062, 0x00000024, 0x00000134, 0x0000012e, 0x00000133, 0x00050041,
+    0x00000069, 0x00000135, 0x0000000f, 0x00000030, 0x0004003d, 0x0000001d, 0x00000136, 0x00000135,
+    0x000500ab, 0x0000001b, 0x00000137, 0x00000136, 0x0000003c, 0x0008004f, 0x00000023, 0x00000138,
+    0x00000134, 0x00000134, 0x00000000, 0x00000001, 0x00000002, 0x00050039, 0x00000023, 0x00000139,
+    0x00000005, 0x00000138, 0x00050051, 0x0000001e, 0x0000013a, 0x00000134, 0x00000003, 0x00050050,
+    0x00000024, 0x0000013b, 0x00000139, 0x0000013a, 0x00070050, 0x00000026, 0x0000013c, 0x00000137,
+    0x00000137, 0x00000137, 0x00000137, 0x000600a9, 0x00000024, 0x0000013d, 0x0000013c, 0x0000013b,
+    0x00000134, 0x000200fe, 0x0000013d, 0x00010038, 0x00050036, 0x00000019, 0x0000000a, 0x00000000,
+    0x0000002b, 0x00030037, 0x0000001f, 0x0000013e, 0x00030037, 0x0000001c, 0x0000013f, 0x00030037,
+    0x0000001c, 0x00000140, 0x00030037, 0x0000001b, 0x00000141, 0x000200f8, 0x00000142, 0x0004003b,
+    0x00000072, 0x00000012, 0x00000007, 0x0004003b, 0x00000074, 0x00000016, 0x00000007, 0x0004003b,
+    0x00000073, 0x00000013, 0x00000007, 0x0004003b, 0x00000074, 0x00000014, 0x00000007, 0x0004003b,
+    0x00000074, 0x00000015, 0x00000007, 0x0004003d, 0x0000001d, 0x00000143, 0x00000003, 0x00050089,
+    0x0000001d, 0x00000144, 0x00000143, 0x00000042, 0x00050086, 0x0000001d, 0x00000145, 0x00000143,
+    0x00000042, 0x0004007c, 0x0000001c, 0x00000146, 0x00000144, 0x0004007c, 0x0000001c, 0x00000147,
+    0x00000145, 0x00050050, 0x0000001f, 0x00000148, 0x00000146, 0x00000147, 0x00050084, 0x0000001f,
+    0x00000149, 0x0000013e, 0x0000005c, 0x00050084, 0x0000001f, 0x0000014a, 0x00000148, 0x0000005a,
+    0x00050080, 0x0000001f, 0x0000014b, 0x00000149, 0x0000014a, 0x0003003e, 0x00000016, 0x0000002e,
+    0x000200f9, 0x0000014c, 0x000200f8, 0x0000014c, 0x000400f6, 0x0000014d, 0x0000014e, 0x00000000,
+    0x000200f9, 0x0000014f, 0x000200f8, 0x0000014f, 0x0004003d, 0x0000001c, 0x00000150, 0x00000016,
+    0x000500b1, 0x0000001b, 0x00000151, 0x00000150, 0x00000032, 0x000400fa, 0x00000151, 0x00000152,
+    0x0000014d, 0x000200f8, 0x00000152, 0x0004003d, 0x0000001c, 0x00000153, 0x00000016, 0x000500c7,
+    0x0000001c, 0x00000154, 0x00000153, 0x0000002f, 0x000500c3, 0x0000001c, 0x00000155, 0x00000153,
+    0x0000002f, 0x00050050, 0x0000001f, 0x00000156, 0x00000154, 0x00000155, 0x00050080, 0x0000001f,
+    0x00000157, 0x0000014b, 0x00000156, 0x00050084, 0x0000001f, 0x00000158, 0x00000157, 0x0000005a,
+    0x00070039, 0x00000024, 0x00000159, 0x00000009, 0x00000141, 0x00000158, 0x0000013f, 0x00050080,
+    0x0000001f, 0x0000015a, 0x00000158, 0x0000005d, 0x00070039, 0x00000024, 0x0000015b, 0x00000009,
+    0x00000141, 0x0000015a, 0x0000013f, 0x00050081, 0x00000024, 0x0000015c, 0x00000159, 0x0000015b,
+    0x00050080, 0x0000001f, 0x0000015d, 0x00000158, 0x0000005e, 0x00070039, 0x00000024, 0x0000015e,
+    0x00000009, 0x00000141, 0x0000015d, 0x0000013f, 0x00050081, 0x00000024, 0x0000015f, 0x0000015c,
+    0x0000015e, 0x00050080, 0x0000001f, 0x00000160, 0x00000158, 0x00000059, 0x00070039, 0x00000024,
+    0x00000161, 0x00000009, 0x00000141, 0x00000160, 0x0000013f, 0x00050081, 0x00000024, 0x00000162,
+    0x0000015f, 0x00000161, 0x0005008e, 0x00000024, 0x00000163, 0x00000162, 0x00000047, 0x00050041,
+    0x00000073, 0x00000164, 0x00000012, 0x00000153, 0x0003003e, 0x00000164, 0x00000163, 0x00080039,
+    0x00000019, 0x00000165, 0x00000008, 0x00000140, 0x00000157, 0x0000013f, 0x00000163, 0x000200f9,
+    0x0000014e, 0x000200f8, 0x0000014e, 0x0004003d, 0x0000001c, 0x00000166, 0x00000016, 0x00050080,
+    0x0000001c, 0x00000167, 0x00000166, 0x0000002f, 0x0003003e, 0x00000016, 0x00000167, 0x000200f9,
+    0x0000014c, 0x000200f8, 0x0000014d, 0x00050041, 0x00000073, 0x00000168, 0x00000012, 0x0000002e,
+    0x0004003d, 0x00000024, 0x00000169, 0x00000168, 0x00050041, 0x00000073, 0x0000016a, 0x00000012,
+    0x0000002f, 0x0004003d, 0x00000024, 0x0000016b, 0x0000016a, 0x00050081, 0x00000024, 0x0000016c,
+    0x00000169, 0x0000016b, 0x00050041, 0x00000073, 0x0000016d, 0x00000012, 0x00000030, 0x0004003d,
+    0x00000024, 0x0000016e, 0x0000016d, 0x00050081, 0x00000024, 0x0000016f, 0x0000016c, 0x0000016e,
+    0x00050041, 0x00000073, 0x00000170, 0x00000012, 0x00000031, 0x0004003d, 0x00000024, 0x00000171,
+    0x00000170, 0x00050081, 0x00000024, 0x00000172, 0x0000016f, 0x00000171, 0x0005008e, 0x00000024,
+    0x00000173, 0x00000172, 0x00000047, 0x0003003e, 0x00000013, 0x00000173, 0x00050080, 0x0000001c,
+    0x00000174, 0x00000140, 0x0000002f, 0x00050084, 0x0000001f, 0x00000175, 0x0000013e, 0x0000005b,
+    0x00050080, 0x0000001f, 0x00000176, 0x00000175, 0x00000148, 0x00080039, 0x00000019, 0x00000177,
+    0x00000008, 0x00000174, 0x00000176, 0x0000013f, 0x00000173, 0x00060041, 0x0000006d, 0x00000178,
+    0x00000010, 0x00000147, 0x00000146, 0x0003003e, 0x00000178, 0x00000173, 0x000400e0, 0x0000003e,
+    0x0000003e, 0x00000043, 0x0003003e, 0x00000014, 0x00000036, 0x00050080, 0x0000001c, 0x00000179,
+    0x00000140, 0x00000030, 0x0003003e, 0x00000015, 0x00000179, 0x000200f9, 0x0000017a, 0x000200f8,
+    0x0000017a, 0x000400f6, 0x0000017b, 0x0000017c, 0x00000000, 0x000200f9, 0x0000017d, 0x000200f8,
+    0x0000017d, 0x0004003d, 0x0000001c, 0x0000017e, 0x00000015, 0x00050080, 0x0000001c, 0x0000017f,
+    0x00000140, 0x00000034, 0x000500b1, 0x0000001b, 0x00000180, 0x0000017e, 0x0000017f, 0x000400fa,
+    0x00000180, 0x00000181, 0x0000017b, 0x000200f8, 0x00000181, 0x0004003d, 0x0000001c, 0x00000182,
+    0x00000014, 0x00050084, 0x0000001c, 0x00000183, 0x00000182, 0x00000182, 0x0004007c, 0x0000001d,
+    0x00000184, 0x00000183, 0x000500b0, 0x0000001b, 0x00000185, 0x00000143, 0x00000184, 0x0004007c,
+    0x0000001c, 0x00000186, 0x00000143, 0x0005008b, 0x0000001c, 0x00000187, 0x00000186, 0x00000182,
+    0x00050087, 0x0000001c, 0x00000188, 0x00000186, 0x00000182, 0x00050050, 0x0000001f, 0x00000189,
+    0x00000187, 0x00000188, 0x000300f7, 0x0000018a, 0x00000000, 0x000400fa, 0x00000185, 0x0000018b,
+    0x0000018a, 0x000200f8, 0x0000018b, 0x00050084, 0x0000001c, 0x0000018c, 0x00000187, 0x00000030,
+    0x00050084, 0x0000001c, 0x0000018d, 0x00000188, 0x00000030, 0x00050080, 0x0000001c, 0x0000018e,
+    0x0000018c, 0x0000002f, 0x00050080, 0x0000001c, 0x0000018f, 0x0000018d, 0x0000002f, 0x00060041,
+    0x0000006d, 0x00000190, 0x00000010, 0x0000018d, 0x0000018c, 0x0004003d, 0x00000024, 0x00000191,
+    0x00000190, 0x00060041, 0x0000006d, 0x00000192, 0x00000010, 0x0000018d, 0x0000018e, 0x0004003d,
+    0x00000024, 0x00000193, 0x00000192, 0x00050081, 0x00000024, 0x00000194, 0x00000191, 0x00000193,
+    0x00060041, 0x0000006d, 0x00000195, 0x00000010, 0x0000018f, 0x0000018c, 0x0004003d, 0x00000024,
+    0x00000196, 0x00000195, 0x00050081, 0x00000024, 0x00000197, 0x00000194, 0x00000196, 0x00060041,
+    0x0000006d, 0x00000198, 0x00000010, 0x0000018f, 0x0000018e, 0x0004003d, 0x00000024, 0x00000199,
+    0x00000198, 0x00050081, 0x00000024, 0x0000019a, 0x00000197, 0x00000199, 0x0005008e, 0x00000024,
+    0x0000019b, 0x0000019a, 0x00000047, 0x0003003e, 0x00000013, 0x0000019b, 0x000200f9, 0x0000018a,
+    0x000200f8, 0x0000018a, 0x000400e0, 0x0000003e, 0x0000003e, 0x00000043, 0x000300f7, 0x0000019c,
+    0x00000000, 0x000400fa, 0x00000185, 0x0000019d, 0x0000019c, 0x000200f8, 0x0000019d, 0x0004003d,
+    0x00000024, 0x0000019e, 0x00000013, 0x00060041, 0x0000006d, 0x0000019f, 0x00000010, 0x00000188,
+    0x00000187, 0x0003003e, 0x0000019f, 0x0000019e, 0x0004003d, 0x0000001c, 0x000001a0, 0x00000015,
+    0x00050050, 0x0000001f, 0x000001a1, 0x00000182, 0x00000182, 0x00050084, 0x0000001f, 0x000001a2,
+    0x0000013e, 0x000001a1, 0x00050080, 0x0000001f, 0x000001a3, 0x000001a2, 0x00000189, 0x00080039,
+    0x00000019, 0x000001a4, 0x00000008, 0x000001a0, 0x000001a3, 0x0000013f, 0x0000019e, 0x000200f9,
+    0x0000019c, 0x000200f8, 0x0000019c, 0x000400e0, 0x0000003e, 0x0000003e, 0x00000043, 0x00050087,
+    0x0000001c, 0x000001a5, 0x00000182, 0x00000030, 0x0003003e, 0x00000014, 0x000001a5, 0x000200f9,
+    0x0000017c, 0x000200f8, 0x0000017c, 0x0004003d, 0x0000001c, 0x000001a6, 0x00000015, 0x00050080,
+    0x0000001c, 0x000001a7, 0x000001a6, 0x0000002f, 0x0003003e, 0x00000015, 0x000001a7, 0x000200f9,
+    0x0000017a, 0x000200f8, 0x0000017b, 0x000100fd, 0x00010038,
+};
+const uint32_t mipmap_downsample_comp_spv_size = 2445;
+#endif // MIPMAP_DOWNSAMPLE_COMP_SPV_H
\ No newline at end of file
@@ -5,61 +5,118 @@
 #include <stdint.h>
 
 const uint32_t sprite_default_frag_spv[] = {
-    0x07230203, 0x00010000, 0x000d000b, 0x0000002c, 0x00000000, 0x00020011, 0x00000001, 0x0006000b,
+    0x07230203, 0x00010000, 0x000d000b, 0x00000075, 0x00000000, 0x00020011, 0x00000001, 0x0006000b,
     0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e, 0x00000000, 0x00000001,
-    0x0007000f, 0x00000004, 0x00000004, 0x6e69616d, 0x00000000, 0x00000011, 0x00000020, 0x00030010,
-    0x00000004, 0x00000007, 0x00030003, 0x00000002, 0x000001cc, 0x000a0004, 0x475f4c47, 0x4c474f4f,
+    0x0007000f, 0x00000004, 0x00000002, 0x6e69616d, 0x00000000, 0x00000003, 0x00000004, 0x00030010,
+    0x00000002, 0x00000007, 0x00030003, 0x00000002, 0x000001cc, 0x000a0004, 0x475f4c47, 0x4c474f4f,
     0x70635f45, 0x74735f70, 0x5f656c79, 0x656e696c, 0x7269645f, 0x69746365, 0x00006576, 0x00080004,
     0x475f4c47, 0x4c474f4f, 0x6e695f45, 0x64756c63, 0x69645f65, 0x74636572, 0x00657669, 0x00040005,
-    0x00000004, 0x6e69616d, 0x00000000, 0x00030005, 0x00000009, 0x00786574, 0x00040005, 0x0000000d,
-    0x65626c61, 0x00006f64, 0x00040005, 0x00000011, 0x755f6e69, 0x00000076, 0x00050005, 0x00000020,
-    0x5f74756f, 0x6f6c6f63, 0x00000072, 0x00050005, 0x00000023, 0x736e6f63, 0x746e6174, 0x00000073,
-    0x00040006, 0x00000023, 0x00000000, 0x00006469, 0x00050006, 0x00000023, 0x00000001, 0x65646f6d,
-    0x0000006c, 0x00050005, 0x00000025, 0x68737570, 0x6e6f635f, 0x00007473, 0x00050005, 0x00000026,
-    0x5f6f6275, 0x656d6163, 0x00006172, 0x00050006, 0x00000026, 0x00000000, 0x77656976, 0x00000000,
-    0x00060006, 0x00000026, 0x00000001, 0x77656976, 0x65766e49, 0x00657372, 0x00050006, 0x00000026,
-    0x00000002, 0x6a6f7270, 0x00000000, 0x00040005, 0x00000028, 0x656d6163, 0x00006172, 0x00050005,
-    0x00000029, 0x5f6f6275, 0x69727073, 0x00006574, 0x00060006, 0x00000029, 0x00000000, 0x725f7675,
-    0x7461746f, 0x006e6f69, 0x00060006, 0x00000029, 0x00000001, 0x6f5f7675, 0x65736666, 0x00000074,
-    0x00060006, 0x00000029, 0x00000002, 0x735f7675, 0x656c6163, 0x00000000, 0x00040005, 0x0000002b,
-    0x69727073, 0x00006574, 0x00040047, 0x0000000d, 0x00000021, 0x00000002, 0x00040047, 0x0000000d,
-    0x00000022, 0x00000000, 0x00040047, 0x00000011, 0x0000001e, 0x00000000, 0x00040047, 0x00000020,
-    0x0000001e, 0x00000000, 0x00030047, 0x00000023, 0x00000002, 0x00050048, 0x00000023, 0x00000000,
-    0x00000023, 0x00000000, 0x00040048, 0x00000023, 0x00000001, 0x00000005, 0x00050048, 0x00000023,
-    0x00000001, 0x00000007, 0x00000010, 0x00050048, 0x00000023, 0x00000001, 0x00000023, 0x00000010,
-    0x00030047, 0x00000026, 0x00000002, 0x00040048, 0x00000026, 0x00000000, 0x00000005, 0x00050048,
-    0x00000026, 0x00000000, 0x00000007, 0x00000010, 0x00050048, 0x00000026, 0x00000000, 0x00000023,
-    0x00000000, 0x00040048, 0x00000026, 0x00000001, 0x00000005, 0x00050048, 0x00000026, 0x00000001,
-    0x00000007, 0x00000010, 0x00050048, 0x00000026, 0x00000001, 0x00000023, 0x00000040, 0x00040048,
-    0x00000026, 0x00000002, 0x00000005, 0x00050048, 0x00000026, 0x00000002, 0x00000007, 0x00000010,
-    0x00050048, 0x00000026, 0x00000002, 0x00000023, 0x00000080, 0x00040047, 0x00000028, 0x00000021,
-    0x00000000, 0x00040047, 0x00000028, 0x00000022, 0x00000000, 0x00030047, 0x00000029, 0x00000002,
-    0x00050048, 0x00000029, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000029, 0x00000001,
-    0x00000023, 0x00000008, 0x00050048, 0x00000029, 0x00000002, 0x00000023, 0x00000010, 0x00040047,
-    0x0000002b, 0x00000021, 0x00000001, 0x00040047, 0x0000002b, 0x00000022, 0x00000000, 0x00020013,
-    0x00000002, 0x00030021, 0x00000003, 0x00000002, 0x00030016, 0x00000006, 0x00000020, 0x00040017,
-    0x00000007, 0x00000006, 0x00000004, 0x00040020, 0x00000008, 0x00000007, 0x00000007, 0x00090019,
-    0x0000000a, 0x00000006, 0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0x00000000,
-    0x0003001b, 0x0000000b, 0x0000000a, 0x00040020, 0x0000000c, 0x00000000, 0x0000000b, 0x0004003b,
-    0x0000000c, 0x0000000d, 0x00000000, 0x00040017, 0x0000000f, 0x00000006, 0x00000002, 0x00040020,
-    0x00000010, 0x00000001, 0x0000000f, 0x0004003b, 0x00000010, 0x00000011, 0x00000001, 0x00040015,
-    0x00000014, 0x00000020, 0x00000000, 0x0004002b, 0x00000014, 0x00000015, 0x00000003, 0x00040020,
-    0x00000016, 0x00000007, 0x00000006, 0x0004002b, 0x00000006, 0x00000019, 0x00000000, 0x00020014,
-    0x0000001a, 0x00040020, 0x0000001f, 0x00000003, 0x00000007, 0x0004003b, 0x0000001f, 0x00000020,
-    0x00000003, 0x00040018, 0x00000022, 0x00000007, 0x00000004, 0x0004001e, 0x00000023, 0x00000014,
-    0x00000022, 0x00040020, 0x00000024, 0x00000009, 0x00000023, 0x0004003b, 0x00000024, 0x00000025,
-    0x00000009, 0x0005001e, 0x00000026, 0x00000022, 0x00000022, 0x00000022, 0x00040020, 0x00000027,
-    0x00000002, 0x00000026, 0x0004003b, 0x00000027, 0x00000028, 0x00000002, 0x0005001e, 0x00000029,
-    0x00000006, 0x0000000f, 0x0000000f, 0x00040020, 0x0000002a, 0x00000002, 0x00000029, 0x0004003b,
-    0x0000002a, 0x0000002b, 0x00000002, 0x00050036, 0x00000002, 0x00000004, 0x00000000, 0x00000003,
-    0x000200f8, 0x00000005, 0x0004003b, 0x00000008, 0x00000009, 0x00000007, 0x0004003d, 0x0000000b,
-    0x0000000e, 0x0000000d, 0x0004003d, 0x0000000f, 0x00000012, 0x00000011, 0x00050057, 0x00000007,
-    0x00000013, 0x0000000e, 0x00000012, 0x0003003e, 0x00000009, 0x00000013, 0x00050041, 0x00000016,
-    0x00000017, 0x00000009, 0x00000015, 0x0004003d, 0x00000006, 0x00000018, 0x00000017, 0x000500b4,
-    0x0000001a, 0x0000001b, 0x00000018, 0x00000019, 0x000300f7, 0x0000001d, 0x00000000, 0x000400fa,
-    0x0000001b, 0x0000001c, 0x0000001d, 0x000200f8, 0x0000001c, 0x000100fc, 0x000200f8, 0x0000001d,
-    0x0004003d, 0x00000007, 0x00000021, 0x00000009, 0x0003003e, 0x00000020, 0x00000021, 0x000100fd,
+    0x00000002, 0x6e69616d, 0x00000000, 0x00080005, 0x00000005, 0x636e7566, 0x746f725f, 0x5f657461,
+    0x76287675, 0x663b3266, 0x00003b31, 0x00030005, 0x00000006, 0x00007675, 0x00040005, 0x00000007,
+    0x6c676e61, 0x00000065, 0x000b0005, 0x00000008, 0x636e7566, 0x6172745f, 0x6f66736e, 0x755f6d72,
+    0x66762876, 0x66763b32, 0x66763b32, 0x31663b32, 0x0000003b, 0x00030005, 0x00000009, 0x00007675,
+    0x00040005, 0x0000000a, 0x7366666f, 0x00007465, 0x00040005, 0x0000000b, 0x6c616373, 0x00000065,
+    0x00040005, 0x0000000c, 0x6c676e61, 0x00000065, 0x00040005, 0x0000000d, 0x746e6563, 0x00007265,
+    0x00040005, 0x0000000e, 0x736f6378, 0x00000000, 0x00040005, 0x0000000f, 0x6e697378, 0x00000000,
+    0x00030005, 0x00000010, 0x00746f72, 0x00040005, 0x00000011, 0x61726170, 0x0000006d, 0x00040005,
+    0x00000012, 0x61726170, 0x0000006d, 0x00060005, 0x00000013, 0x6e617274, 0x726f6673, 0x5f64656d,
+    0x00007675, 0x00040005, 0x00000003, 0x755f6e69, 0x00000076, 0x00050005, 0x00000014, 0x5f6f6275,
+    0x69727073, 0x00006574, 0x00060006, 0x00000014, 0x00000000, 0x725f7675, 0x7461746f, 0x006e6f69,
+    0x00060006, 0x00000014, 0x00000001, 0x6f5f7675, 0x65736666, 0x00000074, 0x00060006, 0x00000014,
+    0x00000002, 0x735f7675, 0x656c6163, 0x00000000, 0x00040005, 0x00000015, 0x69727073, 0x00006574,
+    0x00040005, 0x00000016, 0x61726170, 0x0000006d, 0x00040005, 0x00000017, 0x61726170, 0x0000006d,
+    0x00040005, 0x00000018, 0x61726170, 0x0000006d, 0x00040005, 0x00000019, 0x61726170, 0x0000006d,
+    0x00030005, 0x0000001a, 0x00786574, 0x00040005, 0x0000001b, 0x65626c61, 0x00006f64, 0x00050005,
+    0x00000004, 0x5f74756f, 0x6f6c6f63, 0x00000072, 0x00050005, 0x0000001c, 0x736e6f63, 0x746e6174,
+    0x00000073, 0x00040006, 0x0000001c, 0x00000000, 0x00006469, 0x00050006, 0x0000001c, 0x00000001,
+    0x65646f6d, 0x0000006c, 0x00050005, 0x0000001d, 0x68737570, 0x6e6f635f, 0x00007473, 0x00050005,
+    0x0000001e, 0x5f6f6275, 0x656d6163, 0x00006172, 0x00050006, 0x0000001e, 0x00000000, 0x77656976,
+    0x00000000, 0x00060006, 0x0000001e, 0x00000001, 0x77656976, 0x65766e49, 0x00657372, 0x00050006,
+    0x0000001e, 0x00000002, 0x6a6f7270, 0x00000000, 0x00040005, 0x0000001f, 0x656d6163, 0x00006172,
+    0x00040047, 0x00000003, 0x0000001e, 0x00000000, 0x00030047, 0x00000014, 0x00000002, 0x00050048,
+    0x00000014, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000014, 0x00000001, 0x00000023,
+    0x00000008, 0x00050048, 0x00000014, 0x00000002, 0x00000023, 0x00000010, 0x00040047, 0x00000015,
+    0x00000021, 0x00000001, 0x00040047, 0x00000015, 0x00000022, 0x00000000, 0x00040047, 0x0000001b,
+    0x00000021, 0x00000002, 0x00040047, 0x0000001b, 0x00000022, 0x00000000, 0x00040047, 0x00000004,
+    0x0000001e, 0x00000000, 0x00030047, 0x0000001c, 0x00000002, 0x00050048, 0x0000001c, 0x00000000,
+    0x00000023, 0x00000000, 0x00040048, 0x0000001c, 0x00000001, 0x00000005, 0x00050048, 0x0000001c,
+    0x00000001, 0x00000007, 0x00000010, 0x00050048, 0x0000001c, 0x00000001, 0x00000023, 0x00000010,
+    0x00030047, 0x0000001e, 0x00000002, 0x00040048, 0x0000001e, 0x00000000, 0x00000005, 0x00050048,
+    0x0000001e, 0x00000000, 0x00000007, 0x00000010, 0x00050048, 0x0000001e, 0x00000000, 0x00000023,
+    0x00000000, 0x00040048, 0x0000001e, 0x00000001, 0x00000005, 0x00050048, 0x0000001e, 0x00000001,
+    0x00000007, 0x00000010, 0x00050048, 0x0000001e, 0x00000001, 0x00000023, 0x00000040, 0x00040048,
+    0x0000001e, 0x00000002, 0x00000005, 0x00050048, 0x0000001e, 0x00000002, 0x00000007, 0x00000010,
+    0x00050048, 0x0000001e, 0x00000002, 0x00000023, 0x00000080, 0x00040047, 0x0000001f, 0x00000021,
+    0x00000000, 0x00040047, 0x0000001f, 0x00000022, 0x00000000, 0x00020013, 0x00000020, 0x00030021,
+    0x00000021, 0x00000020, 0x00030016, 0x00000022, 0x00000020, 0x00040017, 0x00000023, 0x00000022,
+    0x00000002, 0x00040020, 0x00000024, 0x00000007, 0x00000023, 0x00040020, 0x00000025, 0x00000007,
+    0x00000022, 0x00050021, 0x00000026, 0x00000023, 0x00000024, 0x00000025, 0x00070021, 0x00000027,
+    0x00000023, 0x00000024, 0x00000024, 0x00000024, 0x00000025, 0x0004002b, 0x00000022, 0x00000028,
+    0x3f000000, 0x0005002c, 0x00000023, 0x00000029, 0x00000028, 0x00000028, 0x00040018, 0x0000002a,
+    0x00000023, 0x00000002, 0x00040020, 0x0000002b, 0x00000007, 0x0000002a, 0x0004002b, 0x00000022,
+    0x0000002c, 0x00000000, 0x00040020, 0x0000002d, 0x00000001, 0x00000023, 0x0004003b, 0x0000002d,
+    0x00000003, 0x00000001, 0x0005001e, 0x00000014, 0x00000022, 0x00000023, 0x00000023, 0x00040020,
+    0x0000002e, 0x00000002, 0x00000014, 0x0004003b, 0x0000002e, 0x00000015, 0x00000002, 0x00040015,
+    0x0000002f, 0x00000020, 0x00000001, 0x0004002b, 0x0000002f, 0x00000030, 0x00000001, 0x00040020,
+    0x00000031, 0x00000002, 0x00000023, 0x0004002b, 0x0000002f, 0x00000032, 0x00000002, 0x0004002b,
+    0x0000002f, 0x00000033, 0x00000000, 0x00040020, 0x00000034, 0x00000002, 0x00000022, 0x00040017,
+    0x00000035, 0x00000022, 0x00000004, 0x00040020, 0x00000036, 0x00000007, 0x00000035, 0x00090019,
+    0x00000037, 0x00000022, 0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0x00000000,
+    0x0003001b, 0x00000038, 0x00000037, 0x00040020, 0x00000039, 0x00000000, 0x00000038, 0x0004003b,
+    0x00000039, 0x0000001b, 0x00000000, 0x00040015, 0x0000003a, 0x00000020, 0x00000000, 0x0004002b,
+    0x0000003a, 0x0000003b, 0x00000003, 0x00020014, 0x0000003c, 0x00040020, 0x0000003d, 0x00000003,
+    0x00000035, 0x0004003b, 0x0000003d, 0x00000004, 0x00000003, 0x00040018, 0x0000003e, 0x00000035,
+    0x00000004, 0x0004001e, 0x0000001c, 0x0000003a, 0x0000003e, 0x00040020, 0x0000003f, 0x00000009,
+    0x0000001c, 0x0004003b, 0x0000003f, 0x0000001d, 0x00000009, 0x0005001e, 0x0000001e, 0x0000003e,
+    0x0000003e, 0x0000003e, 0x00040020, 0x00000040, 0x00000002, 0x0000001e, 0x0004003b, 0x00000040,
+    0x0000001f, 0x00000002, 0x00050036, 0x00000020, 0x00000002, 0x00000000, 0x00000021, 0x000200f8,
+    0x00000041, 0x0004003b, 0x00000024, 0x00000013, 0x00000007, 0x0004003b, 0x00000024, 0x00000016,
+    0x00000007, 0x0004003b, 0x00000024, 0x00000017, 0x00000007, 0x0004003b, 0x00000024, 0x00000018,
+    0x00000007, 0x0004003b, 0x00000025, 0x00000019, 0x00000007, 0x0004003b, 0x00000036, 0x0000001a,
+    0x00000007, 0x0004003d, 0x00000023, 0x00000042, 0x00000003, 0x0003003e, 0x00000016, 0x00000042,
+    0x00050041, 0x00000031, 0x00000043, 0x00000015, 0x00000030, 0x0004003d, 0x00000023, 0x00000044,
+    0x00000043, 0x0003003e, 0x00000017, 0x00000044, 0x00050041, 0x00000031, 0x00000045, 0x00000015,
+    0x00000032, 0x0004003d, 0x00000023, 0x00000046, 0x00000045, 0x0003003e, 0x00000018, 0x00000046,
+    0x00050041, 0x00000034, 0x00000047, 0x00000015, 0x00000033, 0x0004003d, 0x00000022, 0x00000048,
+    0x00000047, 0x0006000c, 0x00000022, 0x00000049, 0x00000001, 0x0000000b, 0x00000048, 0x0003003e,
+    0x00000019, 0x00000049, 0x00080039, 0x00000023, 0x0000004a, 0x00000008, 0x00000016, 0x00000017,
+    0x00000018, 0x00000019, 0x0003003e, 0x00000013, 0x0000004a, 0x0004003d, 0x00000038, 0x0000004b,
+    0x0000001b, 0x0004003d, 0x00000023, 0x0000004c, 0x00000013, 0x00050057, 0x00000035, 0x0000004d,
+    0x0000004b, 0x0000004c, 0x0003003e, 0x0000001a, 0x0000004d, 0x00050041, 0x00000025, 0x0000004e,
+    0x0000001a, 0x0000003b, 0x0004003d, 0x00000022, 0x0000004f, 0x0000004e, 0x000500b4, 0x0000003c,
+    0x00000050, 0x0000004f, 0x0000002c, 0x000300f7, 0x00000051, 0x00000000, 0x000400fa, 0x00000050,
+    0x00000052, 0x00000051, 0x000200f8, 0x00000052, 0x000100fc, 0x000200f8, 0x00000051, 0x0004003d,
+    0x00000035, 0x00000053, 0x0000001a, 0x0003003e, 0x00000004, 0x00000053, 0x000100fd, 0x00010038,
+    0x00050036, 0x00000023, 0x00000005, 0x00000000, 0x00000026, 0x00030037, 0x00000024, 0x00000006,
+    0x00030037, 0x00000025, 0x00000007, 0x000200f8, 0x00000054, 0x0004003b, 0x00000024, 0x0000000d,
+    0x00000007, 0x0004003b, 0x00000025, 0x0000000e, 0x00000007, 0x0004003b, 0x00000025, 0x0000000f,
+    0x00000007, 0x0004003b, 0x0000002b, 0x00000010, 0x00000007, 0x0003003e, 0x0000000d, 0x00000029,
+    0x0004003d, 0x00000023, 0x00000055, 0x0000000d, 0x0004003d, 0x00000023, 0x00000056, 0x00000006,
+    0x00050083, 0x00000023, 0x00000057, 0x00000056, 0x00000055, 0x0003003e, 0x00000006, 0x00000057,
+    0x0004003d, 0x00000022, 0x00000058, 0x00000007, 0x0006000c, 0x00000022, 0x00000059, 0x00000001,
+    0x0000000e, 0x00000058, 0x0003003e, 0x0000000e, 0x00000059, 0x0004003d, 0x00000022, 0x0000005a,
+    0x00000007, 0x0006000c, 0x00000022, 0x0000005b, 0x00000001, 0x0000000d, 0x0000005a, 0x0003003e,
+    0x0000000f, 0x0000005b, 0x0004003d, 0x00000022, 0x0000005c, 0x0000000e, 0x0004003d, 0x00000022,
+    0x0000005d, 0x0000000f, 0x0004007f, 0x00000022, 0x0000005e, 0x0000005d, 0x0004003d, 0x00000022,
+    0x0000005f, 0x0000000f, 0x0004003d, 0x00000022, 0x00000060, 0x0000000e, 0x00050050, 0x00000023,
+    0x00000061, 0x0000005c, 0x0000005e, 0x00050050, 0x00000023, 0x00000062, 0x0000005f, 0x00000060,
+    0x00050050, 0x0000002a, 0x00000063, 0x00000061, 0x00000062, 0x0003003e, 0x00000010, 0x00000063,
+    0x0004003d, 0x0000002a, 0x00000064, 0x00000010, 0x0004003d, 0x00000023, 0x00000065, 0x00000006,
+    0x00050091, 0x00000023, 0x00000066, 0x00000064, 0x00000065, 0x0003003e, 0x00000006, 0x00000066,
+    0x0004003d, 0x00000023, 0x00000067, 0x0000000d, 0x0004003d, 0x00000023, 0x00000068, 0x00000006,
+    0x00050081, 0x00000023, 0x00000069, 0x00000068, 0x00000067, 0x0003003e, 0x00000006, 0x00000069,
+    0x0004003d, 0x00000023, 0x0000006a, 0x00000006, 0x000200fe, 0x0000006a, 0x00010038, 0x00050036,
+    0x00000023, 0x00000008, 0x00000000, 0x00000027, 0x00030037, 0x00000024, 0x00000009, 0x00030037,
+    0x00000024, 0x0000000a, 0x00030037, 0x00000024, 0x0000000b, 0x00030037, 0x00000025, 0x0000000c,
+    0x000200f8, 0x0000006b, 0x0004003b, 0x00000024, 0x00000011, 0x00000007, 0x0004003b, 0x00000025,
+    0x00000012, 0x00000007, 0x0004003d, 0x00000023, 0x0000006c, 0x00000009, 0x0003003e, 0x00000011,
+    0x0000006c, 0x0004003d, 0x00000022, 0x0000006d, 0x0000000c, 0x0003003e, 0x00000012, 0x0000006d,
+    0x00060039, 0x00000023, 0x0000006e, 0x00000005, 0x00000011, 0x00000012, 0x0003003e, 0x00000009,
+    0x0000006e, 0x0004003d, 0x00000023, 0x0000006f, 0x00000009, 0x0004003d, 0x00000023, 0x00000070,
+    0x0000000a, 0x00050081, 0x00000023, 0x00000071, 0x0000006f, 0x00000070, 0x0004003d, 0x00000023,
+    0x00000072, 0x0000000b, 0x00050085, 0x00000023, 0x00000073, 0x00000071, 0x00000072, 0x0003003e,
+    0x00000009, 0x00000073, 0x0004003d, 0x00000023, 0x00000074, 0x00000009, 0x000200fe, 0x00000074,
     0x00010038,
 };
-const uint32_t sprite_default_frag_spv_size = 433;
+const uint32_t sprite_default_frag_spv_size = 889;
 #endif // SPRITE_DEFAULT_FRAG_SPV_H
\ No newline at end of file
@@ -2,6 +2,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Context
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -270,41 +274,142 @@ CTOOLBOX_API bool darray_empty(const darray *array)
 // ID Generator
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// macros for bit manipulation
+#define BIT_INDEX(id, base)   ((id) - (base))
+#define IDGEN_MAX_LEVELS      6           // 64^6 words covers the whole uint32_t range
+#define IDGEN_NONE            UINT32_MAX
+
 struct idgen
 {
     uint32_t current_id;
     uint32_t start_id;
     uint32_t max_id;
     uint32_t count;
-    uint32_t bitset_size;     // number of uint32_t words
-    uint32_t* used_bits;      // bitset representing used IDs
+    uint32_t level_count;                   // levels needed to summarize the whole id range into a single word
+    uint32_t word_counts[IDGEN_MAX_LEVELS]; // words allocated per level, level 0 grows lazily and the others follow it
+    uint64_t* levels[IDGEN_MAX_LEVELS];     // level 0 has a bit per id, a bit of level k is set when its word on level k - 1 is full
     const ctoolbox_memfuncs* memfuncs;
 };
 
-// macros for bit manipulation
-#define BIT_INDEX(id, base)   ((id) - (base))
-#define BIT_WORD(i)           ((i) >> 5)          // divide by 32
-#define BIT_MASK(i)           (1u << ((i) & 31u))
+/// @brief index of the lowest set bit, value must not be 0
+static inline uint32_t idgen_ctz64(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return (uint32_t)index;
+#else
+    uint32_t index = 0;
+    while (!(value & 1u)) { value >>= 1; index++; }
+    return index;
+#endif
+}
 
-static inline bool bit_test(uint32_t* bits, uint32_t bitset_size, uint32_t idx)
+/// @brief how many bits of a level are meaningful, the ones past it belong to words that don't exist
+static inline uint32_t idgen_level_bits(const idgen* gen, uint32_t level)
 {
-    uint32_t word = BIT_WORD(idx);
-    if (word >= bitset_size) return false;
-    return bits[word] & BIT_MASK(idx);
+    return level == 0 ? gen->word_counts[0] * 64u : gen->word_counts[level - 1];
+}
+
+/// @brief finds the first clear bit at or after pos on a level, full words are skipped through the level above
+static uint32_t idgen_find_clear(const idgen* gen, uint32_t level, uint32_t pos)
+{
+    uint32_t bits = idgen_level_bits(gen, level);
+    if (pos >= bits) return IDGEN_NONE;
+
+    uint32_t word = pos >> 6;
+    uint64_t clear = ~gen->levels[level][word] & (~0ull << (pos & 63u));
+    if (clear) {
+        uint32_t index = (word << 6) + idgen_ctz64(clear);
+        return index < bits ? index : IDGEN_NONE;
+    }
+
+    if (level + 1 >= gen->level_count) return IDGEN_NONE;
+
+    uint32_t next = idgen_find_clear(gen, level + 1, word + 1);
+    if (next == IDGEN_NONE) return IDGEN_NONE;
+
+    uint32_t index = (next << 6) + idgen_ctz64(~gen->levels[level][next]);
+    return index < bits ? index : IDGEN_NONE;
 }
 
-static inline void bit_set(uint32_t* bits, uint32_t bitset_size, uint32_t idx)
+/// @brief marks a bit as used, a word that fills up is marked on the level above
+static void idgen_bit_set(idgen* gen, uint32_t idx)
 {
-    uint32_t word = BIT_WORD(idx);
-    if (word >= bitset_size) return;
-    bits[word] |= BIT_MASK(idx);
+    for (uint32_t level = 0; level < gen->level_count; level++) {
+        uint64_t* word = &gen->levels[level][idx >> 6];
+        *word |= 1ull << (idx & 63u);
+        if (*word != ~0ull) return;
+        idx >>= 6;
+    }
+}
+
+/// @brief marks a bit as free, a word that stops being full is unmarked on the level above
+static void idgen_bit_clear(idgen* gen, uint32_t idx)
+{
+    for (uint32_t level = 0; level < gen->level_count; level++) {
+        uint64_t* word = &gen->levels[level][idx >> 6];
+        bool was_full = *word == ~0ull;
+        *word &= ~(1ull << (idx & 63u));
+        if (!was_full) return;
+        idx >>= 6;
+    }
+}
+
+static inline bool idgen_bit_test(const idgen* gen, uint32_t idx)
+{
+    if (idx >= gen->word_counts[0] * 64u) return false;
+    return (gen->levels[0][idx >> 6] >> (idx & 63u)) & 1u;
+}
+
+/// @brief grows the bitset so idx is addressable, doubling to keep growth amortized, returns false when out of memory
+static bool idgen_reserve(idgen* gen, uint32_t idx)
+{
+    uint32_t needed = (idx >> 6) + 1;
+    if (needed <= gen->word_counts[0]) return true;
+
+    uint32_t max_words = (gen->max_id - gen->start_id + 63u) / 64u;
+    uint32_t words = gen->word_counts[0] ? gen->word_counts[0] : IDGEN_INITIAL_WORDS;
+    while (words < needed) words *= 2;
+    if (words > max_words) words = max_words;
+
+    for (uint32_t level = 0; level < gen->level_count; level++) {
+        uint64_t* grown = ctoolbox_custom_realloc(gen->memfuncs, gen->levels[level], words * sizeof(uint64_t));
+        if (!grown) return false;
+
+        memset(grown + gen->word_counts[level], 0, (words - gen->word_counts[level]) * sizeof(uint64_t));
+        gen->levels[level] = grown;
+        gen->word_counts[level] = words;
+        words = (words + 63u) / 64u;
+    }
+
+    return true;
 }
 
-static inline void bit_clear(uint32_t* bits, uint32_t bitset_size, uint32_t idx)
+/// @brief takes the first free id after the cursor, then the first never allocated one, then wraps around
+static bool idgen_acquire(idgen* gen, uint32_t* out_id)
 {
-    uint32_t word = BIT_WORD(idx);
-    if (word >= bitset_size) return;
-    bits[word] &= ~BIT_MASK(idx);
+    uint32_t range = gen->max_id - gen->start_id;
+    uint32_t from = gen->current_id - gen->start_id;
+
+    // bits past the range pad the last word, landing on one counts as reaching the end
+    uint32_t idx = idgen_find_clear(gen, 0, from);
+    if (idx == IDGEN_NONE || idx >= range) {
+        uint32_t allocated = gen->word_counts[0] * 64u;
+        idx = allocated < range ? (from > allocated ? from : allocated) : idgen_find_clear(gen, 0, 0);
+    }
+
+    if (idx == IDGEN_NONE || idx >= range || !idgen_reserve(gen, idx)) return false;
+
+    idgen_bit_set(gen, idx);
+    gen->count++;
+    gen->current_id = gen->start_id + idx + 1;
+    if (gen->current_id >= gen->max_id) gen->current_id = gen->start_id;
+
+    *out_id = gen->start_id + idx;
+    return true;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -330,18 +435,19 @@ CTOOLBOX_API idgen* idgen_create_memfuncs(uint32_t start_id, const ctoolbox_memf
     gen->max_id = IDGEN_MAX_SAFE_IDS;
     gen->memfuncs = actual_memfuncs;
 
-    gen->bitset_size = (IDGEN_MAX_SAFE_IDS + 31u) / 32u;
-    if (gen->bitset_size == 0) {
-        gen->bitset_size = 1;
+    // one level per factor of 64 until the whole range fits a single summary word
+    uint32_t words = (gen->max_id - gen->start_id + 63u) / 64u;
+    gen->level_count = 1;
+    while (words > 1 && gen->level_count < IDGEN_MAX_LEVELS) {
+        words = (words + 63u) / 64u;
+        gen->level_count++;
     }
 
-    gen->used_bits = ctoolbox_custom_malloc(actual_memfuncs, gen->bitset_size * sizeof(uint32_t));
-    if (!gen->used_bits) {
-        ctoolbox_custom_free(actual_memfuncs, gen);
+    if (!idgen_reserve(gen, 0)) {
+        idgen_destroy(gen);
         return NULL;
     }
 
-    memset(gen->used_bits, 0, gen->bitset_size * sizeof(uint32_t));
     return gen;
 }
 
@@ -349,31 +455,30 @@ void idgen_destroy(idgen* gen)
 {
     if (!gen) return;
     const ctoolbox_memfuncs* mem = gen->memfuncs;
-    if (gen->used_bits) ctoolbox_custom_free(mem, gen->used_bits);
+    for (uint32_t level = 0; level < gen->level_count; level++) {
+        if (gen->levels[level]) ctoolbox_custom_free(mem, gen->levels[level]);
+    }
     ctoolbox_custom_free(mem, gen);
 }
 
 CTOOLBOX_API uint32_t idgen_next(idgen* gen)
 {
-    if (!gen) return 0;
+    uint32_t id = 0;
+    if (!gen || !idgen_acquire(gen, &id)) return 0;
+    return id;
+}
+
+CTOOLBOX_API uint32_t idgen_next_n(idgen* gen, uint32_t count, uint32_t* out_ids)
+{
+    if (!gen || !out_ids) return 0;
 
-    uint32_t range = gen->max_id - gen->start_id;
-    for (uint32_t i = 0; i < range; i++) {
-        uint32_t candidate = gen->current_id + i;
-        if (candidate >= gen->max_id)
-            candidate = gen->start_id + (candidate - gen->max_id);
-
-        uint32_t idx = BIT_INDEX(candidate, gen->start_id);
-        if (!bit_test(gen->used_bits, gen->bitset_size, idx)) {  // Add bounds check
-            bit_set(gen->used_bits, gen->bitset_size, idx);      // Add bounds check
-            gen->count++;
-            gen->current_id = candidate + 1;
-            if (gen->current_id >= gen->max_id)
-                gen->current_id = gen->start_id;
-            return candidate;
-        }
+    // after the first lookup the next free id is on the same word or one the summary points to, so it's a ctz away
+    uint32_t generated = 0;
+    while (generated < count && idgen_acquire(gen, &out_ids[generated])) {
+        generated++;
     }
-    return 0;
+
+    return generated;
 }
 
 CTOOLBOX_API bool idgen_register(idgen* gen, uint32_t id)
@@ -381,9 +486,10 @@ CTOOLBOX_API bool idgen_register(idgen* gen, uint32_t id)
     if (!gen || id < gen->start_id || id >= gen->max_id) return false;
 
     uint32_t idx = BIT_INDEX(id, gen->start_id);
-    if (bit_test(gen->used_bits, gen->bitset_size, idx)) return false;  // Add bounds check
+    if (idgen_bit_test(gen, idx)) return false;
+    if (!idgen_reserve(gen, idx)) return false;
 
-    bit_set(gen->used_bits, gen->bitset_size, idx);  // Add bounds check
+    idgen_bit_set(gen, idx);
     gen->count++;
     return true;
 }
@@ -393,9 +499,9 @@ CTOOLBOX_API bool idgen_unregister(idgen* gen, uint32_t id)
     if (!gen || id < gen->start_id || id >= gen->max_id) return false;
 
     uint32_t idx = BIT_INDEX(id, gen->start_id);
-    if (!bit_test(gen->used_bits, gen->bitset_size, idx)) return false;
+    if (!idgen_bit_test(gen, idx)) return false;
 
-    bit_clear(gen->used_bits, gen->bitset_size, idx);
+    idgen_bit_clear(gen, idx);
     gen->count--;
 
     // move current_id back for better reuse
@@ -408,7 +514,7 @@ CTOOLBOX_API bool idgen_is_registered(idgen* gen, uint32_t id)
 {
     if (!gen || id < gen->start_id || id >= gen->max_id) return false;
     uint32_t idx = BIT_INDEX(id, gen->start_id);
-    return bit_test(gen->used_bits, gen->bitset_size, idx);
+    return idgen_bit_test(gen, idx);
 }
 
 CTOOLBOX_API uint32_t idgen_count(idgen* gen)
@@ -419,13 +525,15 @@ CTOOLBOX_API uint32_t idgen_count(idgen* gen)
 CTOOLBOX_API void idgen_reset(idgen* gen)
 {
     if (!gen) return;
-    memset(gen->used_bits, 0, gen->bitset_size * sizeof(uint32_t));
+    for (uint32_t level = 0; level < gen->level_count; level++) {
+        memset(gen->levels[level], 0, gen->word_counts[level] * sizeof(uint64_t));
+    }
     gen->count = 0;
     gen->current_id = gen->start_id;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// Static Hashtable
+// String Hashtable
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -434,42 +542,160 @@ CTOOLBOX_API void idgen_reset(idgen* gen)
 
 struct shash 
 {
-    char* key;
+    uint64_t hash;          // full hash, compared before the keys
+    const char* key;        // interned into the table's arena
     void* value;
-    struct shash* next;
+    uint32_t distance;      // how far from it's home slot plus one, 0 marks an empty slot
 };
 
+/// @brief a block of interned keys, blocks are released when the table compacts it's keys or is destroyed
+typedef struct shash_arena_block
+{
+    struct shash_arena_block* next;
+    size_t used;
+    size_t capacity;
+    char data[];
+} shash_arena_block;
+
 struct shashtable
 {
-    shash* buckets[SHASHTABLE_SIZE];
+    shash* slots;
+    size_t capacity;        // always a power of two
+    size_t count;
+    shash_arena_block* arena;
+    size_t keyBytes;        // bytes of live and deleted keys held by the arena
+    size_t liveKeyBytes;    // bytes of the keys still in the table
     ctoolbox_memfuncs memfuncs;
-    size_t count;  // Track total entries
 };
 
-CTOOLBOX_API unsigned long shash_djb2_hash(const char *str)
+/// @brief fnv-1a with a final avalanche, so the low bits used to pick a slot depend on every character
+static uint64_t shash_hash(const char* str)
 {
-    unsigned long hash = 5381;
-    int c;
+    uint64_t hash = 14695981039346656037ULL;
+    while (*str) {
+        hash ^= (unsigned char)*str++;
+        hash *= 1099511628211ULL;
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
 
-    while ((c = *str++)) {
-        hash = (hash << 5) + hash + c;  // hash * 33 + c (original djb2)
-        hash ^= (hash << 7) | (hash >> (sizeof(hash) * 8 - 7)); // additional mixing
+/// @brief copies a key into the arena, keys of deleted entries are reclaimed by shash_compact
+static const char* shash_intern(shashtable* table, const char* key)
+{
+    size_t len = strlen(key) + 1;
+    shash_arena_block* block = table->arena;
+
+    if (!block || block->capacity - block->used < len) {
+        size_t capacity = len > SHASHTABLE_ARENA_BLOCK_SIZE ? len : SHASHTABLE_ARENA_BLOCK_SIZE;
+        block = (shash_arena_block*)ctoolbox_custom_malloc(&table->memfuncs, sizeof(shash_arena_block) + capacity);
+        if (!block) return NULL;
+
+        block->used = 0;
+        block->capacity = capacity;
+        block->next = table->arena;
+        table->arena = block;
     }
 
-    return hash % SHASHTABLE_SIZE;
+    char* str = block->data + block->used;
+    memcpy(str, key, len);
+    block->used += len;
+    table->keyBytes += len;
+    table->liveKeyBytes += len;
+    return str;
 }
 
-CTOOLBOX_API ctoolbox_result shash_strdup(const ctoolbox_memfuncs* fun, const char* src, char** output)
+/// @brief copies the live keys into a single fresh block and releases the old ones, a failed allocation keeps the old arena
+static void shash_compact(shashtable* table)
 {
-    if (!fun || !src || !output) return CTOOLBOX_ERROR_INVALID_PARAM;
-    
-    size_t len = strlen(src);
-    char* str = (char*)ctoolbox_custom_malloc(fun, len + 1);
-    if (!str) return CTOOLBOX_ERROR_MEMORY_ALLOC;
-    
-    memcpy(str, src, len + 1);
-    *output = str;
-    
+    size_t capacity = table->liveKeyBytes > SHASHTABLE_ARENA_BLOCK_SIZE ? table->liveKeyBytes : SHASHTABLE_ARENA_BLOCK_SIZE;
+    shash_arena_block* fresh = (shash_arena_block*)ctoolbox_custom_malloc(&table->memfuncs, sizeof(shash_arena_block) + capacity);
+    if (!fresh) return;
+
+    fresh->used = 0;
+    fresh->capacity = capacity;
+    fresh->next = NULL;
+
+    for (size_t i = 0; i < table->capacity; i++) {
+        shash* slot = &table->slots[i];
+        if (slot->distance == 0) continue;
+
+        size_t len = strlen(slot->key) + 1;
+        memcpy(fresh->data + fresh->used, slot->key, len);
+        slot->key = fresh->data + fresh->used;
+        fresh->used += len;
+    }
+
+    shash_arena_block* block = table->arena;
+    while (block) {
+        shash_arena_block* next = block->next;
+        ctoolbox_custom_free(&table->memfuncs, block);
+        block = next;
+    }
+
+    table->arena = fresh;
+    table->keyBytes = fresh->used;
+}
+
+/// @brief robin hood placement, an entry takes the slot of any entry closer to it's home and carries that one forward
+static void shash_place(shash* slots, size_t capacity, shash entry)
+{
+    size_t mask = capacity - 1;
+    size_t index = (size_t)entry.hash & mask;
+    entry.distance = 1;
+
+    for (;;) {
+        shash* slot = &slots[index];
+        if (slot->distance == 0) {
+            *slot = entry;
+            return;
+        }
+
+        if (slot->distance < entry.distance) {
+            shash displaced = *slot;
+            *slot = entry;
+            entry = displaced;
+        }
+
+        index = (index + 1) & mask;
+        entry.distance++;
+    }
+}
+
+/// @brief returns the slot holding key, or NULL, probing stops once the slots are closer to their home than the key would be
+static shash* shash_find(const shashtable* table, const char* key, uint64_t hash)
+{
+    if (table->count == 0) return NULL;
+
+    size_t mask = table->capacity - 1;
+    size_t index = (size_t)hash & mask;
+
+    for (uint32_t distance = 1; ; distance++) {
+        shash* slot = &table->slots[index];
+        if (slot->distance < distance) return NULL;
+        if (slot->hash == hash && strcmp(slot->key, key) == 0) return slot;
+        index = (index + 1) & mask;
+    }
+}
+
+/// @brief moves every entry into a slot array of the new capacity, keys stay where they are in the arena
+static ctoolbox_result shash_resize(shashtable* table, size_t capacity)
+{
+    shash* slots = (shash*)ctoolbox_custom_calloc(&table->memfuncs, capacity, sizeof(shash));
+    if (!slots) return CTOOLBOX_ERROR_MEMORY_ALLOC;
+
+    for (size_t i = 0; i < table->capacity; i++) {
+        if (table->slots[i].distance != 0) shash_place(slots, capacity, table->slots[i]);
+    }
+
+    ctoolbox_custom_free(&table->memfuncs, table->slots);
+    table->slots = slots;
+    table->capacity = capacity;
     return CTOOLBOX_SUCCESS;
 }
 
@@ -484,16 +710,23 @@ CTOOLBOX_API shashtable* shashtable_init()
 
 CTOOLBOX_API shashtable* shashtable_init_memfuncs(const ctoolbox_memfuncs* memfuncs)
 {
-    shashtable* outHashtable = ctoolbox_custom_malloc(memfuncs ? memfuncs : &CTOOLBOX_DEFAULT_MEMFUNCS, sizeof(shashtable));
+    const ctoolbox_memfuncs* actual_memfuncs = memfuncs ? memfuncs : &CTOOLBOX_DEFAULT_MEMFUNCS;
+    shashtable* outHashtable = ctoolbox_custom_malloc(actual_memfuncs, sizeof(shashtable));
+    if (!outHashtable) return NULL;
 
-    for (int i = 0; i < SHASHTABLE_SIZE; i++) {
-        outHashtable->buckets[i] = NULL;
+    outHashtable->memfuncs = *actual_memfuncs;
+    outHashtable->capacity = SHASHTABLE_SIZE;
+    outHashtable->count = 0;
+    outHashtable->arena = NULL;
+    outHashtable->keyBytes = 0;
+    outHashtable->liveKeyBytes = 0;
+    outHashtable->slots = (shash*)ctoolbox_custom_calloc(actual_memfuncs, SHASHTABLE_SIZE, sizeof(shash));
+
+    if (!outHashtable->slots) {
+        ctoolbox_custom_free(actual_memfuncs, outHashtable);
+        return NULL;
     }
-    
-    if (memfuncs) outHashtable->memfuncs = *memfuncs;
-    else outHashtable->memfuncs = CTOOLBOX_DEFAULT_MEMFUNCS;
 
-    outHashtable->count = 0;
     return outHashtable;
 }
 
@@ -501,53 +734,46 @@ CTOOLBOX_API void shashtable_destroy(shashtable* table)
 {
     if (!table) return;
 
-    for (int i = 0; i < SHASHTABLE_SIZE; i++) {
-        shash* entry = table->buckets[i];
-        while (entry) {
-            shash* next = entry->next;
-            ctoolbox_custom_free(&table->memfuncs, entry->key);
-            ctoolbox_custom_free(&table->memfuncs, entry);
-            entry = next;
-        }
+    shash_arena_block* block = table->arena;
+    while (block) {
+        shash_arena_block* next = block->next;
+        ctoolbox_custom_free(&table->memfuncs, block);
+        block = next;
     }
+
+    ctoolbox_custom_free(&table->memfuncs, table->slots);
     ctoolbox_custom_free(&table->memfuncs, table);
 }
 
+CTOOLBOX_API uint64_t shashtable_hash(const char* key)
+{
+    return key ? shash_hash(key) : 0;
+}
+
 CTOOLBOX_API ctoolbox_result shashtable_insert(shashtable *table, const char* key, void* value)
 {
     if (!table || !key) return CTOOLBOX_ERROR_INVALID_PARAM;
-    if (table->count >= SHASHTABLE_SIZE * 10) return CTOOLBOX_ERROR_FULL;
 
-    unsigned long index = shash_djb2_hash(key);
-    
-    // check if key already exists
-    shash* current = table->buckets[index];
-    while (current) {
-        if (strcmp(current->key, key) == 0) {
-            current->value = value;
-            return CTOOLBOX_SUCCESS;
-        }
-        current = current->next;
+    uint64_t hash = shash_hash(key);
+    shash* existing = shash_find(table, key, hash);
+    if (existing) {
+        existing->value = value;
+        return CTOOLBOX_SUCCESS;
     }
 
-    // create new entry
-    shash* new_entry = (shash*)ctoolbox_custom_malloc(&table->memfuncs, sizeof(shash));
-    if (!new_entry) return CTOOLBOX_ERROR_MEMORY_ALLOC;
-
-    new_entry->key = NULL;
-    new_entry->value = value;
-    new_entry->next = NULL;
-
-    // duplicate key
-    ctoolbox_result result = shash_strdup(&table->memfuncs, key, &new_entry->key);
-    if (result != CTOOLBOX_SUCCESS) {
-        ctoolbox_custom_free(&table->memfuncs, new_entry);
-        return result;
+    // grows at 7/8 load, robin hood keeps probes short well past the point chaining would
+    if ((table->count + 1) * 8 > table->capacity * 7) {
+        ctoolbox_result result = shash_resize(table, table->capacity * 2);
+        if (result != CTOOLBOX_SUCCESS) return result;
     }
 
-    // insert at beginning of chain (simplest)
-    new_entry->next = table->buckets[index];
-    table->buckets[index] = new_entry;
+    shash entry = { 0 };
+    entry.hash = hash;
+    entry.key = shash_intern(table, key);
+    entry.value = value;
+    if (!entry.key) return CTOOLBOX_ERROR_MEMORY_ALLOC;
+
+    shash_place(table->slots, table->capacity, entry);
     table->count++;
 
     return CTOOLBOX_SUCCESS;
@@ -557,41 +783,47 @@ CTOOLBOX_API ctoolbox_result shashtable_delete(shashtable* table, const char* ke
 {
     if (!table || !key) return CTOOLBOX_ERROR_INVALID_PARAM;
 
-    unsigned long index = shash_djb2_hash(key);
-    shash* current = table->buckets[index];
-    shash* prev = NULL;
+    shash* slot = shash_find(table, key, shash_hash(key));
+    if (!slot) return CTOOLBOX_ERROR_NOT_FOUND;
 
-    while (current) {
-        if (strcmp(current->key, key) == 0) {
-            if (prev) prev->next = current->next;
-            else table->buckets[index] = current->next;
+    table->liveKeyBytes -= strlen(slot->key) + 1;
 
-            ctoolbox_custom_free(&table->memfuncs, current->key);
-            ctoolbox_custom_free(&table->memfuncs, current);
-            table->count--;
+    // backward shift, entries after the hole move one slot closer to their home until one is already there
+    size_t mask = table->capacity - 1;
+    size_t index = (size_t)(slot - table->slots);
+    for (;;) {
+        size_t next = (index + 1) & mask;
+        if (table->slots[next].distance <= 1) break;
 
-            return CTOOLBOX_SUCCESS;
-        }
-        prev = current;
-        current = current->next;
+        table->slots[index] = table->slots[next];
+        table->slots[index].distance--;
+        index = next;
     }
 
-    return CTOOLBOX_ERROR_NOT_FOUND;
+    memset(&table->slots[index], 0, sizeof(shash));
+    table->count--;
+
+    // tables that keep adding and removing keys would grow the arena forever, so it's compacted once dead keys outweigh live ones
+    size_t deadKeyBytes = table->keyBytes - table->liveKeyBytes;
+    if (deadKeyBytes > table->liveKeyBytes && deadKeyBytes >= SHASHTABLE_ARENA_BLOCK_SIZE) shash_compact(table);
+
+    return CTOOLBOX_SUCCESS;
 }
 
 CTOOLBOX_API void* shashtable_lookup(shashtable* table, const char* key)
 {
     if (!table || !key) return NULL;
 
-    unsigned long index = shash_djb2_hash(key);
-    const shash* current = table->buckets[index];
+    shash* slot = shash_find(table, key, shash_hash(key));
+    return slot ? slot->value : NULL;
+}
 
-    while (current) {
-        if (strcmp(current->key, key) == 0) return current->value;
-        current = current->next;
-    }
+CTOOLBOX_API void* shashtable_lookup_hashed(shashtable* table, const char* key, uint64_t hash)
+{
+    if (!table || !key) return NULL;
 
-    return NULL;
+    shash* slot = shash_find(table, key, hash);
+    return slot ? slot->value : NULL;
 }
 
 CTOOLBOX_API bool shashtable_contains(shashtable* table, const char *key)
@@ -604,3 +836,27 @@ CTOOLBOX_API size_t shashtable_count(shashtable* table)
     return table ? table->count : 0;
 }
 
+CTOOLBOX_API void shashtable_get_stats(shashtable* table, shashtable_stats* stats)
+{
+    if (!stats) return;
+    memset(stats, 0, sizeof(shashtable_stats));
+    if (!table) return;
+
+    size_t totalDistance = 0;
+    for (size_t i = 0; i < table->capacity; i++) {
+        uint32_t distance = table->slots[i].distance;
+        if (distance == 0) continue;
+
+        totalDistance += distance;
+        if (distance > stats->longestProbe) stats->longestProbe = distance;
+    }
+
+    for (shash_arena_block* block = table->arena; block; block = block->next) {
+        stats->arenaBytes += block->capacity;
+    }
+
+    stats->count = table->count;
+    stats->capacity = table->capacity;
+    stats->averageProbe = table->count ? (float)totalDistance / (float)table->count : 0.0f;
+    stats->keyBytes = table->keyBytes;
+}
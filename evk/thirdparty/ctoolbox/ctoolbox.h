@@ -157,9 +157,13 @@ CTOOLBOX_API bool darray_empty(const darray* array);
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #ifndef IDGEN_MAX_SAFE_IDS
-#define IDGEN_MAX_SAFE_IDS 16777216 // maximum of 16.7 million IDs (~2MB memory usage)
+#define IDGEN_MAX_SAFE_IDS 16777216 // maximum of 16.7 million IDs (~2MB memory usage when all are in use)
 #endif // IDGEN_MAX_SAFE_IDS
 
+#ifndef IDGEN_INITIAL_WORDS
+#define IDGEN_INITIAL_WORDS 16      // 64-bit words allocated on creation (1024 IDs), doubles as IDs are handed out
+#endif // IDGEN_INITIAL_WORDS
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // functions
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -184,28 +188,56 @@ CTOOLBOX_API void idgen_destroy(idgen* gen);
 /// @brief generate next ID, returns 0 if exhausted
 CTOOLBOX_API uint32_t idgen_next(idgen* gen);
 
+/// @brief generates up to count IDs into out_ids, returns how many were generated (less than count if exhausted)
+CTOOLBOX_API uint32_t idgen_next_n(idgen* gen, uint32_t count, uint32_t* out_ids);
+
 /// @brief register an id
 CTOOLBOX_API bool idgen_register(idgen* gen, uint32_t id);
 
 /// @brief unregister an id
 CTOOLBOX_API bool idgen_unregister(idgen* gen, uint32_t id);
 
+/// @brief checks if an id is in use
+CTOOLBOX_API bool idgen_is_registered(idgen* gen, uint32_t id);
+
+/// @brief returns how many ids are in use
+CTOOLBOX_API uint32_t idgen_count(idgen* gen);
+
+/// @brief releases every id, keeping the memory already grown
+CTOOLBOX_API void idgen_reset(idgen* gen);
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// Static Hashtable
+// String Hashtable
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// @brief defines the size of the static hash table
+/// @brief initial slot count of the hash table, must be a power of two, the table doubles whenever it gets 7/8 full
 #ifndef SHASHTABLE_SIZE
     #define SHASHTABLE_SIZE 128
 #endif
 
+/// @brief size of the blocks keys are interned into, longer keys get a block of their own
+#ifndef SHASHTABLE_ARENA_BLOCK_SIZE
+    #define SHASHTABLE_ARENA_BLOCK_SIZE 4096
+#endif
+
 /// @brief opaque structure for the hash entry
 typedef struct shash shash;
 
 /// @brief opaque structure for the hash table
 typedef struct shashtable shashtable;
 
+/// @brief describes the table layout, meant to evaluate how it behaves with a given key set
+typedef struct shashtable_stats
+{
+    size_t count;
+    size_t capacity;
+    uint32_t longestProbe;  // most slots a lookup of a stored key visits
+    float averageProbe;     // slots visited on average by lookups of stored keys
+    size_t keyBytes;        // interned key bytes, including keys of deleted entries not compacted yet
+    size_t arenaBytes;      // bytes reserved by the key arena
+} shashtable_stats;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // functions
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -223,7 +255,10 @@ CTOOLBOX_API shashtable* shashtable_init_memfuncs(const ctoolbox_memfuncs* memfu
 /// @brief destroys the hashtable
 CTOOLBOX_API void shashtable_destroy(shashtable* table);
 
-/// @brief inserts an item into the hashtable
+/// @brief returns the hash the table uses for a key, so hot lookups of a known key may skip hashing it
+CTOOLBOX_API uint64_t shashtable_hash(const char* key);
+
+/// @brief inserts an item into the hashtable, replacing the value when the key is already present
 CTOOLBOX_API ctoolbox_result shashtable_insert(shashtable* table, const char* key, void* value);
 
 /// @brief deletes an item from the hashtable
@@ -232,12 +267,18 @@ CTOOLBOX_API ctoolbox_result shashtable_delete(shashtable* table, const char* ke
 /// @brief returns a peek at the given hash entry associated with given key
 CTOOLBOX_API void* shashtable_lookup(shashtable* table, const char* key);
 
+/// @brief same as shashtable_lookup with the key's hash already computed by shashtable_hash
+CTOOLBOX_API void* shashtable_lookup_hashed(shashtable* table, const char* key, uint64_t hash);
+
 /// @brief checks if a given key exists in the hashtable
 CTOOLBOX_API bool shashtable_contains(shashtable* table, const char* key);
 
 /// @brief returns how many entries exists in the hashtable
 CTOOLBOX_API size_t shashtable_count(shashtable* table);
 
+/// @brief fills stats with the table's occupancy and probe lengths
+CTOOLBOX_API void shashtable_get_stats(shashtable* table, shashtable_stats* stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -17,144 +17,385 @@ extern "C" {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////// Internal Implementation
 
-/// @brief holds an alocation information
-typedef struct memm_allocation
+#if defined(_MSC_VER)
+    #include <intrin.h>
+    #define MEMM_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__) || defined(__clang__)
+    #include <sched.h>
+    #define MEMM_THREAD_LOCAL __thread
+#else
+    #define MEMM_THREAD_LOCAL _Thread_local
+#endif
+
+#define MEMM_MAGIC_LIVE 0x4D454D4Du  // "MEMM"
+#define MEMM_UNTRACKED 0xFFFFFFFFu   // shard of allocations skipped by sampling
+
+/// @brief holds an alocation information, stored right before the memory given to the user so tracking never allocates
+typedef struct memm_header
 {
-    void* ptr;
     size_t size;
     const char* file;
     int line;
-    time_t timestamp;
-    struct memm_allocation* next;
-} memm_allocation_t;
+    unsigned int shard;         // shard it's tracked on, MEMM_UNTRACKED when sampling skipped it
+    unsigned int magic;         // MEMM_MAGIC_LIVE while allocated, only read for allocations sampling skipped
+    struct memm_header* next;   // chain of the shard bucket
+} memm_header_t;
+
+/// @brief header size rounded up so user memory keeps malloc's alignment
+#define MEMM_HEADER_SIZE ((sizeof(memm_header_t) + 15) & ~(size_t)15)
+
+/// @brief a slice of the tracking state, tables are picked by allocation address and counters by thread
+typedef struct memm_shard
+{
+    volatile long lock;
+    memm_header_t** hash_table;             // allocated on the first tracked allocation, NULL until then
+    size_t bucket_count;                    // power of 2, doubled when tracked passes it so chains stay short
+    size_t tracked;                         // allocations chained in the table
+    volatile long long total_allocated;     // bytes allocated
+    volatile long long total_freed;         // bytes freed
+    volatile long long allocation_count;    // allocations calls count
+    volatile long long free_count;          // free calls count
+    char padding[64];                       // keeps the counters of neighbour shards off this cache line
+} memm_shard_t;
 
 /// @brief holds the memm state, wich keeps tracks of all memory allocated stuff
 typedef struct memm
 {
-    memm_allocation_t* hash_table[MEMM_HASH_TABLE_SIZE];
-    size_t total_allocated;     // bytes allocated
-    size_t total_freed;         // bytes freed
-    size_t peak_memory;         // max memory simultaneosly allocated, used 
-    size_t allocation_count;    // allocations calls count
-    size_t free_count;          // free calls count
+    memm_shard_t shards[MEMM_SHARD_COUNT];
+    volatile long long current_usage;       // bytes currently allocated, shared so the peak is exact
+    volatile long long untracked_live;      // live allocations sampling skipped, while 0 every live allocation is in a table
+    volatile long long peak_memory;         // max memory simultaneosly allocated, used
+    volatile long next_shard;               // round robin of shards given to new threads
+    volatile long sample_rate;              // one in sample_rate allocations is tracked
 } memm_t;
 
 /// @brief global state
 static memm_t g_memm = { 0 };
 
-/// @brief hashes the function 
-static size_t memm_hash_ptr(void* ptr) {
-    return ((size_t)ptr) & (MEMM_HASH_TABLE_SIZE - 1);
+/// @brief per-thread shard (+1, 0 means not assigned yet) and allocations left until the next sampled one
+static MEMM_THREAD_LOCAL unsigned int t_memm_shard = 0;
+static MEMM_THREAD_LOCAL long t_memm_sample_countdown = 0;
+
+static inline long long memm_atomic_add(volatile long long* value, long long amount)
+{
+    #if defined(_MSC_VER)
+    return _InterlockedExchangeAdd64(value, amount);
+    #else
+    return __atomic_fetch_add(value, amount, __ATOMIC_RELAXED);
+    #endif
 }
 
-/// @brief register an allocation
-static void memm_register_allocation(void* ptr, size_t size, const char* file, int line)
+static inline long long memm_atomic_load(volatile long long* value)
 {
-    if (!ptr) return;
-    
-    size_t hash = memm_hash_ptr(ptr);
-    memm_allocation_t* alloc = (memm_allocation_t*)malloc(sizeof(memm_allocation_t));
-    
-    if (!alloc) {
-        #ifdef MEMM_ENABLE_LOGGING
-        fprintf(stderr, "MEMM-ERROR: Failed to register allocation for %p\n", ptr);
+    #if defined(_MSC_VER)
+    return _InterlockedCompareExchange64(value, 0, 0);
+    #else
+    return __atomic_load_n(value, __ATOMIC_RELAXED);
+    #endif
+}
+
+static inline bool memm_atomic_cas(volatile long long* value, long long expected, long long desired)
+{
+    #if defined(_MSC_VER)
+    return _InterlockedCompareExchange64(value, desired, expected) == expected;
+    #else
+    return __atomic_compare_exchange_n(value, &expected, desired, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+    #endif
+}
+
+#if !defined(_MSC_VER)
+/// @brief waits for a held lock, pausing so the holder's sibling thread keeps the core and yielding once the holder seems descheduled
+static inline void memm_spin_wait(volatile long* lock)
+{
+    for (unsigned int spins = 0; __atomic_load_n(lock, __ATOMIC_RELAXED); spins++) {
+        if (spins < 64) {
+            #if defined(__i386__) || defined(__x86_64__)
+            __builtin_ia32_pause();
+            #elif defined(__aarch64__) || defined(__arm__)
+            __asm__ __volatile__("yield");
+            #endif
+        }
+        else {
+            sched_yield();
+        }
+    }
+}
+#endif
+
+static inline void memm_lock(memm_shard_t* shard)
+{
+    #if defined(_MSC_VER)
+    while (_InterlockedExchange(&shard->lock, 1)) while (shard->lock) _mm_pause();
+    #else
+    while (__atomic_exchange_n(&shard->lock, 1, __ATOMIC_ACQUIRE)) memm_spin_wait(&shard->lock);
+    #endif
+}
+
+static inline void memm_unlock(memm_shard_t* shard)
+{
+    #if defined(_MSC_VER)
+    _InterlockedExchange(&shard->lock, 0);
+    #else
+    __atomic_store_n(&shard->lock, 0, __ATOMIC_RELEASE);
+    #endif
+}
+
+/// @brief returns the shard of the calling thread, assigned on it's first allocation
+static memm_shard_t* memm_thread_shard()
+{
+    if (t_memm_shard == 0) {
+        #if defined(_MSC_VER)
+        long next = _InterlockedExchangeAdd(&g_memm.next_shard, 1);
+        #else
+        long next = __atomic_fetch_add(&g_memm.next_shard, 1, __ATOMIC_RELAXED);
         #endif
-        return;
+        t_memm_shard = (unsigned int)(next % MEMM_SHARD_COUNT) + 1;
     }
-    
-    alloc->ptr = ptr;
-    alloc->size = size;
-    alloc->file = file;
-    alloc->line = line;
-    alloc->timestamp = time(NULL);
-    alloc->next = g_memm.hash_table[hash];
-    g_memm.hash_table[hash] = alloc;
-    
-    g_memm.total_allocated += size;
-    g_memm.allocation_count++;
-    
-    size_t current_usage = g_memm.total_allocated - g_memm.total_freed;
-    if (current_usage > g_memm.peak_memory) {
-        g_memm.peak_memory = current_usage;
+    return &g_memm.shards[t_memm_shard - 1];
+}
+
+/// @brief mixes the pointer, the full finalizer spreads the address bits over the low ones the buckets take as the table grows
+static unsigned long long memm_mix_ptr(const void* ptr)
+{
+    unsigned long long x = (unsigned long long)(size_t)ptr;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+/// @brief returns the bucket of the pointer inside it's shard
+static size_t memm_hash_ptr(const memm_shard_t* shard, const void* ptr)
+{
+    return (size_t)memm_mix_ptr(ptr) & (shard->bucket_count - 1);
+}
+
+/// @brief rehashes the shard into bucket_count buckets, the shard keeps it's table when the new one can't be allocated, called with the shard locked
+static bool memm_resize_table(memm_shard_t* shard, size_t bucket_count)
+{
+    memm_header_t** table = (memm_header_t**)calloc(bucket_count, sizeof(memm_header_t*));
+    if (!table) return false;
+
+    memm_header_t** old_table = shard->hash_table;
+    size_t old_count = shard->bucket_count;
+    shard->hash_table = table;
+    shard->bucket_count = bucket_count;
+
+    for (size_t i = 0; i < old_count; i++) {
+        memm_header_t* current = old_table[i];
+        while (current) {
+            memm_header_t* next = current->next;
+            size_t hash = memm_hash_ptr(shard, current);
+            current->next = table[hash];
+            table[hash] = current;
+            current = next;
+        }
     }
+
+    free(old_table);
+    return true;
 }
 
-/// @brief unregister the allocation
-static bool memm_unregister_allocation(void* ptr, const char* file, int line)
+/// @brief returns the shard whose table tracks the pointer, chosen by address so a free finds it without reading the header
+static unsigned int memm_table_shard(const void* ptr)
 {
-    if (!ptr) return true;
-    
-    size_t hash = memm_hash_ptr(ptr);
-    memm_allocation_t** current = &g_memm.hash_table[hash];
-    
-    while (*current) {
-        if ((*current)->ptr == ptr) {
-            memm_allocation_t* to_free = *current;
-            *current = to_free->next;
-            
-            g_memm.total_freed += to_free->size;
-            g_memm.free_count++;
-            
-            free(to_free);
-            return true;
+    return (unsigned int)((memm_mix_ptr(ptr) >> 32) % MEMM_SHARD_COUNT);
+}
+
+/// @brief returns true when this allocation should be tracked with it's file and line
+static bool memm_should_sample()
+{
+    long rate = g_memm.sample_rate;
+    if (rate <= 1) return true;
+
+    if (--t_memm_sample_countdown > 0) return false;
+    t_memm_sample_countdown = rate;
+    return true;
+}
+
+/// @brief updates the usage and peak after an allocation
+static void memm_add_usage(long long size)
+{
+    long long current = memm_atomic_add(&g_memm.current_usage, size) + size;
+    long long peak = memm_atomic_load(&g_memm.peak_memory);
+    while (current > peak && !memm_atomic_cas(&g_memm.peak_memory, peak, current)) {
+        peak = memm_atomic_load(&g_memm.peak_memory);
+    }
+}
+
+/// @brief register an allocation, returns the user memory right after the header
+static void* memm_register_allocation(memm_header_t* header, size_t size, const char* file, int line)
+{
+    memm_shard_t* shard = memm_thread_shard();
+
+    header->size = size;
+    header->file = file;
+    header->line = line;
+    header->magic = MEMM_MAGIC_LIVE;
+    header->shard = MEMM_UNTRACKED;
+    header->next = NULL;
+
+    bool tracked = false;
+    if (memm_should_sample()) {
+        unsigned int owner_index = memm_table_shard(header);
+        memm_shard_t* owner = &g_memm.shards[owner_index];
+
+        // the load is kept under one allocation per bucket, a failed resize only lengthens the chains
+        memm_lock(owner);
+        if (owner->tracked >= owner->bucket_count) {
+            memm_resize_table(owner, owner->bucket_count ? owner->bucket_count * 2 : MEMM_HASH_TABLE_SIZE);
+        }
+
+        if (owner->hash_table) {
+            size_t hash = memm_hash_ptr(owner, header);
+            header->shard = owner_index;
+            header->next = owner->hash_table[hash];
+            owner->hash_table[hash] = header;
+            owner->tracked++;
+            tracked = true;
+        }
+        memm_unlock(owner);
+    }
+
+    if (!tracked) {
+        memm_atomic_add(&g_memm.untracked_live, 1);
+    }
+
+    memm_atomic_add(&shard->total_allocated, (long long)size);
+    memm_atomic_add(&shard->allocation_count, 1);
+    memm_add_usage((long long)size);
+
+    return (char*)header + MEMM_HEADER_SIZE;
+}
+
+/// @brief unregister the allocation, returns false when the pointer is not a live memm allocation
+static bool memm_unregister_allocation(memm_header_t* header, const char* file, int line)
+{
+    // the table is searched before the header is touched, a pointer that was already freed must not be read
+    bool found = false;
+    memm_shard_t* owner = &g_memm.shards[memm_table_shard(header)];
+
+    memm_lock(owner);
+    memm_header_t** current = owner->hash_table ? &owner->hash_table[memm_hash_ptr(owner, header)] : NULL;
+    while (current && *current) {
+        if (*current == header) {
+            *current = header->next;
+            owner->tracked--;
+            found = true;
+            break;
         }
         current = &(*current)->next;
     }
-    
-    #ifdef MEMM_ENABLE_LOGGING
-    fprintf(stderr, "MEMM-ERROR: Attempt to free unknown pointer %p (%s:%d)\n", ptr, file, line);
-    #endif
-    return false;
+    memm_unlock(owner);
+
+    // while every live allocation is sampled a miss is reported right away, otherwise the header is trusted to tell
+    // an allocation sampling skipped apart, so only sampled allocations are safely checked for double frees
+    if (!found) {
+        bool skipped = memm_atomic_load(&g_memm.untracked_live) > 0 && header->magic == MEMM_MAGIC_LIVE && header->shard == MEMM_UNTRACKED;
+        if (!skipped) {
+            #ifdef MEMM_ENABLE_LOGGING
+            fprintf(stderr, "MEMM-ERROR: Attempt to free unknown or already freed pointer %p (%s:%d)\n", (void*)((char*)header + MEMM_HEADER_SIZE), file, line);
+            #else
+            (void)file;
+            (void)line;
+            #endif
+            return false;
+        }
+        memm_atomic_add(&g_memm.untracked_live, -1);
+    }
+
+    memm_shard_t* shard = memm_thread_shard();
+    memm_atomic_add(&shard->total_freed, (long long)header->size);
+    memm_atomic_add(&shard->free_count, 1);
+    memm_atomic_add(&g_memm.current_usage, -(long long)header->size);
+
+    header->magic = 0;
+    return true;
+}
+
+/// @brief sums a counter over every shard
+static size_t memm_sum_shards(size_t offset)
+{
+    long long sum = 0;
+    for (size_t i = 0; i < MEMM_SHARD_COUNT; i++) {
+        sum += memm_atomic_load((volatile long long*)((char*)&g_memm.shards[i] + offset));
+    }
+    return (size_t)sum;
+}
+
+/// @brief sums the buckets of every shard
+static size_t memm_bucket_count()
+{
+    size_t count = 0;
+    for (size_t i = 0; i < MEMM_SHARD_COUNT; i++) {
+        memm_lock(&g_memm.shards[i]);
+        count += g_memm.shards[i].bucket_count;
+        memm_unlock(&g_memm.shards[i]);
+    }
+    return count;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////// External Implementations
 
 MEMM_API void memm_init()
 {
+    for (size_t i = 0; i < MEMM_SHARD_COUNT; i++) free(g_memm.shards[i].hash_table);
     memset(&g_memm, 0, sizeof(g_memm));
+    g_memm.sample_rate = MEMM_DEFAULT_SAMPLE_RATE;
     #ifdef MEMM_ENABLE_LOGGING
-    printf("Memory manager initialized with %d buckets\n", MEMM_HASH_TABLE_SIZE);
+    printf("Memory manager initialized with %d shards of %d buckets growing with load\n", MEMM_SHARD_COUNT, MEMM_HASH_TABLE_SIZE);
     #endif
 }
 
 MEMM_API void memm_shutdown()
 {
-    // cleanup tracking structures
-    for (size_t i = 0; i < MEMM_HASH_TABLE_SIZE; i++) {
-        memm_allocation_t* current = g_memm.hash_table[i];
-        while (current) {
-            memm_allocation_t* next = current->next;
-            free(current);
-            current = next;
-        }
-        g_memm.hash_table[i] = NULL;
+    // tracking lives inside the allocations, so only the tables are released
+    for (size_t i = 0; i < MEMM_SHARD_COUNT; i++) {
+        memm_lock(&g_memm.shards[i]);
+        free(g_memm.shards[i].hash_table);
+        g_memm.shards[i].hash_table = NULL;
+        g_memm.shards[i].bucket_count = 0;
+        g_memm.shards[i].tracked = 0;
+        memm_unlock(&g_memm.shards[i]);
     }
     #ifdef MEMM_ENABLE_LOGGING
     printf("Memory manager shutdown complete\n");
     #endif
 }
 
+MEMM_API void memm_set_sample_rate(unsigned int rate)
+{
+    g_memm.sample_rate = rate > 1 ? (long)rate : 1;
+}
+
+MEMM_API unsigned int memm_get_sample_rate()
+{
+    return (unsigned int)g_memm.sample_rate;
+}
+
 MEMM_API void* memm_malloc(size_t size, const char* file, int line)
 {
-    void* ptr = malloc(size);
-    if (ptr) {
-        memm_register_allocation(ptr, size, file, line);
-    } 
+    memm_header_t* header = size <= (size_t)-1 - MEMM_HEADER_SIZE ? (memm_header_t*)malloc(MEMM_HEADER_SIZE + size) : NULL;
+    if (header) {
+        return memm_register_allocation(header, size, file, line);
+    }
 
     else {
         #ifdef MEMM_ENABLE_LOGGING
         fprintf(stderr, "MEMM-ERROR: malloc failed for %zu bytes (%s:%d)\n", size, file, line);
         #endif
     }
-    return ptr;
+    return NULL;
 }
 
 MEMM_API void* memm_calloc(size_t num, size_t size, const char *file, int line)
 {
-    void* ptr = calloc(num, size);
+    void* ptr = (size == 0 || num <= ((size_t)-1 - MEMM_HEADER_SIZE) / size) ? memm_malloc(num * size, file, line) : NULL;
     if (ptr) {
-        memm_register_allocation(ptr, num * size, file, line);
-    } 
+        memset(ptr, 0, num * size);
+    }
 
     else {
         #ifdef MEMM_ENABLE_LOGGING
@@ -166,56 +407,62 @@ MEMM_API void* memm_calloc(size_t num, size_t size, const char *file, int line)
 
 MEMM_API void* memm_realloc(void *ptr, size_t size, const char *file, int line)
 {
-    if (ptr) {
-        memm_unregister_allocation(ptr, file, line);
+    if (!ptr) {
+        return memm_malloc(size, file, line);
     }
-    
-    void* new_ptr = realloc(ptr, size);
-    if (new_ptr) {
-        memm_register_allocation(new_ptr, size, file, line);
-    } 
 
-    else if (size > 0) {
-        #ifdef MEMM_ENABLE_LOGGING
-        fprintf(stderr, "MEMM-ERROR: realloc failed for %zu bytes (%s:%d)\n", size, file, line);
-        #endif
+    memm_header_t* header = (memm_header_t*)((char*)ptr - MEMM_HEADER_SIZE);
+    if (!memm_unregister_allocation(header, file, line)) {
+        return NULL;
+    }
+
+    // the block stays valid until realloc succeeds, it's restored with the old values if it fails
+    const char* old_file = header->file;
+    int old_line = header->line;
+    size_t old_size = header->size;
+
+    memm_header_t* new_header = size <= (size_t)-1 - MEMM_HEADER_SIZE ? (memm_header_t*)realloc(header, MEMM_HEADER_SIZE + size) : NULL;
+    if (new_header) {
+        return memm_register_allocation(new_header, size, file, line);
     }
-    return new_ptr;
+
+    // the original block is still valid and owned by the caller
+    memm_register_allocation(header, old_size, old_file, old_line);
+    #ifdef MEMM_ENABLE_LOGGING
+    fprintf(stderr, "MEMM-ERROR: realloc failed for %zu bytes (%s:%d)\n", size, file, line);
+    #endif
+    return NULL;
 }
 
 MEMM_API void memm_free(void *ptr, const char *file, int line)
 {
-    if (memm_unregister_allocation(ptr, file, line)) {
-        free(ptr);
-    } 
+    if (!ptr) return;
 
-    else {
-        #ifdef MEMM_ENABLE_LOGGING
-        fprintf(stderr, "MEMM-WARN: free on an untracked memory (%s:%d)\n", file, line);
-        #endif
-        // if not found in our tracking, still free it to avoid real leaks
-        free(ptr);
+    // only pointers given by memm carry a header, anything else is reported and left alone since freeing it's header would corrupt the heap
+    memm_header_t* header = (memm_header_t*)((char*)ptr - MEMM_HEADER_SIZE);
+    if (memm_unregister_allocation(header, file, line)) {
+        free(header);
     }
 }
 
 MEMM_API size_t memm_get_current_usage()
 {
-    return g_memm.total_allocated - g_memm.total_freed;
+    return (size_t)memm_atomic_load(&g_memm.current_usage);
 }
 
 MEMM_API size_t memm_get_peak_usage()
 {
-    return g_memm.peak_memory;
+    return (size_t)memm_atomic_load(&g_memm.peak_memory);
 }
 
 MEMM_API size_t memm_get_allocation_count()
  {
-    return g_memm.allocation_count;
+    return memm_sum_shards(offsetof(memm_shard_t, allocation_count));
 }
 
 MEMM_API size_t memm_get_free_count()
  {
-    return g_memm.free_count;
+    return memm_sum_shards(offsetof(memm_shard_t, free_count));
 }
 
 MEMM_API size_t memm_get_stats_string(char *buffer, size_t buffer_size)
@@ -233,15 +480,18 @@ MEMM_API size_t memm_get_stats_string(char *buffer, size_t buffer_size)
         "Allocation calls:     %zu\n"
         "Free calls:           %zu\n"
         "Potential leaks:      %zu objects\n"
-        "Hash table size:      %d buckets\n",
-        g_memm.total_allocated,
-        g_memm.total_freed,
+        "Hash table size:      %d shards, %zu buckets\n"
+        "Sample rate:          1 in %u allocations tracked\n",
+        memm_sum_shards(offsetof(memm_shard_t, total_allocated)),
+        memm_sum_shards(offsetof(memm_shard_t, total_freed)),
         memm_get_current_usage(),
         memm_get_peak_usage(),
         memm_get_allocation_count(),
         memm_get_free_count(),
         memm_get_allocation_count() - memm_get_free_count(),
-        MEMM_HASH_TABLE_SIZE
+        MEMM_SHARD_COUNT,
+        memm_bucket_count(),
+        memm_get_sample_rate()
     );
 
     if (written < 0) {
@@ -286,21 +536,25 @@ MEMM_API size_t memm_get_allocations_string(char *buffer, size_t buffer_size)
     size_t total_count = 0;
     size_t total_bytes = 0;
     
-    for (size_t i = 0; i < MEMM_HASH_TABLE_SIZE && remaining > 1; i++) {
-        memm_allocation_t* current = g_memm.hash_table[i];
-        while (current && remaining > 1) {
-            written = snprintf(cursor, remaining, "  %p: %6zu bytes @ %s:%d\n", current->ptr, current->size, current->file, current->line);
+    for (size_t s = 0; s < MEMM_SHARD_COUNT && remaining > 1; s++) {
+        memm_lock(&g_memm.shards[s]);
+        for (size_t i = 0; i < g_memm.shards[s].bucket_count && remaining > 1; i++) {
+            memm_header_t* current = g_memm.shards[s].hash_table[i];
+            while (current && remaining > 1) {
+                written = snprintf(cursor, remaining, "  %p: %6zu bytes @ %s:%d\n", (void*)((char*)current + MEMM_HEADER_SIZE), current->size, current->file, current->line);
             
-            if (written < 0) break;
-            if ((size_t)written >= remaining) written = remaining - 1;
+                if (written < 0) break;
+                if ((size_t)written >= remaining) written = remaining - 1;
             
-            cursor += written;
-            remaining -= written;
-            total_written += written;
-            total_count++;
-            total_bytes += current->size;
-            current = current->next;
+                cursor += written;
+                remaining -= written;
+                total_written += written;
+                total_count++;
+                total_bytes += current->size;
+                current = current->next;
+            }
         }
+        memm_unlock(&g_memm.shards[s]);
     }
     
     if (total_count == 0 && remaining > 1) {
@@ -360,21 +614,25 @@ MEMM_API size_t memm_get_leaks_string(char *buffer, size_t buffer_size)
     size_t leak_count = 0;
     size_t leak_bytes = 0;
     
-    for (size_t i = 0; i < MEMM_HASH_TABLE_SIZE && remaining > 1; i++) {
-        memm_allocation_t* current = g_memm.hash_table[i];
-        while (current && remaining > 1) {
-            written = snprintf(cursor, remaining, "  LEAK: %6zu bytes at %p (%s:%d)\n", current->size, current->ptr, current->file, current->line);
+    for (size_t s = 0; s < MEMM_SHARD_COUNT && remaining > 1; s++) {
+        memm_lock(&g_memm.shards[s]);
+        for (size_t i = 0; i < g_memm.shards[s].bucket_count && remaining > 1; i++) {
+            memm_header_t* current = g_memm.shards[s].hash_table[i];
+            while (current && remaining > 1) {
+                written = snprintf(cursor, remaining, "  LEAK: %6zu bytes at %p (%s:%d)\n", current->size, (void*)((char*)current + MEMM_HEADER_SIZE), current->file, current->line);
             
-            if (written < 0) break;
-            if ((size_t)written >= remaining) written = remaining - 1;
+                if (written < 0) break;
+                if ((size_t)written >= remaining) written = remaining - 1;
             
-            cursor += written;
-            remaining -= written;
-            total_written += written;
-            leak_count++;
-            leak_bytes += current->size;
-            current = current->next;
+                cursor += written;
+                remaining -= written;
+                total_written += written;
+                leak_count++;
+                leak_bytes += current->size;
+                current = current->next;
+            }
         }
+        memm_unlock(&g_memm.shards[s]);
     }
     
     if (leak_count == 0 && remaining > 1) {
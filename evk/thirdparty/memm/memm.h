@@ -12,11 +12,21 @@
     #define m_free(ptr) memm_free(ptr, __FILE__, __LINE__)
 #endif
 
-/// @brief sets how many allocations the system can hold information about
+/// @brief sets how many buckets each shard starts with, a shard doubles them once it tracks more allocations than buckets
 #ifndef MEMM_HASH_TABLE_SIZE
     #define MEMM_HASH_TABLE_SIZE 2048
 #endif
 
+/// @brief sets how many shards the tracking is split into, an allocation is tracked on the shard picked by it's address so a lock is shared by 1 in N of them
+#ifndef MEMM_SHARD_COUNT
+    #define MEMM_SHARD_COUNT 8
+#endif
+
+/// @brief sets how many allocations are tracked with their file and line, 1 tracks all of them and N tracks one in every N
+#ifndef MEMM_DEFAULT_SAMPLE_RATE
+    #define MEMM_DEFAULT_SAMPLE_RATE 1
+#endif
+
 /// @brief compile-time validation that size is power of 2
 #if (MEMM_HASH_TABLE_SIZE & (MEMM_HASH_TABLE_SIZE - 1)) != 0
     #error "MEMM_HASH_TABLE_SIZE must be a power of 2 for hashing efficiency"
@@ -49,16 +59,23 @@ MEMM_API void memm_init();
 /// @brief shutdows the memory manager
 MEMM_API void memm_shutdown();
 
+/// @brief tracks one in every rate allocations with it's file and line, usage and counters still cover every allocation
+MEMM_API void memm_set_sample_rate(unsigned int rate);
+
+/// @brief returns the current sample rate, 1 when every allocation is tracked
+MEMM_API unsigned int memm_get_sample_rate();
+
 /// @brief allocates memory
 MEMM_API void* memm_malloc(size_t size, const char* file, int line);
 
 /// @brief zeroed-allocates memory
 MEMM_API void* memm_calloc(size_t num, size_t size, const char* file, int line);
 
-/// @brief realocates/changes size of a previously allocated memory block
+/// @brief realocates/changes size of a previously allocated memory block, ptr must come from memm like in memm_free
 MEMM_API void* memm_realloc(void* ptr, size_t size, const char* file, int line);
 
-/// @brief deallocates memory
+/// @brief deallocates memory, unknown and already freed pointers are reported and left alone without being read while every allocation is sampled
+/// once allocations are skipped by sampling the header in front of ptr is trusted, so ptr must come from memm and only sampled double frees are caught
 MEMM_API void memm_free(void* ptr, const char* file, int line);
 
 /// @brief returns how much of the memory is being currently used
@@ -79,7 +96,7 @@ MEMM_API size_t memm_get_stats_string(char* buffer, size_t buffer_size);
 /// @brief fills-out a buffer with information about current tracked and no-long tracked allocations
 MEMM_API size_t memm_get_allocations_string(char* buffer, size_t buffer_size);
 
-/// @brief fills-out a buffer with information about pottentially memory leaks
+/// @brief fills-out a buffer with information about pottentially memory leaks, only sampled allocations are listed
 MEMM_API size_t memm_get_leaks_string(char* buffer, size_t buffer_size);
 
 /// @brief helper macros for stats, must have logging enable
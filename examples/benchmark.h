@@ -0,0 +1,53 @@
+#ifndef EVK_BENCHMARK_INCLUDED
+#define EVK_BENCHMARK_INCLUDED
+
+/// @brief helpers shared by the benchmark programs, they run without a window or a vulkan device
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#endif
+
+/// @brief how many times every measurement is repeated, the fastest run is reported
+#ifndef BENCHMARK_ROUNDS
+#define BENCHMARK_ROUNDS 5
+#endif
+
+/// @brief returns a monotonic timestamp in milliseconds
+static inline double benchmark_now_ms()
+{
+    #ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart * 1000.0 / (double)frequency.QuadPart;
+    #else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1000.0 + (double)now.tv_nsec / 1000000.0;
+    #endif
+}
+
+/// @brief small xorshift generator so every run churns through the same sequence
+static inline uint32_t benchmark_random(uint32_t* state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/// @brief prints a result row, operations per second are derived from the fastest run
+static inline void benchmark_report(const char* name, uint64_t operations, double bestMs)
+{
+    double perSecond = bestMs > 0.0 ? (double)operations / (bestMs / 1000.0) : 0.0;
+    printf("  %-40s %10.3f ms %14.0f ops/s\n", name, bestMs, perSecond);
+}
+
+#endif // EVK_BENCHMARK_INCLUDED
@@ -0,0 +1,176 @@
+#include "benchmark.h"
+
+#define EVK_IMPLEMENTATION
+#include "evk.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+/// @brief packets every producer pushes per round, the queue is sized so none are dropped
+#define PACKETS_PER_PRODUCER (1U << 15)
+#define MAX_PRODUCERS 8
+
+/// @brief the hand over this queue replaces, a shared array guarded by a lock
+typedef struct locked_queue_t
+{
+    #ifdef _WIN32
+    CRITICAL_SECTION lock;
+    #else
+    pthread_mutex_t lock;
+    #endif
+    evkDrawPacket* packets;
+    uint32_t count;
+    uint32_t capacity;
+} locked_queue;
+
+typedef struct producer_t
+{
+    uint32_t index;
+    bool locked;
+    volatile uint64_t* start;
+    locked_queue* queue;
+    evkSprite* sprite;
+} producer;
+
+/// @brief pushes a packet into the locked queue
+static bool locked_queue_push(locked_queue* queue, const evkDrawPacket* packet)
+{
+    bool pushed = false;
+    #ifdef _WIN32
+    EnterCriticalSection(&queue->lock);
+    #else
+    pthread_mutex_lock(&queue->lock);
+    #endif
+
+    if (queue->count < queue->capacity) {
+        queue->packets[queue->count++] = *packet;
+        pushed = true;
+    }
+
+    #ifdef _WIN32
+    LeaveCriticalSection(&queue->lock);
+    #else
+    pthread_mutex_unlock(&queue->lock);
+    #endif
+    return pushed;
+}
+
+/// @brief waits for the start signal and pushes it's share of packets, the way a simulation thread hands over transforms
+static void producer_run(producer* p)
+{
+    evkDrawPacket packet = { 0 };
+    packet.sprite = p->sprite;
+    packet.model = fmat4_identity();
+
+    while (EVK_ATOMIC_LOAD(p->start) == 0) {}
+
+    for (uint32_t i = 0; i < PACKETS_PER_PRODUCER; i++) {
+        packet.id = p->index * PACKETS_PER_PRODUCER + i;
+        packet.layer = (uint8_t)(i & 3);
+        packet.transparent = (i & 7) == 0;
+        packet.model.matrix.m30 = (float)i;
+
+        if (p->locked) locked_queue_push(p->queue, &packet);
+        else evk_draw_queue_push(&packet);
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI producer_thread(LPVOID arg) { producer_run((producer*)arg); return 0; }
+#else
+static void* producer_thread(void* arg) { producer_run((producer*)arg); return NULL; }
+#endif
+
+/// @brief runs one round with the given amount of producers and returns how long pushing took
+static double benchmark_round(uint32_t producers, bool locked, locked_queue* queue, evkSprite* sprite)
+{
+    volatile uint64_t start = 0;
+    producer workers[MAX_PRODUCERS];
+
+    #ifdef _WIN32
+    HANDLE threads[MAX_PRODUCERS];
+    #else
+    pthread_t threads[MAX_PRODUCERS];
+    #endif
+
+    for (uint32_t i = 0; i < producers; i++) {
+        workers[i].index = i;
+        workers[i].locked = locked;
+        workers[i].start = &start;
+        workers[i].queue = queue;
+        workers[i].sprite = sprite;
+
+        #ifdef _WIN32
+        threads[i] = CreateThread(NULL, 0, producer_thread, &workers[i], 0, NULL);
+        #else
+        pthread_create(&threads[i], NULL, producer_thread, &workers[i]);
+        #endif
+    }
+
+    double begin = benchmark_now_ms();
+    EVK_ATOMIC_STORE(&start, 1);
+
+    for (uint32_t i = 0; i < producers; i++) {
+        #ifdef _WIN32
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+        #else
+        pthread_join(threads[i], NULL);
+        #endif
+    }
+
+    return benchmark_now_ms() - begin;
+}
+
+int main()
+{
+    // packets are only copied, the sprite is never read without a render thread
+    evkSprite sprite;
+    memset(&sprite, 0, sizeof(evkSprite));
+
+    locked_queue queue;
+    memset(&queue, 0, sizeof(locked_queue));
+    queue.capacity = PACKETS_PER_PRODUCER * MAX_PRODUCERS;
+    queue.packets = (evkDrawPacket*)malloc(sizeof(evkDrawPacket) * queue.capacity);
+    if (queue.packets == NULL) return 1;
+
+    #ifdef _WIN32
+    InitializeCriticalSection(&queue.lock);
+    #else
+    pthread_mutex_init(&queue.lock, NULL);
+    #endif
+
+    printf("draw packet hand over, %u packets per producer, best of %d rounds\n", PACKETS_PER_PRODUCER, BENCHMARK_ROUNDS);
+
+    for (uint32_t producers = 1; producers <= MAX_PRODUCERS; producers <<= 1) {
+        uint64_t total = (uint64_t)producers * PACKETS_PER_PRODUCER;
+        double bestLockFree = 0.0, bestLocked = 0.0;
+        evkDrawQueueStats stats = { 0 };
+
+        for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+            // a fresh queue per round stands in for the render thread draining it between frames
+            if (evk_draw_queue_init((uint32_t)total) != evk_Success) return 1;
+            double ms = benchmark_round(producers, false, NULL, &sprite);
+            stats = evk_draw_queue_get_stats();
+            evk_draw_queue_shutdown();
+            if (round == 0 || ms < bestLockFree) bestLockFree = ms;
+
+            queue.count = 0;
+            ms = benchmark_round(producers, true, &queue, &sprite);
+            if (round == 0 || ms < bestLocked) bestLocked = ms;
+        }
+
+        printf("%u producer(s), %llu pushed, %llu dropped\n", producers, (unsigned long long)stats.pushed, (unsigned long long)stats.dropped);
+        benchmark_report("evk_draw_queue_push", total, bestLockFree);
+        benchmark_report("mutex guarded array", total, bestLocked);
+    }
+
+    #ifdef _WIN32
+    DeleteCriticalSection(&queue.lock);
+    #else
+    pthread_mutex_destroy(&queue.lock);
+    #endif
+    free(queue.packets);
+    return 0;
+}
@@ -0,0 +1,211 @@
+#include "benchmark.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define CTOOLBOX_IMPLEMENTATION
+#include "ctoolbox/ctoolbox.h"
+
+/// @brief ids kept alive while churning, about what a large scene holds
+#define LIVE_IDS 100000U
+
+/// @brief how many ids are released and generated again after the generator is full
+#define CHURN_CYCLES 20000U
+
+/// @brief ids spawned per idgen_next_n call
+#define SPAWN_BATCH 4096U
+
+/// @brief generators created and destroyed to measure creation cost
+#define CREATE_CYCLES 1000U
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// the generator idgen replaced, a bit by bit scan over a pre-allocated 2 MB bitset
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef struct legacy_idgen_t
+{
+    uint32_t current_id;
+    uint32_t start_id;
+    uint32_t max_id;
+    uint32_t count;
+    uint32_t bitset_size;
+    uint32_t* used_bits;
+} legacy_idgen;
+
+static legacy_idgen* legacy_idgen_create(uint32_t start_id)
+{
+    legacy_idgen* gen = (legacy_idgen*)malloc(sizeof(legacy_idgen));
+    if (!gen) return NULL;
+
+    memset(gen, 0, sizeof(*gen));
+    gen->start_id = start_id;
+    gen->current_id = start_id;
+    gen->max_id = IDGEN_MAX_SAFE_IDS;
+    gen->bitset_size = (IDGEN_MAX_SAFE_IDS + 31u) / 32u;
+    gen->used_bits = (uint32_t*)malloc(gen->bitset_size * sizeof(uint32_t));
+    if (!gen->used_bits) {
+        free(gen);
+        return NULL;
+    }
+
+    memset(gen->used_bits, 0, gen->bitset_size * sizeof(uint32_t));
+    return gen;
+}
+
+static void legacy_idgen_destroy(legacy_idgen* gen)
+{
+    free(gen->used_bits);
+    free(gen);
+}
+
+static uint32_t legacy_idgen_next(legacy_idgen* gen)
+{
+    uint32_t range = gen->max_id - gen->start_id;
+    for (uint32_t i = 0; i < range; i++) {
+        uint32_t candidate = gen->current_id + i;
+        if (candidate >= gen->max_id) candidate = gen->start_id + (candidate - gen->max_id);
+
+        uint32_t idx = candidate - gen->start_id;
+        if (!(gen->used_bits[idx >> 5] & (1u << (idx & 31u)))) {
+            gen->used_bits[idx >> 5] |= 1u << (idx & 31u);
+            gen->count++;
+            gen->current_id = candidate + 1;
+            if (gen->current_id >= gen->max_id) gen->current_id = gen->start_id;
+            return candidate;
+        }
+    }
+    return 0;
+}
+
+static bool legacy_idgen_unregister(legacy_idgen* gen, uint32_t id)
+{
+    if (id < gen->start_id || id >= gen->max_id) return false;
+
+    uint32_t idx = id - gen->start_id;
+    if (!(gen->used_bits[idx >> 5] & (1u << (idx & 31u)))) return false;
+
+    gen->used_bits[idx >> 5] &= ~(1u << (idx & 31u));
+    gen->count--;
+    if (id < gen->current_id) gen->current_id = id;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// benchmark
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef struct phase_times_t
+{
+    double create;
+    double fill;
+    double churn;
+    double spawn;
+} phase_times;
+
+/// @brief keeps the fastest time of every phase
+static void phase_times_keep_best(phase_times* best, const phase_times* run, int round)
+{
+    if (round == 0 || run->create < best->create) best->create = run->create;
+    if (round == 0 || run->fill < best->fill) best->fill = run->fill;
+    if (round == 0 || run->churn < best->churn) best->churn = run->churn;
+    if (round == 0 || run->spawn < best->spawn) best->spawn = run->spawn;
+}
+
+/// @brief creates generators, fills one, churns it by releasing random live ids and spawns a batch on a fresh one
+static phase_times run_idgen(uint32_t* live, uint32_t* batch)
+{
+    phase_times times = { 0 };
+    uint32_t seed = 0x9E3779B9u;
+
+    double begin = benchmark_now_ms();
+    for (uint32_t i = 0; i < CREATE_CYCLES; i++) idgen_destroy(idgen_create(1));
+    times.create = benchmark_now_ms() - begin;
+
+    idgen* gen = idgen_create(1);
+    begin = benchmark_now_ms();
+    for (uint32_t i = 0; i < LIVE_IDS; i++) live[i] = idgen_next(gen);
+    times.fill = benchmark_now_ms() - begin;
+
+    begin = benchmark_now_ms();
+    for (uint32_t i = 0; i < CHURN_CYCLES; i++) {
+        uint32_t slot = benchmark_random(&seed) % LIVE_IDS;
+        idgen_unregister(gen, live[slot]);
+        live[slot] = idgen_next(gen);
+    }
+    times.churn = benchmark_now_ms() - begin;
+    idgen_destroy(gen);
+
+    gen = idgen_create(1);
+    begin = benchmark_now_ms();
+    for (uint32_t spawned = 0; spawned < LIVE_IDS; spawned += SPAWN_BATCH) idgen_next_n(gen, SPAWN_BATCH, batch);
+    times.spawn = benchmark_now_ms() - begin;
+    idgen_destroy(gen);
+
+    return times;
+}
+
+/// @brief same phases against the legacy generator, which spawns by calling next once per id
+static phase_times run_legacy(uint32_t* live, uint32_t* batch)
+{
+    phase_times times = { 0 };
+    uint32_t seed = 0x9E3779B9u;
+
+    double begin = benchmark_now_ms();
+    for (uint32_t i = 0; i < CREATE_CYCLES; i++) legacy_idgen_destroy(legacy_idgen_create(1));
+    times.create = benchmark_now_ms() - begin;
+
+    legacy_idgen* gen = legacy_idgen_create(1);
+    begin = benchmark_now_ms();
+    for (uint32_t i = 0; i < LIVE_IDS; i++) live[i] = legacy_idgen_next(gen);
+    times.fill = benchmark_now_ms() - begin;
+
+    begin = benchmark_now_ms();
+    for (uint32_t i = 0; i < CHURN_CYCLES; i++) {
+        uint32_t slot = benchmark_random(&seed) % LIVE_IDS;
+        legacy_idgen_unregister(gen, live[slot]);
+        live[slot] = legacy_idgen_next(gen);
+    }
+    times.churn = benchmark_now_ms() - begin;
+    legacy_idgen_destroy(gen);
+
+    gen = legacy_idgen_create(1);
+    begin = benchmark_now_ms();
+    for (uint32_t spawned = 0; spawned < LIVE_IDS; spawned += SPAWN_BATCH) {
+        for (uint32_t i = 0; i < SPAWN_BATCH; i++) batch[i] = legacy_idgen_next(gen);
+    }
+    times.spawn = benchmark_now_ms() - begin;
+    legacy_idgen_destroy(gen);
+
+    return times;
+}
+
+int main()
+{
+    uint32_t* live = (uint32_t*)malloc(sizeof(uint32_t) * LIVE_IDS);
+    uint32_t* batch = (uint32_t*)malloc(sizeof(uint32_t) * SPAWN_BATCH);
+    if (live == NULL || batch == NULL) return 1;
+
+    phase_times current = { 0 }, legacy = { 0 };
+    for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+        phase_times run = run_idgen(live, batch);
+        phase_times_keep_best(&current, &run, round);
+
+        run = run_legacy(live, batch);
+        phase_times_keep_best(&legacy, &run, round);
+    }
+
+    uint32_t spawned = ((LIVE_IDS + SPAWN_BATCH - 1) / SPAWN_BATCH) * SPAWN_BATCH;
+    printf("idgen against the bit scan it replaced, %u live ids, best of %d rounds\n", LIVE_IDS, BENCHMARK_ROUNDS);
+    benchmark_report("idgen create and destroy", CREATE_CYCLES, current.create);
+    benchmark_report("idgen fill", LIVE_IDS, current.fill);
+    benchmark_report("idgen churn, release and next", CHURN_CYCLES, current.churn);
+    benchmark_report("idgen spawn with idgen_next_n", spawned, current.spawn);
+    benchmark_report("legacy create and destroy", CREATE_CYCLES, legacy.create);
+    benchmark_report("legacy fill", LIVE_IDS, legacy.fill);
+    benchmark_report("legacy churn, release and next", CHURN_CYCLES, legacy.churn);
+    benchmark_report("legacy spawn with next", spawned, legacy.spawn);
+
+    free(live);
+    free(batch);
+    return 0;
+}
@@ -0,0 +1,153 @@
+#include "benchmark.h"
+
+#define EVK_IMPLEMENTATION
+#include "evk.h"
+
+/// @brief sprites alive while churning
+#define LIVE_OBJECTS 200000U
+
+/// @brief how many sprites are destroyed and spawned again once the scene is full
+#define CHURN_CYCLES 200000U
+
+/// @brief passes over every live sprite, the way a frame walks them
+#define ITERATE_PASSES 20U
+
+typedef enum allocator_kind_t
+{
+    allocator_kind_pool = 0,
+    allocator_kind_evk,
+    allocator_kind_crt
+} allocator_kind;
+
+typedef struct phase_times_t
+{
+    double spawn;
+    double churn;
+    double iterate;
+    double release;
+} phase_times;
+
+/// @brief keeps the fastest time of every phase
+static void phase_times_keep_best(phase_times* best, const phase_times* run, int round)
+{
+    if (round == 0 || run->spawn < best->spawn) best->spawn = run->spawn;
+    if (round == 0 || run->churn < best->churn) best->churn = run->churn;
+    if (round == 0 || run->iterate < best->iterate) best->iterate = run->iterate;
+    if (round == 0 || run->release < best->release) best->release = run->release;
+}
+
+/// @brief allocates a zeroed sprite from the given allocator
+static void* object_alloc(allocator_kind kind, evkPool* pool)
+{
+    switch (kind) {
+        case allocator_kind_pool: return evk_pool_alloc(pool);
+        case allocator_kind_evk: return EVK_CALLOC(evk_Allocation_Tag_Drawable, 1, sizeof(evkSprite));
+        default: return calloc(1, sizeof(evkSprite));
+    }
+}
+
+/// @brief returns a sprite to the allocator it came from
+static void object_free(allocator_kind kind, evkPool* pool, void* object)
+{
+    switch (kind) {
+        case allocator_kind_pool: evk_pool_free(pool, object); break;
+        case allocator_kind_evk: EVK_FREE(object); break;
+        default: free(object); break;
+    }
+}
+
+/// @brief spawns a scene of sprites, churns it, walks the live ones and releases them
+static phase_times run_allocator(allocator_kind kind, evkSprite** live, evkPoolStats* stats, volatile uint32_t* sink)
+{
+    phase_times times = { 0 };
+    uint32_t seed = 0x9E3779B9u;
+    evkPool pool;
+    evk_pool_init(&pool, (uint32_t)sizeof(evkSprite), evk_Allocation_Tag_Drawable);
+
+    double begin = benchmark_now_ms();
+    for (uint32_t i = 0; i < LIVE_OBJECTS; i++) {
+        live[i] = (evkSprite*)object_alloc(kind, &pool);
+        live[i]->id = i;
+    }
+    times.spawn = benchmark_now_ms() - begin;
+
+    begin = benchmark_now_ms();
+    for (uint32_t i = 0; i < CHURN_CYCLES; i++) {
+        uint32_t slot = benchmark_random(&seed) % LIVE_OBJECTS;
+        object_free(kind, &pool, live[slot]);
+        live[slot] = (evkSprite*)object_alloc(kind, &pool);
+        live[slot]->id = i;
+    }
+    times.churn = benchmark_now_ms() - begin;
+
+    // the pool walks it's chunks in order, heap objects are only reachable through the list the scene keeps
+    begin = benchmark_now_ms();
+    for (uint32_t pass = 0; pass < ITERATE_PASSES; pass++) {
+        uint32_t sum = 0;
+        if (kind == allocator_kind_pool) {
+            uint32_t cursor = 0;
+            uint32_t count = 0;
+            void* batch[256];
+            while ((count = evk_pool_next_batch(&pool, &cursor, batch, 256)) > 0) {
+                for (uint32_t i = 0; i < count; i++) sum += ((evkSprite*)batch[i])->id;
+            }
+        }
+        else {
+            for (uint32_t i = 0; i < LIVE_OBJECTS; i++) sum += live[i]->id;
+        }
+        *sink += sum;
+    }
+    times.iterate = benchmark_now_ms() - begin;
+
+    begin = benchmark_now_ms();
+    for (uint32_t i = 0; i < LIVE_OBJECTS; i++) object_free(kind, &pool, live[i]);
+    times.release = benchmark_now_ms() - begin;
+
+    *stats = evk_pool_get_stats(&pool);
+    evk_pool_destroy(&pool);
+    return times;
+}
+
+/// @brief prints every phase of an allocator
+static void report(const char* label, const phase_times* times)
+{
+    char name[64];
+    snprintf(name, sizeof(name), "%s spawn", label);
+    benchmark_report(name, LIVE_OBJECTS, times->spawn);
+    snprintf(name, sizeof(name), "%s churn, destroy and spawn", label);
+    benchmark_report(name, CHURN_CYCLES, times->churn);
+    snprintf(name, sizeof(name), "%s iterate live", label);
+    benchmark_report(name, (uint64_t)LIVE_OBJECTS * ITERATE_PASSES, times->iterate);
+    snprintf(name, sizeof(name), "%s release", label);
+    benchmark_report(name, LIVE_OBJECTS, times->release);
+}
+
+int main()
+{
+    evkSprite** live = (evkSprite**)malloc(sizeof(evkSprite*) * LIVE_OBJECTS);
+    if (live == NULL) return 1;
+
+    volatile uint32_t sink = 0;
+    evkPoolStats stats = { 0 }, unused = { 0 };
+    phase_times pool = { 0 }, evk = { 0 }, crt = { 0 };
+
+    for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+        phase_times run = run_allocator(allocator_kind_pool, live, &stats, &sink);
+        phase_times_keep_best(&pool, &run, round);
+
+        run = run_allocator(allocator_kind_evk, live, &unused, &sink);
+        phase_times_keep_best(&evk, &run, round);
+
+        run = run_allocator(allocator_kind_crt, live, &unused, &sink);
+        phase_times_keep_best(&crt, &run, round);
+    }
+
+    printf("%u byte sprites, %u alive, %u churned, best of %d rounds\n", (uint32_t)sizeof(evkSprite), LIVE_OBJECTS, CHURN_CYCLES, BENCHMARK_ROUNDS);
+    printf("pool kept %u slots in %u chunks for a peak of %u sprites\n", stats.capacity, stats.chunks, stats.peak);
+    report("evk_pool", &pool);
+    report("EVK_CALLOC", &evk);
+    report("calloc", &crt);
+
+    free(live);
+    return 0;
+}
@@ -0,0 +1,285 @@
+#include "benchmark.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define CTOOLBOX_IMPLEMENTATION
+#include "ctoolbox/ctoolbox.h"
+
+/// @brief every size touches about this many keys per phase, small tables are rebuilt until they do
+#define KEYS_PER_PHASE 1000000U
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// the table shashtable replaced, 128 chained buckets with a malloc and a strdup per entry
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define LEGACY_SIZE 128
+
+typedef struct legacy_entry_t
+{
+    char* key;
+    void* value;
+    struct legacy_entry_t* next;
+} legacy_entry;
+
+typedef struct legacy_table_t
+{
+    legacy_entry* buckets[LEGACY_SIZE];
+    size_t count;
+} legacy_table;
+
+static unsigned long legacy_hash(const char* str)
+{
+    unsigned long hash = 5381;
+    int c;
+
+    while ((c = *str++)) {
+        hash = (hash << 5) + hash + c;
+        hash ^= (hash << 7) | (hash >> (sizeof(hash) * 8 - 7));
+    }
+
+    return hash % LEGACY_SIZE;
+}
+
+static legacy_table* legacy_init()
+{
+    return (legacy_table*)calloc(1, sizeof(legacy_table));
+}
+
+static void legacy_destroy(legacy_table* table)
+{
+    for (int i = 0; i < LEGACY_SIZE; i++) {
+        legacy_entry* entry = table->buckets[i];
+        while (entry) {
+            legacy_entry* next = entry->next;
+            free(entry->key);
+            free(entry);
+            entry = next;
+        }
+    }
+    free(table);
+}
+
+static ctoolbox_result legacy_insert(legacy_table* table, const char* key, void* value)
+{
+    if (table->count >= LEGACY_SIZE * 10) return CTOOLBOX_ERROR_FULL;
+
+    unsigned long index = legacy_hash(key);
+    for (legacy_entry* current = table->buckets[index]; current; current = current->next) {
+        if (strcmp(current->key, key) == 0) {
+            current->value = value;
+            return CTOOLBOX_SUCCESS;
+        }
+    }
+
+    legacy_entry* entry = (legacy_entry*)malloc(sizeof(legacy_entry));
+    if (!entry) return CTOOLBOX_ERROR_MEMORY_ALLOC;
+
+    size_t len = strlen(key);
+    entry->key = (char*)malloc(len + 1);
+    if (!entry->key) {
+        free(entry);
+        return CTOOLBOX_ERROR_MEMORY_ALLOC;
+    }
+
+    memcpy(entry->key, key, len + 1);
+    entry->value = value;
+    entry->next = table->buckets[index];
+    table->buckets[index] = entry;
+    table->count++;
+    return CTOOLBOX_SUCCESS;
+}
+
+static ctoolbox_result legacy_delete(legacy_table* table, const char* key)
+{
+    unsigned long index = legacy_hash(key);
+    legacy_entry* prev = NULL;
+
+    for (legacy_entry* current = table->buckets[index]; current; prev = current, current = current->next) {
+        if (strcmp(current->key, key) == 0) {
+            if (prev) prev->next = current->next;
+            else table->buckets[index] = current->next;
+
+            free(current->key);
+            free(current);
+            table->count--;
+            return CTOOLBOX_SUCCESS;
+        }
+    }
+
+    return CTOOLBOX_ERROR_NOT_FOUND;
+}
+
+static void* legacy_lookup(legacy_table* table, const char* key)
+{
+    for (const legacy_entry* current = table->buckets[legacy_hash(key)]; current; current = current->next) {
+        if (strcmp(current->key, key) == 0) return current->value;
+    }
+
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// benchmark
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef struct phase_times_t
+{
+    double insert;
+    double lookup;
+    double lookupHashed;
+    double miss;
+    double erase;
+    bool full;
+} phase_times;
+
+/// @brief keeps the fastest time of every phase
+static void phase_times_keep_best(phase_times* best, const phase_times* run, int round)
+{
+    if (round == 0 || run->insert < best->insert) best->insert = run->insert;
+    if (round == 0 || run->lookup < best->lookup) best->lookup = run->lookup;
+    if (round == 0 || run->lookupHashed < best->lookupHashed) best->lookupHashed = run->lookupHashed;
+    if (round == 0 || run->miss < best->miss) best->miss = run->miss;
+    if (round == 0 || run->erase < best->erase) best->erase = run->erase;
+    best->full = best->full || run->full;
+}
+
+/// @brief inserts, looks up, misses and deletes every key, repeating the cycle so small tables do as much work as large ones
+static phase_times run_shashtable(char** keys, char** missing, uint64_t* hashes, uint32_t count, uint32_t repeats, volatile uintptr_t* sink)
+{
+    phase_times times = { 0 };
+
+    for (uint32_t r = 0; r < repeats; r++) {
+        shashtable* table = shashtable_init();
+        double begin = benchmark_now_ms();
+        for (uint32_t i = 0; i < count; i++) shashtable_insert(table, keys[i], (void*)(uintptr_t)(i + 1));
+        times.insert += benchmark_now_ms() - begin;
+
+        begin = benchmark_now_ms();
+        for (uint32_t i = 0; i < count; i++) *sink += (uintptr_t)shashtable_lookup(table, keys[i]);
+        times.lookup += benchmark_now_ms() - begin;
+
+        begin = benchmark_now_ms();
+        for (uint32_t i = 0; i < count; i++) *sink += (uintptr_t)shashtable_lookup_hashed(table, keys[i], hashes[i]);
+        times.lookupHashed += benchmark_now_ms() - begin;
+
+        begin = benchmark_now_ms();
+        for (uint32_t i = 0; i < count; i++) *sink += (uintptr_t)shashtable_lookup(table, missing[i]);
+        times.miss += benchmark_now_ms() - begin;
+
+        begin = benchmark_now_ms();
+        for (uint32_t i = 0; i < count; i++) shashtable_delete(table, keys[i]);
+        times.erase += benchmark_now_ms() - begin;
+
+        shashtable_destroy(table);
+    }
+
+    return times;
+}
+
+/// @brief same cycle against the legacy table, flags the run when the table refused keys
+static phase_times run_legacy(char** keys, char** missing, uint32_t count, uint32_t repeats, volatile uintptr_t* sink)
+{
+    phase_times times = { 0 };
+
+    for (uint32_t r = 0; r < repeats; r++) {
+        legacy_table* table = legacy_init();
+        double begin = benchmark_now_ms();
+        for (uint32_t i = 0; i < count; i++) {
+            if (legacy_insert(table, keys[i], (void*)(uintptr_t)(i + 1)) == CTOOLBOX_ERROR_FULL) times.full = true;
+        }
+        times.insert += benchmark_now_ms() - begin;
+
+        begin = benchmark_now_ms();
+        for (uint32_t i = 0; i < count; i++) *sink += (uintptr_t)legacy_lookup(table, keys[i]);
+        times.lookup += benchmark_now_ms() - begin;
+
+        begin = benchmark_now_ms();
+        for (uint32_t i = 0; i < count; i++) *sink += (uintptr_t)legacy_lookup(table, missing[i]);
+        times.miss += benchmark_now_ms() - begin;
+
+        begin = benchmark_now_ms();
+        for (uint32_t i = 0; i < count; i++) legacy_delete(table, keys[i]);
+        times.erase += benchmark_now_ms() - begin;
+
+        legacy_destroy(table);
+    }
+
+    return times;
+}
+
+/// @brief allocates count keys shaped like the names evk stores, a prefix and a number
+static char** make_keys(const char* prefix, uint32_t count)
+{
+    char** keys = (char**)malloc(sizeof(char*) * count);
+    if (keys == NULL) return NULL;
+
+    for (uint32_t i = 0; i < count; i++) {
+        char buffer[64];
+        int len = snprintf(buffer, sizeof(buffer), "%s_%u", prefix, i);
+        keys[i] = (char*)malloc((size_t)len + 1);
+        if (keys[i] != NULL) memcpy(keys[i], buffer, (size_t)len + 1);
+    }
+
+    return keys;
+}
+
+static void free_keys(char** keys, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) free(keys[i]);
+    free(keys);
+}
+
+int main()
+{
+    const uint32_t sizes[] = { 10, 1000, 100000 };
+    volatile uintptr_t sink = 0;
+
+    printf("shashtable against the chained table it replaced, best of %d rounds\n", BENCHMARK_ROUNDS);
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        uint32_t count = sizes[s];
+        uint32_t repeats = KEYS_PER_PHASE / count;
+        uint64_t operations = (uint64_t)count * repeats;
+
+        char** keys = make_keys("sprite", count);
+        char** missing = make_keys("texture", count);
+        uint64_t* hashes = (uint64_t*)malloc(sizeof(uint64_t) * count);
+        if (keys == NULL || missing == NULL || hashes == NULL) return 1;
+
+        for (uint32_t i = 0; i < count; i++) hashes[i] = shashtable_hash(keys[i]);
+
+        phase_times current = { 0 }, legacy = { 0 };
+        for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+            phase_times run = run_shashtable(keys, missing, hashes, count, repeats, &sink);
+            phase_times_keep_best(&current, &run, round);
+
+            run = run_legacy(keys, missing, count, repeats, &sink);
+            phase_times_keep_best(&legacy, &run, round);
+        }
+
+        printf("%u keys, %u cycles\n", count, repeats);
+        benchmark_report("shashtable insert", operations, current.insert);
+        benchmark_report("shashtable lookup", operations, current.lookup);
+        benchmark_report("shashtable lookup hashed", operations, current.lookupHashed);
+        benchmark_report("shashtable lookup missing", operations, current.miss);
+        benchmark_report("shashtable delete", operations, current.erase);
+
+        // the legacy table stops at ten entries per bucket, past that it's numbers don't describe the same work
+        if (legacy.full) {
+            printf("  %-40s n/a, full at %d entries\n", "legacy", LEGACY_SIZE * 10);
+        }
+        else {
+            benchmark_report("legacy insert", operations, legacy.insert);
+            benchmark_report("legacy lookup", operations, legacy.lookup);
+            benchmark_report("legacy lookup missing", operations, legacy.miss);
+            benchmark_report("legacy delete", operations, legacy.erase);
+        }
+
+        free_keys(keys, count);
+        free_keys(missing, count);
+        free(hashes);
+    }
+
+    return 0;
+}
@@ -0,0 +1,340 @@
+#include "benchmark.h"
+
+#define EVK_IMPLEMENTATION
+#include "evk.h"
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
+/// @brief synthetic images written and loaded by every run
+#define IMAGE_COUNT 64U
+#define IMAGE_SIZE 512U
+
+/// @brief encodes a png whose single deflate block uses the fixed huffman codes, literals only, so stb walks it's full decoder
+typedef struct png_writer_t
+{
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    uint32_t bits;
+    uint32_t bitCount;
+} png_writer;
+
+static bool png_reserve(png_writer* writer, size_t bytes)
+{
+    if (writer->size + bytes <= writer->capacity) return true;
+
+    size_t capacity = writer->capacity ? writer->capacity * 2 : 4096;
+    while (capacity < writer->size + bytes) capacity *= 2;
+
+    uint8_t* data = (uint8_t*)realloc(writer->data, capacity);
+    if (data == NULL) return false;
+    writer->data = data;
+    writer->capacity = capacity;
+    return true;
+}
+
+static bool png_put_u32(png_writer* writer, uint32_t value)
+{
+    if (!png_reserve(writer, 4)) return false;
+    writer->data[writer->size++] = (uint8_t)(value >> 24);
+    writer->data[writer->size++] = (uint8_t)(value >> 16);
+    writer->data[writer->size++] = (uint8_t)(value >> 8);
+    writer->data[writer->size++] = (uint8_t)value;
+    return true;
+}
+
+/// @brief writes count bits of value, deflate packs them from the least significant bit
+static bool png_put_bits(png_writer* writer, uint32_t value, uint32_t count)
+{
+    writer->bits |= value << writer->bitCount;
+    writer->bitCount += count;
+    while (writer->bitCount >= 8) {
+        if (!png_reserve(writer, 1)) return false;
+        writer->data[writer->size++] = (uint8_t)writer->bits;
+        writer->bits >>= 8;
+        writer->bitCount -= 8;
+    }
+    return true;
+}
+
+/// @brief writes a huffman code, those are stored from their most significant bit
+static bool png_put_code(png_writer* writer, uint32_t code, uint32_t length)
+{
+    uint32_t reversed = 0;
+    for (uint32_t i = 0; i < length; i++) reversed |= ((code >> i) & 1U) << (length - 1 - i);
+    return png_put_bits(writer, reversed, length);
+}
+
+static uint32_t png_crc(const uint8_t* data, size_t size)
+{
+    static uint32_t table[256];
+    if (table[1] == 0) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) c = c & 1 ? 0xEDB88320U ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+    }
+
+    uint32_t crc = 0xFFFFFFFFU;
+    for (size_t i = 0; i < size; i++) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFU;
+}
+
+/// @brief closes a chunk whose length and type start at begin
+static bool png_end_chunk(png_writer* writer, size_t begin)
+{
+    uint32_t length = (uint32_t)(writer->size - begin - 8);
+    writer->data[begin] = (uint8_t)(length >> 24);
+    writer->data[begin + 1] = (uint8_t)(length >> 16);
+    writer->data[begin + 2] = (uint8_t)(length >> 8);
+    writer->data[begin + 3] = (uint8_t)length;
+    return png_put_u32(writer, png_crc(writer->data + begin + 4, writer->size - begin - 4));
+}
+
+/// @brief writes an rgba8 image with a sub filter on every row, false when the file can't be written
+static bool png_write(const char* path, uint32_t width, uint32_t height, const uint8_t* rgba)
+{
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    png_writer writer = { 0 };
+    bool success = png_reserve(&writer, 64);
+    if (success) {
+        memcpy(writer.data, signature, sizeof(signature));
+        writer.size = sizeof(signature);
+    }
+
+    size_t begin = writer.size;
+    success = success && png_put_u32(&writer, 0) && png_put_u32(&writer, 0x49484452U) && png_put_u32(&writer, width) && png_put_u32(&writer, height);
+    success = success && png_reserve(&writer, 5);
+    if (success) {
+        const uint8_t format[5] = { 8, 6, 0, 0, 0 }; // 8 bit rgba, deflate, adaptive filtering, no interlace
+        memcpy(writer.data + writer.size, format, sizeof(format));
+        writer.size += sizeof(format);
+        success = png_end_chunk(&writer, begin);
+    }
+
+    begin = writer.size;
+    success = success && png_put_u32(&writer, 0) && png_put_u32(&writer, 0x49444154U);
+    success = success && png_reserve(&writer, 2);
+    if (success) {
+        writer.data[writer.size++] = 0x78; // zlib, 32k window
+        writer.data[writer.size++] = 0x01;
+        success = png_put_bits(&writer, 1, 1) && png_put_bits(&writer, 1, 2); // final block, fixed codes
+    }
+
+    uint32_t a = 1, b = 0;
+    for (uint32_t y = 0; success && y < height; y++) {
+        const uint8_t* row = rgba + (size_t)y * width * 4;
+        for (uint32_t x = 0; success && x <= width * 4; x++) {
+            uint8_t value = x == 0 ? 1 : (uint8_t)(row[x - 1] - (x > 4 ? row[x - 5] : 0));
+            a = (a + value) % 65521U;
+            b = (b + a) % 65521U;
+            success = value < 144 ? png_put_code(&writer, 0x30U + value, 8) : png_put_code(&writer, 0x190U + value - 144U, 9);
+        }
+    }
+
+    success = success && png_put_code(&writer, 0, 7) && png_put_bits(&writer, 0, 7); // end of block, then flush the last byte
+    writer.bitCount = 0;
+    success = success && png_put_u32(&writer, (b << 16) | a) && png_end_chunk(&writer, begin);
+
+    begin = writer.size;
+    success = success && png_put_u32(&writer, 0) && png_put_u32(&writer, 0x49454E44U) && png_end_chunk(&writer, begin);
+
+    FILE* file = success ? fopen(path, "wb") : NULL;
+    success = file != NULL && fwrite(writer.data, 1, writer.size, file) == writer.size;
+    if (file != NULL) fclose(file);
+
+    free(writer.data);
+    return success;
+}
+
+/// @brief fills an image with a gradient under noise, so every file decodes to different pixels
+static void image_fill(uint8_t* rgba, uint32_t index)
+{
+    uint32_t seed = 0x9E3779B9u ^ (index * 0x85EBCA6Bu);
+    for (uint32_t y = 0; y < IMAGE_SIZE; y++) {
+        for (uint32_t x = 0; x < IMAGE_SIZE; x++) {
+            uint8_t* texel = rgba + ((size_t)y * IMAGE_SIZE + x) * 4;
+            uint32_t noise = benchmark_random(&seed);
+            texel[0] = (uint8_t)(x + (noise & 15));
+            texel[1] = (uint8_t)(y + ((noise >> 4) & 15));
+            texel[2] = (uint8_t)(index * 16 + ((noise >> 8) & 15));
+            texel[3] = 255;
+        }
+    }
+}
+
+/// @brief decodes every image with the batch workers, the same job evk_texture2d_create_batch runs before it's upload
+static double decode_all(const char** paths, evkTextureBatchImage* images, uint32_t threadCount)
+{
+    evkTextureBatchJob job = { 0 };
+    job.paths = paths;
+    job.images = images;
+    job.count = IMAGE_COUNT;
+    job.next = 0;
+
+    double begin = benchmark_now_ms();
+    ievk_texture_batch_decode_parallel(&job, threadCount);
+    double elapsed = benchmark_now_ms() - begin;
+
+    for (uint32_t i = 0; i < IMAGE_COUNT; i++) {
+        if (images[i].pixels == NULL) elapsed = -1.0;
+        stbi_image_free(images[i].pixels);
+        images[i].pixels = NULL;
+    }
+    return elapsed;
+}
+
+#ifdef _WIN32
+/// @brief a hidden window is enough for a device and swapchain, nothing is presented
+static bool window_create(evkWindow* window)
+{
+    window->window = CreateWindowExA(0, "STATIC", "benchmark_texture_batch", WS_OVERLAPPEDWINDOW, 0, 0, 64, 64, NULL, NULL, GetModuleHandleA(NULL), NULL);
+    return window->window != NULL;
+}
+
+static void window_destroy(evkWindow* window)
+{
+    DestroyWindow(window->window);
+}
+#elif defined(EVK_LINUX_USE_XLIB)
+/// @brief xlib is loaded at runtime so the benchmarks keep building on machines without it's development files
+typedef struct xlib_t
+{
+    void* library;
+    Display* (*open_display)(const char*);
+    Window (*default_root_window)(Display*);
+    Window (*create_simple_window)(Display*, Window, int, int, unsigned int, unsigned int, unsigned int, unsigned long, unsigned long);
+    int (*destroy_window)(Display*, Window);
+    int (*close_display)(Display*);
+} xlib;
+
+static xlib g_Xlib = { 0 };
+
+static bool window_create(evkWindow* window)
+{
+    g_Xlib.library = dlopen("libX11.so.6", RTLD_NOW);
+    if (g_Xlib.library == NULL) return false;
+
+    *(void**)&g_Xlib.open_display = dlsym(g_Xlib.library, "XOpenDisplay");
+    *(void**)&g_Xlib.default_root_window = dlsym(g_Xlib.library, "XDefaultRootWindow");
+    *(void**)&g_Xlib.create_simple_window = dlsym(g_Xlib.library, "XCreateSimpleWindow");
+    *(void**)&g_Xlib.destroy_window = dlsym(g_Xlib.library, "XDestroyWindow");
+    *(void**)&g_Xlib.close_display = dlsym(g_Xlib.library, "XCloseDisplay");
+    if (!g_Xlib.open_display || !g_Xlib.default_root_window || !g_Xlib.create_simple_window || !g_Xlib.destroy_window || !g_Xlib.close_display) return false;
+
+    window->display = g_Xlib.open_display(NULL);
+    if (window->display == NULL) return false;
+
+    window->window = g_Xlib.create_simple_window(window->display, g_Xlib.default_root_window(window->display), 0, 0, 64, 64, 0, 0, 0);
+    return true;
+}
+
+static void window_destroy(evkWindow* window)
+{
+    if (window->display != NULL) {
+        g_Xlib.destroy_window(window->display, window->window);
+        g_Xlib.close_display(window->display);
+    }
+    if (g_Xlib.library != NULL) dlclose(g_Xlib.library);
+}
+#else
+static bool window_create(evkWindow* window) { (void)window; return false; }
+static void window_destroy(evkWindow* window) { (void)window; }
+#endif
+
+/// @brief loads the whole batch through evk on whatever device the loader picks, lavapipe when VK_ICD_FILENAMES points to it
+static void upload_all(const char** paths)
+{
+    evkCreateInfo info = { 0 };
+    info.appName = "benchmark_texture_batch";
+    info.engineName = "EVK";
+    info.width = 64;
+    info.height = 64;
+    info.MSAA = evk_Msaa_Off;
+
+    if (!window_create(&info.window)) {
+        printf("upload skipped, no window could be created for a device\n");
+        window_destroy(&info.window);
+        return;
+    }
+
+    if (evk_init(&info) != evk_Success) {
+        printf("upload skipped, evk failed to initialize\n");
+        window_destroy(&info.window);
+        return;
+    }
+
+    evkTexture2D* textures[IMAGE_COUNT];
+    evkTextureBatchStats best = { 0 };
+    for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+        evkTextureBatchStats stats = { 0 };
+        evkResult result = evk_texture2d_create_batch(paths, IMAGE_COUNT, false, textures, &stats);
+        for (uint32_t i = 0; i < IMAGE_COUNT; i++) {
+            if (textures[i] != NULL) evk_texture2d_destroy(textures[i]);
+        }
+
+        if (result != evk_Success) {
+            printf("evk_texture2d_create_batch failed, %u of %u loaded\n", stats.loaded, stats.requested);
+            break;
+        }
+        if (round == 0 || stats.totalMs < best.totalMs) best = stats;
+    }
+
+    if (best.requested > 0) {
+        printf("evk_texture2d_create_batch, %u of %u loaded with %u thread(s), %llu staging bytes\n", best.loaded, best.requested, best.threadCount, (unsigned long long)best.stagingBytes);
+        benchmark_report("batch decode", IMAGE_COUNT, best.decodeMs);
+        benchmark_report("batch upload and mipmaps", IMAGE_COUNT, best.uploadMs);
+        benchmark_report("batch total", IMAGE_COUNT, best.totalMs);
+    }
+
+    evk_shutdown();
+    window_destroy(&info.window);
+}
+
+int main()
+{
+    uint8_t* rgba = (uint8_t*)malloc((size_t)IMAGE_SIZE * IMAGE_SIZE * 4);
+    evkTextureBatchImage* images = (evkTextureBatchImage*)calloc(IMAGE_COUNT, sizeof(evkTextureBatchImage));
+    if (rgba == NULL || images == NULL) return 1;
+
+    static char names[IMAGE_COUNT][64];
+    const char* paths[IMAGE_COUNT];
+    for (uint32_t i = 0; i < IMAGE_COUNT; i++) {
+        snprintf(names[i], sizeof(names[i]), "benchmark_texture_batch_%02u.png", i);
+        paths[i] = names[i];
+
+        image_fill(rgba, i);
+        if (!png_write(paths[i], IMAGE_SIZE, IMAGE_SIZE, rgba)) {
+            printf("failed to write %s\n", paths[i]);
+            return 1;
+        }
+    }
+    free(rgba);
+
+    // decoding alone scales with the threads, one to as many as a batch may use
+    printf("%u synthetic %ux%u pngs, best of %d rounds\n", IMAGE_COUNT, IMAGE_SIZE, IMAGE_SIZE, BENCHMARK_ROUNDS);
+    for (uint32_t threads = 1; threads <= EVK_TEXTURE_BATCH_MAX_THREADS; threads *= 2) {
+        double best = 0.0;
+        for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+            double elapsed = decode_all(paths, images, threads);
+            if (elapsed < 0.0) {
+                printf("failed to decode the synthetic pngs\n");
+                return 1;
+            }
+            if (round == 0 || elapsed < best) best = elapsed;
+        }
+
+        char name[64];
+        snprintf(name, sizeof(name), "decode with %u thread(s)", threads);
+        benchmark_report(name, IMAGE_COUNT, best);
+    }
+
+    upload_all(paths);
+
+    for (uint32_t i = 0; i < IMAGE_COUNT; i++) remove(paths[i]);
+    free(images);
+    return 0;
+}
@@ -184,7 +184,7 @@ static void examples_create()
     memset(&g_Example, 0, sizeof(example));
    
     // testing path under visual studio, user should handle this 
-    g_Example.sprite = evk_sprite_create_from_path("assets/texture/error.png", 1); // hardcodding an id, user should handle object ids
+    g_Example.sprite = evk_sprite_create_from_path("assets/texture/error.png");
 }
 
 static void examples_destroy()
@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""Pack assets (cooked textures, SPIR-V, meshes) into a single .evkp file meant to be memory mapped."""
+import sys
+import struct
+from pathlib import Path
+
+# config
+INPUT_DIR = "input"             # where assets are located (root), names are paths relative to it
+OUTPUT = "bin/assets.evkp"      # where the pack will be saved
+
+# must match evk_types.h
+MAGIC = 0x504B5645              # EVK_ASSET_PACK_MAGIC, "EVKP"
+VERSION = 1                     # EVK_ASSET_PACK_VERSION
+ALIGNMENT = 64                  # EVK_ASSET_PACK_ALIGNMENT
+HEADER_FMT = '<4I3Q'            # evkAssetPackHeader
+ENTRY_FMT = '<3Q4I'             # evkAssetPackEntry
+TYPE_MAP = { '.evkt':1, '.spv':2, '.evkm':3 }  # evkAssetType, anything else is raw
+
+
+# fnv-1a 64, must match ievk_asset_pack_hash
+def fnv1a64(data):
+    h = 0xcbf29ce484222325
+    for b in data:
+        h = ((h ^ b) * 0x100000001b3) & 0xFFFFFFFFFFFFFFFF
+    return h
+
+def align(value, alignment):
+    return (value + alignment - 1) // alignment * alignment
+
+# writes the pack, the toc is an open addressed table at most half full so lookups are a probe or two
+def build_pack(assets, out):
+    slot_count = 1
+    while slot_count < max(2, len(assets) * 2):
+        slot_count *= 2
+
+    names = bytearray()
+    entries = [None] * slot_count
+    order = []
+    toc_offset = struct.calcsize(HEADER_FMT)
+    names_offset = toc_offset + slot_count * struct.calcsize(ENTRY_FMT)
+
+    for name, path in assets:
+        encoded = name.encode('utf-8')
+        h = fnv1a64(encoded)
+        slot = h & (slot_count - 1)
+        while entries[slot] is not None:
+            if entries[slot]['name'] == encoded:
+                raise RuntimeError(f"duplicated asset name {name}")
+            slot = (slot + 1) & (slot_count - 1)
+
+        entries[slot] = { 'name':encoded, 'hash':h, 'path':path, 'name_offset':len(names),
+                          'type':TYPE_MAP.get(path.suffix.lower(), 0) }
+        order.append(entries[slot])
+        names += encoded
+
+    # blobs follow the names, grouped in the order they were given so a level's assets stay contiguous
+    offset = align(names_offset + len(names), ALIGNMENT)
+    for e in order:
+        e['size'] = e['path'].stat().st_size
+        if e['size'] == 0:
+            raise RuntimeError(f"{e['path']} is empty")
+        e['offset'] = offset
+        offset = align(offset + e['size'], ALIGNMENT)
+
+    out = Path(out)
+    out.parent.mkdir(parents=True, exist_ok=True)
+    with open(out, 'wb') as f:
+        f.write(struct.pack(HEADER_FMT, MAGIC, VERSION, len(assets), slot_count, toc_offset, names_offset, len(names)))
+        for e in entries:
+            if e is None:
+                f.write(struct.pack(ENTRY_FMT, 0, 0, 0, 0, 0, 0, 0))
+            else:
+                f.write(struct.pack(ENTRY_FMT, e['hash'], e['offset'], e['size'], e['name_offset'], len(e['name']), e['type'], 0))
+        f.write(names)
+        for e in order:
+            f.write(b'\0' * (e['offset'] - f.tell()))
+            f.write(e['path'].read_bytes())
+
+    print(f"OK: {len(assets)} assets -> {out} ({offset} bytes, {slot_count} toc slots)")
+
+def main():
+    import argparse
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('inputs', nargs='*', help=f"files to pack, defaults to everything under {INPUT_DIR}")
+    parser.add_argument('-r', '--root', default=INPUT_DIR, help="names are stored relative to this directory")
+    parser.add_argument('-o', '--output', default=OUTPUT)
+    args = parser.parse_args()
+
+    root = Path(args.root)
+    paths = [Path(p) for p in args.inputs] or sorted(p for p in root.rglob('*') if p.is_file())
+    if not paths:
+        print("No assets to pack")
+        return 1
+
+    assets = []
+    for p in paths:
+        try: name = p.resolve().relative_to(root.resolve()).as_posix()
+        except ValueError: name = p.name
+        assets.append((name, p))
+
+    try:
+        build_pack(assets, args.output)
+    except Exception as e:
+        print(f"FAIL: {e}")
+        return 1
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,17 @@
+/// @brief vertex inputs matching evkVertex, locations follow evkVertexComponent and formats are expanded by the input assembler
+layout(location = 0) in vec3 in_position;   // R32G32B32_SFLOAT
+layout(location = 1) in vec2 in_normal;     // R16G16_SNORM, octahedral encoded
+layout(location = 2) in vec2 in_uv_0;       // R16G16_SFLOAT
+layout(location = 3) in vec4 in_color_0;    // R8G8B8A8_UNORM
+layout(location = 4) in uvec4 in_joints_0;  // R8G8B8A8_UINT
+layout(location = 5) in vec4 in_weights_0;  // R16G16B16A16_UNORM
+
+/// @brief decodes an octahedral encoded normal back into an unit-length vector
+vec3 func_decode_octahedral(vec2 e)
+{
+    vec3 n = vec3(e.x, e.y, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
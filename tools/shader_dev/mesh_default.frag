@@ -0,0 +1,18 @@
+#version 460
+#extension GL_GOOGLE_include_directive : enable
+
+#include "include/constants.glsl"
+#include "include/ubo_camera.glsl"
+
+layout(location = 0) in vec3 in_normal;
+layout(location = 1) in vec2 in_uv;
+layout(location = 2) in vec4 in_color;
+layout(location = 0) out vec4 out_color;
+
+void main()
+{
+    // simple directional light until materials are in place
+    vec3 light_dir = normalize(vec3(0.3, 1.0, 0.5));
+    float diffuse = max(dot(normalize(in_normal), light_dir), 0.0) * 0.8 + 0.2;
+    out_color = vec4(in_color.rgb * diffuse, in_color.a);
+}
@@ -0,0 +1,20 @@
+#version 460
+#extension GL_GOOGLE_include_directive : enable
+
+#include "include/constants.glsl"
+#include "include/ubo_camera.glsl"
+#include "include/vertex.glsl"
+
+layout(location = 0) out vec3 out_normal;
+layout(location = 1) out vec2 out_uv;
+layout(location = 2) out vec4 out_color;
+
+void main()
+{
+    vec4 world_pos = push_const.model * vec4(in_position, 1.0);
+    gl_Position = camera.proj * camera.view * world_pos;
+
+    out_normal = mat3(push_const.model) * func_decode_octahedral(in_normal);
+    out_uv = in_uv_0;
+    out_color = in_color_0;
+}
@@ -0,0 +1,11 @@
+#version 460
+#extension GL_GOOGLE_include_directive : enable
+
+#include "include/constants.glsl"
+
+layout(location = 0) out uint out_color;
+
+void main()
+{
+    out_color = push_const.id;
+}
@@ -0,0 +1,12 @@
+#version 460
+#extension GL_GOOGLE_include_directive : enable
+
+#include "include/constants.glsl"
+#include "include/ubo_camera.glsl"
+
+layout(location = 0) in vec3 in_position;
+
+void main()
+{
+    gl_Position = camera.proj * camera.view * push_const.model * vec4(in_position, 1.0);
+}
@@ -13,16 +13,10 @@ layout(location = 0) out vec4 out_color;
 
 void main()
 {
-    //// apply UV transformations
-    //vec2 transformed_uv = func_transform_uv(in_uv, sprite.uv_offset, sprite.uv_scale, radians(sprite.uv_rotation));
-    //
-    //// assign albedo color
-    //out_color = texture(albedo, transformed_uv);
-    //
-    //// discard nearly tranparency
-    //if(out_color.a < 0.01) discard;
+    // apply UV transformations, atlas sprites use it to address their region
+    vec2 transformed_uv = func_transform_uv(in_uv, sprite.uv_offset, sprite.uv_scale, radians(sprite.uv_rotation));
 
-    vec4 tex = texture(albedo, in_uv);
+    vec4 tex = texture(albedo, transformed_uv);
     if (tex.a == 0.0) {
         discard;
     }
@@ -0,0 +1,271 @@
+#!/usr/bin/env python3
+"""Cook images into GPU-ready .evkt textures (block compressed levels with precomputed mips)."""
+import sys
+import struct
+import shutil
+import tempfile
+import subprocess
+from pathlib import Path
+
+import numpy as np
+from PIL import Image
+
+# config
+INPUT_DIR = "input"             # where source images are located (root)
+OUTPUT_DIR = "bin"              # where cooked textures will be saved
+IMAGE_EXTS = { '.png', '.jpg', '.jpeg', '.tga', '.bmp' }
+
+# must match evk_types.h
+MAGIC = 0x544B5645              # EVK_COOKED_TEXTURE_MAGIC, "EVKT"
+VERSION = 1                     # EVK_COOKED_TEXTURE_VERSION
+MAX_LEVELS = 16                 # EVK_COOKED_TEXTURE_MAX_LEVELS
+HEADER_FMT = '<8I' + 'QQ' * MAX_LEVELS
+ALIGNMENT = 16
+
+# VkFormat values per cook format as (unorm, srgb), block size in texels and bytes per block
+FORMATS = {
+    'rgba8':   { 'vk': (37, 43),   'block': 1, 'bytes': 4 },
+    'bc1':     { 'vk': (131, 132), 'block': 4, 'bytes': 8 },
+    'bc7':     { 'vk': (145, 146), 'block': 4, 'bytes': 16 },
+    'astc4x4': { 'vk': (157, 158), 'block': 4, 'bytes': 16 },
+}
+
+
+# srgb <-> linear, mips are filtered in linear space
+def srgb_to_linear(c):
+    return np.where(c <= 0.04045, c / 12.92, ((c + 0.055) / 1.055) ** 2.4)
+
+def linear_to_srgb(c):
+    return np.where(c <= 0.0031308, c * 12.92, 1.055 * np.power(np.maximum(c, 0.0), 1.0 / 2.4) - 0.055)
+
+# halves one axis, even sizes average texel pairs and odd sizes use a 1-2-1 tent over three texels so the edges stay covered
+def downsample_axis(a, axis):
+    n = a.shape[axis]
+    if n == 1:
+        return a
+    m = n // 2
+    take = lambda idx: np.take(a, np.minimum(idx, n - 1), axis=axis)  # edge clamped taps
+    j = np.arange(m) * 2
+    if n & 1 == 0:
+        return (take(j) + take(j + 1)) * 0.5
+    return take(j) * 0.25 + take(j + 1) * 0.5 + take(j + 2) * 0.25
+
+# number of levels in a full chain, each level is max(1, size >> i) like the loader expects
+def mip_count(w, h):
+    return max(w, h).bit_length()
+
+# builds the mip chain as rgba8 arrays
+def build_mips(img, srgb, max_levels):
+    rgba = np.asarray(img.convert('RGBA'), dtype=np.float32) / 255.0
+    if srgb:
+        rgba[..., :3] = srgb_to_linear(rgba[..., :3])
+
+    h, w = rgba.shape[:2]
+    levels = [rgba]
+    for _ in range(1, min(max_levels, mip_count(w, h))):
+        levels.append(downsample_axis(downsample_axis(levels[-1], 0), 1))
+
+    out = []
+    for level in levels:
+        level = level.copy()
+        if srgb:
+            level[..., :3] = linear_to_srgb(level[..., :3])
+        out.append(np.clip(level * 255.0 + 0.5, 0, 255).astype(np.uint8))
+    return out
+
+# splits an rgba8 level into 4x4 blocks, padding by edge replication, returns (blocks_y, blocks_x, 16, 4)
+def to_blocks(level):
+    h, w = level.shape[:2]
+    ph, pw = (h + 3) // 4 * 4, (w + 3) // 4 * 4
+    padded = np.pad(level, ((0, ph - h), (0, pw - w), (0, 0)), mode='edge')
+    return padded.reshape(ph // 4, 4, pw // 4, 4, 4).transpose(0, 2, 1, 3, 4).reshape(ph // 4, pw // 4, 16, 4)
+
+# packs rgb floats [0, 255] into rgb565
+def pack565(c):
+    r = np.clip(np.rint(c[..., 0] * 31.0 / 255.0), 0, 31).astype(np.uint32)
+    g = np.clip(np.rint(c[..., 1] * 63.0 / 255.0), 0, 63).astype(np.uint32)
+    b = np.clip(np.rint(c[..., 2] * 31.0 / 255.0), 0, 31).astype(np.uint32)
+    return (r << 11) | (g << 5) | b
+
+def unpack565(v):
+    r = ((v >> 11) & 31).astype(np.float32) * 255.0 / 31.0
+    g = ((v >> 5) & 63).astype(np.float32) * 255.0 / 63.0
+    b = (v & 31).astype(np.float32) * 255.0 / 31.0
+    return np.stack([r, g, b], axis=-1)
+
+# encodes a level into bc1 (opaque, four color mode), endpoints come from the block's principal axis
+def encode_bc1(level):
+    blocks = to_blocks(level)[..., :3].astype(np.float32)
+    by, bx = blocks.shape[:2]
+    px = blocks.reshape(-1, 16, 3)
+
+    mean = px.mean(axis=1, keepdims=True)
+    centered = px - mean
+    cov = np.einsum('nki,nkj->nij', centered, centered)
+    axis = np.ones((px.shape[0], 3), dtype=np.float32)
+    for _ in range(8):  # power iteration
+        axis = np.einsum('nij,nj->ni', cov, axis)
+        axis /= np.maximum(np.linalg.norm(axis, axis=1, keepdims=True), 1e-8)
+
+    proj = np.einsum('nki,ni->nk', centered, axis)
+    lo = mean[:, 0] + axis * proj.min(axis=1, keepdims=True)
+    hi = mean[:, 0] + axis * proj.max(axis=1, keepdims=True)
+    c0, c1 = pack565(hi), pack565(lo)
+
+    # four color mode needs c0 > c1, equal endpoints fall back to a solid block
+    swap = c0 < c1
+    c0, c1 = np.where(swap, c1, c0), np.where(swap, c0, c1)
+    e0, e1 = unpack565(c0), unpack565(c1)
+    palette = np.stack([e0, e1, (2 * e0 + e1) / 3.0, (e0 + 2 * e1) / 3.0], axis=1)
+
+    dist = ((px[:, :, None, :] - palette[:, None, :, :]) ** 2).sum(axis=-1)
+    idx = dist.argmin(axis=2).astype(np.uint32)
+    idx = np.where((c0 == c1)[:, None], 0, idx)
+
+    bits = (idx << (np.arange(16, dtype=np.uint32) * 2)).sum(axis=1, dtype=np.uint64).astype(np.uint32)
+    out = np.zeros((px.shape[0],), dtype=[('c0', '<u2'), ('c1', '<u2'), ('idx', '<u4')])
+    out['c0'], out['c1'], out['idx'] = c0, c1, bits
+    assert out.nbytes == by * bx * 8
+    return out.tobytes()
+
+# runs an external encoder, returns the payload without the container header
+def run_external(tool, args, level, suffix, header_size):
+    exe = shutil.which(tool)
+    if not exe:
+        raise RuntimeError(f"{tool} not found in PATH")
+
+    with tempfile.TemporaryDirectory() as tmp:
+        src = Path(tmp) / 'level.png'
+        dst = Path(tmp) / f'level{suffix}'
+        Image.fromarray(level, 'RGBA').save(src)
+        result = subprocess.run([exe, *args(str(src), str(dst))], capture_output=True, text=True)
+        if result.returncode != 0:
+            raise RuntimeError(f"{tool} failed: {result.stderr.strip()}")
+
+        data = dst.read_bytes()
+        return data[header_size(data):]
+
+# dds payloads start after the 128 byte header, plus the dx10 extension when present
+def dds_header_size(data):
+    return 148 if data[84:88] == b'DX10' else 128
+
+def encode_bc7(level, srgb):
+    return run_external('bc7enc', lambda s, d: [s, '-o', d] + (['-srgb'] if srgb else []), level, '.dds', dds_header_size)
+
+def encode_astc4x4(level, srgb):
+    mode = '-cs' if srgb else '-cl'
+    return run_external('astcenc', lambda s, d: [mode, s, d, '4x4', '-medium'], level, '.astc', lambda data: 16)
+
+# encodes a single level into the requested format
+def encode_level(fmt, level, srgb):
+    if fmt == 'rgba8': return level.tobytes()
+    if fmt == 'bc1': return encode_bc1(level)
+    if fmt == 'bc7': return encode_bc7(level, srgb)
+    if fmt == 'astc4x4': return encode_astc4x4(level, srgb)
+    raise ValueError(f"unknown format {fmt}")
+
+# cooks an image into an .evkt file
+def cook(inp, out, fmt, srgb, mips):
+    info = FORMATS[fmt]
+    img = Image.open(inp)
+    levels = build_mips(img, srgb, MAX_LEVELS if mips else 1)
+
+    payloads = []
+    for i, level in enumerate(levels):
+        data = encode_level(fmt, level, srgb)
+        h, w = level.shape[:2]
+        blocks = ((w + info['block'] - 1) // info['block']) * ((h + info['block'] - 1) // info['block'])
+        if len(data) != blocks * info['bytes']:
+            raise RuntimeError(f"level {i} has {len(data)} bytes, expected {blocks * info['bytes']}")
+        payloads.append(data)
+
+    offset = struct.calcsize(HEADER_FMT)
+    entries = []
+    for data in payloads:
+        offset = (offset + ALIGNMENT - 1) // ALIGNMENT * ALIGNMENT
+        entries.append((offset, len(data)))
+        offset += len(data)
+
+    flat = [v for e in entries for v in e] + [0, 0] * (MAX_LEVELS - len(entries))
+    width, height = img.size
+    header = struct.pack(HEADER_FMT, MAGIC, VERSION, info['vk'][1 if srgb else 0], width, height, len(payloads), 1, 0, *flat)
+
+    out = Path(out)
+    out.parent.mkdir(parents=True, exist_ok=True)
+    with open(out, 'wb') as f:
+        f.write(header)
+        for (pos, _), data in zip(entries, payloads):
+            f.write(b'\0' * (pos - f.tell()))
+            f.write(data)
+
+    print(f"OK: {inp} -> {out} ({fmt}{', srgb' if srgb else ''}, {width}x{height}, {len(payloads)} levels, {offset} bytes)")
+    return True
+
+# validates a cooked file the way ievk_cooked_texture_read_header does, returns the header fields
+def read_cooked(path):
+    data = Path(path).read_bytes()
+    fields = struct.unpack_from(HEADER_FMT, data)
+    magic, version, vkformat, width, height, levels, layers = fields[:7]
+    if magic != MAGIC or version != VERSION:
+        raise RuntimeError("unknown magic or version")
+    if width == 0 or height == 0 or layers != 1 or levels == 0 or levels > MAX_LEVELS:
+        raise RuntimeError("invalid size, layer count or level count")
+    if levels > mip_count(width, height):
+        raise RuntimeError(f"{levels} levels but a {width}x{height} image has at most {mip_count(width, height)}")
+
+    info = next(f for f in FORMATS.values() if vkformat in f['vk'])
+    for i in range(levels):
+        offset, size = fields[8 + i * 2], fields[9 + i * 2]
+        w, h = max(1, width >> i), max(1, height >> i)
+        expected = ((w + info['block'] - 1) // info['block']) * ((h + info['block'] - 1) // info['block']) * info['bytes']
+        if size == 0 or offset + size > len(data) or size < expected:
+            raise RuntimeError(f"level {i} holds {size} bytes at {offset}, it's extent needs {expected}")
+    return width, height, levels
+
+# cooks non-power-of-two images and loads them back, the level chain must match what the loader accepts
+def check():
+    with tempfile.TemporaryDirectory() as tmp:
+        for w, h in ((37, 19), (5, 64), (1, 3), (640, 480)):
+            src, dst = Path(tmp) / f'{w}x{h}.png', Path(tmp) / f'{w}x{h}.evkt'
+            pixels = (np.arange(w * h * 4, dtype=np.uint32).reshape(h, w, 4) * 37 % 256).astype(np.uint8)
+            Image.fromarray(pixels, 'RGBA').save(src)
+            for fmt in ('rgba8', 'bc1'):
+                cook(src, dst, fmt, True, True)
+                width, height, levels = read_cooked(dst)
+                if (width, height, levels) != (w, h, mip_count(w, h)):
+                    raise RuntimeError(f"{fmt} {w}x{h} loaded back as {width}x{height} with {levels} levels")
+    print("Round trip OK")
+    return 0
+
+def main():
+    import argparse
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('inputs', nargs='*', help=f"images to cook, defaults to everything under {INPUT_DIR}")
+    parser.add_argument('-f', '--format', choices=FORMATS.keys(), default='bc1')
+    parser.add_argument('--linear', action='store_true', help="data textures (normals, masks), skips srgb")
+    parser.add_argument('--no-mips', action='store_true')
+    parser.add_argument('-o', '--output', default=OUTPUT_DIR)
+    parser.add_argument('--check', action='store_true', help="cooks and reloads non-power-of-two images, then exits")
+    args = parser.parse_args()
+
+    if args.check:
+        return check()
+
+    inputs = [Path(p) for p in args.inputs] or [p for p in Path(INPUT_DIR).rglob('*') if p.suffix.lower() in IMAGE_EXTS]
+    if not inputs:
+        print("No images to cook")
+        return 1
+
+    failed = 0
+    for inp in inputs:
+        try:
+            cook(inp, Path(args.output) / f"{inp.stem}.evkt", args.format, not args.linear, not args.no_mips)
+        except Exception as e:
+            print(f"FAIL: {inp}: {e}")
+            failed += 1
+
+    print(f"Cooked {len(inputs) - failed}/{len(inputs)}")
+    return 1 if failed else 0
+
+if __name__ == '__main__':
+    sys.exit(main())